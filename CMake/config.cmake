@@ -133,6 +133,9 @@ mark_as_advanced(TTK_SCRIPTS_PATH)
 option(TTK_ENABLE_SHARED_BASE_LIBRARIES "Generate shared base libraries instead of static ones" ON)
 mark_as_advanced(TTK_ENABLE_SHARED_BASE_LIBRARIES)
 
+option(TTK_BUILD_BENCHMARKS "Build the benchmarks and checks of the base layer" OFF)
+mark_as_advanced(TTK_BUILD_BENCHMARKS)
+
 option(TTK_BUILD_DOCUMENTATION "Build doxygen developer documentation" OFF)
 if(TTK_BUILD_DOCUMENTATION)
   find_package(Doxygen)
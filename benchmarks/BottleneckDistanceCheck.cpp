@@ -0,0 +1,228 @@
+/// \brief Check of the exact geometric bottleneck distance of
+/// ttk::BottleneckDistance.
+///
+/// Computes the bottleneck distance between pairs of random persistence
+/// diagrams with the geometric approach and fails if it differs from a
+/// reference, obtained by testing every candidate distance for a perfect
+/// matching in the complete bipartite graph (points and their diagonal
+/// projections). The TTK (Gabow-Tarjan) approach is only timed: it evaluates
+/// its matching with the point-to-point distances, not with the costs it
+/// optimized, and overestimates the distance. Then runs the geometric approach
+/// on two large diagrams made of interleaved staircases, whose Hopcroft-Karp
+/// augmenting paths go through all the pairs.
+
+// TTK Includes
+#include <BottleneckDistance.h>
+#include <CommandLineParser.h>
+#include <Timer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <random>
+
+static double bottleneck(const ttk::DiagramType &diagram0,
+                         const ttk::DiagramType &diagram1,
+                         const std::string &algorithm) {
+  ttk::BottleneckDistance bottleneckDistance{};
+  bottleneckDistance.setDebugLevel(0);
+  bottleneckDistance.setWasserstein("inf");
+  bottleneckDistance.setAlgorithm(algorithm);
+  // keep the pairs of low persistence, as the reference does
+  bottleneckDistance.setPersistencePercentThreshold(0.0);
+  std::vector<ttk::MatchingType> matchings{};
+  if(bottleneckDistance.execute(diagram0, diagram1, matchings) != 0) {
+    return -1.0;
+  }
+  return bottleneckDistance.getDistance();
+}
+
+// smallest distance for which the points of the two diagrams and their
+// diagonal projections can be perfectly matched (L1 distance between points,
+// persistence between a point and its projection, 0 between projections)
+static double referenceBottleneck(const ttk::DiagramType &diagram0,
+                                  const ttk::DiagramType &diagram1) {
+  const size_t n0 = diagram0.size(), n1 = diagram1.size(), n = n0 + n1;
+  const double inf = std::numeric_limits<double>::infinity();
+  std::vector<double> cost(n * n, inf);
+  for(size_t i = 0; i < n; ++i) {
+    for(size_t j = 0; j < n; ++j) {
+      auto &c = cost[i * n + j];
+      if(i < n0 && j < n1) {
+        c = std::abs(diagram0[i].birth.sfValue - diagram1[j].birth.sfValue)
+            + std::abs(diagram0[i].death.sfValue - diagram1[j].death.sfValue);
+      } else if(i < n0) {
+        c = j - n1 == i ? diagram0[i].persistence() : inf;
+      } else if(j < n1) {
+        c = i - n0 == j ? diagram1[j].persistence() : inf;
+      } else {
+        c = 0.0;
+      }
+    }
+  }
+
+  const auto perfectMatching = [&](const double threshold) {
+    std::vector<int> pair(n, -1);
+    std::vector<bool> visited(n);
+    const std::function<bool(size_t)> augment = [&](const size_t i) {
+      for(size_t j = 0; j < n; ++j) {
+        if(cost[i * n + j] <= threshold && !visited[j]) {
+          visited[j] = true;
+          if(pair[j] == -1 || augment(pair[j])) {
+            pair[j] = i;
+            return true;
+          }
+        }
+      }
+      return false;
+    };
+    for(size_t i = 0; i < n; ++i) {
+      std::fill(visited.begin(), visited.end(), false);
+      if(!augment(i)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  std::vector<double> candidates{};
+  std::copy_if(cost.begin(), cost.end(), std::back_inserter(candidates),
+               [&](const double c) { return c < inf; });
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(
+    std::unique(candidates.begin(), candidates.end()), candidates.end());
+  // the largest candidate always admits a perfect matching
+  size_t lo{}, hi{candidates.size() - 1};
+  while(lo < hi) {
+    const size_t mid = (lo + hi) / 2;
+    if(perfectMatching(candidates[mid])) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  return candidates[lo];
+}
+
+int main(int argc, char **argv) {
+
+  int pairNumber{200};
+  int diagramPairs{20};
+  int largePairNumber{100000};
+
+  {
+    ttk::CommandLineParser parser;
+    parser.setArgument(
+      "n", &pairNumber, "Number of persistence pairs per random diagram", true);
+    parser.setArgument(
+      "p", &diagramPairs, "Number of pairs of random diagrams", true);
+    parser.setArgument("N", &largePairNumber,
+                       "Number of persistence pairs per staircase diagram",
+                       true);
+    parser.parse(argc, argv);
+  }
+
+  ttk::Debug msg;
+  msg.setDebugMsgPrefix("BottleneckDistanceCheck");
+
+  if(pairNumber < 1 || diagramPairs < 1 || largePairNumber < 1) {
+    msg.printErr("Invalid parameters");
+    return 1;
+  }
+
+  const auto makePair = [](const double birth, const double death,
+                           const ttk::SimplexId dim) {
+    ttk::PersistencePair pair{};
+    pair.birth = {0,
+                  dim == 0 ? ttk::CriticalType::Local_minimum
+                           : ttk::CriticalType::Saddle1,
+                  birth,
+                  {}};
+    pair.death = {0,
+                  dim == 0 ? ttk::CriticalType::Saddle1
+                           : ttk::CriticalType::Local_maximum,
+                  death,
+                  {}};
+    pair.dim = dim;
+    pair.isFinite = true;
+    return pair;
+  };
+
+  // random diagrams, most pairs close to the diagonal (noise) and a few
+  // persistent ones, with different sizes
+  std::mt19937 gen{0};
+  std::uniform_real_distribution<double> dis{0.0, 1.0};
+  std::exponential_distribution<double> noise{20.0};
+  const auto randomDiagram = [&](const int size) {
+    ttk::DiagramType diagram{};
+    for(int i = 0; i < size; ++i) {
+      const double birth = dis(gen);
+      const double persistence = dis(gen) < 0.1 ? dis(gen) : noise(gen);
+      diagram.emplace_back(makePair(birth, birth + persistence, i % 2));
+    }
+    return diagram;
+  };
+
+  int status{};
+  double geometricTime{}, ttkTime{}, maxError{};
+  for(int i = 0; i < diagramPairs; ++i) {
+    const auto diagram0 = randomDiagram(pairNumber);
+    const auto diagram1 = randomDiagram(pairNumber + i % 7);
+    ttk::Timer tm{};
+    bottleneck(diagram0, diagram1, "ttk");
+    ttkTime += tm.getElapsedTime();
+    tm.reStart();
+    const double distance = bottleneck(diagram0, diagram1, "geometric");
+    geometricTime += tm.getElapsedTime();
+    // pairs of different dimensions are never matched together
+    double reference{};
+    for(const ttk::SimplexId dim : {0, 1}) {
+      const auto select = [dim](const ttk::DiagramType &diagram) {
+        ttk::DiagramType selection{};
+        std::copy_if(diagram.begin(), diagram.end(),
+                     std::back_inserter(selection),
+                     [dim](const ttk::PersistencePair &p) {
+                       return p.dim == dim;
+                     });
+        return selection;
+      };
+      reference = std::max(
+        reference, referenceBottleneck(select(diagram0), select(diagram1)));
+    }
+    const double error = std::abs(distance - reference);
+    maxError = std::max(maxError, error);
+    if(distance < 0 || error > 1e-9 * (1.0 + reference)) {
+      msg.printErr("Diagrams " + std::to_string(i) + ": geometric "
+                   + std::to_string(distance) + " vs reference "
+                   + std::to_string(reference));
+      status = 1;
+    }
+  }
+  msg.printMsg("TTK approach", 1.0, ttkTime, 1);
+  msg.printMsg("Geometric approach (max difference "
+                 + std::to_string(maxError) + ")",
+               1.0, geometricTime, ttk::globalThreadNumber_);
+
+  // interleaved staircases: each pair is at distance 1 of two pairs of the
+  // other diagram and at distance 3 of the diagonal. Listed from right to
+  // left, the first augmenting phase matches each pair with its left
+  // neighbor and the second one finds a path through all the pairs.
+  ttk::DiagramType stairs0{}, stairs1{};
+  for(int i = largePairNumber - 1; i >= 0; --i) {
+    stairs0.emplace_back(makePair(i, i + 3.0, 0));
+    stairs1.emplace_back(makePair(i + 0.5, i + 3.5, 0));
+  }
+  ttk::Timer tm{};
+  const double distance = bottleneck(stairs0, stairs1, "geometric");
+  if(std::abs(distance - 1.0) > 1e-9) {
+    msg.printErr("Staircases: geometric " + std::to_string(distance)
+                 + " vs 1");
+    status = 1;
+  }
+  msg.printMsg("Geometric approach on " + std::to_string(largePairNumber)
+                 + " staircase pairs",
+               1.0, tm.getElapsedTime(), ttk::globalThreadNumber_);
+
+  return status;
+}
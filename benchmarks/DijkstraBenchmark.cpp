@@ -0,0 +1,193 @@
+/// \brief Benchmark of the shortest path implementations of ttk::Dijkstra.
+///
+/// Compares the priority queue implementation with the Delta-stepping one
+/// (single-threaded and parallel, full and bounded propagations) on a
+/// synthetic triangulated height field. Fails if the Delta-stepping
+/// distances differ from the priority queue ones by more than 1e-9 relative
+/// to the largest distance.
+
+// TTK Includes
+#include <CommandLineParser.h>
+#include <Dijkstra.h>
+#include <Timer.h>
+#include <Triangulation.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+
+int main(int argc, char **argv) {
+
+  int resolution{1000};
+  int queryNumber{10};
+  int radius{20};
+  double delta{0.0};
+
+  {
+    ttk::CommandLineParser parser;
+    parser.setArgument(
+      "r", &resolution, "Grid resolution (vertices per side)", true);
+    parser.setArgument("q", &queryNumber, "Number of queries", true);
+    parser.setArgument(
+      "b", &radius, "Target distance of bounded queries (in edges)", true);
+    parser.setArgument(
+      "d", &delta, "Bucket width (mean edge length if 0)", true);
+    parser.parse(argc, argv);
+  }
+  const int threadNumber{ttk::globalThreadNumber_};
+
+  ttk::Debug msg;
+  msg.setDebugMsgPrefix("DijkstraBenchmark");
+
+  if(resolution < 2 || queryNumber < 1 || radius < 1) {
+    msg.printErr("Invalid parameters");
+    return 1;
+  }
+
+  // jittered grid with a smooth height
+  ttk::Timer tm{};
+  const auto n = static_cast<ttk::SimplexId>(resolution);
+  std::mt19937 gen{0};
+  std::uniform_real_distribution<float> jitter{-0.3F, 0.3F};
+  std::vector<float> points{};
+  points.reserve(3 * n * n);
+  for(ttk::SimplexId j = 0; j < n; ++j) {
+    for(ttk::SimplexId i = 0; i < n; ++i) {
+      const float x = i + jitter(gen);
+      const float y = j + jitter(gen);
+      points.emplace_back(x);
+      points.emplace_back(y);
+      points.emplace_back(8.0F * std::sin(0.05F * x) * std::cos(0.03F * y));
+    }
+  }
+  std::vector<ttk::LongSimplexId> connectivity{};
+  const auto cellNumber = 2 * (n - 1) * (n - 1);
+#ifdef TTK_CELL_ARRAY_NEW
+  std::vector<ttk::LongSimplexId> offsets{};
+  for(ttk::SimplexId i = 0; i <= cellNumber; ++i) {
+    offsets.emplace_back(3 * i);
+  }
+#endif // TTK_CELL_ARRAY_NEW
+  for(ttk::SimplexId j = 0; j + 1 < n; ++j) {
+    for(ttk::SimplexId i = 0; i + 1 < n; ++i) {
+      const ttk::LongSimplexId a = j * n + i;
+      for(const auto &tri : {std::array<ttk::LongSimplexId, 3>{a, a + 1, a + n},
+                             {a + 1, a + n + 1, a + n}}) {
+#ifndef TTK_CELL_ARRAY_NEW
+        connectivity.emplace_back(3);
+#endif // TTK_CELL_ARRAY_NEW
+        connectivity.insert(connectivity.end(), tri.begin(), tri.end());
+      }
+    }
+  }
+
+  ttk::Triangulation triangulation{};
+  triangulation.setInputPoints(n * n, points.data());
+#ifdef TTK_CELL_ARRAY_NEW
+  triangulation.setInputCells(cellNumber, connectivity.data(), offsets.data());
+#else
+  triangulation.setInputCells(cellNumber, connectivity.data());
+#endif // TTK_CELL_ARRAY_NEW
+  triangulation.preconditionVertexNeighbors();
+  msg.printMsg("Built a " + std::to_string(n * n) + " vertices surface", 1.0,
+               tm.getElapsedTime());
+
+  if(!(delta > 0.0)) {
+    delta = ttk::Dijkstra::meanEdgeLength<double>(triangulation, threadNumber);
+  }
+  msg.printMsg("Bucket width: " + std::to_string(delta));
+
+  // random sources away from the border
+  std::uniform_int_distribution<ttk::SimplexId> coord{
+    radius, std::max(n - 1 - radius, static_cast<ttk::SimplexId>(radius))};
+  std::vector<ttk::SimplexId> sources{};
+  for(int i = 0; i < queryNumber; ++i) {
+    sources.emplace_back(coord(gen) * n + coord(gen));
+  }
+  const auto targetsOf = [n, radius](const ttk::SimplexId s) {
+    const ttk::SimplexId i = s % n, j = s / n;
+    return std::vector<ttk::SimplexId>{
+      j * n + std::max(i - radius, ttk::SimplexId{0}),
+      j * n + std::min(i + radius, n - 1),
+      std::max(j - radius, ttk::SimplexId{0}) * n + i,
+      std::min(j + radius, n - 1) * n + i};
+  };
+
+  std::vector<std::vector<double>> reference(queryNumber);
+  ttk::Dijkstra::DeltaSteppingWorkspace<double> workspace{};
+  double error{};
+
+  // full propagations
+  tm.reStart();
+  for(int i = 0; i < queryNumber; ++i) {
+    ttk::Dijkstra::shortestPath(sources[i], triangulation, reference[i]);
+  }
+  const auto pqTime = tm.getElapsedTime() / queryNumber;
+  msg.printMsg("Priority queue, full", 1.0, pqTime, 1);
+
+  for(const int nThreads : {1, threadNumber}) {
+    tm.reStart();
+    for(int i = 0; i < queryNumber; ++i) {
+      ttk::Dijkstra::shortestPathDeltaStepping<double>(
+        {sources[i]}, triangulation, workspace, {}, delta, nThreads);
+      for(size_t j = 0; j < reference[i].size(); ++j) {
+        error = std::max(error, std::abs(workspace.dists[j] - reference[i][j]));
+      }
+    }
+    const auto time = tm.getElapsedTime() / queryNumber;
+    msg.printMsg("Delta-stepping, full (x" + std::to_string(pqTime / time)
+                   + ")",
+                 1.0, time, nThreads);
+    if(nThreads == threadNumber) {
+      break;
+    }
+  }
+  msg.printMsg("Max. distance difference: " + std::to_string(error));
+
+  // the paths of equal length may sum their edges in another order
+  double maxDist{};
+  for(const auto &dists : reference) {
+    maxDist = std::max(maxDist, *std::max_element(dists.begin(), dists.end()));
+  }
+  const double tolerance = 1e-9 * maxDist;
+  int status = error > tolerance;
+
+  // bounded propagations
+  tm.reStart();
+  std::vector<double> dists{};
+  for(int i = 0; i < queryNumber; ++i) {
+    ttk::Dijkstra::shortestPath(
+      sources[i], triangulation, dists, targetsOf(sources[i]));
+  }
+  const auto pqBoundedTime = tm.getElapsedTime() / queryNumber;
+  msg.printMsg("Priority queue, bounded", 1.0, pqBoundedTime, 1);
+
+  error = 0.0;
+  for(const int nThreads : {1, threadNumber}) {
+    tm.reStart();
+    for(int i = 0; i < queryNumber; ++i) {
+      const auto targets = targetsOf(sources[i]);
+      ttk::Dijkstra::shortestPathDeltaStepping<double>(
+        {sources[i]}, triangulation, workspace, targets, delta, nThreads);
+      for(const auto t : targets) {
+        error = std::max(error, std::abs(workspace.dists[t] - reference[i][t]));
+      }
+    }
+    const auto time = tm.getElapsedTime() / queryNumber;
+    msg.printMsg("Delta-stepping, bounded (x"
+                   + std::to_string(pqBoundedTime / time) + ")",
+                 1.0, time, nThreads);
+    if(nThreads == threadNumber) {
+      break;
+    }
+  }
+  msg.printMsg("Max. target distance difference: " + std::to_string(error));
+  status |= error > tolerance;
+
+  if(status != 0) {
+    msg.printErr("Delta-stepping distances differ from the priority queue");
+  }
+
+  return status;
+}
@@ -0,0 +1,258 @@
+/// \brief Check of the native PCA, MDS and t-SNE backends of
+/// ttk::DimensionReduction against scikit-learn.
+///
+/// Embeds the iris data set with the native backends and compares the
+/// embeddings to the scikit-learn ones checked in next to it (see
+/// data/dimensionReductionReferences.py). The check fails if
+/// - the PCA coordinates, up to the sign of each component, differ by more
+///   than 1e-6 relative to the embedding extent,
+/// - the fraction of the k nearest neighbors of the input preserved by the
+///   MDS or t-SNE embedding is lower than the reference one by more than the
+///   tolerance (the native MDS is classical scaling while scikit-learn uses
+///   SMACOF, and t-SNE is stochastic),
+/// - the stress of the MDS embedding exceeds the reference one by more than
+///   10%.
+
+// TTK Includes
+#include <CommandLineParser.h>
+#include <DimensionReduction.h>
+#include <Timer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <sstream>
+
+using Embedding = std::vector<std::vector<double>>;
+
+// reads the rows of a CSV file, skipping the comment lines
+static int readCSV(const std::string &fileName,
+                   std::vector<std::vector<double>> &rows) {
+  std::ifstream file{fileName};
+  if(!file.is_open()) {
+    return 1;
+  }
+  std::string line{};
+  while(std::getline(file, line)) {
+    if(line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::replace(line.begin(), line.end(), ',', ' ');
+    std::istringstream stream{line};
+    std::vector<double> row{};
+    double value{};
+    while(stream >> value) {
+      row.emplace_back(value);
+    }
+    if(!rows.empty() && row.size() != rows[0].size()) {
+      return 1;
+    }
+    rows.emplace_back(std::move(row));
+  }
+  return rows.empty();
+}
+
+// fraction of the k nearest neighbors of each point in the input that are
+// also among its k nearest neighbors in the embedding
+static double neighborhoodPreservation(const std::vector<double> &points,
+                                       const int nRows,
+                                       const int nColumns,
+                                       const Embedding &embedding,
+                                       const int k) {
+  const auto knn = [&](const int i, const auto &distance) {
+    std::vector<int> ids(nRows);
+    std::iota(ids.begin(), ids.end(), 0);
+    std::vector<double> d(nRows);
+    for(int j = 0; j < nRows; ++j) {
+      d[j] = distance(i, j);
+    }
+    d[i] = std::numeric_limits<double>::max();
+    // ties broken by index, the data set having duplicated points
+    std::partial_sort(
+      ids.begin(), ids.begin() + k, ids.end(), [&](const int a, const int b) {
+        return d[a] < d[b] || (d[a] == d[b] && a < b);
+      });
+    ids.resize(k);
+    std::sort(ids.begin(), ids.end());
+    return ids;
+  };
+  const auto inputDistance = [&](const int i, const int j) {
+    double d{};
+    for(int c = 0; c < nColumns; ++c) {
+      const double e = points[i * nColumns + c] - points[j * nColumns + c];
+      d += e * e;
+    }
+    return d;
+  };
+  const auto outputDistance = [&](const int i, const int j) {
+    double d{};
+    for(const auto &component : embedding) {
+      const double e = component[i] - component[j];
+      d += e * e;
+    }
+    return d;
+  };
+
+  size_t kept{};
+  for(int i = 0; i < nRows; ++i) {
+    const auto a = knn(i, inputDistance);
+    const auto b = knn(i, outputDistance);
+    std::vector<int> common{};
+    std::set_intersection(
+      a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(common));
+    kept += common.size();
+  }
+  return static_cast<double>(kept) / (static_cast<double>(nRows) * k);
+}
+
+// normalized stress (Kruskal) of the embedding
+static double stress(const std::vector<double> &points,
+                     const int nRows,
+                     const int nColumns,
+                     const Embedding &embedding) {
+  double num{}, den{};
+  for(int i = 0; i < nRows; ++i) {
+    for(int j = i + 1; j < nRows; ++j) {
+      double d0{}, d1{};
+      for(int c = 0; c < nColumns; ++c) {
+        const double e = points[i * nColumns + c] - points[j * nColumns + c];
+        d0 += e * e;
+      }
+      for(const auto &component : embedding) {
+        const double e = component[i] - component[j];
+        d1 += e * e;
+      }
+      const double diff = std::sqrt(d0) - std::sqrt(d1);
+      num += diff * diff;
+      den += d0;
+    }
+  }
+  return std::sqrt(num / den);
+}
+
+// largest coordinate difference, the components being defined up to their
+// sign, relative to the extent of the reference embedding
+static double coordinateDifference(const Embedding &a, const Embedding &b) {
+  double diff{}, extent{};
+  for(size_t c = 0; c < std::min(a.size(), b.size()); ++c) {
+    const double dot
+      = std::inner_product(a[c].begin(), a[c].end(), b[c].begin(), 0.0);
+    const double sign = dot < 0 ? -1.0 : 1.0;
+    for(size_t i = 0; i < a[c].size(); ++i) {
+      diff = std::max(diff, std::abs(a[c][i] - sign * b[c][i]));
+      extent = std::max(extent, std::abs(a[c][i]));
+    }
+  }
+  return diff / std::max(extent, 1e-12);
+}
+
+int main(int argc, char **argv) {
+
+  std::string dataPath{};
+  int neighborNumber{10};
+  double tolerance{0.05};
+
+  {
+    ttk::CommandLineParser parser;
+    parser.setArgument(
+      "p", &dataPath, "Path to the data set and its references");
+    parser.setArgument(
+      "k", &neighborNumber, "Number of neighbors to preserve", true);
+    parser.setArgument(
+      "e", &tolerance, "Tolerance on the neighbor preservation", true);
+    parser.parse(argc, argv);
+  }
+
+  ttk::Debug msg;
+  msg.setDebugMsgPrefix("DimensionReductionSklearnCheck");
+
+  std::vector<std::vector<double>> rows{};
+  if(readCSV(dataPath + "/iris.csv", rows) != 0) {
+    msg.printErr("Could not read " + dataPath + "/iris.csv");
+    return 1;
+  }
+  const int nRows = rows.size();
+  const int nColumns = rows[0].size();
+  if(neighborNumber < 1 || neighborNumber >= nRows) {
+    msg.printErr("Invalid parameters");
+    return 1;
+  }
+  std::vector<double> points{};
+  for(const auto &row : rows) {
+    points.insert(points.end(), row.begin(), row.end());
+  }
+
+  using METHOD = ttk::DimensionReduction::METHOD;
+  const std::vector<std::pair<METHOD, std::string>> methods{
+    {METHOD::PCA, "pca"}, {METHOD::MDS, "mds"}, {METHOD::T_SNE, "tsne"}};
+
+  int status{};
+  for(const auto &method : methods) {
+    // scikit-learn embedding, one row per point
+    std::vector<std::vector<double>> referenceRows{};
+    const auto fileName = dataPath + "/iris_" + method.second + ".csv";
+    if(readCSV(fileName, referenceRows) != 0
+       || static_cast<int>(referenceRows.size()) != nRows) {
+      msg.printErr("Could not read " + fileName);
+      status = 1;
+      continue;
+    }
+    Embedding reference(referenceRows[0].size(), std::vector<double>(nRows));
+    for(int i = 0; i < nRows; ++i) {
+      for(size_t c = 0; c < reference.size(); ++c) {
+        reference[c][i] = referenceRows[i][c];
+      }
+    }
+
+    ttk::DimensionReduction dimensionReduction{};
+    dimensionReduction.setDebugLevel(ttk::globalDebugLevel_);
+    dimensionReduction.setThreadNumber(ttk::globalThreadNumber_);
+    dimensionReduction.setInputMethod(method.first);
+    dimensionReduction.setInputNumberOfComponents(reference.size());
+    dimensionReduction.setUseNativeBackend(true);
+
+    Embedding embedding{};
+    ttk::Timer tm{};
+    if(dimensionReduction.execute(embedding, points, nRows, nColumns) != 0) {
+      msg.printErr(method.second + " failed");
+      status = 1;
+      continue;
+    }
+    const double time = tm.getElapsedTime();
+
+    const double preservation = neighborhoodPreservation(
+      points, nRows, nColumns, embedding, neighborNumber);
+    const double referencePreservation = neighborhoodPreservation(
+      points, nRows, nColumns, reference, neighborNumber);
+    std::string comparison
+      = std::to_string(neighborNumber) + "-NN preservation "
+        + std::to_string(preservation) + " (scikit-learn "
+        + std::to_string(referencePreservation) + ")";
+    bool failed = preservation < referencePreservation - tolerance;
+
+    if(method.first == METHOD::PCA) {
+      const double difference = coordinateDifference(reference, embedding);
+      comparison += ", max relative coordinate difference "
+                    + std::to_string(difference);
+      failed |= !(difference <= 1e-6);
+    } else if(method.first == METHOD::MDS) {
+      const double s = stress(points, nRows, nColumns, embedding);
+      const double referenceStress = stress(points, nRows, nColumns, reference);
+      comparison += ", stress " + std::to_string(s) + " (scikit-learn "
+                    + std::to_string(referenceStress) + ")";
+      failed |= !(s <= 1.1 * referenceStress);
+    }
+
+    if(failed) {
+      msg.printErr(method.second + ": " + comparison);
+      status = 1;
+    } else {
+      msg.printMsg(method.second + ": " + comparison, 1.0, time,
+                   ttk::globalThreadNumber_);
+    }
+  }
+
+  return status;
+}
@@ -0,0 +1,179 @@
+/// \brief Benchmark of the parallel Reeb graph computation of ttk::FTRGraph.
+///
+/// Computes the Reeb graph of a synthetic field on a tetrahedral mesh, first
+/// with one thread then with the global thread number, and fails if both
+/// runs do not give the same graph. The timings of each step (leaf search,
+/// sweep along the preimages stored in the dynamic graph, segmentation) are
+/// printed by ttk::ftr::FTRGraph with a debug level of 3.
+
+// TTK Includes
+#include <CommandLineParser.h>
+#include <FTRGraph.h>
+#include <Timer.h>
+#include <Triangulation.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+int main(int argc, char **argv) {
+
+  int resolution{50};
+  int noisy{0};
+  int implicit{0};
+
+  {
+    ttk::CommandLineParser parser;
+    parser.setArgument(
+      "r", &resolution, "Grid resolution (vertices per side)", true);
+    parser.setArgument(
+      "n", &noisy, "Random field instead of a smooth one (0 or 1)", true);
+    parser.setArgument("g", &implicit,
+                       "Implicit grid instead of an explicit mesh (0 or 1)",
+                       true);
+    parser.parse(argc, argv);
+  }
+  const int threadNumber{ttk::globalThreadNumber_};
+
+  ttk::Debug msg;
+  msg.setDebugMsgPrefix("FTRGraphBenchmark");
+
+  if(resolution < 2) {
+    msg.printErr("Invalid parameters");
+    return 1;
+  }
+
+  // regular grid, each cube split in 6 tetrahedra for the explicit mesh
+  ttk::Timer tm{};
+  const auto n = static_cast<ttk::SimplexId>(resolution);
+  const auto vertexNumber = n * n * n;
+  std::vector<float> points{};
+  std::vector<ttk::LongSimplexId> connectivity{};
+#ifdef TTK_CELL_ARRAY_NEW
+  std::vector<ttk::LongSimplexId> offsets{};
+#endif // TTK_CELL_ARRAY_NEW
+  ttk::Triangulation triangulation{};
+  if(implicit) {
+    triangulation.setInputGrid(0, 0, 0, 1, 1, 1, n, n, n);
+  } else {
+    points.reserve(3 * vertexNumber);
+    for(ttk::SimplexId k = 0; k < n; ++k) {
+      for(ttk::SimplexId j = 0; j < n; ++j) {
+        for(ttk::SimplexId i = 0; i < n; ++i) {
+          points.emplace_back(i);
+          points.emplace_back(j);
+          points.emplace_back(k);
+        }
+      }
+    }
+    const std::array<std::array<int, 4>, 6> tets{{{0, 1, 3, 7},
+                                                  {0, 1, 5, 7},
+                                                  {0, 2, 3, 7},
+                                                  {0, 2, 6, 7},
+                                                  {0, 4, 5, 7},
+                                                  {0, 4, 6, 7}}};
+    const auto cellNumber = 6 * (n - 1) * (n - 1) * (n - 1);
+#ifdef TTK_CELL_ARRAY_NEW
+    for(ttk::SimplexId i = 0; i <= cellNumber; ++i) {
+      offsets.emplace_back(4 * i);
+    }
+#endif // TTK_CELL_ARRAY_NEW
+    for(ttk::SimplexId k = 0; k + 1 < n; ++k) {
+      for(ttk::SimplexId j = 0; j + 1 < n; ++j) {
+        for(ttk::SimplexId i = 0; i + 1 < n; ++i) {
+          std::array<ttk::LongSimplexId, 8> cube{};
+          for(int c = 0; c < 8; ++c) {
+            cube[c] = ((k + (c >> 2)) * n + j + ((c >> 1) & 1)) * n + i
+                      + (c & 1);
+          }
+          for(const auto &tet : tets) {
+#ifndef TTK_CELL_ARRAY_NEW
+            connectivity.emplace_back(4);
+#endif // TTK_CELL_ARRAY_NEW
+            for(const auto c : tet) {
+              connectivity.emplace_back(cube[c]);
+            }
+          }
+        }
+      }
+    }
+    triangulation.setInputPoints(vertexNumber, points.data());
+#ifdef TTK_CELL_ARRAY_NEW
+    triangulation.setInputCells(
+      cellNumber, connectivity.data(), offsets.data());
+#else
+    triangulation.setInputCells(cellNumber, connectivity.data());
+#endif // TTK_CELL_ARRAY_NEW
+  }
+  msg.printMsg("Built a " + std::to_string(vertexNumber) + " vertices "
+                 + (implicit ? "grid" : "tetrahedral mesh"),
+               1.0, tm.getElapsedTime());
+
+  // smooth field with a few extrema per axis, or white noise
+  std::mt19937 gen{0};
+  std::uniform_real_distribution<float> dis{0.0F, 1.0F};
+  std::vector<float> scalars(vertexNumber);
+  for(ttk::SimplexId v = 0; v < vertexNumber; ++v) {
+    const float x = v % n;
+    const float y = (v / n) % n;
+    const float z = v / (n * n);
+    scalars[v] = noisy ? dis(gen)
+                       : std::sin(0.7F * x) * std::cos(0.5F * y)
+                           + 0.3F * std::sin(0.9F * z) + 0.01F * dis(gen);
+  }
+  std::vector<ttk::SimplexId> order(vertexNumber);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&scalars](const ttk::SimplexId a, const ttk::SimplexId b) {
+              return scalars[a] < scalars[b]
+                     || (scalars[a] == scalars[b] && a < b);
+            });
+  std::vector<ttk::SimplexId> sosOffsets(vertexNumber);
+  for(ttk::SimplexId i = 0; i < vertexNumber; ++i) {
+    sosOffsets[order[i]] = i;
+  }
+
+  int status{};
+  double sequentialTime{};
+  std::array<size_t, 2> reference{};
+  for(const int nThreads : {1, threadNumber}) {
+    ttk::ftr::FTRGraph<float, ttk::Triangulation> ftrGraph{&triangulation};
+    ttk::ftr::Params params{};
+    params.threadNumber = nThreads;
+    params.debugLevel = ttk::globalDebugLevel_;
+    ftrGraph.setParams(params);
+    ftrGraph.setDebugLevel(ttk::globalDebugLevel_);
+    ftrGraph.setScalars(scalars.data());
+    ftrGraph.setVertexSoSoffsets(sosOffsets.data());
+
+    tm.reStart();
+    ftrGraph.build();
+    const auto time = tm.getElapsedTime();
+
+    const ttk::ftr::Graph graph{std::move(ftrGraph.extractOutputGraph())};
+    std::array<size_t, 2> size{graph.getNumberOfNodes(), 0};
+    for(ttk::ftr::idSuperArc i = 0; i < graph.getNumberOfArcs(); ++i) {
+      size[1] += graph.getArc(i).isVisible();
+    }
+
+    if(nThreads == 1) {
+      sequentialTime = time;
+      reference = size;
+    } else if(size != reference) {
+      msg.printErr("Different Reeb graphs with 1 and "
+                   + std::to_string(nThreads) + " threads");
+      status = 1;
+    }
+    msg.printMsg("Reeb graph: " + std::to_string(size[0]) + " nodes, "
+                   + std::to_string(size[1]) + " arcs (x"
+                   + std::to_string(sequentialTime / time) + ")",
+                 1.0, time, nThreads);
+    if(nThreads == threadNumber) {
+      break;
+    }
+  }
+
+  return status;
+}
@@ -0,0 +1,126 @@
+/// \brief Benchmark of the task scheduling of ttk::MergeTreeClustering.
+///
+/// Clusters ensembles of random merge trees of increasing size (doubling
+/// from the minimum to the maximum number of trees), first with one thread
+/// then with the global thread number, and fails if both runs do not give
+/// the same assignment. The tree distances run as tasks of the barycenter
+/// and clustering loops (see ttk::MergeTreeBase::forEachTask) and the edit
+/// distance tables of at least the given size are filled in parallel.
+
+// TTK Includes
+#include <CommandLineParser.h>
+#include <MergeTreeClustering.h>
+#include <Timer.h>
+
+#include <algorithm>
+#include <random>
+
+int main(int argc, char **argv) {
+
+  int minTreeNumber{16};
+  int treeNumber{128};
+  int leafNumber{50};
+  int clusterNumber{2};
+  int minTableSize{4096};
+
+  {
+    ttk::CommandLineParser parser;
+    parser.setArgument(
+      "m", &minTreeNumber, "Minimum number of merge trees", true);
+    parser.setArgument(
+      "n", &treeNumber, "Maximum number of merge trees", true);
+    parser.setArgument("l", &leafNumber, "Number of leaves per tree", true);
+    parser.setArgument("k", &clusterNumber, "Number of clusters", true);
+    parser.setArgument("s", &minTableSize,
+                       "Minimum edit distance table size for the parallel "
+                       "filling",
+                       true);
+    parser.parse(argc, argv);
+  }
+  const int threadNumber{ttk::globalThreadNumber_};
+
+  ttk::Debug msg;
+  msg.setDebugMsgPrefix("MergeTreeClusteringBenchmark");
+
+  if(minTreeNumber < clusterNumber || treeNumber < minTreeNumber
+     || leafNumber < 2 || clusterNumber < 1) {
+    msg.printErr("Invalid parameters");
+    return 1;
+  }
+
+  // random binary merge trees: leaves are merged pairwise at increasing
+  // values, the ensemble has three scales of persistence
+  std::mt19937 gen{0};
+  std::uniform_real_distribution<double> dis{0.0, 1.0};
+  const auto randomTree = [&](const double scale) {
+    std::vector<double> scalars{};
+    std::vector<std::tuple<ttk::ftm::idNode, ttk::ftm::idNode>> arcs{};
+    std::vector<std::pair<ttk::ftm::idNode, double>> roots{};
+    for(int i = 0; i < leafNumber; ++i) {
+      scalars.emplace_back(0.5 * dis(gen) * scale);
+      roots.emplace_back(i, scalars.back());
+    }
+    while(roots.size() > 1) {
+      std::shuffle(roots.begin(), roots.end(), gen);
+      const auto a = roots.back();
+      roots.pop_back();
+      const auto b = roots.back();
+      roots.pop_back();
+      const ttk::ftm::idNode parent = scalars.size();
+      scalars.emplace_back(std::max(a.second, b.second)
+                           + 0.1 * dis(gen) * scale);
+      arcs.emplace_back(a.first, parent);
+      arcs.emplace_back(b.first, parent);
+      roots.emplace_back(parent, scalars.back());
+    }
+    return ttk::makeFakeMergeTree<double>(scalars, arcs);
+  };
+
+  int status{};
+  for(int n = minTreeNumber; n <= treeNumber; n *= 2) {
+    double sequentialTime{};
+    std::vector<int> reference{};
+    for(const int nThreads : {1, threadNumber}) {
+      // the clustering modifies its input trees
+      std::vector<ttk::ftm::MergeTree<double>> trees{};
+      gen.seed(0);
+      for(int i = 0; i < n; ++i) {
+        trees.emplace_back(randomTree(1.0 + i % 3));
+      }
+
+      ttk::MergeTreeClustering<double> clustering{};
+      clustering.setDebugLevel(ttk::globalDebugLevel_);
+      clustering.setThreadNumber(nThreads);
+      clustering.setNoCentroids(clusterNumber);
+      clustering.setDeterministic(true);
+      clustering.setParallelEditDistanceMinSize(minTableSize);
+
+      using Matchings = std::vector<
+        std::vector<std::tuple<ttk::ftm::idNode, ttk::ftm::idNode, double>>>;
+      std::vector<Matchings> matchings(clusterNumber, Matchings(n));
+      std::vector<int> assignment(n);
+      std::vector<ttk::ftm::MergeTree<double>> centroids{};
+
+      ttk::Timer tm{};
+      clustering.execute<double>(trees, matchings, assignment, centroids);
+      const auto time = tm.getElapsedTime();
+
+      if(nThreads == 1) {
+        sequentialTime = time;
+        reference = assignment;
+      } else if(assignment != reference) {
+        msg.printErr("Different assignments with 1 and "
+                     + std::to_string(nThreads) + " threads");
+        status = 1;
+      }
+      msg.printMsg("Clustered " + std::to_string(n) + " trees (x"
+                     + std::to_string(sequentialTime / time) + ")",
+                   1.0, time, nThreads);
+      if(nThreads == threadNumber) {
+        break;
+      }
+    }
+  }
+
+  return status;
+}
@@ -0,0 +1,203 @@
+/// \brief Check of the mini-batch K-Means of
+/// ttk::PersistenceDiagramClustering.
+///
+/// The diagrams are generated on request by the loader (no collection is
+/// held in memory): each one is a noisy copy of one of k template diagrams.
+/// The check fails if the clusters do not recover the templates, or if the
+/// matchings of the final assignment are not consistent: every pair of a
+/// diagram matched once, centroid pairs matched at most once, costs equal
+/// to the distances between the matched pairs and summing to the distances
+/// of the clustering.
+
+// TTK Includes
+#include <CommandLineParser.h>
+#include <PersistenceDiagramClustering.h>
+#include <Timer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+int main(int argc, char **argv) {
+
+  int diagramNumber{2000};
+  int pairNumber{50};
+  int clusterNumber{3};
+  int batchSize{64};
+
+  {
+    ttk::CommandLineParser parser;
+    parser.setArgument("n", &diagramNumber, "Number of diagrams", true);
+    parser.setArgument(
+      "p", &pairNumber, "Number of persistence pairs per diagram", true);
+    parser.setArgument("k", &clusterNumber, "Number of clusters", true);
+    parser.setArgument("b", &batchSize, "Batch size", true);
+    parser.parse(argc, argv);
+  }
+
+  ttk::Debug msg;
+  msg.setDebugMsgPrefix("PersistenceDiagramMiniBatchCheck");
+
+  if(clusterNumber < 1 || diagramNumber < clusterNumber || pairNumber < 2
+     || batchSize < 1) {
+    msg.printErr("Invalid parameters");
+    return 1;
+  }
+
+  const auto makePair = [](const double birth, const double death,
+                           const ttk::CriticalType birthType,
+                           const ttk::CriticalType deathType) {
+    ttk::PersistencePair pair{};
+    pair.birth = {0, birthType, birth, {}};
+    pair.death = {0, deathType, death, {}};
+    pair.dim = deathType == ttk::CriticalType::Local_maximum ? 1 : 0;
+    pair.isFinite = deathType != ttk::CriticalType::Local_maximum
+                    || birthType != ttk::CriticalType::Local_minimum;
+    return pair;
+  };
+
+  // template diagrams: a global min-max pair, then min-saddle and
+  // saddle-max pairs, in well separated regions
+  std::vector<ttk::DiagramType> templates(clusterNumber);
+  {
+    std::mt19937 gen{0};
+    std::uniform_real_distribution<double> dis{0.0, 1.0};
+    for(int k = 0; k < clusterNumber; ++k) {
+      const double offset = 10.0 * k;
+      auto &diagram = templates[k];
+      diagram.emplace_back(makePair(offset, offset + 20.0,
+                                    ttk::CriticalType::Local_minimum,
+                                    ttk::CriticalType::Local_maximum));
+      for(int i = 1; i < pairNumber; ++i) {
+        const double birth = offset + 5.0 * dis(gen);
+        const double persistence = 1.0 + 4.0 * dis(gen);
+        diagram.emplace_back(
+          i % 2 == 0 ? makePair(birth, birth + persistence,
+                                ttk::CriticalType::Local_minimum,
+                                ttk::CriticalType::Saddle1)
+                     : makePair(birth, birth + persistence,
+                                ttk::CriticalType::Saddle1,
+                                ttk::CriticalType::Local_maximum));
+      }
+    }
+  }
+
+  // the i-th diagram is a noisy copy of the template i % clusterNumber
+  size_t loadedDiagrams{};
+  const auto loader = [&](const size_t i, ttk::DiagramType &diagram) {
+    std::mt19937 gen(i);
+    std::normal_distribution<double> noise{0.0, 0.1};
+    diagram = templates[i % clusterNumber];
+    for(auto &pair : diagram) {
+      pair.birth.sfValue += noise(gen);
+      pair.death.sfValue = std::max(
+        pair.birth.sfValue + 0.05, pair.death.sfValue + noise(gen));
+    }
+    ++loadedDiagrams;
+    return 0;
+  };
+
+  ttk::PersistenceDiagramClustering clustering{};
+  clustering.setThreadNumber(ttk::globalThreadNumber_);
+  clustering.setDebugLevel(ttk::globalDebugLevel_);
+  clustering.setNumberOfClusters(clusterNumber);
+  clustering.setBatchSize(batchSize);
+
+  std::vector<ttk::DiagramType> centroids{};
+  std::vector<std::vector<std::vector<ttk::MatchingType>>> matchings{};
+  ttk::Timer tm{};
+  const auto clusters
+    = clustering.executeMiniBatch(diagramNumber, loader, centroids, &matchings);
+  msg.printMsg("Mini-batch K-Means of " + std::to_string(diagramNumber)
+                 + " diagrams (" + std::to_string(loadedDiagrams)
+                 + " diagrams loaded)",
+               1.0, tm.getElapsedTime(), ttk::globalThreadNumber_);
+
+  if(clusters.size() != static_cast<size_t>(diagramNumber)
+     || centroids.size() != static_cast<size_t>(clusterNumber)) {
+    msg.printErr("Clustering failed");
+    return 1;
+  }
+
+  int status{};
+
+  // the clusters must recover the templates (up to their numbering)
+  for(int i = 0; i < diagramNumber; ++i) {
+    const int k = i % clusterNumber;
+    const bool sameAsTemplate = clusters[i] == clusters[k];
+    bool distinct{true};
+    for(int l = 0; l < k; ++l) {
+      distinct = distinct && clusters[l] != clusters[k];
+    }
+    if(!sameAsTemplate || !distinct) {
+      msg.printErr("Diagram " + std::to_string(i) + " in cluster "
+                   + std::to_string(clusters[i]) + " instead of "
+                   + std::to_string(clusters[k]));
+      status = 1;
+      break;
+    }
+  }
+
+  // matchings: (pair of the diagram or -1, pair of the centroid or -1,
+  // power of the distance)
+  const auto power = [](const double v) { return v * v; };
+  const auto diagonalCost = [&](const ttk::PersistencePair &p) {
+    return 2.0 * power(p.persistence() / 2.0);
+  };
+  double totalCost{}, maxCostError{};
+  for(int i = 0; i < diagramNumber && status == 0; ++i) {
+    ttk::DiagramType diagram{};
+    loader(i, diagram);
+    const auto &centroid = centroids[clusters[i]];
+    std::vector<int> diagramMatched(diagram.size()),
+      centroidMatched(centroid.size());
+    for(const auto &m : matchings[clusters[i]][i]) {
+      const int p = std::get<0>(m);
+      const int q = std::get<1>(m);
+      double expected{};
+      if(p >= static_cast<int>(diagram.size())
+         || q >= static_cast<int>(centroid.size()) || (p < 0 && q < 0)) {
+        status = 1;
+        break;
+      }
+      if(p >= 0) {
+        diagramMatched[p]++;
+      }
+      if(q >= 0) {
+        centroidMatched[q]++;
+      }
+      if(p >= 0 && q >= 0) {
+        expected
+          = power(diagram[p].birth.sfValue - centroid[q].birth.sfValue)
+            + power(diagram[p].death.sfValue - centroid[q].death.sfValue);
+      } else {
+        expected = diagonalCost(p >= 0 ? diagram[p] : centroid[q]);
+      }
+      maxCostError = std::max(maxCostError, std::abs(std::get<2>(m) - expected));
+      totalCost += std::get<2>(m);
+    }
+    const auto once = [](const int n) { return n == 1; };
+    const auto atMostOnce = [](const int n) { return n <= 1; };
+    if(status != 0
+       || !std::all_of(diagramMatched.begin(), diagramMatched.end(), once)
+       || !std::all_of(
+         centroidMatched.begin(), centroidMatched.end(), atMostOnce)) {
+      msg.printErr("Invalid matching of diagram " + std::to_string(i));
+      status = 1;
+    }
+  }
+
+  const auto distances = clustering.getDistances();
+  const double distance = distances[0] + distances[1] + distances[2];
+  msg.printMsg("Sum of the matching costs " + std::to_string(totalCost)
+               + " (clustering cost " + std::to_string(distance)
+               + ", max cost error " + std::to_string(maxCostError) + ")");
+  if(status == 0
+     && (totalCost <= 0 || maxCostError > 1e-9
+         || std::abs(totalCost - distance) > 1e-9 * distance)) {
+    msg.printErr("Inconsistent matching costs");
+    status = 1;
+  }
+
+  return status;
+}
@@ -0,0 +1,338 @@
+/// \brief Check of the warm-started auctions of
+/// ttk::PersistenceDiagramBarycenter on the example data of the repository.
+///
+/// Each point data array of the input VTK image files (vectors are replaced
+/// by their magnitude) is cut into tiles along the x axis, and the
+/// persistence diagrams of the tiles form an ensemble. The barycenter of each
+/// ensemble is computed with and without warm start (ReinitPrices). The check
+/// fails if the Frechet energy of the warm-started barycenter (sum of the
+/// squared Wasserstein distances from the diagrams to the barycenter, by pair
+/// type, evaluated with auctions at 0.1%) exceeds the one of the default
+/// barycenter by more than the given tolerance.
+///
+/// The reader only supports the base64 encodings (inline or appended, raw or
+/// zlib-compressed) of Float32 and Float64 arrays written by VTK.
+
+// TTK Includes
+#include <CommandLineParser.h>
+#include <OrderDisambiguation.h>
+#include <PersistenceDiagram.h>
+#include <PersistenceDiagramAuction.h>
+#include <PersistenceDiagramBarycenter.h>
+#include <Timer.h>
+#include <Triangulation.h>
+
+#include <zlib.h>
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+struct Field {
+  std::string name{};
+  std::array<int, 2> dimensions{};
+  std::vector<double> values{};
+};
+
+// value of the attribute key in the XML tag
+static std::string attribute(const std::string &tag, const std::string &key) {
+  const auto begin = tag.find(" " + key + "=\"");
+  if(begin == std::string::npos) {
+    return {};
+  }
+  const auto first = begin + key.size() + 3;
+  return tag.substr(first, tag.find('"', first) - first);
+}
+
+// base64 decoding of the data, which can be made of several padded blocks
+static std::vector<unsigned char> decodeBase64(const std::string &data,
+                                               const size_t from) {
+  const std::string alphabet
+    = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::vector<unsigned char> bytes{};
+  std::array<int, 4> group{};
+  int n{}, padding{};
+  for(size_t i = from; i < data.size() && data[i] != '<'; ++i) {
+    const auto c = data[i];
+    if(c == '=') {
+      group[n++] = 0;
+      padding++;
+    } else if(alphabet.find(c) != std::string::npos) {
+      group[n++] = static_cast<int>(alphabet.find(c));
+    }
+    if(n == 4) {
+      const int v = (group[0] << 18) | (group[1] << 12) | (group[2] << 6)
+                    | group[3];
+      for(int j = 0; j < 3 - padding; ++j) {
+        bytes.emplace_back((v >> (16 - 8 * j)) & 0xFF);
+      }
+      n = 0;
+      padding = 0;
+    }
+  }
+  return bytes;
+}
+
+static int readVTI(const std::string &path, std::vector<Field> &fields) {
+  std::ifstream file(path);
+  if(!file) {
+    return -1;
+  }
+  std::stringstream buffer{};
+  buffer << file.rdbuf();
+  const std::string content = buffer.str();
+
+  const auto tagAt = [&](const size_t position) {
+    return content.substr(position, content.find('>', position) - position);
+  };
+  const auto vtkFile = content.find("<VTKFile");
+  const auto imageData = content.find("<ImageData");
+  if(vtkFile == std::string::npos || imageData == std::string::npos) {
+    return -1;
+  }
+  const auto header = tagAt(vtkFile);
+  const bool compressed = !attribute(header, "compressor").empty();
+  const size_t headerSize
+    = attribute(header, "header_type") == "UInt64" ? 8 : 4;
+  std::array<int, 6> extent{};
+  std::stringstream(attribute(tagAt(imageData), "WholeExtent"))
+    >> extent[0] >> extent[1] >> extent[2] >> extent[3] >> extent[4]
+    >> extent[5];
+  if(extent[4] != extent[5]) {
+    return -1;
+  }
+  const size_t appended = content.find('_', content.find("<AppendedData"));
+
+  for(size_t position = content.find("<DataArray");
+      position != std::string::npos;
+      position = content.find("<DataArray", position + 1)) {
+    const auto tag = tagAt(position);
+    const auto type = attribute(tag, "type");
+    const auto components = attribute(tag, "NumberOfComponents");
+    const int nComponents = components.empty() ? 1 : std::stoi(components);
+    const size_t data
+      = attribute(tag, "format") == "appended"
+          ? appended + 1 + std::stoul(attribute(tag, "offset"))
+          : content.find('>', position) + 1;
+    if((type != "Float32" && type != "Float64")
+       || (attribute(tag, "format") == "appended"
+           && (appended == std::string::npos
+               || attribute(content.substr(content.find("<AppendedData")),
+                            "encoding")
+                    != "base64"))) {
+      return -1;
+    }
+
+    const auto bytes = decodeBase64(content, data);
+    const auto readHeader = [&](const size_t i) {
+      uint64_t value{};
+      std::memcpy(&value, bytes.data() + i * headerSize, headerSize);
+      return value;
+    };
+    std::vector<unsigned char> raw{};
+    if(compressed) {
+      const auto nBlocks = readHeader(0);
+      const auto blockSize = readHeader(1);
+      const auto lastBlockSize = readHeader(2);
+      size_t offset = (3 + nBlocks) * headerSize;
+      for(uint64_t b = 0; b < nBlocks; ++b) {
+        uLongf size = (b + 1 == nBlocks && lastBlockSize != 0) ? lastBlockSize
+                                                               : blockSize;
+        const auto compressedSize = readHeader(3 + b);
+        raw.resize(raw.size() + size);
+        if(offset + compressedSize > bytes.size()
+           || uncompress(raw.data() + raw.size() - size, &size,
+                         bytes.data() + offset, compressedSize)
+                != Z_OK) {
+          return -1;
+        }
+        offset += compressedSize;
+      }
+    } else {
+      raw.assign(bytes.begin() + headerSize,
+                 bytes.begin() + headerSize + readHeader(0));
+    }
+
+    Field field{};
+    field.name = attribute(tag, "Name");
+    field.dimensions = {extent[1] - extent[0] + 1, extent[3] - extent[2] + 1};
+    const size_t nPoints = field.dimensions[0] * field.dimensions[1];
+    const size_t valueSize = type == "Float32" ? 4 : 8;
+    if(raw.size() != nPoints * nComponents * valueSize) {
+      return -1;
+    }
+    const auto value = [&](const size_t i) {
+      if(valueSize == 4) {
+        float v{};
+        std::memcpy(&v, raw.data() + i * 4, 4);
+        return static_cast<double>(v);
+      }
+      double v{};
+      std::memcpy(&v, raw.data() + i * 8, 8);
+      return v;
+    };
+    field.values.resize(nPoints);
+    for(size_t i = 0; i < nPoints; ++i) {
+      if(nComponents == 1) {
+        field.values[i] = value(i);
+        continue;
+      }
+      double norm{};
+      for(int c = 0; c < nComponents; ++c) {
+        norm += std::pow(value(i * nComponents + c), 2);
+      }
+      field.values[i] = std::sqrt(norm);
+    }
+    fields.emplace_back(std::move(field));
+  }
+  return 0;
+}
+
+// persistence diagrams of the tiles of the field along the x axis
+static std::vector<ttk::DiagramType> tileDiagrams(const Field &field,
+                                                  const int tileNumber) {
+  const int width = (field.dimensions[0] - 1) / tileNumber;
+  const int height = field.dimensions[1];
+  std::vector<ttk::DiagramType> diagrams(tileNumber);
+  for(int t = 0; t < tileNumber; ++t) {
+    std::vector<double> values((width + 1) * height);
+    for(int j = 0; j < height; ++j) {
+      for(int i = 0; i <= width; ++i) {
+        values[j * (width + 1) + i]
+          = field.values[j * field.dimensions[0] + t * width + i];
+      }
+    }
+    std::vector<ttk::SimplexId> order(values.size());
+    ttk::preconditionOrderArray(values.size(), values.data(), order.data(),
+                                ttk::globalThreadNumber_);
+
+    ttk::Triangulation triangulation{};
+    triangulation.setInputGrid(0, 0, 0, 1, 1, 1, width + 1, height, 1);
+    ttk::PersistenceDiagram persistenceDiagram{};
+    persistenceDiagram.setDebugLevel(0);
+    persistenceDiagram.setThreadNumber(ttk::globalThreadNumber_);
+    persistenceDiagram.preconditionTriangulation(&triangulation);
+    persistenceDiagram.execute(
+      diagrams[t], values.data(), 0, order.data(), &triangulation);
+  }
+  return diagrams;
+}
+
+// pair types of ttk::PersistenceDiagramBarycenter: 0 for the pairs with a
+// minimum, 1 for the saddle-saddle pairs, 2 for the pairs with a maximum
+static int pairType(const ttk::PersistencePair &pair) {
+  const auto has = [&pair](const ttk::CriticalType type) {
+    return pair.birth.type == type || pair.death.type == type;
+  };
+  return has(ttk::CriticalType::Local_maximum)   ? 2
+         : has(ttk::CriticalType::Local_minimum) ? 0
+                                                 : 1;
+}
+
+// sum of the squared Wasserstein distances from the diagrams to the
+// barycenter, the pairs of different types being never matched together
+static double frechetEnergy(const std::vector<ttk::DiagramType> &diagrams,
+                            const ttk::DiagramType &barycenter) {
+  const auto select = [](const ttk::DiagramType &diagram, const int type) {
+    ttk::DiagramType selection{};
+    for(const auto &pair : diagram) {
+      if(pair.persistence() > 0 && pairType(pair) == type) {
+        selection.emplace_back(pair);
+      }
+    }
+    return selection;
+  };
+  double energy{};
+  for(const auto &diagram : diagrams) {
+    for(int type = 0; type < 3; ++type) {
+      const auto bidders = select(diagram, type);
+      const auto goods = select(barycenter, type);
+      ttk::PersistenceDiagramAuction auction(2, 1.0, 1.0, 0.001, true);
+      auction.BuildAuctionDiagrams(bidders, goods);
+      energy += auction.run();
+    }
+  }
+  return energy;
+}
+
+int main(int argc, char **argv) {
+
+  std::vector<std::string> inputs{};
+  int tileNumber{8};
+  double tolerance{1.0};
+
+  {
+    ttk::CommandLineParser parser;
+    parser.setArgument("i", &inputs, "Input VTK image files (.vti)");
+    parser.setArgument("n", &tileNumber, "Number of tiles per field", true);
+    parser.setArgument("e", &tolerance,
+                       "Tolerance on the Frechet energy (percents)", true);
+    parser.parse(argc, argv);
+  }
+
+  ttk::Debug msg;
+  msg.setDebugMsgPrefix("PersistenceDiagramWarmStartCheck");
+
+  std::vector<Field> fields{};
+  for(const auto &input : inputs) {
+    if(readVTI(input, fields) != 0) {
+      msg.printErr("Could not read " + input);
+      return 1;
+    }
+  }
+  if(fields.empty() || tileNumber < 2) {
+    msg.printErr("Invalid parameters");
+    return 1;
+  }
+
+  int status{};
+  for(const auto &field : fields) {
+    if(field.dimensions[0] - 1 < tileNumber) {
+      msg.printErr("Field " + field.name + " too small");
+      return 1;
+    }
+    auto diagrams = tileDiagrams(field, tileNumber);
+    size_t pairNumber{};
+    for(const auto &diagram : diagrams) {
+      pairNumber += diagram.size();
+    }
+    msg.printMsg("Field " + field.name + ": " + std::to_string(tileNumber)
+                 + " diagrams, " + std::to_string(pairNumber) + " pairs");
+
+    std::array<double, 2> energies{};
+    for(const bool warmStart : {false, true}) {
+      ttk::PersistenceDiagramBarycenter barycenter{};
+      barycenter.setDebugLevel(ttk::globalDebugLevel_);
+      barycenter.setThreadNumber(ttk::globalThreadNumber_);
+      barycenter.setWasserstein("2");
+      barycenter.setMethod(2);
+      barycenter.setNumberOfInputs(tileNumber);
+      barycenter.setReinitPrices(!warmStart);
+
+      ttk::DiagramType output{};
+      std::vector<std::vector<std::vector<ttk::MatchingType>>> matchings{};
+      ttk::Timer tm{};
+      barycenter.execute(diagrams, output, matchings);
+      const double time = tm.getElapsedTime();
+      energies[warmStart] = frechetEnergy(diagrams, output);
+      msg.printMsg(std::string{warmStart ? "Warm start" : "Default"}
+                     + ": energy " + std::to_string(energies[warmStart])
+                     + ", " + std::to_string(output.size()) + " pairs",
+                   1.0, time, ttk::globalThreadNumber_);
+    }
+
+    const double difference
+      = 100.0 * (energies[1] - energies[0]) / std::max(energies[0], 1e-12);
+    msg.printMsg("Field " + field.name + ": energy difference "
+                 + std::to_string(difference) + "%");
+    if(difference > tolerance) {
+      msg.printErr("Warm-started barycenter of " + field.name
+                   + " worse than the default one");
+      status = 1;
+    }
+  }
+
+  return status;
+}
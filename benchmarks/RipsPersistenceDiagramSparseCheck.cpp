@@ -0,0 +1,219 @@
+/// \brief Check of the sparse approximation of
+/// ttk::RipsPersistenceDiagram.
+///
+/// Computes the Rips persistence diagrams (up to dimension 1) of random point
+/// clouds, noisy circles in a uniform noise, exactly and with the sparse
+/// (1 + epsilon)-approximation. The approximation is multiplicative: in log
+/// scale, the bottleneck distance between the exact and the sparse diagrams
+/// is at most log(1 + epsilon) with the L-infinity ground metric. The check
+/// fails if
+/// - the deaths of the 0-dimensional pairs (born at 0), sorted, differ by
+///   more than a factor 1 + epsilon,
+/// - the bottleneck distance of ttk::BottleneckDistance between the log
+///   scale 1-dimensional diagrams exceeds 2 log(1 + epsilon) (its ground
+///   metric is L1),
+/// - the essential classes differ in number or their births by more than a
+///   factor 1 + epsilon.
+/// The exact diagrams computed with 1 and with the given number of threads
+/// must also be identical.
+
+// TTK Includes
+#include <BottleneckDistance.h>
+#include <CommandLineParser.h>
+#include <RipsPersistenceDiagram.h>
+#include <Timer.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+
+using Diagrams = std::vector<std::vector<ripser::pers_pair_t>>;
+
+static Diagrams ripsDiagrams(const std::vector<std::vector<double>> &points,
+                             const double epsilon,
+                             const int threadNumber,
+                             double &time) {
+  ttk::RipsPersistenceDiagram rips{};
+  rips.setDebugLevel(0);
+  rips.setThreadNumber(threadNumber);
+  rips.setSimplexMaximumDimension(1);
+  rips.setSimplexMaximumDiameter(std::numeric_limits<double>::infinity());
+  rips.setSparseApproximation(epsilon);
+  Diagrams diagrams{};
+  ttk::Timer tm{};
+  rips.execute(points, diagrams);
+  time += tm.getElapsedTime();
+  return diagrams;
+}
+
+// largest log ratio between the sorted values
+static double logRatio(std::vector<double> a, std::vector<double> b) {
+  if(a.size() != b.size()) {
+    return std::numeric_limits<double>::infinity();
+  }
+  std::sort(a.begin(), a.end());
+  std::sort(b.begin(), b.end());
+  double ratio{};
+  for(size_t i = 0; i < a.size(); ++i) {
+    if(a[i] != b[i]) {
+      ratio = std::max(ratio, std::abs(std::log(a[i] / b[i])));
+    }
+  }
+  return ratio;
+}
+
+// bottleneck distance between the log scale finite diagrams
+static double logBottleneck(const std::vector<ripser::pers_pair_t> &pairs0,
+                            const std::vector<ripser::pers_pair_t> &pairs1) {
+  const auto toDiagram = [](const std::vector<ripser::pers_pair_t> &pairs) {
+    ttk::DiagramType diagram{};
+    for(const auto &pair : pairs) {
+      const double birth = pair.first.second;
+      const double death = pair.second.second;
+      if(std::isinf(death) || death <= birth) {
+        continue;
+      }
+      ttk::PersistencePair p{};
+      p.birth = {0, ttk::CriticalType::Saddle1, std::log(birth), {}};
+      p.death = {0, ttk::CriticalType::Local_maximum, std::log(death), {}};
+      p.dim = 1;
+      p.isFinite = true;
+      diagram.emplace_back(p);
+    }
+    return diagram;
+  };
+  ttk::BottleneckDistance bottleneckDistance{};
+  bottleneckDistance.setDebugLevel(0);
+  bottleneckDistance.setWasserstein("inf");
+  bottleneckDistance.setAlgorithm("geometric");
+  bottleneckDistance.setPersistencePercentThreshold(0.0);
+  std::vector<ttk::MatchingType> matchings{};
+  const auto diagram0 = toDiagram(pairs0);
+  const auto diagram1 = toDiagram(pairs1);
+  if(diagram0.empty() && diagram1.empty()) {
+    return 0;
+  }
+  if(bottleneckDistance.execute(diagram0, diagram1, matchings) != 0) {
+    return std::numeric_limits<double>::infinity();
+  }
+  return bottleneckDistance.getDistance();
+}
+
+int main(int argc, char **argv) {
+
+  int pointNumber{400};
+  int cloudNumber{5};
+  std::vector<double> epsilons{};
+
+  {
+    ttk::CommandLineParser parser;
+    parser.setArgument("n", &pointNumber, "Number of points per cloud", true);
+    parser.setArgument("c", &cloudNumber, "Number of point clouds", true);
+    parser.setArgument(
+      "e", &epsilons, "Approximation factors (default: 0.1 0.5 1)", true);
+    parser.parse(argc, argv);
+  }
+  if(epsilons.empty()) {
+    epsilons = {0.1, 0.5, 1.0};
+  }
+
+  ttk::Debug msg;
+  msg.setDebugMsgPrefix("RipsPersistenceDiagramSparseCheck");
+
+  if(pointNumber < 10 || cloudNumber < 1
+     || *std::min_element(epsilons.begin(), epsilons.end()) <= 0) {
+    msg.printErr("Invalid parameters");
+    return 1;
+  }
+
+  int status{};
+  std::mt19937 gen{0};
+  std::uniform_real_distribution<double> dis{0.0, 1.0};
+  std::normal_distribution<double> noise{0.0, 0.02};
+  double exactTime{}, parallelTime{};
+  std::vector<double> sparseTimes(epsilons.size()),
+    maxRatios(epsilons.size());
+
+  for(int c = 0; c < cloudNumber; ++c) {
+    // 2 + c % 3 noisy circles, a tenth of the points in a uniform noise
+    std::vector<std::vector<double>> points(pointNumber);
+    const int circleNumber = 2 + c % 3;
+    for(int i = 0; i < pointNumber; ++i) {
+      if(i % 10 == 0) {
+        points[i] = {3.0 * dis(gen), 3.0 * dis(gen)};
+        continue;
+      }
+      const int k = i % circleNumber;
+      const double radius = 0.2 + 0.1 * k;
+      const double angle = 2 * M_PI * dis(gen);
+      points[i] = {0.5 + k + radius * std::cos(angle) + noise(gen),
+                   1.5 + radius * std::sin(angle) + noise(gen)};
+    }
+
+    double sequentialTime{};
+    const auto exact = ripsDiagrams(points, 0, 1, sequentialTime);
+    const auto parallel
+      = ripsDiagrams(points, 0, ttk::globalThreadNumber_, parallelTime);
+    exactTime += sequentialTime;
+    if(exact != parallel) {
+      msg.printErr("Cloud " + std::to_string(c) + ": diagrams differ with "
+                   + std::to_string(ttk::globalThreadNumber_) + " threads");
+      status = 1;
+    }
+
+    for(size_t e = 0; e < epsilons.size(); ++e) {
+      const double epsilon = epsilons[e];
+      const auto sparse = ripsDiagrams(
+        points, epsilon, ttk::globalThreadNumber_, sparseTimes[e]);
+
+      std::array<std::vector<double>, 2> deaths{}, essentialBirths{};
+      for(const auto *diagrams : {&exact, &sparse}) {
+        const size_t d = diagrams == &exact ? 0 : 1;
+        for(const auto &pair : (*diagrams)[0]) {
+          if(!std::isinf(pair.second.second)) {
+            deaths[d].emplace_back(pair.second.second);
+          }
+        }
+        for(const auto &diagram : *diagrams) {
+          for(const auto &pair : diagram) {
+            if(std::isinf(pair.second.second)) {
+              // avoids log(0) for the essential class of dimension 0
+              essentialBirths[d].emplace_back(
+                std::max(pair.first.second, 1e-300));
+            }
+          }
+        }
+      }
+      const double bound = std::log1p(epsilon) * (1 + 1e-9);
+      const double ratio0 = logRatio(deaths[0], deaths[1]);
+      const double ratio1 = logBottleneck(exact[1], sparse[1]) / 2;
+      const double ratioEssential
+        = logRatio(essentialBirths[0], essentialBirths[1]);
+      const double ratio = std::max({ratio0, ratio1, ratioEssential});
+      maxRatios[e] = std::max(maxRatios[e], ratio);
+      if(ratio > bound) {
+        msg.printErr("Cloud " + std::to_string(c) + ", epsilon "
+                     + std::to_string(epsilon) + ": log ratios "
+                     + std::to_string(ratio0) + " (H0), "
+                     + std::to_string(ratio1) + " (H1), "
+                     + std::to_string(ratioEssential)
+                     + " (essential) above " + std::to_string(bound));
+        status = 1;
+      }
+    }
+  }
+
+  msg.printMsg("Exact diagrams", 1.0, exactTime, 1);
+  msg.printMsg("Exact diagrams", 1.0, parallelTime, ttk::globalThreadNumber_);
+  for(size_t e = 0; e < epsilons.size(); ++e) {
+    msg.printMsg("Sparse diagrams, epsilon " + std::to_string(epsilons[e])
+                   + " (max log ratio " + std::to_string(maxRatios[e])
+                   + ", bound " + std::to_string(std::log1p(epsilons[e]))
+                   + ")",
+                 1.0, sparseTimes[e], ttk::globalThreadNumber_);
+  }
+
+  return status;
+}
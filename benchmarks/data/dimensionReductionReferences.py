@@ -0,0 +1,48 @@
+# Generates the scikit-learn reference embeddings of the iris data set read
+# by DimensionReductionSklearnCheck, with the parameters of the Python
+# backend of ttk::DimensionReduction (its default values, fixed seed).
+#
+# usage: python3 dimensionReductionReferences.py (from this directory)
+
+import numpy as np
+import sklearn
+from sklearn import datasets, decomposition, manifold
+
+X = datasets.load_iris().data
+
+embeddings = {
+    "pca": decomposition.PCA(n_components=2, svd_solver="full"),
+    "mds": manifold.MDS(
+        n_components=2,
+        metric_mds=True,
+        n_init=4,
+        init="random",
+        max_iter=300,
+        eps=1e-6,
+        random_state=0,
+    ),
+    "tsne": manifold.TSNE(
+        n_components=2,
+        perplexity=30,
+        early_exaggeration=12,
+        learning_rate=200,
+        max_iter=1000,
+        n_iter_without_progress=300,
+        min_grad_norm=1e-7,
+        init="random",
+        method="barnes_hut",
+        angle=0.5,
+        random_state=0,
+    ),
+}
+
+header = "scikit-learn " + sklearn.__version__
+np.savetxt("iris.csv", X, fmt="%.1f", delimiter=",")
+for name, method in embeddings.items():
+    np.savetxt(
+        "iris_" + name + ".csv",
+        method.fit_transform(X),
+        fmt="%.9e",
+        delimiter=",",
+        header=header,
+    )
@@ -30,17 +30,18 @@ namespace ttk {
     ~AssignmentAuction() override = default;
 
     int run(std::vector<MatchingType> &matchings) override;
-    void runAuctionRound(std::vector<std::vector<dataType>> &cMatrix);
+    void runAuctionRound(const AssignmentMatrixView<dataType> &cMatrix);
 
     void initFirstRound();
     void initBiddersAndGoods();
     void initEpsilon();
     void epsilonScaling();
-    void makeBalancedMatrix(std::vector<std::vector<dataType>> &matrix);
+    void makeBalancedMatrix(const AssignmentMatrixView<dataType> &matrix);
 
-    bool stoppingCriterion(std::vector<std::vector<dataType>> &cMatrix);
-    dataType getRelativePrecision(std::vector<std::vector<dataType>> &cMatrix);
-    dataType getMatchingDistance(std::vector<std::vector<dataType>> &cMatrix);
+    bool stoppingCriterion(const AssignmentMatrixView<dataType> &cMatrix);
+    dataType
+      getRelativePrecision(const AssignmentMatrixView<dataType> &cMatrix);
+    dataType getMatchingDistance(const AssignmentMatrixView<dataType> &cMatrix);
 
     inline void setBalanced(bool balanced) override {
       AssignmentSolver<dataType>::setBalanced(balanced);
@@ -90,6 +91,11 @@ namespace ttk {
     std::vector<int> goodAssignments{};
     std::vector<double> goodPrices{};
     dataType lowerBoundCost;
+
+    // workspaces, reused when the solver is reused
+    AssignmentMatrix<dataType> balancedMatrix{};
+    std::queue<int> unassignedBidders{};
+    std::vector<double> savedPrices{};
   }; // AssignmentAuction Class
 
   template <typename type>
@@ -98,10 +104,10 @@ namespace ttk {
   }
 
   template <class dataType>
-  dataType getMaxValue(std::vector<std::vector<dataType>> &matrix,
+  dataType getMaxValue(const AssignmentMatrixView<dataType> &matrix,
                        bool balancedAsgn) {
-    unsigned int const nRows = matrix.size();
-    unsigned int const nCols = matrix[0].size();
+    unsigned int const nRows = matrix.rows();
+    unsigned int const nCols = matrix.cols();
     dataType maxValue = std::numeric_limits<dataType>::lowest();
     for(unsigned int i = 0; i < nRows; ++i) {
       for(unsigned int j = 0; j < nCols; ++j) {
@@ -117,7 +123,7 @@ namespace ttk {
   void AssignmentAuction<dataType>::initEpsilon() {
     if(epsilon == -1.0) {
       dataType maxValue
-        = getMaxValue<dataType>(this->costMatrix, this->balancedAssignment);
+        = getMaxValue<dataType>(this->costView, this->balancedAssignment);
       epsilon = maxValue / 4.0;
       if(epsilon == 0.0)
         epsilon = 1.0;
@@ -154,22 +160,24 @@ namespace ttk {
 
   template <typename dataType>
   void AssignmentAuction<dataType>::makeBalancedMatrix(
-    std::vector<std::vector<dataType>> &matrix) {
-    unsigned int const nRows = matrix.size();
-    unsigned int const nCols = matrix[0].size();
-    matrix[nRows - 1][nCols - 1] = 0;
-
-    // Add rows
-    for(unsigned int i = 0; i < nCols - 2; ++i) {
-      std::vector<dataType> const newLine(matrix[nRows - 1]);
-      matrix.push_back(newLine);
-    }
-    // Add columns
-    for(unsigned int i = 0; i < (nRows - 1) + (nCols - 1); ++i) {
-      for(unsigned int j = 0; j < nRows - 2; ++j) {
-        matrix[i].push_back(matrix[i][nCols - 1]);
-      }
+    const AssignmentMatrixView<dataType> &matrix) {
+    int const nRows = matrix.rows();
+    int const nCols = matrix.cols();
+    int const size = (nRows - 1) + (nCols - 1);
+
+    // The first nRows - 1 rows are extended with copies of their last
+    // column, the added rows are copies of the (extended) last row, whose
+    // last cell is zeroed
+    balancedMatrix.resize(size, size);
+    for(int i = 0; i < size; ++i) {
+      const dataType *row = matrix[std::min(i, nRows - 1)];
+      dataType *newRow = balancedMatrix[i];
+      std::copy(row, row + nCols, newRow);
+      if(i >= nRows - 1)
+        newRow[nCols - 1] = 0;
+      std::fill(newRow + nCols, newRow + size, newRow[nCols - 1]);
     }
+    this->costView = balancedMatrix;
   }
 
   // ----------------------------------------
@@ -177,8 +185,7 @@ namespace ttk {
   // ----------------------------------------
   template <typename dataType>
   void AssignmentAuction<dataType>::runAuctionRound(
-    std::vector<std::vector<dataType>> &cMatrix) {
-    std::queue<int> unassignedBidders{};
+    const AssignmentMatrixView<dataType> &cMatrix) {
     for(unsigned int i = 0; i < bidderAssignments.size(); ++i)
       unassignedBidders.push(i);
 
@@ -190,11 +197,12 @@ namespace ttk {
       dataType bestValue = std::numeric_limits<dataType>::lowest();
       dataType bestSecondValue = std::numeric_limits<dataType>::lowest();
       int bestGoodId = -1;
+      const dataType *bidderCosts = cMatrix[bidderId];
       for(unsigned int goodId = 0; goodId < goodPrices.size(); ++goodId) {
-        if(cMatrix[bidderId][goodId] == static_cast<dataType>(-1))
+        if(bidderCosts[goodId] == static_cast<dataType>(-1))
           continue;
         dataType goodPrice = goodPrices[goodId];
-        dataType value = -cMatrix[bidderId][goodId] - goodPrice;
+        dataType value = -bidderCosts[goodId] - goodPrice;
         if(value > bestValue) {
           bestSecondValue = bestValue;
           bestValue = value;
@@ -225,12 +233,13 @@ namespace ttk {
   }
 
   template <typename dataType>
-  dataType getLowerBoundCost(std::vector<std::vector<dataType>> &costMatrix) {
+  dataType
+    getLowerBoundCost(const AssignmentMatrixView<dataType> &costMatrix) {
     std::vector<dataType> minCol(
-      costMatrix[0].size(), std::numeric_limits<dataType>::max()),
-      minRow(costMatrix.size(), std::numeric_limits<dataType>::max());
-    for(unsigned int i = 0; i < costMatrix.size(); ++i) {
-      for(unsigned int j = 0; j < costMatrix[i].size(); ++j) {
+      costMatrix.cols(), std::numeric_limits<dataType>::max()),
+      minRow(costMatrix.rows(), std::numeric_limits<dataType>::max());
+    for(int i = 0; i < costMatrix.rows(); ++i) {
+      for(int j = 0; j < costMatrix.cols(); ++j) {
         if(costMatrix[i][j] < minCol[j])
           minCol[j] = costMatrix[i][j];
         if(costMatrix[i][j] < minRow[i])
@@ -255,7 +264,7 @@ namespace ttk {
     // Try to avoid price war
     double const tempPrice
       = *std::max_element(goodPrices.begin(), goodPrices.end());
-    std::vector<double> savedPrices;
+    savedPrices.clear();
     for(unsigned int i = 0; i < goodPrices.size(); ++i) {
       auto old = goodPrices[i];
       goodPrices[i]
@@ -266,18 +275,18 @@ namespace ttk {
 
     // Make balanced cost matrix
     if(not this->balancedAssignment)
-      this->makeBalancedMatrix(this->costMatrix);
+      this->makeBalancedMatrix(this->costView);
 
     // Get lower bound cost
-    lowerBoundCost = getLowerBoundCost(this->costMatrix);
+    lowerBoundCost = getLowerBoundCost(this->costView);
 
     // Run auction
     initFirstRound();
-    while(not stoppingCriterion(this->costMatrix)) {
+    while(not stoppingCriterion(this->costView)) {
       initBiddersAndGoods();
-      runAuctionRound(this->costMatrix);
+      runAuctionRound(this->costView);
 
-      dataType cost = getMatchingDistance(this->costMatrix);
+      dataType cost = getMatchingDistance(this->costView);
       if(cost < bestCost) {
         bestCost = cost;
         bestBidderAssignments = bidderAssignments;
@@ -299,7 +308,7 @@ namespace ttk {
       if(this->balancedAssignment
          or (not this->balancedAssignment
              and not(i >= this->rowSize - 1 and j >= this->colSize - 1))) {
-        matchings.push_back(std::make_tuple(i, j, this->costMatrix[i][j]));
+        matchings.push_back(std::make_tuple(i, j, this->costView[i][j]));
       }
     }
 
@@ -316,7 +325,7 @@ namespace ttk {
   // Adapted from Persistence Diagrams Auction
   template <typename dataType>
   bool AssignmentAuction<dataType>::stoppingCriterion(
-    std::vector<std::vector<dataType>> &cMatrix) {
+    const AssignmentMatrixView<dataType> &cMatrix) {
     if(bidderAssignments[0] == -1) // Auction not started
       return false;
     dataType delta = 5;
@@ -327,7 +336,7 @@ namespace ttk {
   // Adapted from Persistence Diagrams Auction
   template <typename dataType>
   dataType AssignmentAuction<dataType>::getRelativePrecision(
-    std::vector<std::vector<dataType>> &cMatrix) {
+    const AssignmentMatrixView<dataType> &cMatrix) {
     dataType d = this->getMatchingDistance(cMatrix);
     if(d < 1e-6 or d <= (lowerBoundCost * lowerBoundCostWeight)) {
       return 0;
@@ -343,7 +352,7 @@ namespace ttk {
   // Adapted from Persistence Diagrams Auction
   template <typename dataType>
   dataType AssignmentAuction<dataType>::getMatchingDistance(
-    std::vector<std::vector<dataType>> &cMatrix) {
+    const AssignmentMatrixView<dataType> &cMatrix) {
     dataType d = 0;
     for(unsigned int bidderId = 0; bidderId < bidderAssignments.size();
         ++bidderId) {
@@ -143,8 +143,8 @@ namespace ttk {
   template <typename dataType>
   dataType AssignmentExhaustive<dataType>::tryAssignment(
     std::vector<int> &asgn, std::vector<MatchingType> &matchings) {
-    unsigned int const nRows = this->costMatrix.size() - 1;
-    unsigned int const nCols = this->costMatrix[0].size() - 1;
+    unsigned int const nRows = this->costView.rows() - 1;
+    unsigned int const nCols = this->costView.cols() - 1;
     // int max_dim = std::max(nRows, nCols);
     unsigned int const min_dim = std::min(nRows, nCols);
     bool const transpose = nRows > nCols;
@@ -154,8 +154,8 @@ namespace ttk {
       int const indMatrix = std::min(ind, min_dim);
       int const i = (!transpose) ? indMatrix : asgn[ind];
       int const j = (!transpose) ? asgn[ind] : indMatrix;
-      cost += this->costMatrix[i][j];
-      matchings.push_back(std::make_tuple(i, j, this->costMatrix[i][j]));
+      cost += this->costView[i][j];
+      matchings.push_back(std::make_tuple(i, j, this->costView[i][j]));
     }
     return cost;
   }
@@ -163,8 +163,8 @@ namespace ttk {
   template <typename dataType>
   int AssignmentExhaustive<dataType>::run(
     std::vector<MatchingType> &matchings) {
-    int const nRows = this->costMatrix.size() - 1;
-    int const nCols = this->costMatrix[0].size() - 1;
+    int const nRows = this->costView.rows() - 1;
+    int const nCols = this->costView.cols() - 1;
     int const max_dim = std::max(nRows, nCols);
     int const min_dim = std::min(nRows, nCols);
 
@@ -31,43 +31,13 @@ namespace ttk {
       createdZeros.clear();
     }
 
-    inline int setInput(std::vector<std::vector<dataType>> &C_) override {
-      AssignmentSolver<dataType>::setInput(C_);
-
-      createdZeros.clear();
-
-      auto r = (unsigned long)this->rowSize;
-      auto c = (unsigned long)this->colSize;
-
-      rowCover.resize(r);
-      colCover.resize(c);
-
-      rowLimitsMinus.resize(r);
-      rowLimitsPlus.resize(r);
-      colLimitsMinus.resize(c);
-      colLimitsPlus.resize(c);
-
-      M.resize(r);
-      for(int row = 0; row < this->rowSize; ++row)
-        M[row].resize(c);
-
-      const int nbPaths = 1 + this->colSize + this->rowSize;
-      path.resize((unsigned long)nbPaths);
-      for(int p = 0; p < nbPaths; ++p)
-        path[p].resize(2);
-
-      resetMasks();
-
-      return 0;
-    }
-
     inline void showCostMatrix() {
-      auto C = AssignmentSolver<dataType>::getCostMatrix();
+      const auto &C = AssignmentSolver<dataType>::getCostMatrix();
       std::stringstream msg;
       for(int r = 0; r < this->rowSize; ++r) {
         msg << std::endl << "  ";
         for(int c = 0; c < this->colSize; ++c)
-          msg << std::fixed << std::setprecision(3) << (*C)[r][c] << " ";
+          msg << std::fixed << std::setprecision(3) << C[r][c] << " ";
       }
 
       this->printMsg(msg.str(), debug::Priority::DETAIL);
@@ -93,8 +63,36 @@ namespace ttk {
       this->printMsg(msg.str(), debug::Priority::DETAIL);
     }
 
+  protected:
+    inline int initInput() override {
+      AssignmentSolver<dataType>::initInput();
+
+      createdZeros.clear();
+
+      auto r = (unsigned long)this->rowSize;
+      auto c = (unsigned long)this->colSize;
+
+      rowCover.resize(r);
+      colCover.resize(c);
+
+      rowLimitsMinus.resize(r);
+      rowLimitsPlus.resize(r);
+      colLimitsMinus.resize(c);
+      colLimitsPlus.resize(c);
+
+      M.resize(this->rowSize, this->colSize);
+
+      const int nbPaths = 1 + this->colSize + this->rowSize;
+      path.resize(nbPaths, 2);
+
+      resetMasks();
+
+      return 0;
+    }
+
   private:
-    std::vector<std::vector<int>> M;
+    // flat workspaces, reused when the solver is reused
+    AssignmentMatrix<int> M;
     std::vector<bool> rowCover;
     std::vector<bool> colCover;
 
@@ -103,7 +101,8 @@ namespace ttk {
     std::vector<int> colLimitsMinus;
     std::vector<int> colLimitsPlus;
 
-    std::vector<std::vector<int>> path;
+    AssignmentMatrix<int> path;
+    AssignmentMatrix<dataType> inputMatrix;
     std::vector<std::pair<int, int>> createdZeros;
 
     int pathRow0;
@@ -130,9 +129,9 @@ namespace ttk {
     int stepSeven(int &step);
 
     int affect(std::vector<MatchingType> &matchings,
-               const std::vector<std::vector<dataType>> &C);
+               const AssignmentMatrixView<dataType> &C);
 
-    int computeAffectationCost(const std::vector<std::vector<dataType>> &C);
+    int computeAffectationCost(const AssignmentMatrixView<dataType> &C);
 
     inline bool isZero(dataType t) {
       // return std::abs((double) t) < 1e-15;
@@ -140,25 +139,17 @@ namespace ttk {
     }
 
     inline int resetMasks() {
-      for(int r = 0; r < this->rowSize; ++r) {
+      for(int r = 0; r < this->rowSize; ++r)
         rowCover[r] = false;
-        for(int c = 0; c < this->colSize; ++c)
-          M[r][c] = 0;
-      }
+      M.fill(0);
       for(int c = 0; c < this->colSize; ++c)
         colCover[c] = false;
       return 0;
     }
 
-    inline int copyInputMatrix(std::vector<std::vector<dataType>> &saveInput) {
-      auto C = AssignmentSolver<dataType>::getCostMatrixPointer();
-      const int rS = this->rowSize;
-      const int cS = this->colSize;
-
-      for(int r = 0; r < rS; ++r)
-        for(int c = 0; c < cS; ++c)
-          saveInput[r][c] = (*C)[r][c];
-
+    inline int copyInputMatrix(AssignmentMatrix<dataType> &saveInput) {
+      const auto &C = AssignmentSolver<dataType>::getCostMatrix();
+      saveInput.assign(C.data(), C.rows(), C.cols());
       return 0;
     }
   };
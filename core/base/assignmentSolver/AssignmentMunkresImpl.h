@@ -13,9 +13,15 @@ int ttk::AssignmentMunkres<dataType>::run(
   bool done = false;
   Timer t;
 
-  std::vector<std::vector<dataType>> inputMatrix(
-    this->rowSize, std::vector<dataType>(this->colSize));
-  copyInputMatrix(inputMatrix);
+  // the steps work on costMatrix, the matching costs are read from the input
+  AssignmentMatrixView<dataType> input{this->costView};
+  if(this->costView.data() == this->costMatrix.data()) {
+    copyInputMatrix(inputMatrix);
+    input = inputMatrix;
+  } else {
+    this->costMatrix.assign(
+      this->costView.data(), this->costView.rows(), this->costView.cols());
+  }
 
   while(!done) {
     ++iter;
@@ -73,8 +79,8 @@ int ttk::AssignmentMunkres<dataType>::run(
     }
   }
 
-  this->computeAffectationCost(inputMatrix);
-  this->affect(matchings, inputMatrix);
+  this->computeAffectationCost(input);
+  this->affect(matchings, input);
   this->clear();
 
   return 0;
@@ -85,8 +91,7 @@ template <typename dataType>
 int ttk::AssignmentMunkres<dataType>::stepOne(int &step) // ~ 0% perf
 {
   double minInCol;
-  std::vector<std::vector<dataType>> *C
-    = AssignmentSolver<dataType>::getCostMatrixPointer();
+  auto *C = AssignmentSolver<dataType>::getCostMatrixPointer();
 
   // Benefit from the matrix sparsity.
   dataType maxVal = std::numeric_limits<dataType>::max();
@@ -209,8 +214,7 @@ int ttk::AssignmentMunkres<dataType>::stepOne(int &step) // ~ 0% perf
 template <typename dataType>
 int ttk::AssignmentMunkres<dataType>::stepTwo(int &step) // ~ 0% perf
 {
-  std::vector<std::vector<dataType>> *C
-    = AssignmentSolver<dataType>::getCostMatrixPointer();
+  auto *C = AssignmentSolver<dataType>::getCostMatrixPointer();
 
   for(int r = 0; r < this->rowSize - 1; ++r) {
     for(int c = 0; c < this->colSize - 1; ++c) {
@@ -512,7 +516,7 @@ int ttk::AssignmentMunkres<dataType>::stepSeven(int &ttkNotUsed(step)) {
 template <typename dataType>
 int ttk::AssignmentMunkres<dataType>::affect(
   std::vector<MatchingType> &matchings,
-  const std::vector<std::vector<dataType>> &C) {
+  const AssignmentMatrixView<dataType> &C) {
   const int nbC = this->colSize;
   const int nbR = this->rowSize;
 
@@ -544,7 +548,7 @@ int ttk::AssignmentMunkres<dataType>::affect(
 
 template <typename dataType>
 int ttk::AssignmentMunkres<dataType>::computeAffectationCost(
-  const std::vector<std::vector<dataType>> &C) {
+  const AssignmentMatrixView<dataType> &C) {
   const int nbC = this->colSize;
   const int nbR = this->rowSize;
 
@@ -16,8 +16,131 @@
 #include <Debug.h>
 #include <PersistenceDiagramUtils.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace ttk {
 
+  /// Dense row-major matrix used as input and workspace by the assignment
+  /// solvers. Rows are accessed as raw pointers, so that matrix[i][j] reads
+  /// and writes the element (i, j). Resizing keeps the allocated capacity,
+  /// so a matrix reused across solves does not allocate.
+  template <class dataType>
+  class AssignmentMatrix {
+  public:
+    AssignmentMatrix() = default;
+
+    AssignmentMatrix(const int rows, const int cols, const dataType value = 0)
+      : rows_{rows}, cols_{cols},
+        data_(static_cast<size_t>(rows) * cols, value) {
+    }
+
+    inline void resize(const int rows, const int cols) {
+      rows_ = rows;
+      cols_ = cols;
+      data_.resize(static_cast<size_t>(rows) * cols);
+    }
+
+    inline void assign(const std::vector<std::vector<dataType>> &matrix) {
+      this->resize(matrix.size(), matrix.empty() ? 0 : matrix[0].size());
+      for(int r = 0; r < rows_; ++r)
+        std::copy(matrix[r].begin(), matrix[r].end(), (*this)[r]);
+    }
+
+    inline void assign(const dataType *const data,
+                       const int rows,
+                       const int cols) {
+      this->resize(rows, cols);
+      std::copy(data, data + data_.size(), data_.begin());
+    }
+
+    inline void fill(const dataType value) {
+      std::fill(data_.begin(), data_.end(), value);
+    }
+
+    inline int size() const {
+      return rows_;
+    }
+
+    inline int rows() const {
+      return rows_;
+    }
+
+    inline int cols() const {
+      return cols_;
+    }
+
+    inline dataType *data() {
+      return data_.data();
+    }
+
+    inline const dataType *data() const {
+      return data_.data();
+    }
+
+    inline dataType *operator[](const int r) {
+      return data_.data() + static_cast<size_t>(r) * cols_;
+    }
+
+    inline const dataType *operator[](const int r) const {
+      return data_.data() + static_cast<size_t>(r) * cols_;
+    }
+
+    inline void swap(AssignmentMatrix &other) {
+      std::swap(rows_, other.rows_);
+      std::swap(cols_, other.cols_);
+      data_.swap(other.data_);
+    }
+
+  private:
+    int rows_{0};
+    int cols_{0};
+    std::vector<dataType> data_{};
+  };
+
+  /// Read-only view on a dense row-major matrix owned by the caller, used to
+  /// give a cost matrix to the assignment solvers without copying it.
+  template <class dataType>
+  class AssignmentMatrixView {
+  public:
+    AssignmentMatrixView() = default;
+
+    AssignmentMatrixView(const dataType *const data,
+                         const int rows,
+                         const int cols)
+      : data_{data}, rows_{rows}, cols_{cols} {
+    }
+
+    AssignmentMatrixView(const AssignmentMatrix<dataType> &matrix)
+      : data_{matrix.data()}, rows_{matrix.rows()}, cols_{matrix.cols()} {
+    }
+
+    inline int size() const {
+      return rows_;
+    }
+
+    inline int rows() const {
+      return rows_;
+    }
+
+    inline int cols() const {
+      return cols_;
+    }
+
+    inline const dataType *data() const {
+      return data_;
+    }
+
+    inline const dataType *operator[](const int r) const {
+      return data_ + static_cast<size_t>(r) * cols_;
+    }
+
+  private:
+    const dataType *data_{nullptr};
+    int rows_{0};
+    int cols_{0};
+  };
+
   template <class dataType>
   class AssignmentSolver : virtual public Debug {
 
@@ -34,32 +157,45 @@ namespace ttk {
     }
 
     virtual inline void clearMatrix() {
-      std::vector<std::vector<dataType>> C = getCostMatrix();
-      for(int r = 0, rS0 = rowSize; r < rS0; ++r)
-        for(int c = 0, cS0 = colSize; c < cS0; ++c)
-          C[r][c] = 0.0;
+      costMatrix.fill(0.0);
     }
 
-    virtual inline int setInput(std::vector<std::vector<dataType>> &C_) {
-      rowSize = C_.size();
-      colSize = C_[0].size();
+    inline int setInput(const std::vector<std::vector<dataType>> &C_) {
+      costMatrix.assign(C_);
+      costView = costMatrix;
+      return this->initInput();
+    }
 
-      costMatrix = C_;
+    inline int setInput(const AssignmentMatrix<dataType> &C_) {
+      costMatrix.assign(C_.data(), C_.rows(), C_.cols());
+      costView = costMatrix;
+      return this->initInput();
+    }
 
-      setBalanced((this->rowSize == this->colSize));
+    inline int setInput(const dataType *const C_,
+                        const int nRows,
+                        const int nCols) {
+      costMatrix.assign(C_, nRows, nCols);
+      costView = costMatrix;
+      return this->initInput();
+    }
 
-      return 0;
+    /// Non-owning overload: the cost matrix is not copied and must outlive
+    /// the call to run().
+    inline int setInput(const AssignmentMatrixView<dataType> &C_) {
+      costView = C_;
+      return this->initInput();
     }
 
     virtual inline void setBalanced(bool balanced) {
       balancedAssignment = balanced;
     }
 
-    virtual inline std::vector<std::vector<dataType>> getCostMatrix() {
+    inline const AssignmentMatrix<dataType> &getCostMatrix() const {
       return costMatrix;
     }
 
-    virtual inline std::vector<std::vector<dataType>> *getCostMatrixPointer() {
+    inline AssignmentMatrix<dataType> *getCostMatrixPointer() {
       return &costMatrix;
     }
 
@@ -75,7 +211,20 @@ namespace ttk {
     }
 
   protected:
-    std::vector<std::vector<dataType>> costMatrix;
+    /// Called once the cost matrix has been set by setInput: sizes the
+    /// solver workspace.
+    virtual inline int initInput() {
+      rowSize = costView.rows();
+      colSize = costView.cols();
+
+      setBalanced((this->rowSize == this->colSize));
+
+      return 0;
+    }
+
+    AssignmentMatrix<dataType> costMatrix;
+    // input cost matrix, either costMatrix or a matrix owned by the caller
+    AssignmentMatrixView<dataType> costView;
 
     int rowSize = 0;
     int colSize = 0;
@@ -1,6 +1,7 @@
 #include <AssignmentMunkres.h>
 #include <BottleneckDistance.h>
 #include <GabowTarjan.h>
+#include <GeometricBottleneck.h>
 #include <Geometry.h>
 
 ttk::BottleneckDistance::BottleneckDistance() {
@@ -28,11 +29,10 @@ int ttk::BottleneckDistance::execute(const ttk::DiagramType &diag0,
         this->printMsg("Solving with the legacy Dionysus exact approach.");
         this->printErr("Not supported");
       } break;
-      case 2: {
-        this->printMsg(
-          "Solving with the approximate Dionysus geometric approach.");
-        this->printErr("Not supported");
-      } break;
+      case 2:
+        this->printMsg("Solving with the exact geometric approach");
+        this->computeBottleneck(diag0, diag1, matchings, true);
+        break;
       case 3: {
         this->printMsg("Solving with the parallel TTK approach");
         this->printErr("Not supported");
@@ -59,11 +59,10 @@ int ttk::BottleneckDistance::execute(const ttk::DiagramType &diag0,
         this->printErr("Not supported");
       } break;
       case str2int("2"):
-      case str2int("geometric"): {
-        this->printMsg(
-          "Solving with the approximate Dionysus geometric approach.");
-        this->printErr("Not supported");
-      } break;
+      case str2int("geometric"):
+        this->printMsg("Solving with the exact geometric approach");
+        this->computeBottleneck(diag0, diag1, matchings, true);
+        break;
       case str2int("3"):
       case str2int("parallel"): {
         this->printMsg("Solving with the parallel TTK approach");
@@ -396,6 +395,17 @@ namespace {
     solver.run(matchings);
     solver.clear();
   }
+
+  void solveGeometricBottleneck(
+    const std::vector<ttk::GeometricBottleneck::Point> &points1,
+    const std::vector<ttk::GeometricBottleneck::Point> &points2,
+    std::vector<ttk::MatchingType> &matchings,
+    ttk::GeometricBottleneck &solver) {
+
+    solver.setInput(points1, points2);
+    solver.run(matchings);
+    solver.clear();
+  }
 } // namespace
 
 double ttk::BottleneckDistance::buildMappings(
@@ -505,7 +515,8 @@ double ttk::BottleneckDistance::diagonalDistanceFunction(
 int ttk::BottleneckDistance::computeBottleneck(
   const ttk::DiagramType &d1,
   const ttk::DiagramType &d2,
-  std::vector<MatchingType> &matchings) {
+  std::vector<MatchingType> &matchings,
+  const bool useGeometric) {
 
   const auto transposeOriginal = d1.size() > d2.size();
   if(transposeOriginal) {
@@ -523,6 +534,16 @@ int ttk::BottleneckDistance::computeBottleneck(
     return -4;
   }
 
+  // The geometric approach works in the (birth, death) plane
+  const bool geometric
+    = useGeometric && isBottleneck && this->PX == 0 && this->PY == 0
+      && this->PZ == 0 && this->PE > 0 && this->PS > 0;
+  if(useGeometric && !geometric) {
+    this->printWrn("The geometric approach only supports the Bottleneck "
+                   "distance without geometrical lifting");
+    this->printWrn("Falling back to the TTK approach");
+  }
+
   // Needed to limit computation time.
   const auto zeroThresh
     = this->computeMinimumRelevantPersistence(CTDiagram1, CTDiagram2);
@@ -557,24 +578,71 @@ int ttk::BottleneckDistance::computeBottleneck(
   const auto minRowColMax = std::min(nbRowMax + 1, nbColMax + 1);
   const auto minRowColSad = std::min(nbRowSad + 1, nbColSad + 1);
 
-  std::vector<std::vector<double>> minMatrix(
-    minRowColMin, std::vector<double>(maxRowColMin));
-  std::vector<std::vector<double>> maxMatrix(
-    minRowColMax, std::vector<double>(maxRowColMax));
-  std::vector<std::vector<double>> sadMatrix(
-    minRowColSad, std::vector<double>(maxRowColSad));
+  // (no cost matrix with the geometric approach)
+  std::vector<std::vector<double>> minMatrix{}, maxMatrix{}, sadMatrix{};
+  if(!geometric) {
+    minMatrix.resize(minRowColMin, std::vector<double>(maxRowColMin));
+    maxMatrix.resize(minRowColMax, std::vector<double>(maxRowColMax));
+    sadMatrix.resize(minRowColSad, std::vector<double>(maxRowColSad));
+  }
 
-  const bool transposeMin = nbRowMin > nbColMin;
-  const bool transposeMax = nbRowMax > nbColMax;
-  const bool transposeSad = nbRowSad > nbColSad;
+  const bool transposeMin = !geometric && nbRowMin > nbColMin;
+  const bool transposeMax = !geometric && nbRowMax > nbColMax;
+  const bool transposeSad = !geometric && nbRowSad > nbColSad;
 
   Timer t;
 
-  this->buildCostMatrices(CTDiagram1, CTDiagram2, zeroThresh, minMatrix,
-                          maxMatrix, sadMatrix, transposeMin, transposeMax,
-                          transposeSad, wasserstein);
+  if(!geometric) {
+    this->buildCostMatrices(CTDiagram1, CTDiagram2, zeroThresh, minMatrix,
+                            maxMatrix, sadMatrix, transposeMin, transposeMax,
+                            transposeSad, wasserstein);
+  }
 
-  if(!isBottleneck) {
+  if(geometric) {
+
+    // Same distances as distanceFunction and diagonalDistanceFunction
+    const auto toPoints = [&](const ttk::DiagramType &diagram,
+                              const std::vector<int> &map) {
+      std::vector<GeometricBottleneck::Point> points(map.size());
+      for(size_t i = 0; i < map.size(); ++i) {
+        const auto &p = diagram[map[i]];
+        const bool isMin = p.birth.type == CriticalType::Local_minimum;
+        const bool isMax = p.death.type == CriticalType::Local_maximum;
+        points[i].x = p.birth.sfValue;
+        points[i].y = p.death.sfValue;
+        points[i].wx = (isMin && !isMax) ? this->PE : this->PS;
+        points[i].wy = isMax ? this->PE : this->PS;
+        points[i].diag = this->diagonalDistanceFunction(p, wasserstein);
+      }
+      return points;
+    };
+
+    GeometricBottleneck solver;
+    solver.setThreadNumber(this->threadNumber_);
+    solver.setDebugLevel(this->debugLevel_);
+
+    if(nbRowMin > 0 && nbColMin > 0) {
+      this->printMsg("Affecting minima...");
+      solveGeometricBottleneck(toPoints(CTDiagram1, map1[0]),
+                               toPoints(CTDiagram2, map2[0]), minMatchings,
+                               solver);
+    }
+
+    if(nbRowMax > 0 && nbColMax > 0) {
+      this->printMsg("Affecting maxima...");
+      solveGeometricBottleneck(toPoints(CTDiagram1, map1[2]),
+                               toPoints(CTDiagram2, map2[2]), maxMatchings,
+                               solver);
+    }
+
+    if(nbRowSad > 0 && nbColSad > 0) {
+      this->printMsg("Affecting saddles...");
+      solveGeometricBottleneck(toPoints(CTDiagram1, map1[1]),
+                               toPoints(CTDiagram2, map2[1]), sadMatchings,
+                               solver);
+    }
+
+  } else if(!isBottleneck) {
 
     if(nbRowMin > 0 && nbColMin > 0) {
       AssignmentMunkres<double> solverMin;
@@ -676,8 +744,9 @@ int ttk::BottleneckDistance::computeBottleneck(
     }
   }
 
-  const auto affectationD
-    = !isBottleneck ? costs[0] + costs[1] + costs[2] : partialDistance;
+  const auto affectationD = !isBottleneck
+                              ? costs[0] + costs[1] + costs[2]
+                              : std::max({costs[0], costs[1], costs[2]});
   const auto addedPers
     = addedPersistence[0] + addedPersistence[1] + addedPersistence[2];
   this->distance_
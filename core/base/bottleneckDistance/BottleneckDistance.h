@@ -69,7 +69,8 @@ namespace ttk {
   private:
     int computeBottleneck(const ttk::DiagramType &d1,
                           const ttk::DiagramType &d2,
-                          std::vector<MatchingType> &matchings);
+                          std::vector<MatchingType> &matchings,
+                          const bool useGeometric = false);
 
     double computeGeometricalRange(const ttk::DiagramType &CTDiagram1,
                                    const ttk::DiagramType &CTDiagram2) const;
@@ -0,0 +1,570 @@
+#include <GeometricBottleneck.h>
+
+#include <algorithm>
+#include <limits>
+
+static constexpr int INF_LAYER = std::numeric_limits<int>::max();
+
+void ttk::GeometricBottleneck::Grid::build(const std::vector<Point> &points) {
+  const int n = points.size();
+  xMin = std::numeric_limits<double>::max();
+  yMin = std::numeric_limits<double>::max();
+  double xMax = std::numeric_limits<double>::lowest();
+  double yMax = std::numeric_limits<double>::lowest();
+  for(const auto &p : points) {
+    xMin = std::min(xMin, p.x);
+    yMin = std::min(yMin, p.y);
+    xMax = std::max(xMax, p.x);
+    yMax = std::max(yMax, p.y);
+  }
+
+  // about two points per cell
+  const int side = std::max(1, static_cast<int>(std::sqrt(n / 2.0)));
+  nx = xMax > xMin ? side : 1;
+  ny = yMax > yMin ? side : 1;
+  cellX = xMax > xMin ? (xMax - xMin) / nx : 1.0;
+  cellY = yMax > yMin ? (yMax - yMin) / ny : 1.0;
+
+  // counting sort of the points by cell
+  cellStart.assign(nx * ny + 1, 0);
+  std::vector<int> cells(n);
+  for(int i = 0; i < n; ++i) {
+    cells[i] = cellCoord(points[i].y, yMin, cellY, ny) * nx
+               + cellCoord(points[i].x, xMin, cellX, nx);
+    cellStart[cells[i] + 1]++;
+  }
+  for(int c = 0; c < nx * ny; ++c) {
+    cellStart[c + 1] += cellStart[c];
+  }
+  ids.resize(n);
+  std::vector<int> offsets(cellStart.begin(), cellStart.end() - 1);
+  for(int i = 0; i < n; ++i) {
+    ids[offsets[cells[i]]++] = i;
+  }
+}
+
+inline int ttk::GeometricBottleneck::Grid::cellCoord(const double v,
+                                                     const double vMin,
+                                                     const double cell,
+                                                     const int n) const {
+  const double c = (v - vMin) / cell;
+  if(c <= 0) {
+    return 0;
+  }
+  if(c >= n) {
+    return n - 1;
+  }
+  return static_cast<int>(c);
+}
+
+template <typename Func>
+inline void ttk::GeometricBottleneck::Grid::query(const double x,
+                                                  const double y,
+                                                  const double hx,
+                                                  const double hy,
+                                                  const Func &f) const {
+  if(ids.empty()) {
+    return;
+  }
+  const int i0 = cellCoord(x - hx, xMin, cellX, nx);
+  const int i1 = cellCoord(x + hx, xMin, cellX, nx);
+  const int j0 = cellCoord(y - hy, yMin, cellY, ny);
+  const int j1 = cellCoord(y + hy, yMin, cellY, ny);
+  for(int j = j0; j <= j1; ++j) {
+    for(int i = i0; i <= i1; ++i) {
+      const int c = j * nx + i;
+      for(int k = cellStart[c]; k < cellStart[c + 1]; ++k) {
+        f(ids[k]);
+      }
+    }
+  }
+}
+
+double ttk::GeometricBottleneck::computeLowerBound() const {
+  // every point has to be matched to the diagonal or to its closest
+  // neighbor at least
+  double lowerBound = 0;
+  const int n1 = Points1.size();
+  const int n2 = Points2.size();
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) reduction(max : lowerBound)
+#endif // TTK_ENABLE_OPENMP
+  for(int i = 0; i < n1 + n2; ++i) {
+    double m;
+    if(i < n1) {
+      const auto &p = Points1[i];
+      m = p.diag;
+      Grid2.query(p.x, p.y, m / p.wx, m / p.wy, [&](const int j) {
+        const auto &q = Points2[j];
+        const double d = this->distance(p, q);
+        if(d < m && this->isValid(p, q, d)) {
+          m = d;
+        }
+      });
+    } else {
+      const auto &q = Points2[i - n1];
+      m = q.diag;
+      Grid1.query(q.x, q.y, m / MinWx, m / MinWy, [&](const int j) {
+        const auto &p = Points1[j];
+        const double d = this->distance(p, q);
+        if(d < m && this->isValid(p, q, d)) {
+          m = d;
+        }
+      });
+    }
+    lowerBound = std::max(lowerBound, m);
+  }
+
+  return lowerBound;
+}
+
+bool ttk::GeometricBottleneck::enumerateCandidates(
+  const double lo,
+  const double hi,
+  const size_t maxCandidates,
+  std::vector<double> &candidates) const {
+
+  candidates.clear();
+  for(const auto &p : Points1) {
+    if(p.diag > lo && p.diag <= hi) {
+      candidates.emplace_back(p.diag);
+    }
+  }
+  for(const auto &q : Points2) {
+    if(q.diag > lo && q.diag <= hi) {
+      candidates.emplace_back(q.diag);
+    }
+  }
+
+  const int n1 = Points1.size();
+  bool tooMany = candidates.size() > maxCandidates;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  {
+    std::vector<double> local{};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp for schedule(dynamic, 64)
+#endif // TTK_ENABLE_OPENMP
+    for(int i = 0; i < n1; ++i) {
+      bool stop;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic read
+#endif // TTK_ENABLE_OPENMP
+      stop = tooMany;
+      if(stop) {
+        continue;
+      }
+      const auto &p = Points1[i];
+      Grid2.query(p.x, p.y, hi / p.wx, hi / p.wy, [&](const int j) {
+        const auto &q = Points2[j];
+        const double d = this->distance(p, q);
+        // an edge between two points closer to the diagonal than its
+        // length is never needed
+        if(d > lo && d <= hi && this->isValid(p, q, d)
+           && (p.diag > d || q.diag > d)) {
+          local.emplace_back(d);
+        }
+      });
+      if(local.size() > maxCandidates) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic write
+#endif // TTK_ENABLE_OPENMP
+        tooMany = true;
+      }
+    }
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp critical
+#endif // TTK_ENABLE_OPENMP
+    if(!tooMany) {
+      candidates.insert(candidates.end(), local.begin(), local.end());
+    }
+  }
+
+  if(tooMany || candidates.size() > maxCandidates) {
+    candidates.clear();
+    return false;
+  }
+
+  std::sort(candidates.begin(), candidates.end());
+  const auto last = std::unique(candidates.begin(), candidates.end());
+  candidates.erase(last, candidates.end());
+  return true;
+}
+
+void ttk::GeometricBottleneck::buildAdjacency(const double r,
+                                              Workspace &ws) const {
+  // Left vertices: points of the first set, then diagonal projections of the
+  // second set. Right vertices: points of the second set, then diagonal
+  // projections of the first set. Diagonal projections are all connected
+  // together, these edges are implicit.
+  const int n1 = Points1.size();
+  const int n2 = Points2.size();
+  ws.adjStart.resize(n1 + n2 + 1);
+  ws.adj.clear();
+
+  for(int i = 0; i < n1; ++i) {
+    ws.adjStart[i] = ws.adj.size();
+    const auto &p = Points1[i];
+    const bool heavy = p.diag > r;
+    Grid2.query(p.x, p.y, r / p.wx, r / p.wy, [&](const int j) {
+      const auto &q = Points2[j];
+      // two points that can both go to the diagonal need no edge
+      if(!heavy && q.diag <= r) {
+        return;
+      }
+      const double d = this->distance(p, q);
+      if(d <= r && this->isValid(p, q, d)) {
+        ws.adj.emplace_back(j);
+      }
+    });
+    if(!heavy) {
+      ws.adj.emplace_back(n2 + i);
+    }
+  }
+  for(int j = 0; j < n2; ++j) {
+    ws.adjStart[n1 + j] = ws.adj.size();
+    if(Points2[j].diag <= r) {
+      ws.adj.emplace_back(j);
+    }
+  }
+  ws.adjStart[n1 + n2] = ws.adj.size();
+}
+
+bool ttk::GeometricBottleneck::BFS(Workspace &ws) const {
+  const int n1 = Points1.size();
+  const int n2 = Points2.size();
+  const int nLeft = n1 + n2;
+
+  ws.queue.clear();
+  for(int u = 0; u < nLeft; ++u) {
+    if(ws.pairU[u] == -1) {
+      ws.dist[u] = 0;
+      ws.queue.emplace_back(u);
+    } else {
+      ws.dist[u] = INF_LAYER;
+    }
+  }
+  ws.found = INF_LAYER;
+  ws.diagonalLayer = INF_LAYER;
+  ws.diagonalCursor = 0;
+
+  for(size_t head = 0; head < ws.queue.size(); ++head) {
+    const int u = ws.queue[head];
+    if(ws.dist[u] >= ws.found) {
+      continue;
+    }
+    const auto visit = [&](const int v) {
+      const int w = ws.pairV[v];
+      if(w == -1) {
+        if(ws.found == INF_LAYER) {
+          ws.found = ws.dist[u] + 1;
+        }
+      } else if(ws.dist[w] == INF_LAYER) {
+        ws.dist[w] = ws.dist[u] + 1;
+        ws.queue.emplace_back(w);
+      }
+    };
+    for(int k = ws.adjStart[u]; k < ws.adjStart[u + 1]; ++k) {
+      visit(ws.adj[k]);
+    }
+    // the first diagonal projection reached discovers all the diagonal
+    // projections of the other side
+    if(u >= n1 && ws.diagonalLayer == INF_LAYER) {
+      ws.diagonalLayer = ws.dist[u];
+      for(int v = n2; v < n2 + n1; ++v) {
+        visit(v);
+      }
+    }
+  }
+
+  return ws.found != INF_LAYER;
+}
+
+bool ttk::GeometricBottleneck::DFS(const int root, Workspace &ws) const {
+  const int n1 = Points1.size();
+  const int n2 = Points2.size();
+
+  ws.stack.clear();
+  ws.stack.emplace_back(root, ws.adjStart[root]);
+
+  while(!ws.stack.empty()) {
+    const int u = ws.stack.back().first;
+    int &k = ws.stack.back().second;
+
+    // next edge of u: its neighbors, then the diagonal projections if u is
+    // a diagonal projection of the layer that discovered them (one that
+    // failed or was used once in this phase fails for every other vertex of
+    // this layer: skip it for good)
+    int v = -1;
+    if(k < ws.adjStart[u + 1]) {
+      v = ws.adj[k++];
+    } else if(u >= n1 && ws.dist[u] == ws.diagonalLayer
+              && ws.diagonalCursor < static_cast<size_t>(n1)) {
+      v = n2 + ws.diagonalCursor++;
+    } else {
+      // dead end
+      ws.dist[u] = INF_LAYER;
+      ws.stack.pop_back();
+      continue;
+    }
+
+    const int w = ws.pairV[v];
+    if(w == -1) {
+      if(ws.dist[u] + 1 == ws.found) {
+        // augment along the stack, each vertex of the path being matched
+        // to the free vertex of the frame above
+        for(auto it = ws.stack.rbegin(); it != ws.stack.rend(); ++it) {
+          const int next = ws.pairU[it->first];
+          ws.pairV[v] = it->first;
+          ws.pairU[it->first] = v;
+          v = next;
+        }
+        return true;
+      }
+    } else if(ws.dist[w] == ws.dist[u] + 1) {
+      ws.stack.emplace_back(w, ws.adjStart[w]);
+    }
+  }
+
+  return false;
+}
+
+bool ttk::GeometricBottleneck::isMatchable(
+  const double r, Workspace &ws, const Workspace *const warmStart) const {
+  const int n1 = Points1.size();
+  const int n2 = Points2.size();
+  const int nLeft = n1 + n2;
+
+  ws.maximum = false;
+  this->buildAdjacency(r, ws);
+
+  // a point far from the diagonal without any neighbor cannot be matched
+  for(int i = 0; i < n1; ++i) {
+    if(ws.adjStart[i] == ws.adjStart[i + 1]) {
+      return false;
+    }
+  }
+
+  ws.pairV.assign(nLeft, -1);
+  ws.dist.resize(nLeft);
+  if(warmStart != nullptr && warmStart->maximum) {
+    // start from a matching found for a smaller threshold, minus the edges
+    // that are no longer in the graph (between two light points)
+    ws.pairU = warmStart->pairU;
+    for(int u = 0; u < nLeft; ++u) {
+      const int v = ws.pairU[u];
+      if(v == -1) {
+        continue;
+      }
+      bool edge = u >= n1 && v >= n2;
+      for(int k = ws.adjStart[u]; !edge && k < ws.adjStart[u + 1]; ++k) {
+        edge = ws.adj[k] == v;
+      }
+      if(edge) {
+        ws.pairV[v] = u;
+      } else {
+        ws.pairU[u] = -1;
+      }
+    }
+  } else {
+    ws.pairU.assign(nLeft, -1);
+  }
+
+  int matching = 0;
+  for(int u = 0; u < nLeft; ++u) {
+    matching += ws.pairU[u] != -1;
+  }
+  while(this->BFS(ws)) {
+    for(int u = 0; u < nLeft; ++u) {
+      if(ws.pairU[u] == -1 && this->DFS(u, ws)) {
+        ++matching;
+      }
+    }
+  }
+  ws.maximum = true;
+
+  return matching == nLeft;
+}
+
+int ttk::GeometricBottleneck::testThresholds(
+  const std::vector<double> &thresholds,
+  std::vector<Workspace> &workspaces,
+  Workspace &warmStart) const {
+
+  const int n = thresholds.size();
+  std::vector<char> matchable(n, 0);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(std::min(threadNumber_, n)) \
+  schedule(dynamic, 1)
+#endif // TTK_ENABLE_OPENMP
+  for(int i = 0; i < n; ++i) {
+    matchable[i]
+      = this->isMatchable(thresholds[i], workspaces[i], &warmStart);
+  }
+
+  int first = 0;
+  while(first < n && !matchable[first]) {
+    ++first;
+  }
+  // the largest failing threshold gives the next warm start
+  if(first > 0 && workspaces[first - 1].maximum) {
+    std::swap(warmStart, workspaces[first - 1]);
+  }
+  return first < n ? first : -1;
+}
+
+double ttk::GeometricBottleneck::Distance() {
+  Timer tm{};
+
+  Grid1.build(Points1);
+  Grid2.build(Points2);
+  MinWx = std::numeric_limits<double>::max();
+  MinWy = std::numeric_limits<double>::max();
+  for(const auto &p : Points1) {
+    MinWx = std::min(MinWx, p.wx);
+    MinWy = std::min(MinWy, p.wy);
+  }
+
+  const int nThresholds = std::max(1, this->threadNumber_);
+  std::vector<Workspace> workspaces(nThresholds);
+  // maximum matching of the largest threshold that failed so far
+  Workspace warmStart{};
+
+  // The bottleneck distance is one of the candidates: a point to diagonal
+  // or a point to point distance. It lies in [lowerBound, upperBound].
+  const double lowerBound = this->computeLowerBound();
+  double lo = lowerBound;
+  double result = lo;
+
+  if(!this->isMatchable(lo, workspaces[0])) {
+    std::swap(warmStart, workspaces[0]);
+    double hi = 0;
+    for(const auto &p : Points1) {
+      hi = std::max(hi, p.diag);
+    }
+    for(const auto &q : Points2) {
+      hi = std::max(hi, q.diag);
+    }
+
+    // Tests are cheaper for small thresholds and the distance is usually
+    // close to the lower bound.
+    // 1. galloping search from the lower bound
+    std::vector<double> thresholds{};
+    double step = lowerBound > 0 ? lowerBound / 16 : hi / 1024;
+    while(true) {
+      thresholds.clear();
+      for(int i = 0; i < nThresholds; ++i, step *= 2) {
+        thresholds.emplace_back(std::min(lowerBound + step, hi));
+        if(thresholds.back() >= hi) {
+          break;
+        }
+      }
+      const int first = this->testThresholds(thresholds, workspaces, warmStart);
+      if(first >= 0) {
+        hi = thresholds[first];
+        if(first > 0) {
+          lo = thresholds[first - 1];
+        }
+        break;
+      }
+      lo = thresholds.back();
+    }
+
+    // 2. shrink ]lo, hi] until it holds few candidates
+    const size_t maxCandidates = 4 * (Points1.size() + Points2.size()) + 64;
+    std::vector<double> candidates{};
+    while(!this->enumerateCandidates(lo, hi, maxCandidates, candidates)) {
+      thresholds.resize(nThresholds);
+      for(int i = 0; i < nThresholds; ++i) {
+        thresholds[i] = lo + (hi - lo) * (i + 1) / (nThresholds + 1);
+      }
+      if(thresholds[0] <= lo || thresholds.back() >= hi) {
+        // floating point precision reached
+        this->enumerateCandidates(
+          lo, hi, std::numeric_limits<size_t>::max(), candidates);
+        break;
+      }
+      const int first = this->testThresholds(thresholds, workspaces, warmStart);
+      if(first >= 0) {
+        hi = thresholds[first];
+        if(first > 0) {
+          lo = thresholds[first - 1];
+        }
+      } else {
+        lo = thresholds.back();
+      }
+    }
+
+    // 3. exact k-ary search among the remaining candidates (the last one
+    // is matchable since hi is)
+    if(candidates.empty()) {
+      // rounding errors may leave no candidate distance in ]lo, hi], hi
+      // being matchable is then the result
+      candidates.emplace_back(hi);
+    }
+    size_t first = 0, last = candidates.size() - 1;
+    std::vector<size_t> indices{};
+    while(first < last) {
+      indices.clear();
+      const size_t range = last - first;
+      for(int i = 0; i < nThresholds; ++i) {
+        const size_t idx = first + range * (i + 1) / (nThresholds + 1);
+        if(indices.empty() || idx > indices.back()) {
+          indices.emplace_back(idx);
+        }
+      }
+      thresholds.resize(indices.size());
+      for(size_t i = 0; i < indices.size(); ++i) {
+        thresholds[i] = candidates[indices[i]];
+      }
+      const int found = this->testThresholds(thresholds, workspaces, warmStart);
+      if(found >= 0) {
+        last = indices[found];
+        if(found > 0) {
+          first = indices[found - 1] + 1;
+        }
+      } else {
+        first = indices.back() + 1;
+      }
+    }
+    result = candidates[first];
+    this->isMatchable(result, workspaces[0], &warmStart);
+  }
+
+  Matching = std::move(workspaces[0].pairU);
+
+  this->printMsg("Computed distance " + std::to_string(result), 1,
+                 tm.getElapsedTime(), threadNumber_);
+  return result;
+}
+
+int ttk::GeometricBottleneck::run(std::vector<MatchingType> &matchings) {
+  this->Distance();
+
+  matchings.clear();
+  const int n1 = Points1.size();
+  const int n2 = Points2.size();
+
+  for(int i = 0; i < n1; ++i) {
+    const int j = Matching[i];
+    if(j < 0) {
+      this->printErr("Hopcroft-Karp built an invalid matching.");
+      return -1;
+    }
+    if(j < n2) {
+      matchings.emplace_back(i, j, this->distance(Points1[i], Points2[j]));
+    } else {
+      matchings.emplace_back(i, n2 + i, Points1[i].diag);
+    }
+  }
+  for(int j = 0; j < n2; ++j) {
+    if(Matching[n1 + j] == j) {
+      matchings.emplace_back(n1 + j, j, Points2[j].diag);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,174 @@
+/// \ingroup base
+/// \class ttk::GeometricBottleneck
+///
+/// \brief Exact bottleneck matching between two sets of persistence pairs,
+/// without any cost matrix.
+///
+/// The bottleneck value is searched among the candidate distances (pair to
+/// pair and pair to diagonal). Each candidate threshold is tested with a
+/// Hopcroft-Karp maximum matching whose edges are found with a uniform grid
+/// (near neighbor oracle) instead of a complete bipartite graph, following:
+///
+/// \b Related \b publication \n
+/// "Geometry Helps to Compare Persistence Diagrams" \n
+/// Michael Kerber, Dmitriy Morozov, Arnur Nigmetov \n
+/// ACM Journal of Experimental Algorithmics, 2017.
+///
+/// Several thresholds are tested in parallel at each step of the search.
+///
+/// \sa ttk::GabowTarjan
+/// \sa ttk::BottleneckDistance
+
+#pragma once
+
+#include <Debug.h>
+#include <PersistenceDiagramUtils.h>
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace ttk {
+
+  class GeometricBottleneck : public Debug {
+
+  public:
+    /*
+     * A persistence pair in the (birth, death) plane. The distance between a
+     * point p of the first set and a point q of the second set is
+     * p.wx * |p.x - q.x| + p.wy * |p.y - q.y| (the weights of the second set
+     * are not used). diag is the distance of the point to the diagonal.
+     */
+    struct Point {
+      double x{};
+      double y{};
+      double wx{1.0};
+      double wy{1.0};
+      double diag{};
+    };
+
+    GeometricBottleneck() {
+      this->setDebugMsgPrefix("GeometricBottleneck");
+    }
+
+    inline void setInput(const std::vector<Point> &points1,
+                         const std::vector<Point> &points2) {
+      this->Points1 = points1;
+      this->Points2 = points2;
+    }
+
+    inline void clear() {
+      Points1.clear();
+      Points2.clear();
+      Matching.clear();
+    }
+
+    double Distance();
+
+    /*
+     * Matchings use the GabowTarjan convention: (i, j, cost) where j >=
+     * Points2.size() if i is matched to the diagonal and i >= Points1.size()
+     * if j is matched to the diagonal.
+     */
+    int run(std::vector<MatchingType> &matchings);
+
+  private:
+    /*
+     * Uniform grid over a set of points, used to enumerate the points in a
+     * box around a query point.
+     */
+    struct Grid {
+      double xMin{}, yMin{};
+      double cellX{1.0}, cellY{1.0};
+      int nx{1}, ny{1};
+      std::vector<int> cellStart{};
+      std::vector<int> ids{};
+
+      void build(const std::vector<Point> &points);
+
+      template <typename Func>
+      inline void query(const double x,
+                        const double y,
+                        const double hx,
+                        const double hy,
+                        const Func &f) const;
+
+    private:
+      inline int cellCoord(const double v,
+                           const double vMin,
+                           const double cell,
+                           const int n) const;
+    };
+
+    /*
+     * Buffers used by one threshold test, one per thread.
+     */
+    struct Workspace {
+      std::vector<int> adjStart{};
+      std::vector<int> adj{};
+      std::vector<int> pairU{};
+      std::vector<int> pairV{};
+      std::vector<int> dist{};
+      std::vector<int> queue{};
+      // (vertex, next adjacency index) of the frames of the DFS
+      std::vector<std::pair<int, int>> stack{};
+      // true if pairU is a maximum matching
+      bool maximum{};
+      int found{};
+      int diagonalLayer{};
+      size_t diagonalCursor{};
+    };
+
+    inline double distance(const Point &p, const Point &q) const {
+      return p.wx * std::abs(p.x - q.x) + p.wy * std::abs(p.y - q.y);
+    }
+
+    // pair to pair edges longer than going through the diagonal are useless
+    inline bool isValid(const Point &p, const Point &q, const double d) const {
+      return d <= p.diag + q.diag;
+    }
+
+    double computeLowerBound() const;
+
+    // sorted candidate distances in ]lo, hi], false if there are more than
+    // maxCandidates
+    bool enumerateCandidates(const double lo,
+                             const double hi,
+                             const size_t maxCandidates,
+                             std::vector<double> &candidates) const;
+
+    // true if there is a perfect matching using only edges of length <= r,
+    // Hopcroft-Karp starts from the matching of warmStart if given
+    bool isMatchable(const double r,
+                     Workspace &ws,
+                     const Workspace *const warmStart = nullptr) const;
+
+    // k-ary search: test several thresholds in parallel (one workspace per
+    // threshold), returns the index of the smallest threshold passing the
+    // test, or -1. warmStart is updated with the largest failing threshold.
+    int testThresholds(const std::vector<double> &thresholds,
+                       std::vector<Workspace> &workspaces,
+                       Workspace &warmStart) const;
+
+    void buildAdjacency(const double r, Workspace &ws) const;
+    bool BFS(Workspace &ws) const;
+    // iterative, augmenting paths may be as long as the number of points
+    bool DFS(const int root, Workspace &ws) const;
+
+    // Pairs of the two diagrams
+    std::vector<Point> Points1;
+    std::vector<Point> Points2;
+
+    // Grids over Points1 and Points2
+    Grid Grid1;
+    Grid Grid2;
+
+    // Minimal weights of Points1 (for reverse queries from Points2)
+    double MinWx{1.0};
+    double MinWy{1.0};
+
+    // Left vertex -> right vertex of the optimal matching
+    std::vector<int> Matching;
+  };
+
+} // namespace ttk
@@ -7,6 +7,19 @@
 /// Based on implementation described in Physically Based Rendering:
 /// From Theory to Implementation by Matt Pharr, Wenzel Jakob and
 /// Greg Humphreys.
+///
+/// The tree is built in parallel with the binned surface area heuristic
+/// (SAH) and stored as a flat array of nodes in which siblings are adjacent.
+/// Leaves reference a copy of their triangles (first vertex and edges),
+/// stored contiguously in tree order. Rays can be traced one at a time or by
+/// packets of coherent rays (ttk::RayPacket) sharing a single traversal, the
+/// box and triangle tests being fixed-size loops over the packet that the
+/// compiler vectorizes.
+///
+/// \b Related \b publication \n
+/// "On fast Construction of SAH-based Bounding Volume Hierarchies" \n
+/// Ingo Wald \n
+/// IEEE Symposium on Interactive Ray Tracing 2007.
 
 #pragma once
 
@@ -14,365 +27,416 @@
 #include <Geometry.h>
 
 #include <algorithm>
+#include <array>
 #include <limits>
-#include <memory>
-#include <stack>
 #include <vector>
 
 namespace ttk {
   template <typename IT>
   class BoundingVolumeHierarchy {
   protected:
-    struct Node {
-      Node() = default;
-      // leaf constructor
-      Node(const std::vector<int> &triangleIndices,
-           const size_t nTriangles,
-           const float *pMin,
-           const float *pMax) {
-        m_minX = pMin[0];
-        m_minY = pMin[1];
-        m_minZ = pMin[2];
-        m_maxX = pMax[0];
-        m_maxY = pMax[1];
-        m_maxZ = pMax[2];
-        indices = triangleIndices;
-        numTriangles = nTriangles;
+    struct Bounds {
+      float m_min[3]{std::numeric_limits<float>::max(),
+                     std::numeric_limits<float>::max(),
+                     std::numeric_limits<float>::max()};
+      float m_max[3]{std::numeric_limits<float>::lowest(),
+                     std::numeric_limits<float>::lowest(),
+                     std::numeric_limits<float>::lowest()};
+
+      inline void grow(const float *pMin, const float *pMax) {
+        for(int k = 0; k < 3; k++) {
+          m_min[k] = std::min(m_min[k], pMin[k]);
+          m_max[k] = std::max(m_max[k], pMax[k]);
+        }
       }
-      // interior constructor
-      Node(const int axis,
-           const std::shared_ptr<Node> &left,
-           const std::shared_ptr<Node> &right) {
-        numTriangles = 0;
-        m_left = left;
-        m_right = right;
-        m_splitAxis = axis;
-        m_minX = std::min(left->m_minX, right->m_minX);
-        m_minY = std::min(left->m_minY, right->m_minY);
-        m_minZ = std::min(left->m_minZ, right->m_minZ);
-        m_maxX = std::max(left->m_maxX, right->m_maxX);
-        m_maxY = std::max(left->m_maxY, right->m_maxY);
-        m_maxZ = std::max(left->m_maxZ, right->m_maxZ);
+      inline void grow(const Bounds &other) {
+        grow(other.m_min, other.m_max);
       }
+      inline float area() const {
+        const float dx = m_max[0] - m_min[0];
+        const float dy = m_max[1] - m_min[1];
+        const float dz = m_max[2] - m_min[2];
+        return 2.0f * (dx * dy + dy * dz + dz * dx);
+      }
+    };
 
-      ~Node() = default;
-
-      std::vector<int> indices;
+    struct Node {
+      float m_min[3];
+      float m_max[3];
+      // first triangle of a leaf, or first of the two (adjacent) children of
+      // an interior node
+      int offset;
+      // 0 for interior nodes
       int numTriangles;
-      float m_minX, m_minY, m_minZ;
-      float m_maxX, m_maxY, m_maxZ;
-      std::shared_ptr<Node> m_left;
-      std::shared_ptr<Node> m_right;
       int m_splitAxis;
     };
 
+    // triangle in tree order, ready for the Moller-Trumbore test
     struct Triangle {
+      float m_v0[3];
+      float m_v0v1[3];
+      float m_v0v2[3];
+      int m_index;
+    };
+
+    // triangle bounds and centroid, only used during the build
+    struct BuildTriangle {
+      float m_min[3];
+      float m_max[3];
+      float m_centroid[3];
       int m_index;
-      float m_centroid_x, m_centroid_y, m_centroid_z;
-      float m_minX, m_minY, m_minZ;
-      float m_maxX, m_maxY, m_maxZ;
-      Triangle() = default;
-
-      void init(const int &index,
-                const float &centroid_x,
-                const float &centroid_y,
-                const float &centroid_z,
-                const float *pMin,
-                const float *pMax) {
-        m_index = index;
-        m_centroid_x = centroid_x;
-        m_centroid_y = centroid_y;
-        m_centroid_z = centroid_z;
-        m_minX = pMin[0];
-        m_minY = pMin[1];
-        m_minZ = pMin[2];
-
-        m_maxX = pMax[0];
-        m_maxY = pMax[1];
-        m_maxZ = pMax[2];
-      }
     };
 
   public:
+    /** Number of adjacent camera rays traced together */
+    static constexpr int PacketSize{4};
+
     BoundingVolumeHierarchy(const float *coords,
                             const IT *connectivityList,
-                            const size_t &nTriangles) {
-      std::vector<Triangle> triangles;
-      buildTriangleList(triangles, coords, connectivityList, nTriangles);
+                            const size_t &nTriangles,
+                            const int threadNumber = 1) {
+      if(nTriangles == 0) {
+        return;
+      }
 
-      this->nodes = buildTree(triangles, 0, nTriangles);
+      std::vector<BuildTriangle> buildTriangles(nTriangles);
+      buildTriangleList(buildTriangles, coords, connectivityList, nTriangles,
+                        threadNumber);
+
+      // a binary tree with at most one leaf per triangle
+      this->nodes.resize(2 * nTriangles - 1);
+      this->nodeNumber = 1;
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel num_threads(threadNumber)
+#pragma omp single nowait
+#endif // TTK_ENABLE_OPENMP
+      buildTree(buildTriangles.data(), 0, 0, nTriangles, 0);
+
+      this->nodes.resize(this->nodeNumber);
+      this->nodes.shrink_to_fit();
+
+      // store the triangles in tree order
+      this->triangles.resize(nTriangles);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
+      for(size_t i = 0; i < nTriangles; i++) {
+        const int ti = buildTriangles[i].m_index;
+        const float *p0 = &coords[connectivityList[ti * 3 + 0] * 3];
+        const float *p1 = &coords[connectivityList[ti * 3 + 1] * 3];
+        const float *p2 = &coords[connectivityList[ti * 3 + 2] * 3];
+        Triangle &t = this->triangles[i];
+        t.m_index = ti;
+        for(int k = 0; k < 3; k++) {
+          t.m_v0[k] = p0[k];
+        }
+        ttk::Geometry::subtractVectors(p0, p1, t.m_v0v1);
+        ttk::Geometry::subtractVectors(p0, p2, t.m_v0v2);
+      }
     }
 
     ~BoundingVolumeHierarchy() = default;
 
-    std::shared_ptr<Node>
-      buildTree(std::vector<Triangle> &triangles, size_t start, size_t end) {
+    /**
+     * @brief Closest intersection of a single ray with the triangles
+     *
+     * The connectivity and the coordinates are not used anymore (the
+     * triangles are copied at construction), they are only kept for
+     * compatibility.
+     */
+    bool intersect(Ray &r,
+                   const IT *ttkNotUsed(connectivityList),
+                   const float *ttkNotUsed(vertexCoords),
+                   int *triangleIndex,
+                   float *distance) const {
+      RayPacket<1> packet;
+      for(int k = 0; k < 3; k++) {
+        packet.m_origin[k][0] = r.m_origin[k];
+        packet.m_direction[k][0] = r.m_direction[k];
+      }
+      intersect(packet);
+      if(packet.triangleIndex[0] == -1) {
+        return false;
+      }
+      *triangleIndex = packet.triangleIndex[0];
+      *distance = packet.distance[0];
+      r.distance = packet.distance[0];
+      r.u = packet.u[0];
+      r.v = packet.v[0];
+      return true;
+    }
 
-      float minX, minY, minZ;
-      float maxX, maxY, maxZ;
-      minX = minY = minZ = std::numeric_limits<float>::max();
-      maxX = maxY = maxZ = std::numeric_limits<float>::min();
-      for(size_t i = start; i < end; i++) {
-        const Triangle &t = triangles[i];
-        minX = std::min(t.m_minX, minX);
-        minY = std::min(t.m_minY, minY);
-        minZ = std::min(t.m_minZ, minZ);
-
-        maxX = std::max(t.m_maxX, maxX);
-        maxY = std::max(t.m_maxY, maxY);
-        maxZ = std::max(t.m_maxZ, maxZ);
+    /**
+     * @brief Closest intersections of a packet of rays with the triangles
+     *
+     * The rays share the traversal: a node is visited if one of them hits
+     * its box before its current closest hit. Children are visited
+     * front-to-back according to the direction of the first ray. Ties
+     * between hits at the same distance go to the lowest triangle index.
+     */
+    template <int N>
+    void intersect(RayPacket<N> &packet) const {
+      for(int i = 0; i < N; i++) {
+        packet.distance[i] = std::numeric_limits<float>::infinity();
+        packet.u[i] = 0;
+        packet.v[i] = 0;
+        packet.triangleIndex[i] = -1;
       }
-      const int numberTriangles = end - start;
-      if(numberTriangles == 1) {
-        const Triangle &t = triangles[start];
-        std::vector<int> const indices = {t.m_index};
-        float pMin[3] = {t.m_minX, t.m_minY, t.m_minZ};
-        float pMax[3] = {t.m_maxX, t.m_maxY, t.m_maxZ};
-        return std::make_shared<Node>(indices, 1, pMin, pMax);
-      } else {
-        // find the bounds of the centroids, figure out what dimension to split
-        // on
-        float cminX, cminY, cminZ;
-        float cmaxX, cmaxY, cmaxZ;
-        cminX = cminY = cminZ = std::numeric_limits<float>::max();
-        cmaxX = cmaxY = cmaxZ = std::numeric_limits<float>::min();
-        for(size_t i = start; i < end; i++) {
-          const Triangle &t = triangles[i];
-          cminX = std::min(t.m_centroid_x, cminX);
-          cminY = std::min(t.m_centroid_y, cminY);
-          cminZ = std::min(t.m_centroid_z, cminZ);
-
-          cmaxX = std::max(t.m_centroid_x, cmaxX);
-          cmaxY = std::max(t.m_centroid_y, cmaxY);
-          cmaxZ = std::max(t.m_centroid_z, cmaxZ);
-        }
-        // figure out the biggest extent, use that dimension
-        const float diffX = std::abs(cmaxX - cminX);
-        const float diffY = std::abs(cmaxY - cminY);
-        const float diffZ = std::abs(cmaxZ - cminZ);
-        const float maximumExtent = std::max({diffX, diffY, diffZ});
-        int axis;
-        float minToCheck, maxToCheck;
-        if(maximumExtent == diffX) {
-          axis = 0;
-          minToCheck = cminX;
-          maxToCheck = cmaxX;
-        } else if(maximumExtent == diffY) {
-          axis = 1;
-          minToCheck = cminY;
-          maxToCheck = cmaxY;
-        } else {
-          axis = 2;
-          minToCheck = cminZ;
-          maxToCheck = cmaxZ;
+      if(this->nodes.empty()) {
+        return;
+      }
+
+      float invDirection[3][N];
+      for(int k = 0; k < 3; k++) {
+        for(int i = 0; i < N; i++) {
+          invDirection[k][i] = 1.0f / packet.m_direction[k][i];
         }
-        size_t const half = (start + end) / 2;
-        // partition triangles into two sets and build children
-        if(minToCheck == maxToCheck) {
+      }
+
+      std::array<int, MaxStackSize> stack;
+      int stackSize = 0;
+      stack[stackSize++] = 0;
 
-          std::vector<int> triangleIndices;
-          for(size_t i = start; i < end; i++) {
-            triangleIndices.push_back(triangles[i].m_index);
+      while(stackSize > 0) {
+        const Node &node = this->nodes[stack[--stackSize]];
+        if(!wasNodeHit(packet, invDirection, node)) {
+          continue;
+        }
+        if(node.numTriangles > 0) {
+          for(int j = node.offset; j < node.offset + node.numTriangles; j++) {
+            MollerTrumbore(packet, this->triangles[j]);
           }
-          float pMin[3] = {minX, minY, minZ};
-          float pMax[3] = {maxX, maxY, maxZ};
-          return std::make_shared<Node>(
-            triangleIndices, triangleIndices.size(), pMin, pMax);
         } else {
-          // partition triangles into equally sized subsets
-          std::nth_element(&triangles[start], &triangles[half],
-                           &triangles[end - 1] + 1,
-                           [axis](const Triangle &t1, const Triangle &t2) {
-                             switch(axis) {
-                               case 0:
-                               default:
-                                 return t1.m_centroid_x < t2.m_centroid_x;
-                                 break;
-                               case 1:
-                                 return t1.m_centroid_y < t2.m_centroid_y;
-                                 break;
-                               case 2:
-                                 return t1.m_centroid_z < t2.m_centroid_z;
-                                 break;
-                             }
-                           });
-
-          return std::make_shared<Node>(axis, buildTree(triangles, start, half),
-                                        buildTree(triangles, half, end));
+          // push the far child first
+          const int nearChild
+            = packet.m_direction[node.m_splitAxis][0] < 0 ? 1 : 0;
+          stack[stackSize++] = node.offset + 1 - nearChild;
+          stack[stackSize++] = node.offset + nearChild;
         }
       }
-
-      return nullptr;
     }
-    int buildTriangleList(std::vector<Triangle> &triangles,
+
+  protected:
+    static constexpr int MaxLeafSize{4};
+    static constexpr int BinNumber{16};
+    // relative cost of a node traversal w.r.t. a triangle intersection
+    static constexpr float TraversalCost{0.125f};
+    // below this depth splits are object medians, bounding the stack size
+    static constexpr int MaxSAHDepth{64};
+    static constexpr int MaxStackSize{MaxSAHDepth + 64};
+    // subtrees larger than this are built in separate tasks
+    static constexpr size_t TaskGrainSize{16384};
+
+    int buildTriangleList(std::vector<BuildTriangle> &buildTriangles,
                           const float *coords,
                           const IT *connectivityList,
-                          const size_t &nTriangles) {
-      triangles.resize(nTriangles);
+                          const size_t &nTriangles,
+                          const int threadNumber) const {
+      TTK_FORCE_USE(threadNumber);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
       for(size_t ti = 0; ti < nTriangles; ti++) {
-
-        const IT v1 = connectivityList[ti * 3 + 0] * 3;
-        const IT v2 = connectivityList[ti * 3 + 1] * 3;
-        const IT v3 = connectivityList[ti * 3 + 2] * 3;
-
-        const float &x1 = coords[v1 + 0];
-        const float &x2 = coords[v2 + 0];
-        const float &x3 = coords[v3 + 0];
-
-        const float &y1 = coords[v1 + 1];
-        const float &y2 = coords[v2 + 1];
-        const float &y3 = coords[v3 + 1];
-
-        const float &z1 = coords[v1 + 2];
-        const float &z2 = coords[v2 + 2];
-        const float &z3 = coords[v3 + 2];
-
-        const float pMin[3] = {std::min({x1, x2, x3}), std::min({y1, y2, y3}),
-                               std::min({z1, z2, z3})};
-        const float pMax[3] = {std::max({x1, x2, x3}), std::max({y1, y2, y3}),
-                               std::max({z1, z2, z3})};
-
-        triangles[ti].init(ti, findCentroid(x1, x2, x3),
-                           findCentroid(y1, y2, y3), findCentroid(z1, z2, z3),
-                           pMin, pMax);
+        BuildTriangle &t = buildTriangles[ti];
+        t.m_index = ti;
+        for(int k = 0; k < 3; k++) {
+          const float c1 = coords[connectivityList[ti * 3 + 0] * 3 + k];
+          const float c2 = coords[connectivityList[ti * 3 + 1] * 3 + k];
+          const float c3 = coords[connectivityList[ti * 3 + 2] * 3 + k];
+          t.m_min[k] = std::min({c1, c2, c3});
+          t.m_max[k] = std::max({c1, c2, c3});
+          t.m_centroid[k] = (c1 + c2 + c3) / 3;
+        }
       }
 
       return 1;
     }
 
-    bool MollerTrumbore(Ray &ray,
-                        const IT v0,
-                        const IT v1,
-                        const IT v2,
-                        const float *vertexCoords) const {
-      constexpr float kEpsilon = 1e-8;
+    void buildTree(BuildTriangle *buildTriangles,
+                   const int nodeId,
+                   const size_t start,
+                   const size_t end,
+                   const int depth) {
 
-      float v0v1[3], v0v2[3], pvec[3], tvec[3], qvec[3];
-      ttk::Geometry::subtractVectors(
-        &vertexCoords[v0], &vertexCoords[v1], v0v1);
-      ttk::Geometry::subtractVectors(
-        &vertexCoords[v0], &vertexCoords[v2], v0v2);
-      ttk::Geometry::crossProduct(ray.m_direction, v0v2, pvec);
-      const float det = ttk::Geometry::dotProduct(v0v1, pvec);
-      if(det > -kEpsilon && det < kEpsilon)
-        return false;
-
-      const float invDet = 1.0f / det;
-
-      ttk::Geometry::subtractVectors(&vertexCoords[v0], ray.m_origin, tvec);
-      const float u = ttk::Geometry::dotProduct(tvec, pvec) * invDet;
-      if(u < 0.0 || u > 1.0)
-        return false;
+      Node &node = this->nodes[nodeId];
+      Bounds bounds, centroidBounds;
+      for(size_t i = start; i < end; i++) {
+        bounds.grow(buildTriangles[i].m_min, buildTriangles[i].m_max);
+        centroidBounds.grow(
+          buildTriangles[i].m_centroid, buildTriangles[i].m_centroid);
+      }
+      for(int k = 0; k < 3; k++) {
+        node.m_min[k] = bounds.m_min[k];
+        node.m_max[k] = bounds.m_max[k];
+      }
+      node.offset = start;
+      node.numTriangles = end - start;
+      node.m_splitAxis = 0;
+
+      // split along the largest extent of the centroids
+      int axis = 0;
+      for(int k = 1; k < 3; k++) {
+        if(centroidBounds.m_max[k] - centroidBounds.m_min[k]
+           > centroidBounds.m_max[axis] - centroidBounds.m_min[axis]) {
+          axis = k;
+        }
+      }
+      const float cMin = centroidBounds.m_min[axis];
+      const float extent = centroidBounds.m_max[axis] - cMin;
+      if(end - start == 1 || !(extent > 0)) {
+        return;
+      }
 
-      ttk::Geometry::crossProduct(tvec, v0v1, qvec);
-      const float v = ttk::Geometry::dotProduct(ray.m_direction, qvec) * invDet;
-      if(v < 0.0 || u + v > 1.0)
-        return false;
+      // bin the centroids and sweep the SAH cost of the bin boundaries
+      const float scale = BinNumber / extent;
+      const auto binOf = [axis, cMin, scale](const BuildTriangle &t) {
+        const int b = static_cast<int>((t.m_centroid[axis] - cMin) * scale);
+        return std::min(b, BinNumber - 1);
+      };
+      std::array<Bounds, BinNumber> binBounds{};
+      std::array<size_t, BinNumber> binCounts{};
+      for(size_t i = start; i < end; i++) {
+        const int b = binOf(buildTriangles[i]);
+        binCounts[b]++;
+        binBounds[b].grow(buildTriangles[i].m_min, buildTriangles[i].m_max);
+      }
+      std::array<float, BinNumber - 1> costs{};
+      Bounds sweep;
+      size_t count = 0;
+      for(int b = 0; b < BinNumber - 1; b++) {
+        sweep.grow(binBounds[b]);
+        count += binCounts[b];
+        costs[b] = count > 0 ? count * sweep.area() : 0;
+      }
+      sweep = Bounds{};
+      count = 0;
+      for(int b = BinNumber - 1; b > 0; b--) {
+        sweep.grow(binBounds[b]);
+        count += binCounts[b];
+        costs[b - 1] += count > 0 ? count * sweep.area() : 0;
+      }
+      const int bestBin = std::min_element(costs.begin(), costs.end())
+                          - costs.begin();
+      const float area = bounds.area();
+      const float splitCost
+        = TraversalCost + (area > 0 ? costs[bestBin] / area : 0);
+      if(end - start <= static_cast<size_t>(MaxLeafSize)
+         && end - start <= splitCost) {
+        return;
+      }
 
-      const float t = ttk::Geometry::dotProduct(v0v2, qvec) * invDet;
-      ray.distance = t;
-      ray.u = u;
-      ray.v = v;
+      size_t middle
+        = std::partition(buildTriangles + start, buildTriangles + end,
+                         [&binOf, bestBin](const BuildTriangle &t) {
+                           return binOf(t) <= bestBin;
+                         })
+          - buildTriangles;
+      if(middle == start || middle == end || depth >= MaxSAHDepth) {
+        middle = (start + end) / 2;
+        std::nth_element(buildTriangles + start, buildTriangles + middle,
+                         buildTriangles + end,
+                         [axis](const BuildTriangle &t1,
+                                const BuildTriangle &t2) {
+                           return t1.m_centroid[axis] < t2.m_centroid[axis];
+                         });
+      }
 
-      return true;
+      int firstChild{};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic capture
+#endif // TTK_ENABLE_OPENMP
+      {
+        firstChild = this->nodeNumber;
+        this->nodeNumber += 2;
+      }
+      node.offset = firstChild;
+      node.numTriangles = 0;
+      node.m_splitAxis = axis;
+
+      const bool useTask = end - start > TaskGrainSize;
+      TTK_FORCE_USE(useTask);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp task if(useTask)
+#endif // TTK_ENABLE_OPENMP
+      buildTree(buildTriangles, firstChild, start, middle, depth + 1);
+      buildTree(buildTriangles, firstChild + 1, middle, end, depth + 1);
     }
 
-    bool intersect(Ray &r,
-                   const IT *connectivityList,
-                   const float *vertexCoords,
-                   int *triangleIndex,
-                   float *distance) const {
+    template <int N>
+    inline bool wasNodeHit(const RayPacket<N> &packet,
+                           const float (&invDirection)[3][N],
+                           const Node &n) const {
       bool wasHit = false;
-      float nearestTriangle = std::numeric_limits<float>::max();
-      std::stack<Node *> stack;
-      Node *node = &nodes.get()[0];
-      if(!wasNodeHit(r, node)) {
-        return false;
-      }
-      stack.push(node);
-      while(stack.size() != 0) {
-        node = stack.top();
-        stack.pop();
-        if(wasNodeHit(r, node)) {
-
-          if(node->numTriangles > 0) {
-
-            for(int i = 0; i < node->numTriangles; i++) {
-              bool hasHit = false;
-              int const triIdx = node->indices[i];
-
-              IT v0 = connectivityList[triIdx * 3 + 0];
-              IT v1 = connectivityList[triIdx * 3 + 1];
-              IT v2 = connectivityList[triIdx * 3 + 2];
-              v0 *= 3;
-              v1 *= 3;
-              v2 *= 3;
-              hasHit = MollerTrumbore(r, v0, v1, v2, vertexCoords);
-              if(hasHit && r.distance < nearestTriangle) {
-                *triangleIndex = triIdx;
-                nearestTriangle = r.distance;
-                wasHit = true;
-                *distance = r.distance;
-              }
-            }
-          } else {
-
-            if(node->m_right != nullptr) {
-              stack.push(node->m_right.get());
-            }
-            if(node->m_left != nullptr) {
-              stack.push(node->m_left.get());
-            }
-          }
+      for(int i = 0; i < N; i++) {
+        float tmin = std::numeric_limits<float>::lowest();
+        float tmax = std::numeric_limits<float>::max();
+        for(int k = 0; k < 3; k++) {
+          const float t0
+            = (n.m_min[k] - packet.m_origin[k][i]) * invDirection[k][i];
+          const float t1
+            = (n.m_max[k] - packet.m_origin[k][i]) * invDirection[k][i];
+          tmin = std::max(tmin, std::min(t0, t1));
+          tmax = std::min(tmax, std::max(t0, t1));
         }
+        // boxes entirely behind the ray origin are missed
+        wasHit |= tmin <= tmax && tmax >= 0 && tmin <= packet.distance[i];
       }
       return wasHit;
     }
 
-    bool wasNodeHit(const Ray &r, Node *n) const {
-      float tmin = (n->m_minX - r.m_origin[0]) / r.m_direction[0];
-      float tmax = (n->m_maxX - r.m_origin[0]) / r.m_direction[0];
-
-      if(tmin > tmax)
-        std::swap(tmin, tmax);
-
-      float tymin = (n->m_minY - r.m_origin[1]) / r.m_direction[1];
-      float tymax = (n->m_maxY - r.m_origin[1]) / r.m_direction[1];
-
-      if(tymin > tymax)
-        std::swap(tymin, tymax);
-
-      if((tmin > tymax) || (tymin > tmax))
-        return false;
-
-      if(tymin > tmin)
-        tmin = tymin;
-
-      if(tymax < tmax)
-        tmax = tymax;
-
-      float tzmin = (n->m_minZ - r.m_origin[2]) / r.m_direction[2];
-      float tzmax = (n->m_maxZ - r.m_origin[2]) / r.m_direction[2];
-
-      if(tzmin > tzmax)
-        std::swap(tzmin, tzmax);
-
-      if((tmin > tzmax) || (tzmin > tmax))
-        return false;
-
-      if(tzmin > tmin)
-        tmin = tzmin;
-
-      if(tzmax < tmax)
-        tmax = tzmax;
-
-      return true;
+    template <int N>
+    inline void MollerTrumbore(RayPacket<N> &packet,
+                               const Triangle &triangle) const {
+      constexpr float kEpsilon = 1e-8;
+      const float *v0v1 = triangle.m_v0v1;
+      const float *v0v2 = triangle.m_v0v2;
+
+      for(int i = 0; i < N; i++) {
+        const float dir[3] = {packet.m_direction[0][i],
+                              packet.m_direction[1][i],
+                              packet.m_direction[2][i]};
+        const float pvec[3] = {dir[1] * v0v2[2] - dir[2] * v0v2[1],
+                               dir[2] * v0v2[0] - dir[0] * v0v2[2],
+                               dir[0] * v0v2[1] - dir[1] * v0v2[0]};
+        const float det
+          = v0v1[0] * pvec[0] + v0v1[1] * pvec[1] + v0v1[2] * pvec[2];
+        const float invDet = 1.0f / det;
+
+        const float tvec[3] = {packet.m_origin[0][i] - triangle.m_v0[0],
+                               packet.m_origin[1][i] - triangle.m_v0[1],
+                               packet.m_origin[2][i] - triangle.m_v0[2]};
+        const float u
+          = (tvec[0] * pvec[0] + tvec[1] * pvec[1] + tvec[2] * pvec[2])
+            * invDet;
+
+        const float qvec[3] = {tvec[1] * v0v1[2] - tvec[2] * v0v1[1],
+                               tvec[2] * v0v1[0] - tvec[0] * v0v1[2],
+                               tvec[0] * v0v1[1] - tvec[1] * v0v1[0]};
+        const float v
+          = (dir[0] * qvec[0] + dir[1] * qvec[1] + dir[2] * qvec[2]) * invDet;
+        const float t
+          = (v0v2[0] * qvec[0] + v0v2[1] * qvec[1] + v0v2[2] * qvec[2])
+            * invDet;
+
+        const bool wasHit
+          = !(det > -kEpsilon && det < kEpsilon) && !(u < 0.0 || u > 1.0)
+            && !(v < 0.0 || u + v > 1.0)
+            && (t < packet.distance[i]
+                || (t == packet.distance[i]
+                    && triangle.m_index < packet.triangleIndex[i]));
+        if(wasHit) {
+          packet.distance[i] = t;
+          packet.u[i] = u;
+          packet.v[i] = v;
+          packet.triangleIndex[i] = triangle.m_index;
+        }
+      }
     }
 
   private:
-    std::shared_ptr<Node> nodes;
-    float findCentroid(const float &v1, const float &v2, const float &v3) {
-      return (v1 + v2 + v3) / 3;
-    }
+    std::vector<Node> nodes{};
+    std::vector<Triangle> triangles{};
+    int nodeNumber{};
   };
 } // namespace ttk
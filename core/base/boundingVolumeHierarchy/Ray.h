@@ -23,4 +23,19 @@ namespace ttk {
     float u;
     float v;
   };
-} // namespace ttk
\ No newline at end of file
+
+  /// \brief Packet of coherent rays (e.g. adjacent camera pixels), stored as
+  /// a structure of arrays so that they can be traced together.
+  template <int N>
+  class RayPacket {
+  public:
+    static constexpr int size{N};
+    float m_origin[3][N];
+    float m_direction[3][N];
+    // closest hit, triangleIndex is -1 if the ray missed everything
+    float distance[N];
+    float u[N];
+    float v[N];
+    int triangleIndex[N];
+  };
+} // namespace ttk
@@ -6,6 +6,8 @@
 ///
 /// \brief Native renderer that uses a bounding volume hierarchy for accelerated
 /// raycasting.
+///
+/// Adjacent pixels of a row are traced together as a packet of coherent rays.
 
 #pragma once
 
@@ -50,9 +52,9 @@ int ttk::CinemaImagingNative::renderImage(
   unsigned int *primitiveIds,
   float *barycentricCoordinates,
   const size_t &ttkNotUsed(nVertices),
-  const float *vertexCoords,
+  const float *ttkNotUsed(vertexCoords),
   const size_t &ttkNotUsed(nTriangles),
-  const IT *connectivityList,
+  const IT *ttkNotUsed(connectivityList),
   const BoundingVolumeHierarchy<IT> &bvh,
   const double resolution[2],
   const double camPos[3],
@@ -116,105 +118,94 @@ int ttk::CinemaImagingNative::renderImage(
                                     - camUpTrue[2] * camHeightWorldHalf};
 
   float const nan = std::numeric_limits<float>::quiet_NaN();
-  if(orthographicProjection) {
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(this->threadNumber_)
-#endif
-    for(int y = 0; y < resY; y++) {
-      double const v = ((double)y) * pixelHeightWorld;
 
-      size_t pixelIndex = y * resX;
-      size_t bcIndex = 2 * pixelIndex;
+  // trace the rays of a row by packets of adjacent (coherent) pixels
+  using Packet = RayPacket<BoundingVolumeHierarchy<IT>::PacketSize>;
+  const auto renderRow = [&](const int y, const auto &getRay) {
+    const int packetSize = Packet::size;
+    Packet packet;
+    for(int x0 = 0; x0 < resX; x0 += packetSize) {
+      const int nRays = std::min(packetSize, resX - x0);
+      for(int i = 0; i < packetSize; i++) {
+        // pad the last packet of the row with copies of its last ray
+        float ray_origin[3], ray_dir[3];
+        getRay(y, x0 + std::min(i, nRays - 1), ray_origin, ray_dir);
+        for(int k = 0; k < 3; k++) {
+          packet.m_origin[k][i] = ray_origin[k];
+          packet.m_direction[k][i] = ray_dir[k];
+        }
+      }
+
+      bvh.intersect(packet);
 
-      for(int x = 0; x < resX; x++) {
-        double const u = ((double)x) * pixelWidthWorld;
-
-        depthBuffer[pixelIndex] = nan;
-        primitiveIds[pixelIndex] = CinemaImaging::INVALID_ID;
-        barycentricCoordinates[bcIndex] = nan;
-        barycentricCoordinates[bcIndex + 1] = nan;
-
-        // set origin
-        float const org_x
-          = camPosCorner[0] + u * camRight[0] + v * camUpTrue[0];
-        float const org_y
-          = camPosCorner[1] + u * camRight[1] + v * camUpTrue[1];
-        float const org_z
-          = camPosCorner[2] + u * camRight[2] + v * camUpTrue[2];
-
-        float ray_origin[3] = {org_x, org_y, org_z};
-
-        // set dir
-        float const dir_x = camDir[0];
-        float const dir_y = camDir[1];
-        float const dir_z = camDir[2];
-
-        float ray_dir[3] = {dir_x, dir_y, dir_z};
-
-        Ray ray(ray_dir, ray_origin);
-        bool wasHit = false;
-        int triIdx;
-        float distance;
-        wasHit = bvh.intersect(
-          ray, connectivityList, vertexCoords, &triIdx, &distance);
-        if(wasHit) {
-          depthBuffer[pixelIndex] = distance;
-          primitiveIds[pixelIndex] = triIdx;
-          barycentricCoordinates[bcIndex] = ray.u;
-          barycentricCoordinates[bcIndex + 1] = ray.v;
+      size_t pixelIndex = static_cast<size_t>(y) * resX + x0;
+      size_t bcIndex = 2 * pixelIndex;
+      for(int i = 0; i < nRays; i++) {
+        if(packet.triangleIndex[i] != -1) {
+          depthBuffer[pixelIndex] = packet.distance[i];
+          primitiveIds[pixelIndex] = packet.triangleIndex[i];
+          barycentricCoordinates[bcIndex] = packet.u[i];
+          barycentricCoordinates[bcIndex + 1] = packet.v[i];
+        } else {
+          depthBuffer[pixelIndex] = nan;
+          primitiveIds[pixelIndex] = CinemaImaging::INVALID_ID;
+          barycentricCoordinates[bcIndex] = nan;
+          barycentricCoordinates[bcIndex + 1] = nan;
         }
         pixelIndex++;
         bcIndex += 2;
       }
     }
+  };
+
+  if(orthographicProjection) {
+    const auto getRay = [&](const int y, const int x, float ray_origin[3],
+                            float ray_dir[3]) {
+      double const v = ((double)y) * pixelHeightWorld;
+      double const u = ((double)x) * pixelWidthWorld;
+
+      // set origin
+      ray_origin[0] = camPosCorner[0] + u * camRight[0] + v * camUpTrue[0];
+      ray_origin[1] = camPosCorner[1] + u * camRight[1] + v * camUpTrue[1];
+      ray_origin[2] = camPosCorner[2] + u * camRight[2] + v * camUpTrue[2];
+
+      // set dir
+      ray_dir[0] = camDir[0];
+      ray_dir[1] = camDir[1];
+      ray_dir[2] = camDir[2];
+    };
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(this->threadNumber_)
+#endif
+    for(int y = 0; y < resY; y++) {
+      renderRow(y, getRay);
+    }
   } else {
     double const factor
       = (viewAngle / 180.0 * 3.141592653589793) / resolution[0];
 
+    const auto getRay = [&](const int y, const int x, float ray_origin[3],
+                            float ray_dir[3]) {
+      double const v = (y - resY * 0.5) * factor;
+      double const u = (x - resX * 0.5) * factor;
+
+      // set origin
+      ray_origin[0] = camPos[0];
+      ray_origin[1] = camPos[1];
+      ray_origin[2] = camPos[2];
+
+      // set dir
+      ray_dir[0] = camDir[0] + u * camRight[0] + v * camUpTrue[0];
+      ray_dir[1] = camDir[1] + u * camRight[1] + v * camUpTrue[1];
+      ray_dir[2] = camDir[2] + u * camRight[2] + v * camUpTrue[2];
+    };
+
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp parallel for num_threads(this->threadNumber_)
 #endif
     for(int y = 0; y < resY; y++) {
-      double const v = (y - resY * 0.5) * factor;
-      size_t pixelIndex = y * resX;
-      size_t bcIndex = 2 * pixelIndex;
-
-      for(int x = 0; x < resX; x++) {
-        double const u = (x - resX * 0.5) * factor;
-
-        depthBuffer[pixelIndex] = nan;
-        primitiveIds[pixelIndex] = CinemaImaging::INVALID_ID;
-        barycentricCoordinates[bcIndex] = nan;
-        barycentricCoordinates[bcIndex + 1] = nan;
-
-        // set origin
-        float const org_x = camPos[0];
-        float const org_y = camPos[1];
-        float const org_z = camPos[2];
-
-        float ray_origin[3] = {org_x, org_y, org_z};
-        // set dir
-        float const dir_x = camDir[0] + u * camRight[0] + v * camUpTrue[0];
-        float const dir_y = camDir[1] + u * camRight[1] + v * camUpTrue[1];
-        float const dir_z = camDir[2] + u * camRight[2] + v * camUpTrue[2];
-
-        float ray_dir[3] = {dir_x, dir_y, dir_z};
-
-        Ray ray(ray_dir, ray_origin);
-        bool wasHit = false;
-        int triIdx;
-        float distance;
-        wasHit = bvh.intersect(
-          ray, connectivityList, vertexCoords, &triIdx, &distance);
-        if(wasHit) {
-          depthBuffer[pixelIndex] = distance;
-          primitiveIds[pixelIndex] = triIdx;
-          barycentricCoordinates[bcIndex] = ray.u;
-          barycentricCoordinates[bcIndex + 1] = ray.v;
-        }
-        pixelIndex++;
-        bcIndex += 2;
-      }
+      renderRow(y, getRay);
     }
   }
   this->printMsg("Rendering Image ("
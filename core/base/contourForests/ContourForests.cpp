@@ -5,6 +5,7 @@
  * date:                  Aout 2015
  */
 
+#include <algorithm>
 #include <iterator>
 #include <list>
 
@@ -39,14 +40,16 @@ ContourForests::~ContourForests() {
 
 idPartition ContourForests::vertex2partition(const SimplexId &v) {
   const SimplexId &position = scalars_->sosOffsets[v];
-  idPartition partition = 0;
-  while(partition < parallelParams_.nbInterfaces
-        && scalars_->sosOffsets[parallelData_.interfaces[partition].getSeed()]
-             <= position) {
-    ++partition;
-  }
-
-  return partition;
+  // interfaces are sorted by the position of their seed: the partition is
+  // the number of seeds below or at the vertex position
+  const auto begin = parallelData_.interfaces.cbegin();
+  const auto end = begin + parallelParams_.nbInterfaces;
+  const auto it = upper_bound(
+    begin, end, position, [&](const SimplexId &pos, const Interface &i) {
+      return pos < scalars_->sosOffsets[i.getSeed()];
+    });
+
+  return static_cast<idPartition>(distance(begin, it));
 }
 
 // }
@@ -96,6 +99,20 @@ void ContourForests::initNbPartitions() {
     parallelParams_.nbPartitions = parallelParams_.nbThreads;
   }
 
+  // avoid partitions too small to amortize their overlap and stitching
+  if(parallelParams_.minPartitionSize > 0) {
+    const SimplexId maxPartitions
+      = std::max(static_cast<SimplexId>(1),
+                 scalars_->size / parallelParams_.minPartitionSize);
+    if(maxPartitions < static_cast<SimplexId>(parallelParams_.nbPartitions)) {
+      this->printMsg("Reducing the number of partitions from "
+                     + std::to_string(parallelParams_.nbPartitions) + " to "
+                     + std::to_string(maxPartitions)
+                     + " (minimum partition size)");
+      parallelParams_.nbPartitions = static_cast<idPartition>(maxPartitions);
+    }
+  }
+
   parallelParams_.nbInterfaces = parallelParams_.nbPartitions - 1;
 }
 
@@ -111,8 +128,21 @@ void ContourForests::stitch() {
   if(params_->treeType == TreeType::Contour) {
     stitchTree(2);
   } else {
-    stitchTree(0);
-    stitchTree(1);
+    // join and split trees are stitched independently
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel sections num_threads(2) \
+  if(parallelParams_.nbThreads > 1)
+#endif
+    {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp section
+#endif
+      stitchTree(0);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp section
+#endif
+      stitchTree(1);
+    }
   }
 }
 
@@ -134,11 +164,41 @@ void ContourForests::stitchTree(const char treetype) {
 
   vector<bool> seenSeed(parallelParams_.nbInterfaces, false);
 
+  // Stitch nodes of the arcs whose down node is in the partition: their
+  // insertion only modifies the tree below the interface, so the partitions
+  // are processed in parallel. The serial pass below links the trees and
+  // inserts the other stitch nodes (including on the arcs it creates).
+  vector<vector<pair<idSuperArc, SimplexId>>> stitchVertices(
+    parallelParams_.nbInterfaces);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(parallelParams_.nbThreads) \
+  schedule(dynamic)
+#endif
+  for(idInterface i = 0; i < parallelParams_.nbInterfaces; i++) {
+    MergeTree *curTree = getTreePart(i);
+    const auto &seedPair
+      = make_pair(parallelData_.interfaces[i].getSeed(), false);
+
+    for(const auto &arc : curTree->treeData_.arcsCrossingAbove) {
+      SuperArc *crossing = curTree->getSuperArc(arc);
+      if(!crossing->isVisible()
+         || vertex2partition(
+              curTree->getNode(crossing->getDownNodeId())->getVertexId())
+              != i) {
+        continue;
+      }
+      stitchVertices[i].emplace_back(
+        arc, curTree->insertNodeAboveSeed(arc, seedPair));
+    }
+  }
+
   // For each partition, we stich with above
   for(idPartition i = 0; i < parallelParams_.nbPartitions - 1; i++) {
     MergeTree *curTree = getTreePart(i);
     const auto &seedPair
       = make_pair(parallelData_.interfaces[i].getSeed(), false);
+    auto nextStitch = stitchVertices[i].cbegin();
 
     if(DEBUG) {
       cout << "partition : " << static_cast<unsigned>(i);
@@ -148,21 +208,29 @@ void ContourForests::stitchTree(const char treetype) {
     // For each superarc crossing the upper boundary :
     for(const auto &arc : curTree->treeData_.arcsCrossingAbove) {
       SuperArc *crossing = curTree->getSuperArc(arc);
+      const bool inserted
+        = nextStitch != stitchVertices[i].cend() && nextStitch->first == arc;
 
       // Hidden arc, no need to stich (may have already been stitched)
-      if(!crossing->isVisible())
+      if(!crossing->isVisible()) {
+        nextStitch += inserted;
         continue;
+      }
 
       const idNode &downCrossingId = crossing->getDownNodeId();
 
       // the down node of the arc is not on this partition, It should have
       // already been processed
-      if(vertex2partition(curTree->getNode(downCrossingId)->getVertexId()) < i)
+      if(vertex2partition(curTree->getNode(downCrossingId)->getVertexId())
+         < i) {
+        nextStitch += inserted;
         continue;
+      }
 
       // Stitch vertex and insertion in current tree
-      const SimplexId &stitchVertex
-        = curTree->insertNodeAboveSeed(arc, seedPair);
+      const SimplexId stitchVertex
+        = inserted ? (nextStitch++)->second
+                   : curTree->insertNodeAboveSeed(arc, seedPair);
 
       // Opposite partition
       const idPartition &otherPartition = vertex2partition(stitchVertex);
@@ -107,6 +107,7 @@ namespace ttk {
       idPartition nbPartitions;
       int partitionNum;
       bool lessPartition;
+      SimplexId minPartitionSize;
     };
 
     struct ParallelData {
@@ -150,6 +151,13 @@ namespace ttk {
         parallelParams_.lessPartition = l;
       }
 
+      /// Minimum number of vertices per partition, 0 to disable. Reduces the
+      /// number of partitions on small inputs, where their overlap and
+      /// stitching are not amortized by the parallel tree construction.
+      inline void setMinPartitionSize(const SimplexId s) {
+        parallelParams_.minPartitionSize = s;
+      }
+
       // range of partitions, position of seeds , ...
 
       inline std::tuple<SimplexId, SimplexId>
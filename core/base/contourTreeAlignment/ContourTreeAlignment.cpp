@@ -397,40 +397,27 @@ bool ttk::ContourTreeAlignment::alignTree(
 
   // compute optimal alignment between current alignment and new tree
 
-  std::shared_ptr<ttk::cta::BinaryTree> t1, t2;
-
-  std::shared_ptr<ttk::cta::AlignmentTree> res = nullptr;
-  float resVal = FLT_MAX;
-
   const std::vector<std::shared_ptr<ttk::cta::AlignmentNode>> nodes1 = nodes;
   const std::vector<std::shared_ptr<ttk::cta::CTNode>> nodes2
     = ct->getGraph().first;
 
+  std::vector<CandidateRoots> candidates;
   for(const auto &node1 : nodes1) {
 
-    t1 = this->rootAtNode(node1);
+    const std::shared_ptr<ttk::cta::BinaryTree> t1 = this->rootAtNode(node1);
 
     for(const auto &node2 : nodes2) {
 
-      t2 = ct->rootAtNode(node2);
-
-      // compute matching
-
       if((node1->type == ttk::cta::maxNode && node2->type == ttk::cta::maxNode)
          || (node1->type == ttk::cta::minNode
              && node2->type == ttk::cta::minNode)) {
-
-        const std::pair<float, std::shared_ptr<ttk::cta::AlignmentTree>> match
-          = getAlignmentBinary(t1, t2);
-
-        if(match.first < resVal) {
-          resVal = match.first;
-          res = match.second;
-        }
+        candidates.emplace_back(t1, node2);
       }
     }
   }
 
+  const auto res = getBestAlignment(candidates, *ct).second;
+
   if(res)
     computeNewAlignmenttree(res);
   else {
@@ -452,37 +439,26 @@ bool ttk::ContourTreeAlignment::alignTree_consistentRoot(
 
   // compute optimal alignment between current alignment and new tree
 
-  std::shared_ptr<ttk::cta::BinaryTree> t1, t2;
-
-  std::shared_ptr<ttk::cta::AlignmentTree> res = nullptr;
-  float resVal = FLT_MAX;
-
   const std::vector<std::shared_ptr<ttk::cta::CTNode>> nodes2
     = ct->getGraph().first;
 
-  t1 = this->rootAtNode(alignmentRoot);
+  const std::shared_ptr<ttk::cta::BinaryTree> t1
+    = this->rootAtNode(alignmentRoot);
 
+  std::vector<CandidateRoots> candidates;
   for(const auto &node2 : nodes2) {
-
-    // compute matching
-
     if((alignmentRoot->type == ttk::cta::maxNode
         && node2->type == ttk::cta::maxNode)
        || (alignmentRoot->type == ttk::cta::minNode
            && node2->type == ttk::cta::minNode)) {
-
-      t2 = ct->rootAtNode(node2);
-
-      const std::pair<float, std::shared_ptr<ttk::cta::AlignmentTree>> match
-        = getAlignmentBinary(t1, t2);
-
-      if(match.first < resVal) {
-        resVal = match.first;
-        res = match.second;
-      }
+      candidates.emplace_back(t1, node2);
     }
   }
 
+  float resVal;
+  std::shared_ptr<ttk::cta::AlignmentTree> res;
+  std::tie(resVal, res) = getBestAlignment(candidates, *ct);
+
   if(res)
     computeNewAlignmenttree(res);
   else {
@@ -1016,6 +992,53 @@ std::shared_ptr<ttk::cta::BinaryTree>
 =====================================================================================================================
 */
 
+std::pair<float, std::shared_ptr<ttk::cta::AlignmentTree>>
+  ttk::ContourTreeAlignment::getBestAlignment(
+    const std::vector<CandidateRoots> &candidates, ContourTree &ct) {
+
+  float resVal = FLT_MAX;
+  std::shared_ptr<ttk::cta::AlignmentTree> res = nullptr;
+  size_t resIdx = candidates.size();
+
+  // the candidates are independent, each thread keeps its best alignment.
+  // No bound is passed to the recursion: it solves the subtrees before
+  // summing their costs, so a candidate only exceeds the best value once
+  // nearly all of its table is filled
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  {
+    float localVal = FLT_MAX;
+    std::shared_ptr<ttk::cta::AlignmentTree> localRes = nullptr;
+    size_t localIdx = candidates.size();
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp for schedule(dynamic) nowait
+#endif // TTK_ENABLE_OPENMP
+    for(size_t c = 0; c < candidates.size(); c++) {
+      const auto match = getAlignmentBinary(
+        candidates[c].first, ct.rootAtNode(candidates[c].second));
+      if(match.first < localVal) {
+        localVal = match.first;
+        localRes = match.second;
+        localIdx = c;
+      }
+    }
+
+    // same tie-breaking as a sequential traversal of the candidates
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp critical(ContourTreeAlignment_getBestAlignment)
+#endif // TTK_ENABLE_OPENMP
+    if(localVal < resVal || (localVal == resVal && localIdx < resIdx)) {
+      resVal = localVal;
+      res = localRes;
+      resIdx = localIdx;
+    }
+  }
+
+  return std::make_pair(resVal, res);
+}
+
 std::pair<float, std::shared_ptr<ttk::cta::AlignmentTree>>
   ttk::ContourTreeAlignment::getAlignmentBinary(
     const std::shared_ptr<ttk::cta::BinaryTree> &t1,
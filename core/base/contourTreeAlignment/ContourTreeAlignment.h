@@ -44,6 +44,7 @@
 #include <algorithm>
 #include <memory>
 #include <random>
+#include <tuple>
 
 namespace ttk {
 
@@ -350,6 +351,16 @@ namespace ttk {
     int alignmentRootIdx;
     float alignmentVal;
 
+    // a rooted alignment and a root of the new tree
+    using CandidateRoots = std::pair<std::shared_ptr<ttk::cta::BinaryTree>,
+                                     std::shared_ptr<ttk::cta::CTNode>>;
+
+    // aligns the candidates in parallel, returns the best alignment (the
+    // first one in case of ties)
+    std::pair<float, std::shared_ptr<ttk::cta::AlignmentTree>>
+      getBestAlignment(const std::vector<CandidateRoots> &candidates,
+                       ContourTree &ct);
+
     // functions for aligning two trees (computing the alignment value and
     // memoization matrix)
     float alignTreeBinary(const std::shared_ptr<ttk::cta::BinaryTree> &t1,
@@ -621,6 +632,20 @@ int ttk::ContourTreeAlignment::execute(
                      debug::Priority::DETAIL);
 
       i++;
+
+      // the alignment value only grows with the aligned trees: this root
+      // cannot beat the best one anymore
+      if(alignmentVal >= bestAlignmentValue
+         && i < contourtreesToAlign.size()) {
+        this->printMsg("Alignment value above the best one ("
+                         + std::to_string(alignmentVal)
+                         + "), alignment aborted.");
+        break;
+      }
+    }
+
+    if(i < contourtreesToAlign.size()) {
+      continue;
     }
 
     this->printMsg("All trees aligned. Total alignment value: "
@@ -3,6 +3,7 @@
 #include <Geometry.h>
 #include <Triangulation.h>
 
+#include <algorithm>
 #include <array>
 #include <functional>
 #include <limits>
@@ -112,5 +113,357 @@ namespace ttk {
       return 0;
     }
 
+    /**
+     * @brief Mean length of the triangulation edges, default bucket width of
+     * the Delta-stepping shortest paths
+     *
+     * @param[in] triangulation Access to neighbor vertices
+     * @param[in] threadNumber Number of threads
+     *
+     * @return Mean edge length (1 if the triangulation has no edge)
+     */
+    template <typename T,
+              typename triangulationType = ttk::AbstractTriangulation>
+    T meanEdgeLength(const triangulationType &triangulation,
+                     const int threadNumber = 1) {
+
+      const SimplexId vertexNumber = triangulation.getNumberOfVertices();
+      double sum{};
+      size_t count{};
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber) reduction(+ : sum, count)
+#else
+      TTK_FORCE_USE(threadNumber);
+#endif // TTK_ENABLE_OPENMP
+      for(SimplexId i = 0; i < vertexNumber; ++i) {
+        std::array<float, 3> iCoords{};
+        triangulation.getVertexPoint(i, iCoords[0], iCoords[1], iCoords[2]);
+        const auto nneigh = triangulation.getVertexNeighborNumber(i);
+        for(SimplexId j = 0; j < nneigh; ++j) {
+          SimplexId neigh{};
+          triangulation.getVertexNeighbor(i, j, neigh);
+          if(neigh > i) {
+            std::array<float, 3> nCoords{};
+            triangulation.getVertexPoint(
+              neigh, nCoords[0], nCoords[1], nCoords[2]);
+            sum += Geometry::distance(iCoords.data(), nCoords.data());
+            count++;
+          }
+        }
+      }
+
+      const T mean = count > 0 ? T(sum / count) : T(0.0F);
+      return mean > T(0.0F) ? mean : T(1.0F);
+    }
+
+    /**
+     * @brief Buffers of the Delta-stepping shortest paths
+     *
+     * Keep one instance per calling thread and reuse it across queries: the
+     * distance vector and the buckets are only allocated once, and only the
+     * vertices reached by the previous query are reset.
+     */
+    template <typename T>
+    struct DeltaSteppingWorkspace {
+      /** Distances to the closest source (infinity if not reached) */
+      std::vector<T> dists{};
+      /** Index of the closest source (-1 if not reached) */
+      std::vector<SimplexId> closest{};
+
+      struct Relaxation {
+        T dist;
+        SimplexId vertex;
+        SimplexId source;
+      };
+
+      // buckets[owner][bucket], may hold stale entries
+      std::vector<std::vector<std::vector<SimplexId>>> buckets{};
+      // vertices of the current bucket to relax, per owner
+      std::vector<std::vector<SimplexId>> frontier{};
+      // relaxation requests, [producer][owner]
+      std::vector<std::vector<std::vector<Relaxation>>> requests{};
+      // reached vertices, per owner
+      std::vector<std::vector<SimplexId>> reached{};
+      // last round a vertex entered the frontier, avoids duplicates
+      std::vector<size_t> lastRound{};
+      size_t round{};
+    };
+
+    /**
+     * @brief Compute the shortest paths from a set of sources with parallel
+     * Delta-stepping, labelling every vertex with its closest source
+     *
+     * Vertices are grouped in buckets of width @p delta and each bucket is
+     * relaxed in bulk until it stays empty. Relaxations are routed to the
+     * thread owning their target vertex, so no atomics are needed. Ties are
+     * broken towards the lowest source index, which makes the result
+     * independent from the thread scheduling.
+     *
+     * U. Meyer, P. Sanders, "Delta-stepping: a parallelizable shortest path
+     * algorithm", Journal of Algorithms, 2003.
+     *
+     * @param[in] sources Source vertices
+     * @param[in] triangulation Access to neighbor vertices
+     * @param[in,out] workspace Buffers, holding the distances and the closest
+     * source indices on return
+     * @param[in] targets Stop as soon as these vertices are settled (other
+     * vertices may then hold upper bounds of their distance)
+     * @param[in] delta Bucket width, the mean edge length if not positive
+     * (computed at each call, pass it for repeated bounded queries)
+     * @param[in] threadNumber Number of threads
+     * @param[in] mask Vector masking the triangulation
+     *
+     * @return 0 in case of success
+     */
+    template <typename T,
+              typename triangulationType = ttk::AbstractTriangulation>
+    int shortestPathDeltaStepping(
+      const std::vector<SimplexId> &sources,
+      const triangulationType &triangulation,
+      DeltaSteppingWorkspace<T> &workspace,
+      const std::vector<SimplexId> &targets = std::vector<SimplexId>(),
+      T delta = T(0.0F),
+      const int threadNumber = 1,
+      const std::vector<bool> &mask = std::vector<bool>()) {
+
+      const SimplexId vertexNumber = triangulation.getNumberOfVertices();
+#ifdef TTK_ENABLE_OPENMP
+      const int nThreads = std::max(threadNumber, 1);
+#else
+      const int nThreads = 1;
+#endif // TTK_ENABLE_OPENMP
+      const bool isMask = !mask.empty();
+
+      if(isMask && mask.size() != static_cast<size_t>(vertexNumber)) {
+        return 1;
+      }
+      const auto isVertex = [vertexNumber](const SimplexId v) {
+        return v >= 0 && v < vertexNumber;
+      };
+      if(!std::all_of(sources.begin(), sources.end(), isVertex)
+         || !std::all_of(targets.begin(), targets.end(), isVertex)) {
+        return 1;
+      }
+
+      auto &dists = workspace.dists;
+      auto &closest = workspace.closest;
+      auto &buckets = workspace.buckets;
+      auto &frontier = workspace.frontier;
+      auto &requests = workspace.requests;
+      auto &reached = workspace.reached;
+      auto &lastRound = workspace.lastRound;
+      auto &round = workspace.round;
+
+      // reset the workspace
+      if(dists.size() != static_cast<size_t>(vertexNumber)
+         || reached.size() != static_cast<size_t>(nThreads)) {
+        dists.assign(vertexNumber, std::numeric_limits<T>::infinity());
+        closest.assign(vertexNumber, -1);
+        lastRound.assign(vertexNumber, 0);
+        round = 0;
+        buckets.assign(nThreads, {});
+        frontier.assign(nThreads, {});
+        reached.assign(nThreads, {});
+        requests.resize(nThreads);
+        for(auto &r : requests) {
+          r.resize(nThreads);
+        }
+      }
+      for(int t = 0; t < nThreads; ++t) {
+        for(const auto v : reached[t]) {
+          dists[v] = std::numeric_limits<T>::infinity();
+          closest[v] = -1;
+        }
+        reached[t].clear();
+        for(auto &b : buckets[t]) {
+          b.clear();
+        }
+      }
+
+      if(sources.empty()) {
+        return 0;
+      }
+
+      if(!(delta > T(0.0F))) {
+        delta = meanEdgeLength<T>(triangulation, nThreads);
+      }
+
+      const auto edgeLength = [&triangulation](
+                                const SimplexId a, const SimplexId b) {
+        std::array<float, 3> aCoords{}, bCoords{};
+        triangulation.getVertexPoint(a, aCoords[0], aCoords[1], aCoords[2]);
+        triangulation.getVertexPoint(b, bCoords[0], bCoords[1], bCoords[2]);
+        return T(Geometry::distance(aCoords.data(), bCoords.data()));
+      };
+      const auto bucketOf
+        = [delta](const T dist) { return static_cast<size_t>(dist / delta); };
+      const auto ownerOf
+        = [nThreads](const SimplexId v) { return v % nThreads; };
+      // every vertex with a distance below the current bucket is settled
+      const auto targetsSettled = [&](const size_t bucket) {
+        return std::all_of(
+          targets.begin(), targets.end(), [&](const SimplexId v) {
+            return closest[v] != -1 && bucketOf(dists[v]) < bucket;
+          });
+      };
+
+      for(size_t i = 0; i < sources.size(); ++i) {
+        const auto s = sources[i];
+        if(closest[s] == -1) {
+          const auto t = ownerOf(s);
+          dists[s] = T(0.0F);
+          closest[s] = i;
+          reached[t].emplace_back(s);
+          if(buckets[t].empty()) {
+            buckets[t].resize(1);
+          }
+          buckets[t][0].emplace_back(s);
+        }
+      }
+
+      size_t current{};
+
+      while(true) {
+        // next non-empty bucket
+        size_t next = std::numeric_limits<size_t>::max();
+        for(const auto &ownBuckets : buckets) {
+          for(size_t b = current; b < ownBuckets.size() && b < next; ++b) {
+            if(!ownBuckets[b].empty()) {
+              next = b;
+              break;
+            }
+          }
+        }
+        if(next == std::numeric_limits<size_t>::max()) {
+          break;
+        }
+        if(!targets.empty() && targetsSettled(next)) {
+          break;
+        }
+        current = next;
+        round++;
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(static, 1)
+#endif // TTK_ENABLE_OPENMP
+        for(int t = 0; t < nThreads; ++t) {
+          frontier[t].clear();
+          if(current < buckets[t].size()) {
+            for(const auto v : buckets[t][current]) {
+              if(bucketOf(dists[v]) == current && lastRound[v] != round) {
+                lastRound[v] = round;
+                frontier[t].emplace_back(v);
+              }
+            }
+            buckets[t][current].clear();
+          }
+        }
+
+        while(std::any_of(frontier.begin(), frontier.end(),
+                          [](const std::vector<SimplexId> &f) {
+                            return !f.empty();
+                          })) {
+
+          // generate requests (labels are read-only in this phase)
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(static, 1)
+#endif // TTK_ENABLE_OPENMP
+          for(int t = 0; t < nThreads; ++t) {
+            for(auto &r : requests[t]) {
+              r.clear();
+            }
+            for(const auto vert : frontier[t]) {
+              const auto nneigh = triangulation.getVertexNeighborNumber(vert);
+              for(SimplexId i = 0; i < nneigh; ++i) {
+                SimplexId neigh{};
+                triangulation.getVertexNeighbor(vert, i, neigh);
+                if(isMask && !mask[neigh]) {
+                  continue;
+                }
+                const T dist = dists[vert] + edgeLength(vert, neigh);
+                const auto source = closest[vert];
+                if(dist < dists[neigh]
+                   || (dist == dists[neigh] && source < closest[neigh])) {
+                  requests[t][ownerOf(neigh)].push_back({dist, neigh, source});
+                }
+              }
+            }
+          }
+
+          round++;
+
+          // apply requests, each thread updates the vertices it owns
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(static, 1)
+#endif // TTK_ENABLE_OPENMP
+          for(int t = 0; t < nThreads; ++t) {
+            frontier[t].clear();
+            for(int p = 0; p < nThreads; ++p) {
+              for(const auto &r : requests[p][t]) {
+                const auto v = r.vertex;
+                if(r.dist < dists[v]
+                   || (r.dist == dists[v] && r.source < closest[v])) {
+                  if(closest[v] == -1) {
+                    reached[t].emplace_back(v);
+                  }
+                  dists[v] = r.dist;
+                  closest[v] = r.source;
+                  const auto b = bucketOf(r.dist);
+                  if(b <= current) {
+                    if(lastRound[v] != round) {
+                      lastRound[v] = round;
+                      frontier[t].emplace_back(v);
+                    }
+                  } else {
+                    if(buckets[t].size() <= b) {
+                      buckets[t].resize(b + 1);
+                    }
+                    buckets[t][b].emplace_back(v);
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+
+      return 0;
+    }
+
+    /**
+     * @brief Compute the shortest paths from a set of sources in a single
+     * wavefront, labelling every vertex with its closest source
+     *
+     * @param[in] sources Source vertices
+     * @param[in] triangulation Access to neighbor vertices
+     * @param[out] outputDists Distances to the closest source for every mesh
+     * vertex (infinity if unreachable)
+     * @param[out] outputSources Index in @p sources of the closest source for
+     * every mesh vertex (-1 if unreachable)
+     * @param[in] threadNumber Number of threads
+     * @param[in] delta Bucket width, the mean edge length if not positive
+     *
+     * @return 0 in case of success
+     *
+     * @sa shortestPathDeltaStepping
+     */
+    template <typename T,
+              typename triangulationType = ttk::AbstractTriangulation>
+    int shortestPathMultiSource(const std::vector<SimplexId> &sources,
+                                const triangulationType &triangulation,
+                                std::vector<T> &outputDists,
+                                std::vector<SimplexId> &outputSources,
+                                const int threadNumber = 1,
+                                const T delta = T(0.0F)) {
+
+      DeltaSteppingWorkspace<T> workspace{};
+      const int ret = shortestPathDeltaStepping(
+        sources, triangulation, workspace, {}, delta, threadNumber);
+      outputDists = std::move(workspace.dists);
+      outputSources = std::move(workspace.closest);
+      return ret;
+    }
+
   } // namespace Dijkstra
 } // namespace ttk
@@ -49,10 +49,6 @@ int DimensionReduction::execute(
   const int nColumns,
   int *insertionTimeForTopomap) const {
 
-#ifndef TTK_ENABLE_SCIKIT_LEARN
-  TTK_FORCE_USE(nColumns);
-#endif
-
   Timer t;
 
   if(this->Method == METHOD::TOPOMAP) {
@@ -77,6 +73,43 @@ int DimensionReduction::execute(
     return 0;
   }
 
+#ifdef TTK_ENABLE_SCIKIT_LEARN
+  const bool useNativeBackend = this->UseNativeBackend;
+  if(useNativeBackend && !this->hasNativeBackend()
+     && (this->Method == METHOD::PCA || this->Method == METHOD::MDS)) {
+    this->printWrn("TTK has been built without Eigen.");
+    this->printWrn("Using the scikit-learn backend.");
+  }
+#else
+  const bool useNativeBackend = true;
+#endif // TTK_ENABLE_SCIKIT_LEARN
+
+  if(useNativeBackend && this->hasNativeBackend()) {
+    const int nComponents = std::max(2, this->NumberOfComponents);
+    int status{};
+    std::string methodName{};
+    if(this->Method == METHOD::PCA) {
+      methodName = "PCA";
+      status = this->computeNativePCA(
+        outputEmbedding, inputMatrix, nRows, nColumns, nComponents);
+    } else if(this->Method == METHOD::MDS) {
+      methodName = "MDS";
+      status = this->computeNativeMDS(
+        outputEmbedding, inputMatrix, nRows, nColumns, nComponents);
+    } else {
+      methodName = "t-SNE";
+      status = this->computeNativeTSNE(
+        outputEmbedding, inputMatrix, nRows, nColumns, nComponents);
+    }
+    if(status != 0) {
+      return status;
+    }
+
+    this->printMsg("Computed " + methodName + " (native)", 1.0,
+                   t.getElapsedTime(), this->threadNumber_);
+    return 0;
+  }
+
 #ifdef TTK_ENABLE_SCIKIT_LEARN
 #ifndef TTK_ENABLE_KAMIKAZE
   if(majorVersion_ < '3')
@@ -11,6 +11,13 @@
 /// \brief TTK VTK-filter that takes a matrix (vtkTable) as input and apply a
 /// dimension reduction algorithm from scikit-learn.
 ///
+/// PCA, MDS and t-SNE also have native backends (see setUseNativeBackend()),
+/// used by default when TTK has been built without scikit-learn: a
+/// randomized SVD (Halko et al.) for PCA, classical or landmark MDS (de Silva
+/// and Tenenbaum) and Barnes-Hut t-SNE (van der Maaten). Note that the
+/// scikit-learn MDS minimizes the stress (SMACOF) instead. The native PCA and
+/// MDS require Eigen, otherwise the Python backend is used.
+///
 /// \sa ttk::Triangulation
 /// \sa ttkDimensionReduction.cpp %for a usage example.
 ///
@@ -126,6 +133,14 @@ namespace ttk {
       }
     }
 
+    /**
+     * Number of landmarks of the native MDS backend, 0 for classical MDS on
+     * all the points.
+     */
+    inline void setMDSNumberOfLandmarks(const int NumberOfLandmarks) {
+      mds_NumberOfLandmarks = NumberOfLandmarks;
+    }
+
     inline void setTSNEParameters(const float Perplexity,
                                   const float Exaggeration,
                                   const float LearningRate,
@@ -195,7 +210,7 @@ namespace ttk {
       this->Method = method;
 
 #ifndef TTK_ENABLE_SCIKIT_LEARN
-      if(this->Method != METHOD::TOPOMAP) {
+      if(this->Method != METHOD::TOPOMAP && !this->hasNativeBackend()) {
         this->printWrn("TTK has been built without scikit-learn.");
         this->printWrn("Defaulting to the `TopoMap` backend.");
         this->Method = METHOD::TOPOMAP;
@@ -229,6 +244,15 @@ namespace ttk {
       this->printMsg("Using backend `" + methodName + "`");
     }
 
+    /**
+     * Run PCA, MDS and t-SNE natively instead of through the Python
+     * interpreter (always the case without scikit-learn). PCA and MDS fall
+     * back to Python when TTK has been built without Eigen.
+     */
+    inline void setUseNativeBackend(const bool useNativeBackend) {
+      this->UseNativeBackend = useNativeBackend;
+    }
+
     inline void setInputNumberOfComponents(const int numberOfComponents) {
       this->NumberOfComponents = numberOfComponents;
     }
@@ -263,6 +287,30 @@ namespace ttk {
                 int *insertionTimeForTopoMap = nullptr) const;
 
   protected:
+    /**
+     * Whether the current method can run natively: t-SNE always, PCA and
+     * MDS only when TTK has been built with Eigen.
+     */
+    bool hasNativeBackend() const;
+
+    int computeNativePCA(std::vector<std::vector<double>> &outputEmbedding,
+                         const std::vector<double> &inputMatrix,
+                         const int nRows,
+                         const int nColumns,
+                         const int nComponents) const;
+
+    int computeNativeMDS(std::vector<std::vector<double>> &outputEmbedding,
+                         const std::vector<double> &inputMatrix,
+                         const int nRows,
+                         const int nColumns,
+                         const int nComponents) const;
+
+    int computeNativeTSNE(std::vector<std::vector<double>> &outputEmbedding,
+                          const std::vector<double> &inputMatrix,
+                          const int nRows,
+                          const int nColumns,
+                          const int nComponents) const;
+
     // se
     std::string se_Affinity{"nearest_neighbors"};
     float se_Gamma{1};
@@ -285,6 +333,7 @@ namespace ttk {
     int mds_Verbose{0};
     float mds_Epsilon{0};
     std::string mds_Dissimilarity{"euclidean"};
+    int mds_NumberOfLandmarks{0};
 
     // tsne
     float tsne_Perplexity{30};
@@ -329,6 +378,7 @@ namespace ttk {
     int NumberOfComponents{2};
     int NumberOfNeighbors{5};
     int IsDeterministic{true};
+    bool UseNativeBackend{false};
     char majorVersion_{'0'};
     bool IsInputADistanceMatrix{false};
   };
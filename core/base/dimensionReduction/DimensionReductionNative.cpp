@@ -0,0 +1,841 @@
+#include <DimensionReduction.h>
+#include <RadiusSearchTree.h>
+
+#ifdef TTK_ENABLE_EIGEN
+// GCC reports the vectors the AVX-512 intrinsics leave undefined on purpose
+// as maybe uninitialized once inlined in the Eigen kernels
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#include <Eigen/Dense>
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif // TTK_ENABLE_EIGEN
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <random>
+
+using namespace ttk;
+
+namespace {
+
+#ifdef TTK_ENABLE_EIGEN
+
+  using RowMatrix
+    = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+  /**
+   * k leading singular triplets of m, either exact or with the randomized
+   * range finder (10 oversamples, power iterations) of
+   *
+   * "Finding Structure with Randomness: Probabilistic Algorithms for
+   * Constructing Approximate Matrix Decompositions" \n
+   * N. Halko, P. G. Martinsson, J. A. Tropp \n
+   * SIAM Review, 2011.
+   */
+  void computeLeadingSVD(const Eigen::MatrixXd &m,
+                         const Eigen::Index k,
+                         const bool exact,
+                         const int nIter,
+                         std::mt19937 &rng,
+                         Eigen::MatrixXd &u,
+                         Eigen::VectorXd &s,
+                         Eigen::MatrixXd &v) {
+
+    const auto minDim = std::min(m.rows(), m.cols());
+    const auto l = std::min<Eigen::Index>(k + 10, minDim);
+
+    if(exact || l == minDim) {
+      const Eigen::BDCSVD<Eigen::MatrixXd> svd(
+        m, Eigen::ComputeThinU | Eigen::ComputeThinV);
+      u = svd.matrixU().leftCols(k);
+      s = svd.singularValues().head(k);
+      v = svd.matrixV().leftCols(k);
+      return;
+    }
+
+    const auto orthonormalize = [](const Eigen::MatrixXd &a) {
+      const Eigen::HouseholderQR<Eigen::MatrixXd> qr(a);
+      return Eigen::MatrixXd{qr.householderQ()
+                             * Eigen::MatrixXd::Identity(a.rows(), a.cols())};
+    };
+
+    std::normal_distribution<double> normal{};
+    Eigen::MatrixXd omega(m.cols(), l);
+    for(Eigen::Index i = 0; i < omega.size(); ++i) {
+      omega.data()[i] = normal(rng);
+    }
+
+    Eigen::MatrixXd q = orthonormalize(m * omega);
+    for(int i = 0; i < nIter; ++i) {
+      q = orthonormalize(m.transpose() * q);
+      q = orthonormalize(m * q);
+    }
+
+    const Eigen::BDCSVD<Eigen::MatrixXd> svd(
+      q.transpose() * m, Eigen::ComputeThinU | Eigen::ComputeThinV);
+    u = q * svd.matrixU().leftCols(k);
+    s = svd.singularValues().head(k);
+    v = svd.matrixV().leftCols(k);
+  }
+
+  // deterministic signs: the largest entry of every column of v is positive
+  void flipSigns(Eigen::MatrixXd &u, Eigen::MatrixXd &v) {
+    for(Eigen::Index j = 0; j < v.cols(); ++j) {
+      Eigen::Index i{};
+      v.col(j).cwiseAbs().maxCoeff(&i);
+      if(v(i, j) < 0) {
+        u.col(j) *= -1;
+        v.col(j) *= -1;
+      }
+    }
+  }
+
+  /**
+   * Principal components of the rows of data, padded with zeros when
+   * there are less than k of them.
+   */
+  void computePCA(const std::vector<double> &data,
+                  const int nRows,
+                  const int nColumns,
+                  const int k,
+                  const bool whiten,
+                  const std::string &solver,
+                  const std::string &iteratedPower,
+                  std::mt19937 &rng,
+                  Eigen::MatrixXd &embedding) {
+
+    Eigen::MatrixXd x
+      = Eigen::Map<const RowMatrix>(data.data(), nRows, nColumns);
+    x.rowwise() -= x.colwise().mean();
+
+    const int minDim = std::min(nRows, nColumns);
+    const int kk = std::min(k, minDim);
+
+    // same solver selection as scikit-learn
+    bool exact = solver == "full";
+    if(solver != "full" && solver != "randomized") {
+      exact = std::max(nRows, nColumns) <= 500 || kk >= 0.8 * minDim;
+    }
+    const int nIter = iteratedPower == "auto" ? (kk < 0.1 * minDim ? 7 : 4)
+                                              : std::stoi(iteratedPower);
+
+    Eigen::MatrixXd u{}, v{};
+    Eigen::VectorXd s{};
+    computeLeadingSVD(x, kk, exact, nIter, rng, u, s, v);
+    flipSigns(u, v);
+
+    embedding = Eigen::MatrixXd::Zero(nRows, k);
+    if(whiten) {
+      embedding.leftCols(kk) = u * std::sqrt(std::max(nRows - 1, 1));
+    } else {
+      embedding.leftCols(kk) = u * s.asDiagonal();
+    }
+  }
+
+  /**
+   * Classical scaling of a matrix of squared distances: coordinates of the
+   * k leading (non-negative) eigenvalues of the double centered matrix,
+   * and the scaled eigenvectors used to place other points.
+   */
+  void computeClassicalScaling(const Eigen::MatrixXd &sqDistances,
+                               const int k,
+                               std::mt19937 &rng,
+                               Eigen::MatrixXd &coords,
+                               Eigen::MatrixXd &pseudoInverse) {
+
+    const auto n = sqDistances.rows();
+    const Eigen::VectorXd means = sqDistances.rowwise().mean();
+    const double mean = means.mean();
+    Eigen::MatrixXd b = sqDistances;
+    b.rowwise() -= means.transpose();
+    b.colwise() -= means;
+    b.array() += mean;
+    b *= -0.5;
+
+    const auto kk = std::min<Eigen::Index>(k, n);
+    Eigen::MatrixXd u{}, v{};
+    Eigen::VectorXd s{};
+    computeLeadingSVD(b, kk, n <= 500, 7, rng, u, s, v);
+    flipSigns(u, v);
+
+    coords = Eigen::MatrixXd::Zero(n, k);
+    pseudoInverse = Eigen::MatrixXd::Zero(k, n);
+    for(Eigen::Index j = 0; j < kk; ++j) {
+      // singular values of negative eigenvalues are discarded
+      const double lambda = u.col(j).dot(b * u.col(j));
+      if(lambda > 0) {
+        coords.col(j) = u.col(j) * std::sqrt(lambda);
+        pseudoInverse.row(j) = u.col(j).transpose() / std::sqrt(lambda);
+      }
+    }
+  }
+
+#endif // TTK_ENABLE_EIGEN
+
+  /**
+   * Barnes-Hut space partitioning tree (quadtree in 2D, octree in 3D) over
+   * an embedding, whose cells store their center of mass.
+   */
+  class SpaceTree {
+  public:
+    SpaceTree(const std::vector<double> &y, const size_t n, const int dim)
+      : y_{y}, dim_{dim}, ids_(n) {
+      std::iota(ids_.begin(), ids_.end(), 0);
+      std::array<double, 3> lo{}, hi{};
+      for(int c = 0; c < dim_; ++c) {
+        lo[c] = std::numeric_limits<double>::infinity();
+        hi[c] = -lo[c];
+      }
+      for(size_t i = 0; i < n; ++i) {
+        for(int c = 0; c < dim_; ++c) {
+          lo[c] = std::min(lo[c], y_[i * dim_ + c]);
+          hi[c] = std::max(hi[c], y_[i * dim_ + c]);
+        }
+      }
+      std::array<double, 3> center{};
+      double width{};
+      for(int c = 0; c < dim_; ++c) {
+        center[c] = (lo[c] + hi[c]) / 2;
+        width = std::max(width, hi[c] - lo[c]);
+      }
+      nodes_.emplace_back();
+      this->build(0, 0, n, center, width, 0);
+    }
+
+    /**
+     * Repulsive force (to be normalized) on the point i, adds its terms of
+     * the normalization to sumW.
+     */
+    void computeRepulsion(const size_t i,
+                          const double theta2,
+                          const double alpha,
+                          double *const force,
+                          double &sumW) const {
+      const double *const yi = &y_[i * dim_];
+      std::vector<size_t> stack{0};
+      while(!stack.empty()) {
+        const auto &node = nodes_[stack.back()];
+        stack.pop_back();
+        if(node.count == 0) {
+          continue;
+        }
+        if(node.firstChild == 0) {
+          for(size_t k = node.begin; k < node.end; ++k) {
+            if(ids_[k] != i) {
+              this->addTerm(yi, &y_[ids_[k] * dim_], 1, alpha, force, sumW);
+            }
+          }
+          continue;
+        }
+        double d2{};
+        for(int c = 0; c < dim_; ++c) {
+          d2 += (yi[c] - node.com[c]) * (yi[c] - node.com[c]);
+        }
+        if(node.width * node.width < theta2 * d2) {
+          this->addTerm(yi, node.com.data(), node.count, alpha, force, sumW);
+        } else {
+          for(size_t c = 0; c < (size_t{1} << dim_); ++c) {
+            stack.emplace_back(node.firstChild + c);
+          }
+        }
+      }
+    }
+
+  private:
+    // Student-t kernel of alpha degrees of freedom
+    inline void addTerm(const double *const yi,
+                        const double *const yj,
+                        const double weight,
+                        const double alpha,
+                        double *const force,
+                        double &sumW) const {
+      std::array<double, 3> diff{};
+      double d2{};
+      for(int c = 0; c < dim_; ++c) {
+        diff[c] = yi[c] - yj[c];
+        d2 += diff[c] * diff[c];
+      }
+      const double t = 1.0 + d2 / alpha;
+      const double w = alpha == 1.0 ? 1.0 / t : std::pow(t, -(alpha + 1) / 2);
+      sumW += weight * w;
+      for(int c = 0; c < dim_; ++c) {
+        force[c] += weight * w / t * diff[c];
+      }
+    }
+
+    struct Node {
+      std::array<double, 3> com{};
+      double width{};
+      size_t count{};
+      // the children are contiguous, 0 for leaves
+      size_t firstChild{};
+      // points of leaves
+      size_t begin{}, end{};
+    };
+
+    void build(const size_t id,
+               const size_t begin,
+               const size_t end,
+               const std::array<double, 3> &center,
+               const double width,
+               const int depth) {
+      auto &node = nodes_[id];
+      node.count = end - begin;
+      node.width = width;
+      node.begin = begin;
+      node.end = end;
+      for(size_t k = begin; k < end; ++k) {
+        for(int c = 0; c < dim_; ++c) {
+          node.com[c] += y_[ids_[k] * dim_ + c] / node.count;
+        }
+      }
+      // duplicated points stay in the same leaf
+      if(node.count <= 1 || depth >= 32) {
+        return;
+      }
+
+      const size_t nChildren = size_t{1} << dim_;
+      const auto childOf = [&](const size_t p) {
+        size_t child{};
+        for(int c = 0; c < dim_; ++c) {
+          if(y_[p * dim_ + c] > center[c]) {
+            child |= size_t{1} << c;
+          }
+        }
+        return child;
+      };
+      std::vector<size_t> starts(nChildren + 1, 0);
+      for(size_t k = begin; k < end; ++k) {
+        starts[childOf(ids_[k]) + 1]++;
+      }
+      std::partial_sum(starts.begin(), starts.end(), starts.begin());
+      std::vector<size_t> sorted(end - begin);
+      auto next{starts};
+      for(size_t k = begin; k < end; ++k) {
+        sorted[next[childOf(ids_[k])]++] = ids_[k];
+      }
+      std::copy(sorted.begin(), sorted.end(), ids_.begin() + begin);
+
+      const size_t first = nodes_.size();
+      nodes_[id].firstChild = first;
+      nodes_.resize(first + nChildren);
+      for(size_t child = 0; child < nChildren; ++child) {
+        std::array<double, 3> childCenter{center};
+        for(int c = 0; c < dim_; ++c) {
+          childCenter[c] += (child >> c & 1 ? 0.25 : -0.25) * width;
+        }
+        this->build(first + child, begin + starts[child],
+                    begin + starts[child + 1], childCenter, width / 2,
+                    depth + 1);
+      }
+    }
+
+    const std::vector<double> &y_;
+    const int dim_;
+    std::vector<size_t> ids_;
+    std::vector<Node> nodes_{};
+  };
+
+} // namespace
+
+bool DimensionReduction::hasNativeBackend() const {
+#ifdef TTK_ENABLE_EIGEN
+  if(this->Method == METHOD::MDS || this->Method == METHOD::PCA) {
+    return true;
+  }
+#endif // TTK_ENABLE_EIGEN
+  return this->Method == METHOD::T_SNE;
+}
+
+int DimensionReduction::computeNativePCA(
+  std::vector<std::vector<double>> &outputEmbedding,
+  const std::vector<double> &inputMatrix,
+  const int nRows,
+  const int nColumns,
+  const int nComponents) const {
+
+#ifdef TTK_ENABLE_EIGEN
+  Eigen::setNbThreads(this->threadNumber_);
+
+  std::mt19937 rng{this->IsDeterministic ? 0 : std::random_device{}()};
+  Eigen::MatrixXd embedding{};
+  computePCA(inputMatrix, nRows, nColumns, nComponents, this->pca_Whiten,
+             this->pca_SVDSolver, this->pca_MaxIteration, rng, embedding);
+
+  outputEmbedding.resize(nComponents);
+  for(int i = 0; i < nComponents; ++i) {
+    outputEmbedding[i].resize(nRows);
+    Eigen::VectorXd::Map(outputEmbedding[i].data(), nRows)
+      = embedding.col(i);
+  }
+  return 0;
+#else
+  TTK_FORCE_USE(outputEmbedding);
+  TTK_FORCE_USE(inputMatrix);
+  TTK_FORCE_USE(nRows);
+  TTK_FORCE_USE(nColumns);
+  TTK_FORCE_USE(nComponents);
+  this->printErr("The native PCA requires Eigen");
+  return -1;
+#endif // TTK_ENABLE_EIGEN
+}
+
+int DimensionReduction::computeNativeMDS(
+  std::vector<std::vector<double>> &outputEmbedding,
+  const std::vector<double> &inputMatrix,
+  const int nRows,
+  const int nColumns,
+  const int nComponents) const {
+
+#ifdef TTK_ENABLE_EIGEN
+  if(this->IsInputADistanceMatrix && nRows != nColumns) {
+    this->printErr("The distance matrix is not square");
+    return -1;
+  }
+
+  Eigen::setNbThreads(this->threadNumber_);
+  std::mt19937 rng{this->IsDeterministic ? 0 : std::random_device{}()};
+
+  const auto sqDistance = [&](const int i, const int j) {
+    if(this->IsInputADistanceMatrix) {
+      const double d = inputMatrix[i * nColumns + j];
+      return d * d;
+    }
+    double d2{};
+    for(int c = 0; c < nColumns; ++c) {
+      const double diff
+        = inputMatrix[i * nColumns + c] - inputMatrix[j * nColumns + c];
+      d2 += diff * diff;
+    }
+    return d2;
+  };
+
+  const int nLandmarks
+    = this->mds_NumberOfLandmarks > 0
+        ? std::min(std::max(this->mds_NumberOfLandmarks, nComponents), nRows)
+        : nRows;
+
+  // squared distances from the landmarks (rows) to all the points,
+  // landmarks picked by farthest point sampling
+  Eigen::MatrixXd toLandmarks(nLandmarks, nRows);
+  std::vector<int> landmarks(nLandmarks);
+  std::vector<double> minSqDistance(
+    nRows, std::numeric_limits<double>::infinity());
+  for(int l = 0; l < nLandmarks; ++l) {
+    if(nLandmarks == nRows) {
+      landmarks[l] = l;
+    } else if(l == 0) {
+      landmarks[l]
+        = this->IsDeterministic
+            ? 0
+            : std::uniform_int_distribution<int>{0, nRows - 1}(rng);
+    } else {
+      landmarks[l] = std::distance(
+        minSqDistance.begin(),
+        std::max_element(minSqDistance.begin(), minSqDistance.end()));
+    }
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(this->threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+    for(int i = 0; i < nRows; ++i) {
+      toLandmarks(l, i) = sqDistance(landmarks[l], i);
+      minSqDistance[i] = std::min(minSqDistance[i], toLandmarks(l, i));
+    }
+  }
+
+  Eigen::MatrixXd betweenLandmarks(nLandmarks, nLandmarks);
+  for(int l = 0; l < nLandmarks; ++l) {
+    betweenLandmarks.col(l) = toLandmarks.col(landmarks[l]);
+  }
+
+  Eigen::MatrixXd coords{}, pseudoInverse{};
+  computeClassicalScaling(
+    betweenLandmarks, nComponents, rng, coords, pseudoInverse);
+
+  outputEmbedding.resize(nComponents);
+  for(int i = 0; i < nComponents; ++i) {
+    outputEmbedding[i].resize(nRows);
+  }
+
+  if(nLandmarks == nRows) {
+    for(int i = 0; i < nComponents; ++i) {
+      Eigen::VectorXd::Map(outputEmbedding[i].data(), nRows) = coords.col(i);
+    }
+  } else {
+    // distance-based triangulation of
+    //
+    // "Sparse multidimensional scaling using landmark points" \n
+    // V. de Silva, J. B. Tenenbaum \n
+    // Technical report, Stanford University, 2004.
+    toLandmarks.colwise() -= betweenLandmarks.rowwise().mean();
+    const Eigen::MatrixXd embedding = -0.5 * pseudoInverse * toLandmarks;
+    for(int i = 0; i < nComponents; ++i) {
+      Eigen::VectorXd::Map(outputEmbedding[i].data(), nRows)
+        = embedding.row(i).transpose();
+    }
+  }
+
+  return 0;
+#else
+  TTK_FORCE_USE(outputEmbedding);
+  TTK_FORCE_USE(inputMatrix);
+  TTK_FORCE_USE(nRows);
+  TTK_FORCE_USE(nColumns);
+  TTK_FORCE_USE(nComponents);
+  this->printErr("The native MDS requires Eigen");
+  return -1;
+#endif // TTK_ENABLE_EIGEN
+}
+
+int DimensionReduction::computeNativeTSNE(
+  std::vector<std::vector<double>> &outputEmbedding,
+  const std::vector<double> &inputMatrix,
+  const int nRows,
+  const int nColumns,
+  const int nComponents) const {
+
+  const bool precomputed = this->tsne_Metric == "precomputed";
+  if(precomputed && nRows != nColumns) {
+    this->printErr("The distance matrix is not square");
+    return -1;
+  }
+  if(nRows < 2) {
+    this->printErr("t-SNE needs at least two points");
+    return -1;
+  }
+
+  const size_t n = nRows;
+  const int dim = nComponents;
+  bool exact = this->tsne_Method == "exact";
+  if(!exact && dim > 3) {
+    this->printWrn("Barnes-Hut t-SNE is limited to 3 components");
+    this->printWrn("Using the exact gradient");
+    exact = true;
+  }
+  const auto maxNeighbors = static_cast<size_t>(3 * this->tsne_Perplexity + 1);
+  const size_t nNeighbors = exact ? n - 1 : std::min(n - 1, maxNeighbors);
+
+  Timer tm{};
+
+  // (squared for the Euclidean metric) distances to the nearest neighbors
+  std::vector<std::vector<std::pair<double, size_t>>> knn(n);
+  if(precomputed) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(this->threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t i = 0; i < n; ++i) {
+      auto &row = knn[i];
+      for(size_t j = 0; j < n; ++j) {
+        if(j != i) {
+          row.emplace_back(inputMatrix[i * nColumns + j], j);
+        }
+      }
+      std::nth_element(row.begin(), row.begin() + nNeighbors - 1, row.end());
+      row.resize(nNeighbors);
+    }
+  } else {
+    std::vector<std::vector<double>> points(n);
+    double diagonal{};
+    for(int c = 0; c < nColumns; ++c) {
+      double lo = std::numeric_limits<double>::infinity(), hi = -lo;
+      for(size_t i = 0; i < n; ++i) {
+        lo = std::min(lo, inputMatrix[i * nColumns + c]);
+        hi = std::max(hi, inputMatrix[i * nColumns + c]);
+      }
+      diagonal += (hi - lo) * (hi - lo);
+    }
+    for(size_t i = 0; i < n; ++i) {
+      points[i].assign(inputMatrix.begin() + i * nColumns,
+                       inputMatrix.begin() + (i + 1) * nColumns);
+    }
+    const RadiusSearchTree tree{points};
+    // radius of a ball holding the neighbors in a uniform distribution
+    const double radius0
+      = std::sqrt(diagonal)
+        * std::pow(static_cast<double>(nNeighbors + 1) / n, 1.0 / nColumns);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(this->threadNumber_) schedule(dynamic, 64)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t i = 0; i < n; ++i) {
+      auto &row = knn[i];
+      // the radius is doubled until enough neighbors are found
+      for(double radius = std::max(radius0, 1e-12); row.size() < nNeighbors;
+          radius *= 2) {
+        row.clear();
+        tree.forEachNeighbor(
+          points[i].data(), radius, [&](const size_t j, const double d) {
+            if(j != i) {
+              row.emplace_back(d * d, j);
+            }
+          });
+      }
+      std::nth_element(row.begin(), row.begin() + nNeighbors - 1, row.end());
+      row.resize(nNeighbors);
+    }
+  }
+
+  // conditional probabilities of the neighbors matching the perplexity
+  // (binary search of the precision as scikit-learn)
+  const double targetEntropy = std::log(this->tsne_Perplexity);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(this->threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < n; ++i) {
+    auto &row = knn[i];
+    const auto inf = std::numeric_limits<double>::infinity();
+    double beta = 1.0, betaMin = -inf, betaMax = inf;
+    std::vector<double> p(row.size());
+    for(int step = 0; step < 100; ++step) {
+      double sumP{}, sumDP{};
+      for(size_t j = 0; j < row.size(); ++j) {
+        p[j] = std::exp(-row[j].first * beta);
+        sumP += p[j];
+      }
+      sumP = std::max(sumP, 1e-8);
+      for(size_t j = 0; j < row.size(); ++j) {
+        p[j] /= sumP;
+        sumDP += row[j].first * p[j];
+      }
+      const double entropy = std::log(sumP) + beta * sumDP;
+      const double diff = entropy - targetEntropy;
+      if(std::abs(diff) <= 1e-5) {
+        break;
+      }
+      if(diff > 0) {
+        betaMin = beta;
+        beta = betaMax == inf ? beta * 2 : (beta + betaMax) / 2;
+      } else {
+        betaMax = beta;
+        beta = betaMin == -inf ? beta / 2 : (beta + betaMin) / 2;
+      }
+    }
+    for(size_t j = 0; j < row.size(); ++j) {
+      row[j].first = p[j];
+    }
+  }
+
+  // symmetrized joint probabilities, rows sorted by neighbor
+  std::vector<std::vector<std::pair<size_t, double>>> jointP(n);
+  double sumP{};
+  for(size_t i = 0; i < n; ++i) {
+    for(const auto &e : knn[i]) {
+      jointP[i].emplace_back(e.second, e.first);
+      jointP[e.second].emplace_back(i, e.first);
+      sumP += 2 * e.first;
+    }
+  }
+  knn = {};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(this->threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < n; ++i) {
+    auto &row = jointP[i];
+    std::sort(row.begin(), row.end());
+    size_t last{};
+    for(size_t j = 0; j < row.size(); ++j) {
+      if(j > 0 && row[j].first == row[last].first) {
+        row[last].second += row[j].second;
+      } else {
+        row[last = (j == 0 ? 0 : last + 1)] = row[j];
+      }
+    }
+    row.resize(row.empty() ? 0 : last + 1);
+    for(auto &e : row) {
+      e.second /= std::max(sumP, std::numeric_limits<double>::min());
+    }
+  }
+
+  this->printMsg("Computed joint probabilities", 0.1, tm.getElapsedTime(),
+                 this->threadNumber_, debug::LineMode::NEW,
+                 debug::Priority::DETAIL);
+
+  // initial embedding (row-major)
+  std::mt19937 rng{this->IsDeterministic ? 0 : std::random_device{}()};
+  std::vector<double> y(n * dim);
+  bool initialized{false};
+#ifdef TTK_ENABLE_EIGEN
+  if(this->tsne_Init == "pca" && !precomputed) {
+    Eigen::setNbThreads(this->threadNumber_);
+    Eigen::MatrixXd embedding{};
+    computePCA(inputMatrix, nRows, nColumns, dim, false, "auto", "auto", rng,
+               embedding);
+    const double sd = std::sqrt(
+      (embedding.col(0).array() - embedding.col(0).mean()).square().mean());
+    for(size_t i = 0; i < n; ++i) {
+      for(int c = 0; c < dim; ++c) {
+        y[i * dim + c] = embedding(i, c) / (sd > 0 ? sd : 1.0) * 1e-4;
+      }
+    }
+    initialized = true;
+  }
+#else
+  if(this->tsne_Init == "pca" && !precomputed) {
+    this->printWrn("The PCA initialization requires Eigen, using a random "
+                   "initialization");
+  }
+#endif // TTK_ENABLE_EIGEN
+  if(!initialized) {
+    std::normal_distribution<double> normal{0.0, 1e-4};
+    for(auto &v : y) {
+      v = normal(rng);
+    }
+  }
+
+  // gradient descent with momentum and gains of scikit-learn: an early
+  // exaggeration stage, then the main optimization
+  const double alpha = std::max(dim - 1, 1);
+  const double theta2 = this->tsne_Angle * this->tsne_Angle;
+  const int checkPeriod = 50;
+  std::vector<double> grad(n * dim), repulsion(n * dim);
+  std::vector<double> sumW(n);
+
+  // returns the Kullback-Leibler divergence when asked (at checks)
+  const auto computeGradient = [&](const double exaggeration,
+                                   const bool withError) {
+    std::fill(repulsion.begin(), repulsion.end(), 0.0);
+    std::fill(sumW.begin(), sumW.end(), 0.0);
+    std::unique_ptr<SpaceTree> tree{};
+    if(!exact) {
+      tree = std::make_unique<SpaceTree>(y, n, dim);
+    }
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(this->threadNumber_) schedule(dynamic, 64)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t i = 0; i < n; ++i) {
+      if(exact) {
+        std::vector<double> forceN(dim);
+        for(size_t j = 0; j < n; ++j) {
+          if(j == i) {
+            continue;
+          }
+          double d2{};
+          for(int c = 0; c < dim; ++c) {
+            d2 += (y[i * dim + c] - y[j * dim + c])
+                  * (y[i * dim + c] - y[j * dim + c]);
+          }
+          const double t = 1.0 + d2 / alpha;
+          const double w = std::pow(t, -(alpha + 1) / 2);
+          sumW[i] += w;
+          for(int c = 0; c < dim; ++c) {
+            forceN[c] += w / t * (y[i * dim + c] - y[j * dim + c]);
+          }
+        }
+        std::copy(forceN.begin(), forceN.end(), repulsion.begin() + i * dim);
+      } else {
+        std::array<double, 3> force{};
+        tree->computeRepulsion(i, theta2, alpha, force.data(), sumW[i]);
+        std::copy(force.begin(), force.begin() + dim,
+                  repulsion.begin() + i * dim);
+      }
+    }
+    double z{};
+    for(const auto w : sumW) {
+      z += w;
+    }
+    z = std::max(z, std::numeric_limits<double>::min());
+
+    double error{};
+    const double coef = 2.0 * (alpha + 1.0) / alpha;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(this->threadNumber_) reduction(+ : error)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t i = 0; i < n; ++i) {
+      std::vector<double> attraction(dim);
+      for(const auto &e : jointP[i]) {
+        const size_t j = e.first;
+        double d2{};
+        for(int c = 0; c < dim; ++c) {
+          d2 += (y[i * dim + c] - y[j * dim + c])
+                * (y[i * dim + c] - y[j * dim + c]);
+        }
+        const double t = 1.0 + d2 / alpha;
+        const double p = exaggeration * e.second;
+        for(int c = 0; c < dim; ++c) {
+          attraction[c] += p / t * (y[i * dim + c] - y[j * dim + c]);
+        }
+        if(withError) {
+          const double tiny = std::numeric_limits<float>::min();
+          const double q = std::pow(t, -(alpha + 1) / 2) / z;
+          error += p * std::log(std::max(p, tiny) / std::max(q, tiny));
+        }
+      }
+      for(int c = 0; c < dim; ++c) {
+        grad[i * dim + c]
+          = coef * (attraction[c] - repulsion[i * dim + c] / z);
+      }
+    }
+    return error;
+  };
+
+  const auto optimize = [&](const int first, const int last,
+                            const double momentum, const double exaggeration,
+                            const int nIterWithoutProgress) {
+    std::vector<double> update(n * dim, 0.0), gains(n * dim, 1.0);
+    double bestError = std::numeric_limits<double>::infinity();
+    int bestIter = first;
+    int it = first;
+    for(; it < last; ++it) {
+      const bool check = (it + 1) % checkPeriod == 0;
+      const double error = computeGradient(exaggeration, check);
+      double gradNorm2{};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(this->threadNumber_) \
+  reduction(+ : gradNorm2)
+#endif // TTK_ENABLE_OPENMP
+      for(size_t k = 0; k < n * dim; ++k) {
+        if(update[k] * grad[k] < 0.0) {
+          gains[k] += 0.2;
+        } else {
+          gains[k] *= 0.8;
+        }
+        gains[k] = std::max(gains[k], 0.01);
+        grad[k] *= gains[k];
+        gradNorm2 += grad[k] * grad[k];
+        update[k] = momentum * update[k] - this->tsne_LearningRate * grad[k];
+        y[k] += update[k];
+      }
+      if(check) {
+        if(this->tsne_Verbose > 0) {
+          this->printMsg("Iteration " + std::to_string(it + 1)
+                         + ", KL divergence: " + std::to_string(error));
+        }
+        if(error < bestError) {
+          bestError = error;
+          bestIter = it;
+        } else if(it - bestIter > nIterWithoutProgress) {
+          break;
+        }
+        if(std::sqrt(gradNorm2) <= this->tsne_GradientThreshold) {
+          break;
+        }
+      }
+    }
+    // first iteration of the next stage
+    return std::min(it + 1, last);
+  };
+
+  const int explorationIter = std::min(250, this->tsne_MaxIteration);
+  const int it = optimize(
+    0, explorationIter, 0.5, this->tsne_Exaggeration, explorationIter);
+  optimize(it, this->tsne_MaxIteration, 0.8, 1.0,
+           this->tsne_MaxIterationProgress);
+
+  outputEmbedding.resize(dim);
+  for(int c = 0; c < dim; ++c) {
+    outputEmbedding[c].resize(n);
+    for(size_t i = 0; i < n; ++i) {
+      outputEmbedding[c][i] = y[i * dim + c];
+    }
+  }
+
+  return 0;
+}
@@ -8,13 +8,20 @@
 ///
 /// This package takes a list of sources (a set of points with their global
 /// identifiers attached to them) and produces a distance field to the closest
-/// source.
+/// source, along with the Voronoi segmentation of the sources.
 ///
-/// \b Related \b publication \n
+/// All the sources are propagated in a single parallel wavefront, in memory
+/// linear in the number of vertices.
+///
+/// \b Related \b publications \n
 /// "A note on two problems in connexion with graphs" \n
 /// Edsger W. Dijkstra \n
 /// Numerische Mathematik, 1959.
 ///
+/// "Delta-stepping: a parallelizable shortest path algorithm" \n
+/// Ulrich Meyer, Peter Sanders \n
+/// Journal of Algorithms, 2003.
+///
 /// \sa ttkDistanceField.cpp %for a usage example.
 #pragma once
 
@@ -99,34 +106,24 @@ int ttk::DistanceField::execute(const triangulationType *triangulation_) const {
   std::vector<SimplexId> sources(isSource.begin(), isSource.end());
   isSource.clear();
 
-  // prepare output
-  std::vector<std::vector<dataType>> scalars(sources.size());
-
-  // @PETER This doesn't seem to very work efficient, there's multilple source
-  // shortest paths algorithms.
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(threadNumber_)
-#endif
-  for(size_t i = 0; i < sources.size(); ++i) {
-    int const ret = Dijkstra::shortestPath<dataType>(
-      sources[i], *triangulation_, scalars[i]);
-    if(ret != 0) {
-      this->printErr(
-        "Algorithm not successful (error code:  " + std::to_string(ret) + ").");
-    }
+  // propagate (distance, source) labels from all the sources at once
+  std::vector<dataType> scalars{};
+  std::vector<SimplexId> closest{};
+  int const ret = Dijkstra::shortestPathMultiSource<dataType>(
+    sources, *triangulation_, scalars, closest, this->threadNumber_);
+  if(ret != 0) {
+    this->printErr(
+      "Algorithm not successful (error code:  " + std::to_string(ret) + ").");
+    return ret;
   }
 
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp parallel for num_threads(threadNumber_)
 #endif
   for(SimplexId k = 0; k < vertexNumber_; ++k) {
-    for(size_t i = 0; i < sources.size(); ++i) {
-      if(i == 0 or dist[k] > scalars[i][k]) {
-        dist[k] = scalars[i][k];
-        origin[k] = sources[i];
-        seg[k] = i;
-      }
-    }
+    dist[k] = scalars[k];
+    seg[k] = closest[k];
+    origin[k] = closest[k] != -1 ? sources[closest[k]] : -1;
   }
 
   this->printMsg(
@@ -0,0 +1,123 @@
+#include <DistanceMatrixEngine.h>
+
+#include <cstdint>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // _WIN32
+
+namespace {
+  // layout of the checkpoint file: header, tile status, matrix values
+  struct CheckpointHeader {
+    char magic[8];
+    std::uint64_t nRows;
+    std::uint64_t nCols;
+    std::uint64_t tileSize;
+    std::uint64_t nTiles;
+    std::uint64_t symmetric;
+    // hash of the inputs and of the distance parameters
+    std::uint64_t fingerprint;
+  };
+
+  constexpr char checkpointMagic[8] = {'T', 'T', 'K', 'D', 'M', 'A', 'T', '2'};
+} // namespace
+
+ttk::DistanceMatrixEngine::Checkpoint::~Checkpoint() {
+  this->close();
+}
+
+int ttk::DistanceMatrixEngine::Checkpoint::open(
+  const std::string &path,
+  const size_t nRows,
+  const size_t nCols,
+  const size_t tileSize,
+  const size_t nTiles,
+  const bool symmetric,
+  const std::uint64_t fingerprint,
+  bool &reused) {
+  reused = false;
+
+#ifdef _WIN32
+  TTK_FORCE_USE(path);
+  TTK_FORCE_USE(nRows);
+  TTK_FORCE_USE(nCols);
+  TTK_FORCE_USE(tileSize);
+  TTK_FORCE_USE(nTiles);
+  TTK_FORCE_USE(symmetric);
+  TTK_FORCE_USE(fingerprint);
+  return -1;
+#else
+  CheckpointHeader header{};
+  std::memcpy(header.magic, checkpointMagic, sizeof(header.magic));
+  header.nRows = nRows;
+  header.nCols = nCols;
+  header.tileSize = tileSize;
+  header.nTiles = nTiles;
+  header.symmetric = symmetric;
+  header.fingerprint = fingerprint;
+
+  // values are aligned on 8 bytes
+  const size_t valuesOffset = (sizeof(header) + nTiles + 7) / 8 * 8;
+  const size_t size = valuesOffset + nRows * nCols * sizeof(double);
+
+  fd_ = ::open(path.data(), O_RDWR | O_CREAT, 0644);
+  if(fd_ < 0) {
+    return -1;
+  }
+
+  // reuse the file only if it was created for the same matrix layout and
+  // the same inputs
+  struct stat st {};
+  CheckpointHeader previous{};
+  if(fstat(fd_, &st) == 0 && static_cast<size_t>(st.st_size) == size
+     && pread(fd_, &previous, sizeof(previous), 0)
+          == static_cast<ssize_t>(sizeof(previous))) {
+    reused = std::memcmp(&previous, &header, sizeof(header)) == 0;
+  }
+
+  if(!reused && (ftruncate(fd_, 0) != 0 || ftruncate(fd_, size) != 0)) {
+    this->close();
+    return -1;
+  }
+
+  map_ = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+  if(map_ == MAP_FAILED) {
+    map_ = nullptr;
+    this->close();
+    return -1;
+  }
+  size_ = size;
+  nCols_ = nCols;
+
+  auto bytes = static_cast<unsigned char *>(map_);
+  tiles_ = bytes + sizeof(header);
+  values_ = reinterpret_cast<double *>(bytes + valuesOffset);
+  if(!reused) {
+    // the file was truncated: every tile status is 0
+    std::memcpy(bytes, &header, sizeof(header));
+  }
+
+  return 0;
+#endif // _WIN32
+}
+
+void ttk::DistanceMatrixEngine::Checkpoint::close() {
+#ifndef _WIN32
+  if(map_ != nullptr) {
+    msync(map_, size_, MS_SYNC);
+    munmap(map_, size_);
+  }
+  if(fd_ >= 0) {
+    ::close(fd_);
+  }
+#endif // _WIN32
+  map_ = nullptr;
+  fd_ = -1;
+  size_ = 0;
+  tiles_ = nullptr;
+  values_ = nullptr;
+}
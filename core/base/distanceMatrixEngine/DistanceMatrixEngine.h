@@ -0,0 +1,542 @@
+/// \ingroup base
+/// \class ttk::DistanceMatrixEngine
+///
+/// \brief Shared engine to fill distance matrices between the members of an
+/// ensemble.
+///
+/// The matrix is split into square tiles, scheduled dynamically over the
+/// threads (only the upper triangle of symmetric matrices is computed).
+/// The engine also supports:
+///   - checkpointing: completed tiles are written to a memory-mapped file,
+///   a killed computation resumes from the tiles already done (the file
+///   stores a fingerprint of the inputs and of the distance parameters and
+///   is discarded if they changed),
+///   - incremental computation: the distances between the first members of
+///   the ensemble can be given (setKnownMatrix) and are not computed again,
+///   - k nearest neighbors queries, where cheap lower and upper bounds of the
+///   distance prune most of the exact computations.
+///
+/// Distance functors are called concurrently and should be thread-safe.
+/// They should use a single thread, unless setParallelDistances is enabled
+/// (the pairs are then processed one at a time).
+///
+/// \sa ttk::PersistenceDiagramDistanceMatrix
+/// \sa ttk::MergeTreeDistanceMatrix
+/// \sa ttk::LDistanceMatrix
+
+#pragma once
+
+#include <Debug.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ttk {
+
+  class DistanceMatrixEngine : virtual public Debug {
+
+  public:
+    inline void setTileSize(const int size) {
+      this->TileSize = std::max(size, 1);
+    }
+    inline void setCheckpointFile(const std::string &path) {
+      this->CheckpointFile = path;
+    }
+    /**
+     * Process the pairs one at a time, each distance computation using all
+     * the threads (for distance functors that are parallel themselves).
+     */
+    inline void setParallelDistances(const bool data) {
+      this->ParallelDistances = data;
+    }
+    /**
+     * Distances between the first matrix.size() members, reused instead of
+     * being computed again when members are appended to the ensemble.
+     */
+    inline void setKnownMatrix(std::vector<std::vector<double>> matrix) {
+      this->KnownMatrix = std::move(matrix);
+    }
+
+    /**
+     * Fill the upper triangle of the symmetric n x n matrix (pre-allocated,
+     * indexed by matrix[i][j]) with dist(i, j), then mirror it.
+     *
+     * @param resume Use the known matrix and the checkpoint file.
+     * @param fingerprint Hash of the inputs and of the distance parameters
+     * (see Fingerprint), a checkpoint file with another fingerprint is
+     * discarded.
+     */
+    template <typename MatrixType, typename DistFunc>
+    int computeSymmetric(MatrixType &matrix,
+                         const size_t n,
+                         const DistFunc &dist,
+                         const bool resume = true,
+                         const std::uint64_t fingerprint = 0) const {
+      return this->computeTiles(matrix, n, n, true, dist, resume, fingerprint);
+    }
+
+    /**
+     * Fill the nRows x nCols matrix (pre-allocated) with dist(i, j).
+     */
+    template <typename MatrixType, typename DistFunc>
+    int computeRectangular(MatrixType &matrix,
+                           const size_t nRows,
+                           const size_t nCols,
+                           const DistFunc &dist,
+                           const bool resume = true,
+                           const std::uint64_t fingerprint = 0) const {
+      return this->computeTiles(
+        matrix, nRows, nCols, false, dist, resume, fingerprint);
+    }
+
+    /**
+     * Compute the k nearest neighbors (distance, index) of each of the n
+     * members, sorted by increasing distance, with cascading bounds:
+     *   - lowerBound(i, j) and upperBound(i, j) are evaluated for every pair
+     *   and should be very cheap,
+     *   - refinedBound(i, j) is a tighter lower bound, only evaluated for the
+     *   candidates that were not pruned,
+     *   - dist(i, j, radius) returns the distance if it is below radius and
+     *   may stop early with any value above radius otherwise.
+     */
+    template <typename DistFunc,
+              typename LowerFunc,
+              typename UpperFunc,
+              typename RefineFunc>
+    int computeNearestNeighbors(
+      std::vector<std::vector<std::pair<double, size_t>>> &neighbors,
+      const size_t n,
+      const size_t k,
+      const DistFunc &dist,
+      const LowerFunc &lowerBound,
+      const UpperFunc &upperBound,
+      const RefineFunc &refinedBound) const;
+
+    /**
+     * Select the k nearest (distance, index) among candidates given as
+     * (lower bound, index), visited by increasing lower bound. Candidates
+     * are processed by batches of nThreads in parallel. See
+     * computeNearestNeighbors for refinedBound(j) and dist(j, radius).
+     * Returns the number of calls to dist.
+     */
+    template <typename DistFunc, typename RefineFunc>
+    size_t selectNearest(std::vector<std::pair<double, size_t>> &candidates,
+                         const size_t k,
+                         const DistFunc &dist,
+                         const RefineFunc &refinedBound,
+                         std::vector<std::pair<double, size_t>> &nearest,
+                         const int nThreads = 1) const;
+
+  protected:
+    /**
+     * FNV-1a hash of the inputs and of the distance parameters, identifying
+     * the matrix stored in a checkpoint file.
+     */
+    class Fingerprint {
+    public:
+      template <typename T>
+      inline Fingerprint &add(const T *const data, const size_t n) {
+        const auto bytes = reinterpret_cast<const unsigned char *>(data);
+        for(size_t i = 0; i < n * sizeof(T); ++i) {
+          hash_ = (hash_ ^ bytes[i]) * 0x100000001b3ULL;
+        }
+        return *this;
+      }
+      // for arithmetic types (structures may have uninitialized padding)
+      template <typename T>
+      inline Fingerprint &add(const T value) {
+        return this->add(&value, 1);
+      }
+      inline Fingerprint &add(const std::string &str) {
+        return this->add(str.size()).add(str.data(), str.size());
+      }
+      inline std::uint64_t get() const {
+        return hash_;
+      }
+
+    private:
+      std::uint64_t hash_{0xcbf29ce484222325ULL};
+    };
+
+    inline bool hasCheckpoint() const {
+      return !this->CheckpointFile.empty();
+    }
+
+    // number of threads processing the pairs concurrently
+    inline int getPairThreadNumber() const {
+      return this->ParallelDistances ? 1 : this->threadNumber_;
+    }
+
+    /**
+     * Memory-mapped file storing the matrix and the status of its tiles.
+     */
+    class Checkpoint {
+    public:
+      Checkpoint() = default;
+      Checkpoint(const Checkpoint &) = delete;
+      Checkpoint &operator=(const Checkpoint &) = delete;
+      ~Checkpoint();
+
+      // map the file, reusing its content if it was created for the same
+      // matrix layout. Returns 0 on success.
+      int open(const std::string &path,
+               const size_t nRows,
+               const size_t nCols,
+               const size_t tileSize,
+               const size_t nTiles,
+               const bool symmetric,
+               const std::uint64_t fingerprint,
+               bool &reused);
+
+      inline bool isTileDone(const size_t t) const {
+        return tiles_[t] != 0;
+      }
+      inline void setTileDone(const size_t t) {
+        // the tile values have to be written before its status
+        std::atomic_thread_fence(std::memory_order_release);
+        tiles_[t] = 1;
+      }
+      inline double &value(const size_t i, const size_t j) {
+        return values_[i * nCols_ + j];
+      }
+
+    private:
+      void close();
+
+      int fd_{-1};
+      void *map_{nullptr};
+      size_t size_{};
+      size_t nCols_{};
+      unsigned char *tiles_{nullptr};
+      double *values_{nullptr};
+    };
+
+    template <typename MatrixType, typename DistFunc>
+    int computeTiles(MatrixType &matrix,
+                     const size_t nRows,
+                     const size_t nCols,
+                     const bool symmetric,
+                     const DistFunc &dist,
+                     const bool resume,
+                     const std::uint64_t fingerprint) const;
+
+    int TileSize{32};
+    std::string CheckpointFile{};
+    bool ParallelDistances{false};
+    std::vector<std::vector<double>> KnownMatrix{};
+  };
+
+} // namespace ttk
+
+template <typename MatrixType, typename DistFunc>
+int ttk::DistanceMatrixEngine::computeTiles(
+  MatrixType &matrix,
+  const size_t nRows,
+  const size_t nCols,
+  const bool symmetric,
+  const DistFunc &dist,
+  const bool resume,
+  const std::uint64_t fingerprint) const {
+
+  Timer tm{};
+
+  const size_t ts = this->TileSize;
+  const size_t nRowTiles = (nRows + ts - 1) / ts;
+  const size_t nColTiles = (nCols + ts - 1) / ts;
+
+  // entries (i, j) with i, j < nKnown are already known
+  const size_t nKnown
+    = resume && symmetric ? std::min(this->KnownMatrix.size(), nRows) : 0;
+  for(size_t i = 0; i < nKnown; ++i) {
+    for(size_t j = 0; j < nKnown; ++j) {
+      matrix[i][j] = this->KnownMatrix[i][j];
+    }
+  }
+
+  // tiles (upper triangle of tiles for symmetric matrices)
+  std::vector<std::pair<size_t, size_t>> tiles{};
+  for(size_t ib = 0; ib < nRowTiles; ++ib) {
+    for(size_t jb = symmetric ? ib : 0; jb < nColTiles; ++jb) {
+      tiles.emplace_back(ib, jb);
+    }
+  }
+
+  Checkpoint checkpoint{};
+  bool useCheckpoint = resume && this->hasCheckpoint();
+  bool reused = false;
+  if(useCheckpoint
+     && checkpoint.open(this->CheckpointFile, nRows, nCols, ts, tiles.size(),
+                        symmetric, fingerprint, reused)
+          != 0) {
+    this->printWrn("Could not map checkpoint file " + this->CheckpointFile);
+    useCheckpoint = false;
+  }
+
+  const auto upper = [symmetric](const size_t i, const size_t j) {
+    return !symmetric || j > i;
+  };
+
+  std::atomic<size_t> nReused{0};
+  std::atomic<size_t> nDone{0};
+  const size_t progressStep = std::max(tiles.size() / 10, size_t{1});
+  // only written by the master thread, which prints the progress
+  size_t nextProgress = progressStep;
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1) \
+  num_threads(this->getPairThreadNumber())
+#endif // TTK_ENABLE_OPENMP
+  for(size_t t = 0; t < tiles.size(); ++t) {
+    const size_t iBegin = tiles[t].first * ts;
+    const size_t iEnd = std::min(iBegin + ts, nRows);
+    const size_t jBegin = tiles[t].second * ts;
+    const size_t jEnd = std::min(jBegin + ts, nCols);
+
+    if(useCheckpoint && reused && checkpoint.isTileDone(t)) {
+      for(size_t i = iBegin; i < iEnd; ++i) {
+        for(size_t j = jBegin; j < jEnd; ++j) {
+          if(upper(i, j)) {
+            matrix[i][j] = checkpoint.value(i, j);
+          }
+        }
+      }
+      nReused++;
+      nDone++;
+      continue;
+    }
+
+    // in the upper triangle, only entries with j >= nKnown are new
+    for(size_t i = iBegin; i < iEnd; ++i) {
+      for(size_t j = std::max(jBegin, nKnown); j < jEnd; ++j) {
+        if(upper(i, j)) {
+          matrix[i][j] = dist(i, j);
+        }
+      }
+    }
+
+    if(useCheckpoint) {
+      for(size_t i = iBegin; i < iEnd; ++i) {
+        for(size_t j = jBegin; j < jEnd; ++j) {
+          if(upper(i, j)) {
+            checkpoint.value(i, j) = matrix[i][j];
+          }
+        }
+      }
+      checkpoint.setTileDone(t);
+    }
+
+    const size_t done = ++nDone;
+#ifdef TTK_ENABLE_OPENMP
+    const bool isMaster = omp_get_thread_num() == 0;
+#else
+    const bool isMaster = true;
+#endif // TTK_ENABLE_OPENMP
+    if(isMaster && done >= nextProgress && done < tiles.size()) {
+      nextProgress = (done / progressStep + 1) * progressStep;
+      this->printMsg("Computing distance matrix",
+                     static_cast<double>(done) / tiles.size(),
+                     tm.getElapsedTime(), this->threadNumber_,
+                     debug::LineMode::REPLACE);
+    }
+  }
+
+  if(symmetric) {
+    for(size_t i = 0; i < nRows; ++i) {
+      matrix[i][i] = 0.0;
+      for(size_t j = i + 1; j < nRows; ++j) {
+        matrix[j][i] = matrix[i][j];
+      }
+    }
+  }
+
+  if(nKnown > 0) {
+    this->printMsg("Reused the distances between the first "
+                     + std::to_string(nKnown) + " members",
+                   debug::Priority::DETAIL);
+  }
+  if(nReused > 0) {
+    this->printMsg("Resumed " + std::to_string(nReused) + " / "
+                     + std::to_string(tiles.size())
+                     + " tiles from checkpoint",
+                   debug::Priority::DETAIL);
+  }
+  this->printMsg("Computed " + std::to_string(nRows) + "x"
+                   + std::to_string(nCols) + " distance matrix ("
+                   + std::to_string(tiles.size()) + " tiles)",
+                 1.0, tm.getElapsedTime(), this->threadNumber_);
+
+  return 0;
+}
+
+template <typename DistFunc, typename RefineFunc>
+size_t ttk::DistanceMatrixEngine::selectNearest(
+  std::vector<std::pair<double, size_t>> &candidates,
+  const size_t k,
+  const DistFunc &dist,
+  const RefineFunc &refinedBound,
+  std::vector<std::pair<double, size_t>> &nearest,
+  const int nThreads) const {
+
+  nearest.clear();
+  if(k == 0) {
+    return 0;
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  // max-heap of the best neighbors found so far
+  std::priority_queue<std::pair<double, size_t>> best{};
+  const auto radius = [&best, k]() {
+    return best.size() < k ? std::numeric_limits<double>::infinity()
+                           : best.top().first;
+  };
+
+  std::vector<size_t> batch{};
+  std::vector<double> batchDist{};
+  size_t nComputed{0};
+  size_t next = 0;
+  while(next < candidates.size() && candidates[next].first < radius()) {
+    const double r = radius();
+    batch.clear();
+    while(next < candidates.size() && candidates[next].first < r
+          && static_cast<int>(batch.size()) < std::max(nThreads, 1)) {
+      batch.emplace_back(candidates[next++].second);
+    }
+    batchDist.resize(batch.size());
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1) num_threads(nThreads) \
+  if(nThreads > 1) reduction(+ : nComputed)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t b = 0; b < batch.size(); ++b) {
+      batchDist[b] = std::numeric_limits<double>::infinity();
+      if(refinedBound(batch[b]) < r) {
+        batchDist[b] = dist(batch[b], r);
+        nComputed++;
+      }
+    }
+
+    for(size_t b = 0; b < batch.size(); ++b) {
+      if(best.size() < k) {
+        best.emplace(batchDist[b], batch[b]);
+      } else if(batchDist[b] < best.top().first) {
+        best.pop();
+        best.emplace(batchDist[b], batch[b]);
+      }
+    }
+  }
+
+  // candidates pruned by the bounds are never among the k nearest, but
+  // there might be fewer than k candidates below the radius
+  while(!best.empty() && std::isinf(best.top().first)) {
+    best.pop();
+  }
+  nearest.resize(best.size());
+  for(size_t l = nearest.size(); l > 0; --l) {
+    nearest[l - 1] = best.top();
+    best.pop();
+  }
+
+  return nComputed;
+}
+
+template <typename DistFunc,
+          typename LowerFunc,
+          typename UpperFunc,
+          typename RefineFunc>
+int ttk::DistanceMatrixEngine::computeNearestNeighbors(
+  std::vector<std::vector<std::pair<double, size_t>>> &neighbors,
+  const size_t n,
+  const size_t k,
+  const DistFunc &dist,
+  const LowerFunc &lowerBound,
+  const UpperFunc &upperBound,
+  const RefineFunc &refinedBound) const {
+
+  Timer tm{};
+
+  neighbors.clear();
+  neighbors.resize(n);
+  if(n < 2 || k == 0) {
+    return 0;
+  }
+  const size_t kk = std::min(k, n - 1);
+
+  // exact distances already computed (upper triangle, NaN if unknown)
+  const auto pairIndex = [n](const size_t i, const size_t j) {
+    const auto a = std::min(i, j);
+    const auto b = std::max(i, j);
+    return a * (2 * n - a - 1) / 2 + (b - a - 1);
+  };
+  std::vector<double> cache(n * (n - 1) / 2,
+                            std::numeric_limits<double>::quiet_NaN());
+  std::atomic<size_t> nComputed{0};
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1) \
+  num_threads(this->getPairThreadNumber())
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < n; ++i) {
+    // (lower bound, index) of the candidates
+    std::vector<std::pair<double, size_t>> candidates{};
+    std::vector<double> upperBounds{};
+    candidates.reserve(n - 1);
+    upperBounds.reserve(n - 1);
+    for(size_t j = 0; j < n; ++j) {
+      if(j != i) {
+        candidates.emplace_back(lowerBound(i, j), j);
+        upperBounds.emplace_back(upperBound(i, j));
+      }
+    }
+
+    // the k-th smallest upper bound is above the k-th neighbor distance
+    std::nth_element(
+      upperBounds.begin(), upperBounds.begin() + kk - 1, upperBounds.end());
+    const double radius = upperBounds[kk - 1];
+    candidates.erase(
+      std::remove_if(candidates.begin(), candidates.end(),
+                     [radius](const std::pair<double, size_t> &c) {
+                       return c.first > radius;
+                     }),
+      candidates.end());
+
+    const auto cachedDist = [&](const size_t j, const double r) {
+      const auto id = pairIndex(i, j);
+      double d;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic read
+#endif // TTK_ENABLE_OPENMP
+      d = cache[id];
+      if(std::isnan(d)) {
+        d = dist(i, j, r);
+        nComputed++;
+        // distances above the radius might not be exact
+        if(d <= r) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic write
+#endif // TTK_ENABLE_OPENMP
+          cache[id] = d;
+        }
+      }
+      return d;
+    };
+    const auto refined
+      = [&](const size_t j) { return refinedBound(i, j); };
+
+    this->selectNearest(candidates, kk, cachedDist, refined, neighbors[i]);
+  }
+
+  this->printMsg("Computed " + std::to_string(nComputed) + " / "
+                   + std::to_string(cache.size())
+                   + " distances for the nearest neighbors",
+                 1.0, tm.getElapsedTime(), this->threadNumber_,
+                 debug::LineMode::NEW, debug::Priority::DETAIL);
+
+  return 0;
+}
@@ -0,0 +1,422 @@
+/// \ingroup base
+/// \class ttk::ftm::MergeTreeHierarchy
+/// \date 2026.
+///
+/// \brief Multi-resolution representation of a merge tree.
+///
+/// The branch decomposition of a merge tree (as stored through the node
+/// origins, see FTMTreeUtils) is re-ordered so that any persistence cut of
+/// the tree is a prefix of the branch sequence: the main branch comes first
+/// and each branch is stored after its parent branch, by decreasing
+/// persistence. Extracting the tree simplified at a given persistence
+/// threshold is then linear in the size of the output, without any
+/// simplification pass.
+///
+/// The same order is used by the serialization: a reader can stop at any
+/// record and still obtain a valid (simplified) merge tree, which allows
+/// progressive transmission of the tree from its most important features to
+/// the least important ones.
+///
+/// \sa ttk::ftm::FTMTree_MT
+
+#pragma once
+
+#include <FTMTreeUtils.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <queue>
+#include <tuple>
+
+namespace ttk {
+  namespace ftm {
+
+    template <class dataType>
+    class MergeTreeHierarchy {
+    public:
+      struct Branch {
+        // tree node ids in the input tree
+        idNode birthNode, deathNode;
+        // vertex ids of these nodes in the input data
+        SimplexId birthVertex, deathVertex;
+        dataType birthValue, deathValue;
+        // index of the parent branch in the hierarchy (-1 for the main
+        // branch)
+        int parent;
+        // compact node indices in the multi-resolution tree
+        int birthIndex, deathIndex;
+
+        inline dataType getPersistence() const {
+          return deathValue > birthValue ? deathValue - birthValue
+                                         : birthValue - deathValue;
+        }
+      };
+
+      /// Build the hierarchy from a tree whose node origins store its
+      /// branch decomposition (see ttk::ftm::computePersistencePairs).
+      /// The branches of multi-persistence pairs share their saddle.
+      /// \return 0 upon success, negative values otherwise.
+      int build(FTMTree_MT *tree);
+
+      /// Number of branches whose persistence is greater than or equal to
+      /// the threshold, i.e. the size of the hierarchy prefix to extract.
+      /// Logarithmic time.
+      size_t getNumberOfBranches(const dataType persistenceThreshold) const;
+
+      inline size_t getNumberOfBranches() const {
+        return branches_.size();
+      }
+
+      /// Number of tree nodes spanned by the first noBranches branches.
+      inline size_t getNumberOfNodes(const size_t noBranches) const {
+        return noBranches == 0 ? 0 : prefixNodes_[noBranches - 1];
+      }
+
+      inline const std::vector<Branch> &getBranches() const {
+        return branches_;
+      }
+
+      /// Extract the merge tree made of the first noBranches branches.
+      /// The node i of the output tree has the vertex id
+      /// getNodeVertex(i) in the input data.
+      /// Linear time in the output size (up to the sort of the saddles
+      /// along each branch).
+      MergeTree<dataType> extractMergeTree(size_t noBranches) const;
+
+      inline MergeTree<dataType>
+        extractMergeTree(const dataType persistenceThreshold) const {
+        return extractMergeTree(
+          this->getNumberOfBranches(persistenceThreshold));
+      }
+
+      /// Extract the top-k most persistent pairs of the tree.
+      inline MergeTree<dataType> extractTopBranches(const size_t k) const {
+        return extractMergeTree(std::min(k, branches_.size()));
+      }
+
+      inline SimplexId getNodeVertex(const int nodeIndex) const {
+        return nodeVertices_[nodeIndex];
+      }
+
+      /// Progressive serialization: the header is followed by one record
+      /// per branch in hierarchy order.
+      int write(std::ostream &stream) const;
+
+      /// Read at most maxBranches branches (and stop at the first branch
+      /// less persistent than persistenceThreshold) from a stream written
+      /// by write(). The records past the cut are never decoded.
+      int read(std::istream &stream,
+               const size_t maxBranches = std::numeric_limits<size_t>::max(),
+               const dataType persistenceThreshold
+               = std::numeric_limits<dataType>::lowest());
+
+      inline void clear() {
+        branches_.clear();
+        cutPersistence_.clear();
+        prefixNodes_.clear();
+        nodeVertices_.clear();
+      }
+
+    protected:
+      // update the prefix structures after the insertion of a new branch
+      void pushBranch(Branch &branch, const bool newDeathNode);
+
+      std::vector<Branch> branches_{};
+      // running minimum of the branch persistence (non-increasing)
+      std::vector<dataType> cutPersistence_{};
+      // number of nodes needed by each prefix of the hierarchy
+      std::vector<int> prefixNodes_{};
+      // vertex id of each compact node index
+      std::vector<SimplexId> nodeVertices_{};
+
+      static constexpr uint64_t magicNumber_{0x4d54484945524348};
+      static constexpr uint32_t formatVersion_{1};
+    };
+
+    template <class dataType>
+    void MergeTreeHierarchy<dataType>::pushBranch(Branch &branch,
+                                                  const bool newDeathNode) {
+      branch.birthIndex = nodeVertices_.size();
+      nodeVertices_.emplace_back(branch.birthVertex);
+      if(newDeathNode) {
+        branch.deathIndex = nodeVertices_.size();
+        nodeVertices_.emplace_back(branch.deathVertex);
+      }
+      const dataType pers = branch.getPersistence();
+      cutPersistence_.emplace_back(cutPersistence_.empty()
+                                     ? pers
+                                     : std::min(cutPersistence_.back(), pers));
+      prefixNodes_.emplace_back(nodeVertices_.size());
+      branches_.emplace_back(branch);
+    }
+
+    template <class dataType>
+    int MergeTreeHierarchy<dataType>::build(FTMTree_MT *tree) {
+      this->clear();
+
+      const idNode root = tree->getRoot();
+      if(root == nullNodes or not tree->isNodeOriginDefined(root))
+        return -1;
+
+      const idNode noNodes = tree->getNumberOfNodes();
+      idNode mainBirth = tree->getNode(root)->getOrigin();
+      if(tree->isFullMerge())
+        mainBirth = tree->getMergedRootOrigin<dataType>();
+
+      // every branch starts at a leaf and ends at the saddle stored as the
+      // origin of this leaf (several branches may end at the same saddle)
+      const auto getDeath = [&](const idNode leaf) {
+        return leaf == mainBirth ? root : tree->getNode(leaf)->getOrigin();
+      };
+      std::vector<idNode> leaves;
+      for(idNode node = 0; node < noNodes; ++node) {
+        if(node != root and tree->isLeaf(node) and not tree->isNodeAlone(node)
+           and tree->isNodeOriginDefined(node))
+          leaves.emplace_back(node);
+      }
+
+      // branch (identified by its leaf) of each node, the death node of a
+      // branch belongs to its parent branch
+      std::vector<idNode> nodeBranch(noNodes, nullNodes);
+      for(const auto leaf : leaves) {
+        const idNode death = getDeath(leaf);
+        for(idNode node = leaf; node != death and not tree->isRoot(node);
+            node = tree->getParentSafe(node))
+          nodeBranch[node] = leaf;
+      }
+      nodeBranch[root] = mainBirth;
+
+      // children branches of each branch
+      std::vector<std::vector<idNode>> childBranches(noNodes);
+      for(const auto leaf : leaves) {
+        if(leaf == mainBirth)
+          continue;
+        const idNode parent = nodeBranch[getDeath(leaf)];
+        if(parent == nullNodes or parent == leaf)
+          return -2;
+        childBranches[parent].emplace_back(leaf);
+      }
+
+      const auto makeBranch = [&](const idNode birth, const int parent) {
+        const idNode death = getDeath(birth);
+        Branch branch{};
+        branch.birthNode = birth;
+        branch.deathNode = death;
+        branch.birthVertex = tree->getNode(birth)->getVertexId();
+        branch.deathVertex = tree->getNode(death)->getVertexId();
+        branch.birthValue = tree->getValue<dataType>(birth);
+        branch.deathValue = tree->getValue<dataType>(death);
+        branch.parent = parent;
+        branch.birthIndex = branch.deathIndex = -1;
+        return branch;
+      };
+
+      // compact index of the death nodes already inserted (multi-persistence
+      // pairs share their saddle)
+      std::vector<int> deathIndex(noNodes, -1);
+
+      // best-first traversal of the branch hierarchy: the parent branch is
+      // always inserted before its children, by decreasing persistence
+      using QueueElement = std::tuple<dataType, int, idNode>;
+      const auto cmp = [](const QueueElement &a, const QueueElement &b) {
+        if(std::get<0>(a) != std::get<0>(b))
+          return std::get<0>(a) < std::get<0>(b);
+        // first inserted parent first
+        return std::get<1>(a) > std::get<1>(b);
+      };
+      std::priority_queue<QueueElement, std::vector<QueueElement>,
+                          decltype(cmp)>
+        queue(cmp);
+
+      queue.emplace(makeBranch(mainBirth, -1).getPersistence(), -1, mainBirth);
+      while(!queue.empty()) {
+        const auto parent = std::get<1>(queue.top());
+        const auto birth = std::get<2>(queue.top());
+        queue.pop();
+
+        auto branch = makeBranch(birth, parent);
+        const bool newDeathNode = (deathIndex[branch.deathNode] == -1);
+        if(!newDeathNode)
+          branch.deathIndex = deathIndex[branch.deathNode];
+        this->pushBranch(branch, newDeathNode);
+        deathIndex[branch.deathNode] = branches_.back().deathIndex;
+
+        const int branchId = branches_.size() - 1;
+        for(const auto child : childBranches[birth]) {
+          queue.emplace(
+            makeBranch(child, branchId).getPersistence(), branchId, child);
+        }
+      }
+
+      return 0;
+    }
+
+    template <class dataType>
+    size_t MergeTreeHierarchy<dataType>::getNumberOfBranches(
+      const dataType persistenceThreshold) const {
+      // cutPersistence_ is non-increasing
+      const auto it = std::partition_point(
+        cutPersistence_.begin(), cutPersistence_.end(),
+        [&](const dataType pers) { return pers >= persistenceThreshold; });
+      return std::distance(cutPersistence_.begin(), it);
+    }
+
+    template <class dataType>
+    MergeTree<dataType>
+      MergeTreeHierarchy<dataType>::extractMergeTree(size_t noBranches) const {
+      noBranches = std::min(noBranches, branches_.size());
+      const int noNodes = this->getNumberOfNodes(noBranches);
+
+      MergeTree<dataType> mergeTree = createEmptyMergeTree<dataType>(noNodes);
+      FTMTree_MT *tree = &(mergeTree.tree);
+      std::vector<dataType> scalarsVector(noNodes);
+      for(int i = 0; i < noNodes; ++i)
+        tree->makeNode(i);
+
+      // saddles along each branch
+      std::vector<std::vector<int>> branchSaddles(noBranches);
+      std::vector<bool> originSet(noNodes, false);
+      for(size_t i = 0; i < noBranches; ++i) {
+        const auto &branch = branches_[i];
+        scalarsVector[branch.birthIndex] = branch.birthValue;
+        scalarsVector[branch.deathIndex] = branch.deathValue;
+        // (branches may also end at the death node of their parent, e.g.
+        // at the root of full merge trees)
+        if(branch.parent != -1
+           and branch.deathIndex != branches_[branch.parent].deathIndex)
+          branchSaddles[branch.parent].emplace_back(branch.deathIndex);
+      }
+
+      for(size_t i = 0; i < noBranches; ++i) {
+        const auto &branch = branches_[i];
+        auto &saddles = branchSaddles[i];
+        const bool increasing = branch.deathValue >= branch.birthValue;
+        std::sort(
+          saddles.begin(), saddles.end(), [&](const int a, const int b) {
+            return increasing ? scalarsVector[a] < scalarsVector[b]
+                              : scalarsVector[a] > scalarsVector[b];
+          });
+        saddles.erase(
+          std::unique(saddles.begin(), saddles.end()), saddles.end());
+
+        int down = branch.birthIndex;
+        for(const auto saddle : saddles) {
+          tree->makeSuperArc(down, saddle);
+          down = saddle;
+        }
+        tree->makeSuperArc(down, branch.deathIndex);
+
+        // multi-persistence pairs: the saddle keeps its most persistent
+        // branch as origin
+        tree->getNode(branch.birthIndex)->setOrigin(branch.deathIndex);
+        if(!originSet[branch.deathIndex]) {
+          tree->getNode(branch.deathIndex)->setOrigin(branch.birthIndex);
+          originSet[branch.deathIndex] = true;
+        }
+      }
+
+      setTreeScalars<dataType>(mergeTree, scalarsVector);
+
+      return mergeTree;
+    }
+
+    template <class dataType>
+    int MergeTreeHierarchy<dataType>::write(std::ostream &stream) const {
+      const uint64_t magic = magicNumber_;
+      const uint32_t version = formatVersion_;
+      const uint64_t noBranches = branches_.size();
+      const uint32_t dataSize = sizeof(dataType);
+      stream.write(reinterpret_cast<const char *>(&magic), sizeof(magic));
+      stream.write(reinterpret_cast<const char *>(&version), sizeof(version));
+      stream.write(reinterpret_cast<const char *>(&dataSize), sizeof(dataSize));
+      stream.write(
+        reinterpret_cast<const char *>(&noBranches), sizeof(noBranches));
+
+      for(const auto &branch : branches_) {
+        // a new death node is a saddle not shared with a previous branch
+        // (see pushBranch)
+        const uint8_t newDeathNode
+          = (branch.deathIndex == branch.birthIndex + 1);
+        const int32_t parent = branch.parent;
+        const int64_t birthVertex = branch.birthVertex;
+        const int64_t deathVertex = branch.deathVertex;
+        const int32_t deathIndex = branch.deathIndex;
+        stream.write(reinterpret_cast<const char *>(&parent), sizeof(parent));
+        stream.write(
+          reinterpret_cast<const char *>(&newDeathNode), sizeof(newDeathNode));
+        stream.write(
+          reinterpret_cast<const char *>(&deathIndex), sizeof(deathIndex));
+        stream.write(
+          reinterpret_cast<const char *>(&birthVertex), sizeof(birthVertex));
+        stream.write(
+          reinterpret_cast<const char *>(&deathVertex), sizeof(deathVertex));
+        stream.write(reinterpret_cast<const char *>(&branch.birthValue),
+                     sizeof(dataType));
+        stream.write(reinterpret_cast<const char *>(&branch.deathValue),
+                     sizeof(dataType));
+      }
+
+      return stream.good() ? 0 : -1;
+    }
+
+    template <class dataType>
+    int MergeTreeHierarchy<dataType>::read(
+      std::istream &stream,
+      const size_t maxBranches,
+      const dataType persistenceThreshold) {
+      this->clear();
+
+      uint64_t magic{}, noBranches{};
+      uint32_t version{}, dataSize{};
+      stream.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+      stream.read(reinterpret_cast<char *>(&version), sizeof(version));
+      stream.read(reinterpret_cast<char *>(&dataSize), sizeof(dataSize));
+      stream.read(reinterpret_cast<char *>(&noBranches), sizeof(noBranches));
+      if(!stream.good() or magic != magicNumber_ or version != formatVersion_
+         or dataSize != sizeof(dataType))
+        return -1;
+
+      const size_t toRead = std::min<size_t>(noBranches, maxBranches);
+      branches_.reserve(toRead);
+      for(size_t i = 0; i < toRead; ++i) {
+        int32_t parent{}, deathIndex{};
+        uint8_t newDeathNode{};
+        int64_t birthVertex{}, deathVertex{};
+        Branch branch{};
+        stream.read(reinterpret_cast<char *>(&parent), sizeof(parent));
+        stream.read(
+          reinterpret_cast<char *>(&newDeathNode), sizeof(newDeathNode));
+        stream.read(reinterpret_cast<char *>(&deathIndex), sizeof(deathIndex));
+        stream.read(
+          reinterpret_cast<char *>(&birthVertex), sizeof(birthVertex));
+        stream.read(
+          reinterpret_cast<char *>(&deathVertex), sizeof(deathVertex));
+        stream.read(
+          reinterpret_cast<char *>(&branch.birthValue), sizeof(dataType));
+        stream.read(
+          reinterpret_cast<char *>(&branch.deathValue), sizeof(dataType));
+        if(!stream.good())
+          return -2;
+
+        // the hierarchy is ordered: the remaining branches are below the cut
+        if(!cutPersistence_.empty()
+           and std::min(cutPersistence_.back(), branch.getPersistence())
+                 < persistenceThreshold)
+          break;
+
+        branch.parent = parent;
+        branch.birthVertex = birthVertex;
+        branch.deathVertex = deathVertex;
+        branch.birthNode = branch.deathNode = nullNodes;
+        branch.deathIndex = deathIndex;
+        this->pushBranch(branch, newDeathNode);
+      }
+
+      return 0;
+    }
+
+  } // namespace ftm
+} // namespace ttk
@@ -15,6 +15,7 @@
 
 #include "FTRCommon.h"
 
+#include <algorithm>
 #include <set>
 #include <vector>
 
@@ -144,6 +145,22 @@ namespace ttk {
         return roots;
       }
 
+      /// \brief findRoot but using ids of the nodes in a vector,
+      /// filling a sorted vector of unique roots.
+      /// Unlike the std::set version, the roots buffer can be reused
+      /// between calls so no allocation happens in the sweep.
+      template <typename type>
+      void findRoot(const std::vector<type> &nodesIds,
+                    std::vector<DynGraphNode<Type> *> &roots) {
+        roots.clear();
+        for(auto n : nodesIds) {
+          roots.emplace_back(findRoot(n));
+        }
+        std::sort(roots.begin(), roots.end());
+        const auto it = std::unique(roots.begin(), roots.end());
+        roots.erase(it, roots.end());
+      }
+
       /// @return true if we have merged two tree, false if it was just an
       /// intern operation
       bool insertEdge(DynGraphNode<Type> *const n1,
@@ -70,7 +70,8 @@ namespace ttk {
     };
 
     struct Comp {
-      std::set<DynGraphNode<idVertex> *> lower{}, upper{};
+      // sorted and unique, reused along the propagation
+      std::vector<DynGraphNode<idVertex> *> lower{}, upper{};
     };
 
     template <typename ScalarType, typename triangulationType>
@@ -282,16 +283,16 @@ namespace ttk {
       /// Consider edges ending at the vertex v, one by one,
       /// and find their corresponding components in the current
       /// preimage graph, each representing a component.
-      /// \ret the set of uniques representing components
-      std::set<DynGraphNode<idVertex> *>
-        lowerComps(const std::vector<idEdge> &finishingEdges,
-                   const Propagation *const localProp);
+      /// \ret (in comps) the sorted uniques representing components
+      void lowerComps(const std::vector<idEdge> &finishingEdges,
+                      const Propagation *const localProp,
+                      std::vector<DynGraphNode<idVertex> *> &comps);
 
       /// Symmetric to lowerComps
       /// \ref lowerComps
-      std::set<DynGraphNode<idVertex> *>
-        upperComps(const std::vector<idEdge> &startingEdges,
-                   const Propagation *const localProp);
+      void upperComps(const std::vector<idEdge> &startingEdges,
+                      const Propagation *const localProp,
+                      std::vector<DynGraphNode<idVertex> *> &comps);
 
       bool checkStop(const std::vector<DynGraphNode<idVertex> *> &lowerComp);
 
@@ -400,20 +401,20 @@ namespace ttk {
       idSuperArc
         mergeAtSaddle(const idNode saddleId,
                       Propagation *localProp,
-                      const std::set<DynGraphNode<idVertex> *> &lowerComp);
+                      const std::vector<DynGraphNode<idVertex> *> &lowerComp);
 
       // At a join saddle, close onped arcs only
       // do not touch local propagations
       // return the number of visible arcs merging
       idSuperArc
         mergeAtSaddle(const idNode saddleId,
-                      const std::set<DynGraphNode<idVertex> *> &lowerComp);
+                      const std::vector<DynGraphNode<idVertex> *> &lowerComp);
 
       // At a split saddle, assign new arcs at each CC in the DynGraph,
       // and launch a new propagation taking care of these arcs simultaneously
       // if hidden is true, new arcs are created hidden
       void splitAtSaddle(Propagation *const localProp,
-                         const std::set<DynGraphNode<idVertex> *> &upperComp,
+                         const std::vector<DynGraphNode<idVertex> *> &upperComp,
                          const bool hidden = false);
 
       // Return one triangle by upper CC of the vertex v
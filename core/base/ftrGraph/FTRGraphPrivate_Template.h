@@ -150,7 +150,7 @@ void ttk::ftr::FTRGraph<ScalarType, triangulationType>::growthFromSeed(
 #else
     {
 #endif
-      comp.lower = lowerComps(star.lower, localProp);
+      lowerComps(star.lower, localProp, comp.lower);
 
       if(comp.lower.size() > 1) {
         isJoin = true;
@@ -167,7 +167,7 @@ void ttk::ftr::FTRGraph<ScalarType, triangulationType>::growthFromSeed(
         mergeIn = visit(localProp, currentArc);
       }
       updatePreimage(localProp, currentArc);
-      comp.upper = upperComps(star.upper, localProp);
+      upperComps(star.upper, localProp, comp.upper);
       if(comp.upper.size() > 1) {
         isSplit = true;
       }
@@ -285,7 +285,7 @@ void ttk::ftr::FTRGraph<ScalarType, triangulationType>::growthFromSeed(
       // here to solve a 1 over thousands execution bug in parallel
       // TODO Still required ??
       visitStar(localProp, star);
-      comp.lower = lowerComps(star.lower, localProp);
+      lowerComps(star.lower, localProp, comp.lower);
     }
     saddleNode = graph_.getNodeId(upVert);
     idSuperArc const visibleMerged
@@ -297,7 +297,7 @@ void ttk::ftr::FTRGraph<ScalarType, triangulationType>::growthFromSeed(
     joinParentArc = graph_.openArc(saddleNode, localProp);
     visit(localProp, joinParentArc);
     updatePreimage(localProp, joinParentArc);
-    comp.upper = upperComps(star.upper, localProp);
+    upperComps(star.upper, localProp, comp.upper);
 
     // do not propagate
     if(hideFromHere) {
@@ -453,7 +453,7 @@ void ttk::ftr::FTRGraph<ScalarType, triangulationType>::growthSequential(
     {
 #endif
       bool isJoin = false;
-      comp.lower = lowerComps(star.lower, localProp);
+      lowerComps(star.lower, localProp, comp.lower);
       if(comp.lower.size() == 1) { // regular
         currentArc = (*comp.lower.begin())->getCorArc();
       } else if(comp.lower.size() > 1) { // join saddle
@@ -467,7 +467,7 @@ void ttk::ftr::FTRGraph<ScalarType, triangulationType>::growthSequential(
       propagations_.visit(curVert, localProp);
       updatePreimage(localProp, currentArc);
 
-      comp.upper = upperComps(star.upper, localProp);
+      upperComps(star.upper, localProp, comp.upper);
       if(!comp.upper.size()) { // max
         const idNode maxNode = graph_.makeNode(curVert);
         graph_.closeArc(currentArc, maxNode);
@@ -516,19 +516,19 @@ void ttk::ftr::FTRGraph<ScalarType, triangulationType>::visitStar(
 }
 
 template <typename ScalarType, typename triangulationType>
-std::set<ttk::ftr::DynGraphNode<ttk::ftr::idVertex> *>
-  ttk::ftr::FTRGraph<ScalarType, triangulationType>::lowerComps(
-    const std::vector<idEdge> &finishingEdges,
-    const Propagation *const localProp) {
-  return dynGraph(localProp).findRoot(finishingEdges);
+void ttk::ftr::FTRGraph<ScalarType, triangulationType>::lowerComps(
+  const std::vector<idEdge> &finishingEdges,
+  const Propagation *const localProp,
+  std::vector<DynGraphNode<idVertex> *> &comps) {
+  dynGraph(localProp).findRoot(finishingEdges, comps);
 }
 
 template <typename ScalarType, typename triangulationType>
-std::set<ttk::ftr::DynGraphNode<ttk::ftr::idVertex> *>
-  ttk::ftr::FTRGraph<ScalarType, triangulationType>::upperComps(
-    const std::vector<idEdge> &startingEdges,
-    const Propagation *const localProp) {
-  return dynGraph(localProp).findRoot(startingEdges);
+void ttk::ftr::FTRGraph<ScalarType, triangulationType>::upperComps(
+  const std::vector<idEdge> &startingEdges,
+  const Propagation *const localProp,
+  std::vector<DynGraphNode<idVertex> *> &comps) {
+  dynGraph(localProp).findRoot(startingEdges, comps);
 }
 
 template <typename ScalarType, typename triangulationType>
@@ -960,7 +960,7 @@ ttk::ftr::idSuperArc
   ttk::ftr::FTRGraph<ScalarType, triangulationType>::mergeAtSaddle(
     const idNode saddleId,
     Propagation *localProp,
-    const std::set<DynGraphNode<idVertex> *> &compVect) {
+    const std::vector<DynGraphNode<idVertex> *> &compVect) {
 
 #ifndef TTK_ENABLE_KAMIKAZE
   if(compVect.size() < 2) {
@@ -986,7 +986,8 @@ ttk::ftr::idSuperArc
 template <typename ScalarType, typename triangulationType>
 ttk::ftr::idSuperArc
   ttk::ftr::FTRGraph<ScalarType, triangulationType>::mergeAtSaddle(
-    const idNode saddleId, const std::set<DynGraphNode<idVertex> *> &compVect) {
+    const idNode saddleId,
+    const std::vector<DynGraphNode<idVertex> *> &compVect) {
   // version for the sequential arc growth, do not merge the propagations
 
 #ifndef TTK_ENABLE_KAMIKAZE
@@ -1010,7 +1011,7 @@ ttk::ftr::idSuperArc
 template <typename ScalarType, typename triangulationType>
 void ttk::ftr::FTRGraph<ScalarType, triangulationType>::splitAtSaddle(
   Propagation *const localProp,
-  const std::set<DynGraphNode<idVertex> *> &compVect,
+  const std::vector<DynGraphNode<idVertex> *> &compVect,
   const bool hidden) {
   const idVertex curVert = localProp->getCurVertex();
   const idNode curNode = graph_.getNodeId(curVert);
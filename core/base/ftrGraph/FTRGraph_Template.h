@@ -148,7 +148,10 @@ namespace ttk {
       // list of regular vertices on each arc
       // explicit build: for sampling
       if(params_.samplingLvl) {
+        Timer segmentationTime;
         graph_.buildArcSegmentation<ScalarType>(&scalars_);
+        this->printMsg("segmentation time: ", 1.0,
+                       segmentationTime.getElapsedTime(), this->threadNumber_);
       }
 
       // Debug print
@@ -5,6 +5,10 @@
 ///
 /// \brief TTK KD-Tree
 ///
+/// The nodes (one per point) are stored contiguously in depth-first order,
+/// in a pool owned by the root along with a flat array of the weights of
+/// all the nodes. Subtrees of large ranges are built in parallel.
+///
 
 #pragma once
 
@@ -13,6 +17,7 @@
 #include <Geometry.h> // for pow
 
 #include <algorithm>
+#include <array>
 #include <limits>
 #include <memory>
 
@@ -32,12 +37,18 @@ namespace ttk {
     // for the computation of nearest neighbours
     bool include_weights_{false};
 
+    // Storage of the whole tree, owned by the root: nodes in depth-first
+    // order (the first one being the root itself) and, for each node, its
+    // weights followed by the minimal weights of its subtree
+    std::unique_ptr<KDTree[]> nodes_{};
+    std::vector<dataType> weights_{};
+
   public:
     using KDTreeRoot = std::unique_ptr<KDTree>;
     using KDTreeMap = std::vector<KDTree *>;
 
-    KDTreeRoot left_{}; // Lower half for the coordinate specified
-    KDTreeRoot right_{}; // Higher half
+    KDTree *left_{}; // Lower half for the coordinate specified
+    KDTree *right_{}; // Higher half
     KDTree *parent_{};
     // ID of the object saved here. The whole object is not kept in the KDTree
     // Users should keep track of them in a table for instance
@@ -47,43 +58,47 @@ namespace ttk {
     Container coords_max_{};
     int level_{};
 
-    std::vector<dataType> weight_{};
-    std::vector<dataType> min_subweights_{};
+    // weights of this node and minimal weights of its subtree, in the
+    // storage of the root
+    dataType *weight_{};
+    dataType *min_subweights_{};
 
     KDTree() = default;
     KDTree(const bool include_weights, const int p)
       : p_{p}, include_weights_{include_weights} {
     }
 
-    KDTree(KDTree *const father, const int coords_number, const bool is_left)
-      : is_left_{is_left}, coords_number_{coords_number},
-        include_weights_{father->include_weights_}, parent_{father} {
-    }
-
     // ptNumber : Number of points in the dataset.
     // nodeNumber : Number of nodes in the tree.
     // preciseBoundingBox : Allows for a bounding box that is accurate relative
     // to the input data. It is recommended to set it to false for persistence
     // diagrams and true otherwise.
+    // threadNumber : Number of threads building the subtrees (only without
+    // a limited node number).
     KDTreeMap build(dataType *data,
                     const int &ptNumber,
                     const int &dimension,
                     const std::vector<std::vector<dataType>> &weights = {},
                     const int &weightNumber = 1,
                     const int &nodeNumber = -1,
-                    const bool &preciseBoundingBox = false);
+                    const bool &preciseBoundingBox = false,
+                    const int threadNumber = 1);
 
+    // Builds the subtree of the points idx[begin, end[, this node being
+    // stored at position begin in the depth-first order of root
     void buildRecursive(dataType *data,
-                        std::vector<int> &idx_side,
-                        const int &ptNumber,
+                        std::vector<int> &idx,
+                        const int begin,
+                        const int end,
                         const int &dimension,
                         KDTree<dataType, Container> *parent,
+                        KDTree<dataType, Container> &root,
                         KDTreeMap &correspondence_map,
                         const int &nodeNumber,
                         const int &maximumLevel,
                         int &createdNumberNode,
-                        const std::vector<std::vector<dataType>> &weights = {},
-                        const int &weightNumber = 1);
+                        const std::vector<std::vector<dataType>> &weights,
+                        const int &weightNumber);
 
     inline void updateWeight(const dataType new_weight,
                              const int weight_index = 0) {
@@ -97,6 +112,14 @@ namespace ttk {
                      KDTreeMap &neighbours,
                      std::vector<dataType> &costs,
                      const int weight_index = 0);
+    // Batched version: neighbours[i] and costs[i] are the results of the
+    // query coordinates[i]
+    void getKClosest(const unsigned int k,
+                     const std::vector<Container> &coordinates,
+                     std::vector<KDTreeMap> &neighbours,
+                     std::vector<std::vector<dataType>> &costs,
+                     const int weight_index = 0,
+                     const int threadNumber = 1);
 
     template <typename PowerFunc>
     void recursiveGetKClosest(const unsigned int k,
@@ -158,10 +181,10 @@ typename ttk::KDTree<dataType, Container>::KDTreeMap
     const std::vector<std::vector<dataType>> &weights,
     const int &weightNumber,
     const int &nodeNumber,
-    const bool &preciseBoundingBox) {
+    const bool &preciseBoundingBox,
+    const int threadNumber) {
 
   int createdNumberNode = 1;
-  int idGenerator = createdNumberNode - 1;
   int maximumLevel = 0;
 
   int correspondence_map_size = 0;
@@ -175,6 +198,17 @@ typename ttk::KDTree<dataType, Container>::KDTreeMap
 
   KDTreeMap correspondence_map(correspondence_map_size);
 
+  // one slot per point, the root keeping its own one unused
+  this->nodes_ = std::make_unique<KDTree[]>(ptNumber);
+  this->weights_.assign(static_cast<size_t>(ptNumber) * 2 * weightNumber, 0);
+  this->left_ = nullptr;
+  this->right_ = nullptr;
+  this->weight_ = nullptr;
+  this->min_subweights_ = nullptr;
+  if(ptNumber == 0) {
+    return correspondence_map;
+  }
+
   if(preciseBoundingBox) {
     // First, perform a argsort on the data
     // initialize original index locations
@@ -229,69 +263,19 @@ typename ttk::KDTree<dataType, Container>::KDTreeMap
   for(int i = 0; i < ptNumber; i++) {
     idx[i] = i;
   }
-  // sort indexes based on comparing values in coordinates
-  sort(idx.begin(), idx.end(), [&](int i1, int i2) {
-    return data[dimension * i1 + coords_number_]
-           < data[dimension * i2 + coords_number_];
-  });
-  int median_loc = (int)(ptNumber - 1) / 2;
-  int median_idx = idx[median_loc];
-
-  for(int axis = 0; axis < dimension; axis++) {
-    coordinates_[axis] = data[dimension * median_idx + axis];
-  }
-
-  if(nodeNumber == -1) {
-    correspondence_map[median_idx] = this;
-    id_ = median_idx;
-  } else {
-    correspondence_map[idGenerator] = this;
-    id_ = idGenerator;
-  }
-
-  parent_ = nullptr;
-  level_ = 0;
 
-  this->weight_.clear();
-  this->min_subweights_.clear();
-
-  if(weights.empty()) {
-    this->weight_.resize(weightNumber);
-    this->min_subweights_.resize(weightNumber);
+  if(nodeNumber == -1 && threadNumber > 1) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel num_threads(threadNumber)
+#pragma omp single nowait
+#endif // TTK_ENABLE_OPENMP
+    this->buildRecursive(data, idx, 0, ptNumber, dimension, nullptr, *this,
+                         correspondence_map, nodeNumber, maximumLevel,
+                         createdNumberNode, weights, weightNumber);
   } else {
-    for(int i = 0; i < weightNumber; i++) {
-      weight_.push_back(weights[i][median_idx]);
-      min_subweights_.push_back(weights[i][median_idx]);
-    }
-  }
-
-  if(((nodeNumber == -1) && (idx.size() > 2))
-     || ((nodeNumber != -1) && (createdNumberNode < nodeNumber))) {
-    // Build left leaf
-    std::vector<int> idx_left(median_loc);
-    for(int i = 0; i < median_loc; i++) {
-      idx_left[i] = idx[i];
-    }
-
-    this->left_
-      = std::make_unique<KDTree>(this, (coords_number_ + 1) % dimension, true);
-    this->left_->buildRecursive(data, idx_left, ptNumber, dimension, this,
-                                correspondence_map, nodeNumber, maximumLevel,
-                                createdNumberNode, weights, weightNumber);
-  }
-
-  if(((nodeNumber == -1) && (idx.size() > 1))
-     || ((nodeNumber != -1) && (createdNumberNode < nodeNumber))) {
-    // Build right leaf
-    std::vector<int> idx_right(ptNumber - median_loc - 1);
-    for(int i = 0; i < ptNumber - median_loc - 1; i++) {
-      idx_right[i] = idx[i + median_loc + 1];
-    }
-    this->right_
-      = std::make_unique<KDTree>(this, (coords_number_ + 1) % dimension, false);
-    this->right_->buildRecursive(data, idx_right, ptNumber, dimension, this,
-                                 correspondence_map, nodeNumber, maximumLevel,
-                                 createdNumberNode, weights, weightNumber);
+    this->buildRecursive(data, idx, 0, ptNumber, dimension, nullptr, *this,
+                         correspondence_map, nodeNumber, maximumLevel,
+                         createdNumberNode, weights, weightNumber);
   }
 
   return correspondence_map;
@@ -300,10 +284,12 @@ typename ttk::KDTree<dataType, Container>::KDTreeMap
 template <typename dataType, typename Container>
 void ttk::KDTree<dataType, Container>::buildRecursive(
   dataType *data,
-  std::vector<int> &idx_side,
-  const int &ptNumber,
+  std::vector<int> &idx,
+  const int begin,
+  const int end,
   const int &dimension,
   KDTree<dataType, Container> *parent,
+  KDTree<dataType, Container> &root,
   KDTreeMap &correspondence_map,
   const int &nodeNumber,
   const int &maximumLevel,
@@ -311,16 +297,21 @@ void ttk::KDTree<dataType, Container>::buildRecursive(
   const std::vector<std::vector<dataType>> &weights,
   const int &weightNumber) {
 
-  createdNumberNode++;
-  int idGenerator = createdNumberNode - 1;
+  // ids follow the creation order with a limited node number
+  int idGenerator = 0;
+  if(parent != nullptr && nodeNumber != -1) {
+    createdNumberNode++;
+    idGenerator = createdNumberNode - 1;
+  }
 
-  // First, perform a argsort on the data
-  sort(idx_side.begin(), idx_side.end(), [&](int i1, int i2) {
-    return data[dimension * i1 + coords_number_]
-           < data[dimension * i2 + coords_number_];
-  });
-  int median_loc = (int)(idx_side.size() - 1) / 2;
-  int median_idx = idx_side[median_loc];
+  // Partial sort around the median of the range
+  const int median_loc = begin + (end - begin - 1) / 2;
+  std::nth_element(idx.begin() + begin, idx.begin() + median_loc,
+                   idx.begin() + end, [&](int i1, int i2) {
+                     return data[dimension * i1 + coords_number_]
+                            < data[dimension * i2 + coords_number_];
+                   });
+  const int median_idx = idx[median_loc];
 
   for(int axis = 0; axis < dimension; axis++) {
     coordinates_[axis] = data[dimension * median_idx + axis];
@@ -335,70 +326,93 @@ void ttk::KDTree<dataType, Container>::buildRecursive(
   }
 
   parent_ = parent;
-  level_ = parent->level_ + 1;
-
-  this->weight_.clear();
-  this->min_subweights_.clear();
+  level_ = parent == nullptr ? 0 : parent->level_ + 1;
 
-  if(weights.empty()) {
-    this->weight_.resize(weightNumber);
-    this->min_subweights_.resize(weightNumber);
-  } else {
+  this->weight_ = root.weights_.data() + 2 * begin * weightNumber;
+  this->min_subweights_ = this->weight_ + weightNumber;
+  if(!weights.empty()) {
     for(int i = 0; i < weightNumber; i++) {
-      weight_.push_back(weights[i][median_idx]);
-      min_subweights_.push_back(weights[i][median_idx]);
+      weight_[i] = weights[i][median_idx];
     }
+  }
 
-    if(idx_side.size() > 1) {
-      // Once we get to a leaf, update min_subweights of the parents
-      for(int w = 0; w < weightNumber; w++) {
-        this->updateMinSubweight(w);
-      }
+  // Create bounding box (the one of the root is set by build())
+  if(parent != nullptr) {
+    for(int axis = 0; axis < dimension; axis++) {
+      coords_min_[axis] = parent_->coords_min_[axis];
+      coords_max_[axis] = parent_->coords_max_[axis];
+    }
+    if(is_left_) {
+      coords_max_[parent_->coords_number_]
+        = parent_->coordinates_[parent_->coords_number_];
+    } else {
+      coords_min_[parent_->coords_number_]
+        = parent_->coordinates_[parent_->coords_number_];
     }
   }
 
-  // Create bounding box
-  for(int axis = 0; axis < dimension; axis++) {
-    coords_min_[axis] = parent_->coords_min_[axis];
-    coords_max_[axis] = parent_->coords_max_[axis];
-  }
-  if(is_left_ && !this->isRoot()) {
-    coords_max_[parent_->coords_number_]
-      = parent_->coordinates_[parent_->coords_number_];
-  } else if(!is_left_ && !this->isRoot()) {
-    coords_min_[parent_->coords_number_]
-      = parent_->coordinates_[parent_->coords_number_];
-  }
+  const bool canGrow
+    = nodeNumber == -1
+      || ((parent == nullptr || level_ < maximumLevel)
+          && createdNumberNode < nodeNumber);
+
+  // the subtree of the range [b, e[ takes the e - b slots from b in the
+  // depth-first order: the left child follows this node, the right child
+  // follows the left subtree, hence the slot of a node is the beginning of
+  // its range (the median of this node being put at this position)
+  std::swap(idx[begin], idx[median_loc]);
+  const auto buildChild = [&](const int childBegin, const int childEnd,
+                              const bool isLeft) {
+    KDTree *child = &root.nodes_[childBegin];
+    child->is_left_ = isLeft;
+    child->coords_number_ = (coords_number_ + 1) % dimension;
+    child->p_ = p_;
+    child->include_weights_ = include_weights_;
+    child->buildRecursive(data, idx, childBegin, childEnd, dimension, this,
+                          root, correspondence_map, nodeNumber, maximumLevel,
+                          createdNumberNode, weights, weightNumber);
+    return child;
+  };
 
-  if(((nodeNumber == -1) && (idx_side.size() > 2))
-     || ((nodeNumber != -1) && (level_ < maximumLevel)
-         && (createdNumberNode < nodeNumber))) {
-    // Build left leaf
-    std::vector<int> idx_left(median_loc);
-    for(int i = 0; i < median_loc; i++) {
-      idx_left[i] = idx_side[i];
-    }
+  // large subtrees are built by concurrent tasks (the node slots and the
+  // index ranges of the two halves are disjoint)
+  const bool useTask = nodeNumber == -1 && end - begin > 16384;
+  TTK_FORCE_USE(useTask);
 
-    this->left_
-      = std::make_unique<KDTree>(this, (coords_number_ + 1) % dimension, true);
-    this->left_->buildRecursive(data, idx_left, ptNumber, dimension, this,
-                                correspondence_map, nodeNumber, maximumLevel,
-                                createdNumberNode, weights, weightNumber);
+  if(canGrow && median_loc > begin) {
+    // Build left leaf
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp task if(useTask)
+#endif // TTK_ENABLE_OPENMP
+    this->left_ = buildChild(begin + 1, median_loc + 1, true);
   }
 
-  if(((nodeNumber == -1) && (idx_side.size() > 1))
-     || ((nodeNumber != -1) && (level_ < maximumLevel)
-         && (createdNumberNode < nodeNumber))) {
+  // the node counter is shared with the left subtree
+  const bool canGrowRight
+    = nodeNumber == -1
+      || ((parent == nullptr || level_ < maximumLevel)
+          && createdNumberNode < nodeNumber);
+
+  if(canGrowRight && median_loc + 1 < end) {
     // Build right leaf
-    std::vector<int> idx_right(idx_side.size() - median_loc - 1);
-    for(unsigned int i = 0; i < idx_side.size() - median_loc - 1; i++) {
-      idx_right[i] = idx_side[i + median_loc + 1];
+    this->right_ = buildChild(median_loc + 1, end, false);
+  }
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp taskwait
+#endif // TTK_ENABLE_OPENMP
+
+  // Minimal weights of the subtree
+  for(int w = 0; w < weightNumber; w++) {
+    min_subweights_[w] = weight_[w];
+    if(left_) {
+      min_subweights_[w]
+        = std::min(min_subweights_[w], left_->min_subweights_[w]);
+    }
+    if(right_) {
+      min_subweights_[w]
+        = std::min(min_subweights_[w], right_->min_subweights_[w]);
     }
-    this->right_
-      = std::make_unique<KDTree>(this, (coords_number_ + 1) % dimension, false);
-    this->right_->buildRecursive(data, idx_right, ptNumber, dimension, this,
-                                 correspondence_map, nodeNumber, maximumLevel,
-                                 createdNumberNode, weights, weightNumber);
   }
 }
 
@@ -442,6 +456,10 @@ void ttk::KDTree<dataType, Container>::getKClosest(const unsigned int k,
   /// vector along with their costs in the "costs" vector The output is not
   /// sorted, if you are interested in the k nearest neighbours in the order,
   /// will need to sort them according to their cost.
+  if(weight_ == nullptr) {
+    // empty tree
+    return;
+  }
   if(this->isLeaf()) {
     dataType cost{};
     TTK_POW_LAMBDA(cost = this->getCost, dataType, p, coordinates);
@@ -457,6 +475,30 @@ void ttk::KDTree<dataType, Container>::getKClosest(const unsigned int k,
   // TODO sort neighbours and costs !
 }
 
+template <typename dataType, typename Container>
+void ttk::KDTree<dataType, Container>::getKClosest(
+  const unsigned int k,
+  const std::vector<Container> &coordinates,
+  std::vector<KDTreeMap> &neighbours,
+  std::vector<std::vector<dataType>> &costs,
+  const int weight_index,
+  const int threadNumber) {
+
+  neighbours.resize(coordinates.size());
+  costs.resize(coordinates.size());
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber) schedule(dynamic, 64)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < coordinates.size(); i++) {
+    neighbours[i].clear();
+    costs[i].clear();
+    this->getKClosest(k, coordinates[i], neighbours[i], costs[i], weight_index);
+  }
+
+  TTK_FORCE_USE(threadNumber);
+}
+
 template <typename dataType, typename Container>
 template <typename PowerFunc>
 void ttk::KDTree<dataType, Container>::recursiveGetKClosest(
@@ -488,28 +530,34 @@ void ttk::KDTree<dataType, Container>::recursiveGetKClosest(
     }
   }
 
-  // 2- Recursively visit KDTrees that are worth it
+  // 2- Recursively visit KDTrees that are worth it, the most promising one
+  // first so that the other one is more likely to be pruned
+  dataType bound_left{}, bound_right{};
   if(left_) {
-    const dataType max_cost = *std::max_element(costs.begin(), costs.end());
-    const dataType min_subweight = left_->min_subweights_[weight_index];
-    const dataType d_min = this->distanceToBox(*left_, coordinates, power);
-    if(costs.size() < k || d_min + min_subweight < max_cost) {
-      // 2.2- It is possible that there exists a point in this subtree that is
-      // less costly than max_cost
-      left_->recursiveGetKClosest(
-        k, coordinates, neighbours, costs, weight_index, power);
-    }
+    bound_left = this->distanceToBox(*left_, coordinates, power)
+                 + left_->min_subweights_[weight_index];
   }
-
   if(right_) {
+    bound_right = this->distanceToBox(*right_, coordinates, power)
+                  + right_->min_subweights_[weight_index];
+  }
+  const bool right_first = right_ && (!left_ || bound_right < bound_left);
+  const std::array<KDTree *, 2> children{
+    right_first ? right_ : left_, right_first ? left_ : right_};
+  const std::array<dataType, 2> bounds{
+    right_first ? bound_right : bound_left,
+    right_first ? bound_left : bound_right};
+
+  for(size_t i = 0; i < children.size(); i++) {
+    if(children[i] == nullptr) {
+      continue;
+    }
     const dataType max_cost = *std::max_element(costs.begin(), costs.end());
-    const dataType min_subweight = right_->min_subweights_[weight_index];
-    const dataType d_min = this->distanceToBox(*right_, coordinates, power);
-    if(costs.size() < k || d_min + min_subweight < max_cost) {
+    if(costs.size() < k || bounds[i] < max_cost) {
       // 2.2- It is possible that there exists a point in this subtree that is
       // less costly than max_cost
-      right_->recursiveGetKClosest(
+      children[i]->recursiveGetKClosest(
         k, coordinates, neighbours, costs, weight_index, power);
     }
   }
-}
\ No newline at end of file
+}
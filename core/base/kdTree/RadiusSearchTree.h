@@ -0,0 +1,424 @@
+/// \ingroup base
+/// \class ttk::RadiusSearchTree
+///
+/// \brief Kd-tree over a point cloud of any dimension answering fixed
+/// radius queries and computing Euclidean minimum spanning trees.
+///
+/// The space is split at the median of the axis of largest spread down to
+/// small buckets, whose coordinates are stored contiguously. Contrary to
+/// ttk::KDTree, there are no weights and no per node coordinates, which
+/// keeps the memory footprint to a copy of the points. Queries are const,
+/// hence they can be issued concurrently.
+///
+/// \sa ttk::KDTree
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace ttk {
+
+  class RadiusSearchTree {
+
+  public:
+    /**
+     * @param[in] points Point coordinates, all of the same dimension
+     */
+    RadiusSearchTree(const std::vector<std::vector<double>> &points)
+      : dim_{points.empty() ? 0 : points[0].size()}, ids_(points.size()) {
+      coords_.resize(ids_.size() * dim_);
+      for(size_t i = 0; i < ids_.size(); ++i) {
+        std::copy(
+          points[i].begin(), points[i].end(), coords_.begin() + i * dim_);
+      }
+      this->init();
+    }
+
+    /**
+     * @param[in] coords Row-major coordinates of n points
+     * @param[in] n Number of points
+     * @param[in] dim Dimension of the points
+     */
+    template <typename T>
+    RadiusSearchTree(const T *const coords, const size_t n, const size_t dim)
+      : dim_{dim}, ids_(n), coords_(coords, coords + n * dim) {
+      this->init();
+    }
+
+    inline size_t size() const {
+      return ids_.size();
+    }
+
+    /**
+     * Calls f(j, d) for every point j at Euclidean distance d lower than or
+     * equal to radius from query (of the tree dimension).
+     */
+    template <typename Func>
+    void forEachNeighbor(const double *const query,
+                         const double radius,
+                         Func f) const {
+      if(nodes_.empty()) {
+        return;
+      }
+      const double radius2 = radius * radius;
+      std::vector<size_t> stack{0};
+      while(!stack.empty()) {
+        const auto &node = nodes_[stack.back()];
+        stack.pop_back();
+        if(node.left == 0) {
+          for(size_t k = node.begin; k < node.end; ++k) {
+            const double *const p = &coords_[k * dim_];
+            double d2 = 0;
+            for(size_t l = 0; l < dim_; ++l) {
+              d2 += (p[l] - query[l]) * (p[l] - query[l]);
+            }
+            if(d2 <= radius2) {
+              f(ids_[k], std::sqrt(d2));
+            }
+          }
+          continue;
+        }
+        const double delta = query[node.axis] - node.split;
+        if(delta <= radius) {
+          stack.emplace_back(node.left);
+        }
+        if(delta >= -radius) {
+          stack.emplace_back(node.right);
+        }
+      }
+    }
+
+    /**
+     * Euclidean minimum spanning tree of the points, with the dual-tree
+     * Boruvka algorithm of
+     *
+     * "Fast Euclidean Minimum Spanning Tree: Algorithm, Analysis, and
+     * Applications" \n
+     * W. B. March, P. Ram, A. G. Gray \n
+     * Proc. of ACM SIGKDD 2010.
+     *
+     * Edges of same (squared) length are ordered by their vertex ids, hence
+     * the tree is the one of Kruskal's algorithm processing the edges by
+     * increasing (squared length, smallest id, largest id).
+     *
+     * @param[out] edges The n - 1 edges (u, v), u < v, in no particular order
+     * @param[in] threadNumber Number of threads of the traversals
+     */
+    void computeMinimumSpanningTree(
+      std::vector<std::pair<size_t, size_t>> &edges,
+      const int threadNumber = 1) const;
+
+  protected:
+    // children indices are 0 for leaves (the root is no child)
+    struct Node {
+      size_t begin, end;
+      size_t axis{};
+      double split{};
+      size_t left{}, right{};
+    };
+
+    // builds the tree and sorts the coordinates by bucket
+    void init() {
+      std::iota(ids_.begin(), ids_.end(), 0);
+      if(ids_.empty()) {
+        return;
+      }
+      this->build(0, ids_.size());
+      std::vector<double> sorted(coords_.size());
+      for(size_t i = 0; i < ids_.size(); ++i) {
+        std::copy(coords_.begin() + ids_[i] * dim_,
+                  coords_.begin() + (ids_[i] + 1) * dim_,
+                  sorted.begin() + i * dim_);
+      }
+      coords_ = std::move(sorted);
+    }
+
+    size_t build(const size_t begin, const size_t end) {
+      const size_t id = nodes_.size();
+      nodes_.emplace_back(Node{begin, end});
+      if(end - begin <= leafSize_) {
+        return id;
+      }
+
+      size_t axis{};
+      double spread{};
+      for(size_t l = 0; l < dim_; ++l) {
+        double lo = std::numeric_limits<double>::infinity();
+        double hi = -lo;
+        for(size_t k = begin; k < end; ++k) {
+          lo = std::min(lo, coords_[ids_[k] * dim_ + l]);
+          hi = std::max(hi, coords_[ids_[k] * dim_ + l]);
+        }
+        if(hi - lo > spread) {
+          spread = hi - lo;
+          axis = l;
+        }
+      }
+      if(spread == 0) {
+        return id;
+      }
+
+      const size_t mid = (begin + end) / 2;
+      std::nth_element(ids_.begin() + begin, ids_.begin() + mid,
+                       ids_.begin() + end, [&](const size_t a, const size_t b) {
+                         return coords_[a * dim_ + axis]
+                                < coords_[b * dim_ + axis];
+                       });
+      nodes_[id].axis = axis;
+      nodes_[id].split = coords_[ids_[mid] * dim_ + axis];
+      const auto left = this->build(begin, mid);
+      const auto right = this->build(mid, end);
+      nodes_[id].left = left;
+      nodes_[id].right = right;
+      return id;
+    }
+
+    static constexpr size_t leafSize_{16};
+    const size_t dim_;
+    std::vector<size_t> ids_;
+    std::vector<double> coords_{};
+    std::vector<Node> nodes_{};
+  };
+
+  inline void RadiusSearchTree::computeMinimumSpanningTree(
+    std::vector<std::pair<size_t, size_t>> &edges,
+    const int threadNumber) const {
+
+    // everything is indexed by position in the tree, not by point id
+    const size_t n = ids_.size();
+    const size_t nNodes = nodes_.size();
+    const double inf = std::numeric_limits<double>::infinity();
+    edges.clear();
+    if(n < 2) {
+      return;
+    }
+    edges.reserve(n - 1);
+
+    // bounding boxes, children are after their parent
+    std::vector<double> lo(nNodes * dim_, inf), hi(nNodes * dim_, -inf);
+    for(size_t i = nNodes; i-- > 0;) {
+      const auto &node = nodes_[i];
+      for(size_t l = 0; l < dim_; ++l) {
+        auto &nodeLo = lo[i * dim_ + l];
+        auto &nodeHi = hi[i * dim_ + l];
+        if(node.left == 0) {
+          for(size_t k = node.begin; k < node.end; ++k) {
+            nodeLo = std::min(nodeLo, coords_[k * dim_ + l]);
+            nodeHi = std::max(nodeHi, coords_[k * dim_ + l]);
+          }
+        } else {
+          const size_t a = node.left * dim_ + l, b = node.right * dim_ + l;
+          nodeLo = std::min(lo[a], lo[b]);
+          nodeHi = std::max(hi[a], hi[b]);
+        }
+      }
+    }
+    // squared distances are compared, the box ones being lower bounds
+    const auto boxDistance = [&](const size_t a, const size_t b) {
+      double d2{};
+      for(size_t l = 0; l < dim_; ++l) {
+        const double gap = std::max(lo[b * dim_ + l] - hi[a * dim_ + l],
+                                    lo[a * dim_ + l] - hi[b * dim_ + l]);
+        if(gap > 0) {
+          d2 += gap * gap;
+        }
+      }
+      return d2;
+    };
+
+    // nearest point of another component, ordered by (length, ids)
+    struct Candidate {
+      double length; // squared
+      size_t from, to;
+    };
+    const auto isShorter = [&](const Candidate &a, const Candidate &b) {
+      if(a.length != b.length) {
+        return a.length < b.length;
+      }
+      const auto ka = std::minmax(ids_[a.from], ids_[a.to]);
+      const auto kb = std::minmax(ids_[b.from], ids_[b.to]);
+      return ka < kb;
+    };
+
+    std::vector<size_t> parent(n);
+    std::iota(parent.begin(), parent.end(), 0);
+    const auto find = [&parent](size_t k) {
+      while(parent[k] != k) {
+        parent[k] = parent[parent[k]];
+        k = parent[k];
+      }
+      return k;
+    };
+
+    // component of every point and node (n when mixed)
+    std::vector<size_t> comp(n), nodeComp(nNodes);
+    std::vector<Candidate> pointBest(n);
+    std::vector<double> nodeBound(nNodes);
+    // (racy) squared lengths of the current candidates of the components, only
+    // used for pruning
+    std::vector<std::atomic<double>> compBound(n);
+
+    const auto traverse = [&](const size_t q, const size_t r,
+                              const auto &self) -> void {
+      if(nodeComp[q] != n && nodeComp[q] == nodeComp[r]) {
+        return;
+      }
+      const auto &nq = nodes_[q];
+      const auto &nr = nodes_[r];
+      if(nq.left == 0) {
+        // fresh bound of the leaf
+        double bound{};
+        for(size_t i = nq.begin; i < nq.end; ++i) {
+          bound = std::max(
+            bound, compBound[comp[i]].load(std::memory_order_relaxed));
+        }
+        nodeBound[q] = std::min(nodeBound[q], bound);
+      }
+      if(boxDistance(q, r) > nodeBound[q]) {
+        return;
+      }
+
+      if(nq.left == 0 && nr.left == 0) {
+        double bound{};
+        for(size_t i = nq.begin; i < nq.end; ++i) {
+          const auto ci = comp[i];
+          auto &best = pointBest[i];
+          // point to box pruning
+          double boxD2{};
+          for(size_t l = 0; l < dim_; ++l) {
+            const double x = coords_[i * dim_ + l];
+            const double gap = std::max(
+              lo[r * dim_ + l] - x, x - hi[r * dim_ + l]);
+            if(gap > 0) {
+              boxD2 += gap * gap;
+            }
+          }
+          const double pointBound = std::min(
+            best.length, compBound[ci].load(std::memory_order_relaxed));
+          for(size_t j = nr.begin; boxD2 <= pointBound && j < nr.end; ++j) {
+            if(comp[j] == ci) {
+              continue;
+            }
+            double d2{};
+            for(size_t l = 0; l < dim_; ++l) {
+              const double diff = coords_[i * dim_ + l] - coords_[j * dim_ + l];
+              d2 += diff * diff;
+            }
+            if(d2 > best.length) {
+              continue;
+            }
+            const Candidate c{d2, i, j};
+            if(isShorter(c, best)) {
+              best = c;
+            }
+          }
+          auto cur = compBound[ci].load(std::memory_order_relaxed);
+          while(best.length < cur
+                && !compBound[ci].compare_exchange_weak(
+                  cur, best.length, std::memory_order_relaxed)) {
+          }
+          bound = std::max(
+            bound, compBound[ci].load(std::memory_order_relaxed));
+        }
+        nodeBound[q] = std::min(nodeBound[q], bound);
+        return;
+      }
+
+      // visits the closest pair first to tighten the bounds early
+      const auto visit = [&](const size_t a, const size_t b0, const size_t b1) {
+        if(boxDistance(a, b0) <= boxDistance(a, b1)) {
+          self(a, b0, self);
+          self(a, b1, self);
+        } else {
+          self(a, b1, self);
+          self(a, b0, self);
+        }
+      };
+      if(nq.left == 0) {
+        visit(q, nr.left, nr.right);
+        return;
+      }
+      if(nr.left == 0) {
+        self(nq.left, r, self);
+        self(nq.right, r, self);
+      } else {
+        visit(nq.left, nr.left, nr.right);
+        visit(nq.right, nr.left, nr.right);
+      }
+      nodeBound[q] = std::min(
+        nodeBound[q], std::max(nodeBound[nq.left], nodeBound[nq.right]));
+    };
+
+    // query subtrees processed concurrently
+    std::vector<size_t> roots{0};
+    const size_t nRoots = 8 * static_cast<size_t>(std::max(threadNumber, 1));
+    for(size_t i = 0; i < roots.size() && roots.size() < nRoots;) {
+      if(threadNumber <= 1 || nodes_[roots[i]].left == 0) {
+        ++i;
+        continue;
+      }
+      const auto node = nodes_[roots[i]];
+      roots[i] = node.left;
+      roots.emplace_back(node.right);
+    }
+
+    while(edges.size() < n - 1) {
+      for(size_t k = 0; k < n; ++k) {
+        comp[k] = find(k);
+        pointBest[k] = Candidate{inf, k, k};
+        compBound[k].store(inf, std::memory_order_relaxed);
+      }
+      for(size_t i = nNodes; i-- > 0;) {
+        const auto &node = nodes_[i];
+        nodeBound[i] = inf;
+        if(node.left != 0) {
+          nodeComp[i] = nodeComp[node.left] == nodeComp[node.right]
+                          ? nodeComp[node.left]
+                          : n;
+          continue;
+        }
+        nodeComp[i] = comp[node.begin];
+        for(size_t k = node.begin + 1; k < node.end; ++k) {
+          if(comp[k] != nodeComp[i]) {
+            nodeComp[i] = n;
+            break;
+          }
+        }
+      }
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber) schedule(dynamic)
+#endif // TTK_ENABLE_OPENMP
+      for(size_t i = 0; i < roots.size(); ++i) {
+        traverse(roots[i], 0, traverse);
+      }
+
+      // shortest outgoing edge of every component
+      std::vector<Candidate> compBest(n, Candidate{inf, 0, 0});
+      for(size_t k = 0; k < n; ++k) {
+        if(isShorter(pointBest[k], compBest[comp[k]])) {
+          compBest[comp[k]] = pointBest[k];
+        }
+      }
+      for(size_t k = 0; k < n; ++k) {
+        if(comp[k] != k || compBest[k].length == inf) {
+          continue;
+        }
+        const auto a = find(compBest[k].from);
+        const auto b = find(compBest[k].to);
+        if(a != b) {
+          parent[a] = b;
+          edges.emplace_back(
+            std::minmax(ids_[compBest[k].from], ids_[compBest[k].to]));
+        }
+      }
+    }
+  }
+
+} // namespace ttk
@@ -0,0 +1,136 @@
+#include <LDistanceSketch.h>
+
+ttk::LDistanceSketch::LDistanceSketch() {
+  this->setDebugMsgPrefix("LDistanceSketch");
+}
+
+bool ttk::LDistanceSketch::isCompatible(const double *const sketch,
+                                        const size_t size,
+                                        const SimplexId vertexNumber,
+                                        const double fingerprint) const {
+  const size_t nBlocks = this->getBlockNumber(vertexNumber);
+  return sketch != nullptr && size == this->getSketchSize(nBlocks)
+         && sketch[0] == Version && sketch[1] == vertexNumber
+         && sketch[2] == this->SketchWidth && sketch[3] == this->SketchDepth
+         && sketch[4] == nBlocks && sketch[5] == this->SketchSeed
+         && sketch[6] == fingerprint;
+}
+
+double ttk::LDistanceSketch::getRelativeError() const {
+  if(this->SketchConfidence <= 0.0) {
+    return 0.0;
+  }
+  if(this->SketchConfidence >= 1.0) {
+    return std::numeric_limits<double>::infinity();
+  }
+
+  // The mean of the projected squared distances is unbiased, with a
+  // variance below 2 ||x - y||^4 / (width * depth), hence the bound from
+  // Chebyshev's inequality.
+  return std::sqrt(2.0
+                   / (static_cast<double>(this->SketchWidth)
+                      * this->SketchDepth * (1.0 - this->SketchConfidence)));
+}
+
+double ttk::LDistanceSketch::distance(const double *const sketch1,
+                                      const double *const sketch2,
+                                      const std::string &distanceType,
+                                      double &lower,
+                                      double &upper) const {
+
+  lower = 0.0;
+  upper = std::numeric_limits<double>::infinity();
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+
+  for(size_t i = 0; i < ParameterSize; ++i) {
+    if(sketch1[i] != sketch2[i]) {
+      this->printErr("Sketches computed with different parameters");
+      return nan;
+    }
+  }
+
+  const bool inf = distanceType == "inf";
+  const int p = inf ? 0 : std::stoi(distanceType);
+  if(!inf && p < 1) {
+    return nan;
+  }
+
+  const auto vertexNumber = static_cast<size_t>(sketch1[1]);
+  const auto width = static_cast<size_t>(sketch1[2]);
+  const auto depth = static_cast<size_t>(sketch1[3]);
+  const auto nBlocks = static_cast<size_t>(sketch1[4]);
+  const double *const proj1 = sketch1 + HeaderSize;
+  const double *const proj2 = sketch2 + HeaderSize;
+  const double *const stats1 = proj1 + width * depth;
+  const double *const stats2 = proj2 + width * depth;
+
+  // ||x - y||_p^p = sum_i |z_i|^p on each block of m vertices is bounded by:
+  //   - below: m |mean(z)|^p (Jensen),
+  //   - above: m max|z_i|^p, with max|z_i| bounded by the block ranges,
+  //   - ||z||_2^2 = m mean(z)^2 + ||z - mean(z)||^2, where the norm of the
+  //   difference of the centered fields is between the difference and the
+  //   sum of their centered norms (triangle inequality),
+  //   - the equivalence of the p-norms in dimension m.
+  double sumLower = 0.0;
+  double sumUpper = 0.0;
+  for(size_t b = 0; b < nBlocks; ++b) {
+    const double m = static_cast<double>((b + 1) * vertexNumber / nBlocks
+                                         - b * vertexNumber / nBlocks);
+    const double *const s1 = stats1 + BlockStats * b;
+    const double *const s2 = stats2 + BlockStats * b;
+
+    const double dMean = std::abs(s1[2] - s2[2]);
+    const double spread = std::max({s1[1] - s2[0], s2[1] - s1[0], 0.0});
+    const double dNorm = s1[3] - s2[3];
+    const double sNorm = s1[3] + s2[3];
+    const double l2Lower = m * dMean * dMean + dNorm * dNorm;
+    const double l2Upper
+      = std::min(m * spread * spread, m * dMean * dMean + sNorm * sNorm);
+
+    if(inf) {
+      lower = std::max({lower, dMean, std::sqrt(l2Lower / m)});
+      sumUpper = std::max(sumUpper, std::min(spread, std::sqrt(l2Upper)));
+    } else {
+      const double e = 0.5 * p;
+      const double scale = std::pow(m, 1.0 - e);
+      sumLower += std::max(m * std::pow(dMean, p),
+                           (p >= 2 ? scale : 1.0) * std::pow(l2Lower, e));
+      sumUpper += std::min(m * std::pow(spread, p),
+                           (p >= 2 ? 1.0 : scale) * std::pow(l2Upper, e));
+    }
+  }
+
+  if(inf) {
+    upper = sumUpper;
+  } else {
+    lower = std::pow(sumLower, 1.0 / p);
+    upper = std::pow(sumUpper, 1.0 / p);
+  }
+  upper = std::max(upper, lower);
+
+  if(p != 2) {
+    return 0.5 * (lower + upper);
+  }
+
+  // mean of the squared distances between the projections
+  double squared = 0.0;
+  for(size_t j = 0; j < width * depth; ++j) {
+    const double d = proj1[j] - proj2[j];
+    squared += d * d;
+  }
+  const double estimate = std::sqrt(squared / depth);
+
+  // narrow the guaranteed bounds (unless the projection is inconsistent
+  // with them, which happens with probability 1 - SketchConfidence)
+  const double eps = this->getRelativeError();
+  if(eps < 1.0) {
+    const double pLower = estimate / std::sqrt(1.0 + eps);
+    const double pUpper = estimate / std::sqrt(1.0 - eps);
+    if(pLower <= upper && pUpper >= lower) {
+      lower = std::max(lower, pLower);
+      upper = std::min(upper, pUpper);
+    }
+  }
+
+  return std::min(std::max(estimate, lower), upper);
+}
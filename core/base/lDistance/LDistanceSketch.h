@@ -0,0 +1,290 @@
+/// \ingroup base
+/// \class ttk::LDistanceSketch
+///
+/// \brief Compact summaries of scalar fields to approximate their Lp
+/// distances.
+///
+/// The sketch of a field is computed once (in O(V)) and has a size
+/// independent of the number of vertices V. The Lp distance between two
+/// fields is then approximated from their sketches only, with:
+///   - a sparse random projection (Johnson-Lindenstrauss) of the field:
+///   SketchDepth independent CountSketch projections on SketchWidth buckets,
+///   the squared L2 distance is estimated by the mean of the projected
+///   squared distances (its variance only depends on SketchWidth *
+///   SketchDepth),
+///   - quantized summaries: the vertices are split into SketchBlockNumber
+///   contiguous blocks, whose minimum, maximum, mean and centered norm give
+///   guaranteed lower and upper bounds for every p (and L-infinity).
+///
+/// For p = 2, the projection narrows the guaranteed bounds to an interval
+/// holding with probability at least SketchConfidence. For other values of
+/// p, the estimate is the middle of the guaranteed bounds.
+///
+/// Sketches are stored as flat vectors of doubles (so that they can be
+/// attached to the field data of the datasets) and can only be compared
+/// if they were computed with the same parameters. They also hold a
+/// fingerprint of the field (a hash of a strided sample of its values), so
+/// that a stored sketch is not reused once the field has changed.
+///
+/// \b Related \b publications \n
+/// "Database-friendly random projections: Johnson-Lindenstrauss with binary
+/// coins" \n
+/// Dimitris Achlioptas \n
+/// Journal of Computer and System Sciences, 2003. \n
+/// "Finding frequent items in data streams" \n
+/// Moses Charikar, Kevin Chen, Martin Farach-Colton \n
+/// Theoretical Computer Science, 2004.
+///
+/// \sa ttk::LDistance
+/// \sa ttk::LDistanceMatrix
+
+#pragma once
+
+#include <Debug.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace ttk {
+
+  class LDistanceSketch : virtual public Debug {
+  public:
+    LDistanceSketch();
+
+    inline void setSketchWidth(const int width) {
+      this->SketchWidth = std::min(std::max(width, 1), MaxWidth);
+    }
+    inline void setSketchDepth(const int depth) {
+      this->SketchDepth = std::max(depth, 1);
+    }
+    inline void setSketchBlockNumber(const int blockNumber) {
+      this->SketchBlockNumber = std::max(blockNumber, 1);
+    }
+    inline void setSketchSeed(const int seed) {
+      this->SketchSeed = std::max(seed, 0);
+    }
+    inline void setSketchConfidence(const double confidence) {
+      this->SketchConfidence = confidence;
+    }
+
+    /**
+     * Name of the field data array storing the sketch of a scalar field.
+     */
+    static inline std::string getSketchName(const std::string &fieldName) {
+      return "LDistanceSketch_" + fieldName;
+    }
+
+    /**
+     * Compute the sketch of the scalar field input.
+     */
+    template <typename dataType>
+    int computeSketch(std::vector<double> &sketch,
+                      const dataType *const input,
+                      const SimplexId vertexNumber) const;
+
+    /**
+     * Hash of a strided sample of the scalar field input, stored in its
+     * sketch. Changes outside of the sample are not detected.
+     */
+    template <typename dataType>
+    double computeFingerprint(const dataType *const input,
+                              const SimplexId vertexNumber) const;
+
+    /**
+     * Check that a sketch (e.g. read from the field data of a dataset) was
+     * computed for vertexNumber vertices with the current parameters, from
+     * a field of the given fingerprint (see computeFingerprint()).
+     */
+    bool isCompatible(const double *const sketch,
+                      const size_t size,
+                      const SimplexId vertexNumber,
+                      const double fingerprint) const;
+
+    /**
+     * Approximate the Lp distance ("inf" or an integer p >= 1) between the
+     * fields summarized by sketch1 and sketch2.
+     *
+     * @param[out] lower Lower bound of the distance.
+     * @param[out] upper Upper bound of the distance.
+     * @return The estimated distance, NaN if the sketches do not match.
+     */
+    double distance(const double *const sketch1,
+                    const double *const sketch2,
+                    const std::string &distanceType,
+                    double &lower,
+                    double &upper) const;
+
+    /**
+     * Relative error bound on the estimate of the squared L2 distance,
+     * holding with probability SketchConfidence (infinity if the sketch is
+     * too small for this confidence).
+     */
+    double getRelativeError() const;
+
+  protected:
+    // header: version, #vertices, width, depth, #blocks, seed, fingerprint
+    static constexpr size_t HeaderSize{7};
+    // leading header entries that must match to compare two sketches
+    static constexpr size_t ParameterSize{6};
+    static constexpr int Version{2};
+    // number of vertices hashed in the fingerprint
+    static constexpr SimplexId FingerprintSamples{1024};
+    // 15 bits of each hash chunk select the bucket
+    static constexpr int MaxWidth{1 << 15};
+    // min, max, mean and centered norm of each block
+    static constexpr size_t BlockStats{4};
+
+    static inline uint64_t hash(uint64_t x) {
+      // splitmix64 finalizer
+      x += 0x9e3779b97f4a7c15ULL;
+      x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+      return x ^ (x >> 31);
+    }
+
+    inline size_t getBlockNumber(const SimplexId vertexNumber) const {
+      return std::max<size_t>(
+        std::min<size_t>(this->SketchBlockNumber, vertexNumber), 1);
+    }
+
+    inline size_t getSketchSize(const size_t blockNumber) const {
+      return HeaderSize + static_cast<size_t>(this->SketchWidth)
+             * this->SketchDepth + BlockStats * blockNumber;
+    }
+
+    int SketchWidth{1024};
+    int SketchDepth{4};
+    int SketchBlockNumber{1024};
+    int SketchSeed{0};
+    double SketchConfidence{0.95};
+  };
+
+} // namespace ttk
+
+template <typename dataType>
+double ttk::LDistanceSketch::computeFingerprint(
+  const dataType *const input, const SimplexId vertexNumber) const {
+
+  const auto mix = [](const uint64_t h, const double value) {
+    uint64_t bits{};
+    std::memcpy(&bits, &value, sizeof(bits));
+    return hash(h ^ bits);
+  };
+
+  uint64_t h = hash(static_cast<uint64_t>(vertexNumber));
+  if(input != nullptr && vertexNumber > 0) {
+    const SimplexId stride
+      = std::max<SimplexId>(vertexNumber / FingerprintSamples, 1);
+    for(SimplexId i = 0; i < vertexNumber; i += stride) {
+      h = mix(h, static_cast<double>(input[i]));
+    }
+    h = mix(h, static_cast<double>(input[vertexNumber - 1]));
+  }
+
+  // 52 bits, exactly represented by a double
+  return static_cast<double>(h >> 12);
+}
+
+template <typename dataType>
+int ttk::LDistanceSketch::computeSketch(std::vector<double> &sketch,
+                                        const dataType *const input,
+                                        const SimplexId vertexNumber) const {
+
+#ifndef TTK_ENABLE_KAMIKAZE
+  if(input == nullptr || vertexNumber < 1) {
+    this->printErr("Empty input field");
+    return -1;
+  }
+#endif // TTK_ENABLE_KAMIKAZE
+
+  Timer tm{};
+
+  const size_t width = this->SketchWidth;
+  const size_t depth = this->SketchDepth;
+  const size_t nBlocks = this->getBlockNumber(vertexNumber);
+  const size_t nProj = width * depth;
+
+  sketch.assign(this->getSketchSize(nBlocks), 0.0);
+  sketch[0] = Version;
+  sketch[1] = vertexNumber;
+  sketch[2] = width;
+  sketch[3] = depth;
+  sketch[4] = nBlocks;
+  sketch[5] = this->SketchSeed;
+  sketch[6] = this->computeFingerprint(input, vertexNumber);
+  double *const proj = &sketch[HeaderSize];
+  double *const stats = proj + nProj;
+
+  // one 64-bit hash per vertex gives the buckets and signs of 4 projections
+  const size_t nKeys = (depth + 3) / 4;
+  std::vector<uint64_t> keys(nKeys);
+  for(size_t k = 0; k < nKeys; ++k) {
+    keys[k] = hash(static_cast<uint64_t>(this->SketchSeed) * nKeys + k);
+  }
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel num_threads(this->threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  {
+    std::vector<double> localProj(nProj, 0.0);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp for schedule(static)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t b = 0; b < nBlocks; ++b) {
+      const SimplexId begin = b * vertexNumber / nBlocks;
+      const SimplexId end = (b + 1) * vertexNumber / nBlocks;
+
+      double vMin = input[begin];
+      double vMax = input[begin];
+      double sum = 0.0;
+      for(SimplexId i = begin; i < end; ++i) {
+        const double v = input[i];
+        vMin = std::min(vMin, v);
+        vMax = std::max(vMax, v);
+        sum += v;
+        for(size_t k = 0; k < nKeys; ++k) {
+          const uint64_t h = hash(static_cast<uint64_t>(i) ^ keys[k]);
+          for(size_t c = 0; c < 4 && 4 * k + c < depth; ++c) {
+            const uint64_t chunk = (h >> (16 * c)) & 0xFFFF;
+            const size_t bucket = ((chunk >> 1) * width) >> 15;
+            // branchless random sign
+            const double sign = 1.0 - 2.0 * static_cast<double>(chunk & 1);
+            localProj[(4 * k + c) * width + bucket] += sign * v;
+          }
+        }
+      }
+      const double mean = sum / (end - begin);
+      double m2 = 0.0;
+      for(SimplexId i = begin; i < end; ++i) {
+        const double d = input[i] - mean;
+        m2 += d * d;
+      }
+
+      stats[BlockStats * b] = vMin;
+      stats[BlockStats * b + 1] = vMax;
+      stats[BlockStats * b + 2] = mean;
+      stats[BlockStats * b + 3] = std::sqrt(m2);
+    }
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp critical
+#endif // TTK_ENABLE_OPENMP
+    for(size_t j = 0; j < nProj; ++j) {
+      proj[j] += localProj[j];
+    }
+  }
+
+  this->printMsg("Computed sketch (" + std::to_string(sketch.size())
+                   + " values for " + std::to_string(vertexNumber)
+                   + " vertices)",
+                 1.0, tm.getElapsedTime(), this->threadNumber_,
+                 debug::LineMode::NEW, debug::Priority::DETAIL);
+
+  return 0;
+}
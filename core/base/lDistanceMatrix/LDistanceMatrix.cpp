@@ -3,3 +3,41 @@
 ttk::LDistanceMatrix::LDistanceMatrix() {
   this->setDebugMsgPrefix("LDistanceMatrix");
 }
+
+int ttk::LDistanceMatrix::executeApproximate(
+  std::vector<std::vector<double>> &output,
+  std::vector<std::vector<double>> &lowerBound,
+  std::vector<std::vector<double>> &upperBound,
+  const std::vector<const double *> &sketches) const {
+
+  const size_t nInputs = sketches.size();
+  output.assign(nInputs, std::vector<double>(nInputs, 0.0));
+  lowerBound.assign(nInputs, std::vector<double>(nInputs, 0.0));
+  upperBound.assign(nInputs, std::vector<double>(nInputs, 0.0));
+
+  const auto approximate = [&](const size_t i, const size_t j) {
+    return this->distance(sketches[i], sketches[j], this->DistanceType,
+                          lowerBound[i][j], upperBound[i][j]);
+  };
+
+  // the bounds are not checkpointed: compute every entry
+  const int status
+    = this->computeSymmetric(output, nInputs, approximate, false);
+
+  for(size_t i = 0; i < nInputs; ++i) {
+    for(size_t j = i + 1; j < nInputs; ++j) {
+      lowerBound[j][i] = lowerBound[i][j];
+      upperBound[j][i] = upperBound[i][j];
+    }
+  }
+
+  const double eps = this->getRelativeError();
+  if(this->DistanceType == "2" && eps < 1.0) {
+    this->printMsg("Squared L2 distances within "
+                     + std::to_string(100.0 * eps) + "% with probability "
+                     + std::to_string(this->SketchConfidence),
+                   debug::Priority::DETAIL);
+  }
+
+  return status;
+}
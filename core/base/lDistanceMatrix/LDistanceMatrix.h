@@ -3,6 +3,10 @@
 /// \author Pierre Guillou <pierre.guillou@lip6.fr>
 /// \date May 2020
 ///
+/// \brief Computes the matrix of the Lp distances between scalar fields,
+/// either exactly (O(V) per pair) or approximately from sketches computed
+/// once per field (see ttk::LDistanceSketch), with lower and upper bounds.
+///
 /// \b Online \b examples: \n
 ///   - <a
 ///   href="https://topology-tool-kit.github.io/examples/clusteringKelvinHelmholtzInstabilities/">
@@ -10,14 +14,17 @@
 
 #pragma once
 
+#include <DistanceMatrixEngine.h>
 #include <LDistance.h>
+#include <LDistanceSketch.h>
 #include <Wrapper.h>
 
 #include <string>
 #include <vector>
 
 namespace ttk {
-  class LDistanceMatrix : virtual public Debug {
+  class LDistanceMatrix : public DistanceMatrixEngine,
+                          public LDistanceSketch {
   public:
     LDistanceMatrix();
 
@@ -39,6 +46,26 @@ namespace ttk {
                 const std::vector<const TIn *> &inputs,
                 const size_t nPoints) const;
 
+    /**
+     * Compute the sketches of the inputs, except the ones that are already
+     * compatible with the current sketch parameters and the inputs (e.g.
+     * read from the field data of the inputs).
+     */
+    template <typename TIn>
+    int computeSketches(std::vector<std::vector<double>> &sketches,
+                        const std::vector<const TIn *> &inputs,
+                        const size_t nPoints) const;
+
+    /**
+     * Approximate the distance matrix from the sketches of the inputs, in
+     * O(sketch size) per pair. lowerBound and upperBound are filled with
+     * bounds of the distances (see ttk::LDistanceSketch::distance).
+     */
+    int executeApproximate(std::vector<std::vector<double>> &output,
+                           std::vector<std::vector<double>> &lowerBound,
+                           std::vector<std::vector<double>> &upperBound,
+                           const std::vector<const double *> &sketches) const;
+
   protected:
     std::string DistanceType{"2"};
   };
@@ -62,26 +89,25 @@ int ttk::LDistanceMatrix::execute(std::vector<TOut *> &output,
                      "LDistanceMatrix module, the output must be "
                      "fully initialized: each line pointer must not be NULL.");
 
-  LDistance worker{};
-  worker.setThreadNumber(1);
-  worker.setPrintRes(false);
-
-  // compute matrix upper triangle
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(this->threadNumber_) firstprivate(worker)
-#endif // TTK_ENABLE_OPENMP
-  for(size_t i = 0; i < nInputs; ++i) {
-    output[i][i] = 0;
-    for(size_t j = i + 1; j < nInputs; ++j) {
-      // call execute with nullptr output
-      worker.execute(inputs[i], inputs[j], {}, this->DistanceType, nPoints);
-      // store result
-      output[i][j] = worker.getResult();
-      output[j][i] = worker.getResult();
+  const auto distance = [&](const size_t i, const size_t j) {
+    LDistance worker{};
+    worker.setThreadNumber(1);
+    worker.setPrintRes(false);
+    // call execute with nullptr output
+    worker.execute(inputs[i], inputs[j], {}, this->DistanceType, nPoints);
+    return worker.getResult();
+  };
+
+  Fingerprint fingerprint{};
+  if(this->hasCheckpoint()) {
+    fingerprint.add(this->DistanceType).add(nPoints);
+    for(const auto input : inputs) {
+      fingerprint.add(input, nPoints);
     }
   }
 
-  return 0;
+  return this->computeSymmetric(
+    output, nInputs, distance, true, fingerprint.get());
 }
 
 template <typename TIn, typename TOut>
@@ -99,3 +125,31 @@ int ttk::LDistanceMatrix::execute(std::vector<std::vector<TOut>> &output,
   }
   return execute(outputRaw, inputs, nPoints);
 }
+
+template <typename TIn>
+int ttk::LDistanceMatrix::computeSketches(
+  std::vector<std::vector<double>> &sketches,
+  const std::vector<const TIn *> &inputs,
+  const size_t nPoints) const {
+
+  Timer tm{};
+
+  sketches.resize(inputs.size());
+  size_t nComputed{0};
+  for(size_t i = 0; i < inputs.size(); ++i) {
+    if(this->isCompatible(sketches[i].data(), sketches[i].size(), nPoints,
+                          this->computeFingerprint(inputs[i], nPoints))) {
+      continue;
+    }
+    if(this->computeSketch(sketches[i], inputs[i], nPoints) != 0) {
+      return -1;
+    }
+    nComputed++;
+  }
+
+  this->printMsg("Computed " + std::to_string(nComputed) + " / "
+                   + std::to_string(inputs.size()) + " sketches",
+                 1.0, tm.getElapsedTime(), this->threadNumber_);
+
+  return 0;
+}
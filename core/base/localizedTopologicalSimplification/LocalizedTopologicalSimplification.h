@@ -1079,6 +1079,119 @@ namespace ttk {
         return 0;
       }
 
+      /// This method flattens the segments of the given parent propagations
+      /// and computes the resulting global order in linear time. Vertices
+      /// outside of the segments keep their relative order: their new rank
+      /// is their old rank, minus the number of segment vertices with a
+      /// smaller order, plus the number of segment vertices inserted right
+      /// below a saddle with a smaller order. Segment vertices are then
+      /// ranked below their saddle by their (dense) local order. This is
+      /// equivalent to flattenOrder followed by computeGlobalOrder without
+      /// sorting the whole domain.
+      template <typename IT>
+      int computeGlobalOrderOfSegments(
+        IT *order,
+        const IT *localOrder,
+        std::vector<std::tuple<IT, IT, IT>> &sortedIndices,
+        std::vector<Propagation<IT> *> &parentPropagations) const {
+        ttk::Timer timer;
+
+        const IT nVertices = sortedIndices.size();
+        const IT nParentPropagations = parentPropagations.size();
+
+        // several propagations can end at the same saddle: group them
+        std::sort(parentPropagations.begin(), parentPropagations.end(),
+                  [=](const Propagation<IT> *a, const Propagation<IT> *b) {
+                    return order[a->criticalPoints.back()]
+                           < order[b->criticalPoints.back()];
+                  });
+        std::vector<IT> groups;
+        for(IT p = 0; p < nParentPropagations; p++) {
+          if(p == 0
+             || parentPropagations[p]->criticalPoints.back()
+                  != parentPropagations[p - 1]->criticalPoints.back())
+            groups.push_back(p);
+        }
+        const IT nGroups = groups.size();
+        groups.push_back(nParentPropagations);
+
+        // rank shifts: each segment vertex leaves its rank and is inserted
+        // right below its saddle
+        std::vector<IT> shift(nVertices + 1, 0);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(this->threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+        for(IT p = 0; p < nParentPropagations; p++) {
+          const auto *propagation = parentPropagations[p];
+          for(const auto &v : propagation->segment) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic update
+#endif // TTK_ENABLE_OPENMP
+            shift[order[v] + 1]--;
+          }
+          const IT segmentSize = propagation->segment.size();
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic update
+#endif // TTK_ENABLE_OPENMP
+          shift[order[propagation->criticalPoints.back()]] += segmentSize;
+        }
+        for(IT r = 0; r < nVertices; r++)
+          shift[r + 1] += shift[r];
+
+        this->printMsg("Computing Global Order", 0.2, timer.getElapsedTime(),
+                       this->threadNumber_, debug::LineMode::REPLACE);
+
+        // vertices outside of segments (segment vertices are overridden)
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(this->threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+        for(IT v = 0; v < nVertices; v++)
+          order[v] += shift[order[v]];
+
+        // segment vertices
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(this->threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+        for(IT g = 0; g < nGroups; g++) {
+          const auto *first = parentPropagations[groups[g]];
+          if(groups[g + 1] - groups[g] == 1) {
+            const IT segmentSize = first->segment.size();
+            const IT base = order[first->criticalPoints.back()] - segmentSize;
+            if(segmentSize == 1) {
+              order[first->segment[0]] = base;
+            } else {
+              // local orders are a permutation of [-segmentSize, -1]
+              for(const auto &v : first->segment)
+                order[v] = base + segmentSize + localOrder[v];
+            }
+          } else {
+            std::vector<std::pair<IT, IT>> segment;
+            for(IT p = groups[g]; p < groups[g + 1]; p++)
+              for(const auto &v : parentPropagations[p]->segment)
+                segment.emplace_back(localOrder[v], v);
+            std::sort(segment.begin(), segment.end());
+            const IT segmentSize = segment.size();
+            const IT base = order[first->criticalPoints.back()] - segmentSize;
+            for(IT i = 0; i < segmentSize; i++)
+              order[segment[i].second] = base + i;
+          }
+        }
+
+        this->printMsg("Computing Global Order", 0.8, timer.getElapsedTime(),
+                       this->threadNumber_, debug::LineMode::REPLACE);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(this->threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+        for(IT v = 0; v < nVertices; v++)
+          sortedIndices[order[v]] = std::make_tuple(order[v], localOrder[v], v);
+
+        this->printMsg("Computing Global Order", 1, timer.getElapsedTime(),
+                       this->threadNumber_);
+
+        return 0;
+      }
+
       template <typename DT, typename IT>
       int computeNumericalPerturbation(
         DT *scalars,
@@ -1181,13 +1294,9 @@ namespace ttk {
         if(status)
           return 1;
 
-        // flatten order
-        status = this->flattenOrder<IT>(order, parentPropagations);
-        if(status)
-          return 1;
-
-        // compute global offsets
-        status = this->computeGlobalOrder<IT>(order, localOrder, sortedIndices);
+        // flatten order and compute global offsets
+        status = this->computeGlobalOrderOfSegments<IT>(
+          order, localOrder, sortedIndices, parentPropagations);
         if(status)
           return 1;
 
@@ -1263,13 +1372,9 @@ namespace ttk {
         if(status)
           return 1;
 
-        // flatten order
-        status = this->flattenOrder<IT>(order, parentPropagations);
-        if(status)
-          return 1;
-
-        // compute global offsets
-        status = this->computeGlobalOrder<IT>(order, localOrder, sortedIndices);
+        // flatten order and compute global offsets
+        status = this->computeGlobalOrderOfSegments<IT>(
+          order, localOrder, sortedIndices, parentPropagations);
         if(status)
           return 1;
 
@@ -1300,6 +1405,64 @@ namespace ttk {
         return 0;
       }
 
+      /// This method collects all maxima of an order array that are not
+      /// marked in the given blacklist mask, i.e., the whitelist of maxima
+      /// that will be preserved by detectAndRemoveUnauthorizedMaxima. The
+      /// method also reports how many blacklisted vertices are maxima, so
+      /// that the caller can skip the removal if there is nothing to remove.
+      template <typename IT, class TT>
+      int computeAuthorizedMaxima(std::vector<IT> &authorizedMaxima,
+                                  IT &nBlackListedMaxima,
+                                  std::vector<char> &isMaximum,
+
+                                  const char *blackListMask,
+                                  const IT *order,
+                                  const TT *triangulation) const {
+        ttk::Timer timer;
+        this->printMsg("Collecting Authorized Maxima", 0, 0,
+                       this->threadNumber_, debug::LineMode::REPLACE);
+
+        const IT nVertices = triangulation->getNumberOfVertices();
+        isMaximum.resize(nVertices);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(this->threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+        for(IT v = 0; v < nVertices; v++) {
+          const IT &vOrder = order[v];
+          const IT nNeighbors = triangulation->getVertexNeighborNumber(v);
+          char isMax = 1;
+          for(IT n = 0; n < nNeighbors; n++) {
+            IT u{-1};
+            triangulation->getVertexNeighbor(v, n, u);
+            if(vOrder < order[u]) {
+              isMax = 0;
+              break;
+            }
+          }
+          isMaximum[v] = isMax;
+        }
+
+        // sequential gather to keep the whitelist deterministic
+        authorizedMaxima.clear();
+        nBlackListedMaxima = 0;
+        for(IT v = 0; v < nVertices; v++) {
+          if(!isMaximum[v])
+            continue;
+          if(blackListMask[v])
+            nBlackListedMaxima++;
+          else
+            authorizedMaxima.push_back(v);
+        }
+
+        this->printMsg("Collecting Authorized Maxima ("
+                         + std::to_string(nBlackListedMaxima) + "|"
+                         + std::to_string(authorizedMaxima.size()) + ")",
+                       1, timer.getElapsedTime(), this->threadNumber_);
+
+        return 0;
+      }
+
       template <typename DT, typename IT, class TT>
       int removeUnauthorizedExtrema(DT *scalars,
                                     IT *order,
@@ -1408,6 +1571,119 @@ namespace ttk {
         return 0;
       }
 
+      /// Counterpart of removeUnauthorizedExtrema where the given extrema
+      /// are the ones to remove (blacklist) and every other extremum of the
+      /// input order is preserved. This mirrors the
+      /// ConsiderIdentifierAsBlackList option of the legacy solver.
+      template <typename DT, typename IT, class TT>
+      int removeBlackListedExtrema(DT *scalars,
+                                   IT *order,
+
+                                   const TT *triangulation,
+                                   const IT *blackListedExtremaIndices,
+                                   const IT &nBlackListedExtremaIndices,
+                                   const bool &computePerturbation) const {
+        ttk::Timer globalTimer;
+
+        IT nVertices = triangulation->getNumberOfVertices();
+
+        // Allocating Memory
+        int status = 0;
+        std::vector<IT> segmentation;
+        std::vector<IT> queueMask;
+        std::vector<IT> localOrder;
+        std::vector<Propagation<IT> *> propagationMask;
+        std::vector<Propagation<IT>> propagationsMax;
+        std::vector<Propagation<IT>> propagationsMin;
+        std::vector<std::tuple<IT, IT, IT>> sortedIndices;
+
+        this->allocateMemory<IT>(segmentation, queueMask, localOrder,
+                                 propagationMask, sortedIndices,
+
+                                 nVertices);
+
+        std::vector<char> blackListMask(nVertices, 0);
+        for(IT i = 0; i < nBlackListedExtremaIndices; i++)
+          blackListMask[blackListedExtremaIndices[i]] = 1;
+
+        std::vector<IT> authorizedMaxima;
+        std::vector<char> isMaximum;
+        IT nBlackListedMaxima{0};
+
+        // Maxima
+        status = this->computeAuthorizedMaxima<IT, TT>(
+          authorizedMaxima, nBlackListedMaxima, isMaximum,
+
+          blackListMask.data(), order, triangulation);
+        if(status)
+          return 1;
+
+        if(nBlackListedMaxima > 0) {
+          this->printMsg("----------- [Removing Blacklisted Maxima]",
+                         ttk::debug::Separator::L2);
+
+          status = this->detectAndRemoveUnauthorizedMaxima<IT, TT>(
+            order, segmentation.data(), queueMask.data(), localOrder.data(),
+            propagationMask.data(), propagationsMax, sortedIndices,
+
+            triangulation, authorizedMaxima.data(),
+            static_cast<IT>(authorizedMaxima.size()));
+          if(status)
+            return 1;
+        }
+
+        // Minima (maxima of the inverted order)
+        if(this->invertOrder(order, nVertices))
+          return 1;
+
+        status = this->computeAuthorizedMaxima<IT, TT>(
+          authorizedMaxima, nBlackListedMaxima, isMaximum,
+
+          blackListMask.data(), order, triangulation);
+        if(status)
+          return 1;
+
+        if(nBlackListedMaxima > 0) {
+          this->printMsg("----------- [Removing Blacklisted Minima]",
+                         ttk::debug::Separator::L2);
+
+          status = this->detectAndRemoveUnauthorizedMaxima<IT, TT>(
+            order, segmentation.data(), queueMask.data(), localOrder.data(),
+            propagationMask.data(), propagationsMin, sortedIndices,
+
+            triangulation, authorizedMaxima.data(),
+            static_cast<IT>(authorizedMaxima.size()));
+          if(status)
+            return 1;
+        }
+
+        if(this->invertOrder(order, nVertices))
+          return 1;
+
+        // flatten scalars
+        status = this->flattenScalars<DT, IT>(
+          scalars, propagationsMax, propagationsMin);
+        if(status)
+          return 1;
+
+        // optionally compute perturbation
+        if(computePerturbation) {
+          this->printMsg(debug::Separator::L2);
+          status = this->computeNumericalPerturbation<DT, IT>(
+            scalars, sortedIndices);
+          if(status)
+            return 1;
+        }
+
+        this->printMsg(debug::Separator::L2);
+        this->printMsg(
+          "Complete", 1, globalTimer.getElapsedTime(), this->threadNumber_);
+
+        this->printMsg(debug::Separator::L1);
+
+        return 0;
+      }
+
       template <typename DT, typename IT, class TT>
       int removeNonPersistentExtrema(DT *scalars,
                                      IT *order,
@@ -468,8 +468,7 @@ namespace ttk {
                         return memT[c1 + 1 * dim2 + c2 * dim3 + 1 * dim4];
                       };
                       int size = std::max(topo1_.size(), topo2_.size()) + 1;
-                      auto costMatrix = std::vector<std::vector<dataType>>(
-                        size, std::vector<dataType>(size, 0));
+                      AssignmentMatrix<dataType> costMatrix(size, size);
                       std::vector<MatchingType> matching;
                       for(int r = 0; r < size; r++) {
                         for(int c = 0; c < size; c++) {
@@ -495,7 +494,8 @@ namespace ttk {
                           solverAuction = AssignmentAuction<dataType>();
                           assignmentSolver = &solverAuction;
                       }
-                      assignmentSolver->setInput(costMatrix);
+                      assignmentSolver->setInput(
+                        AssignmentMatrixView<dataType>{costMatrix});
                       assignmentSolver->setBalanced(true);
                       assignmentSolver->run(matching);
                       dataType d_ = memT[child1_mb + (l1 + 1) * dim2
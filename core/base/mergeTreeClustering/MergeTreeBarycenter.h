@@ -57,9 +57,6 @@ namespace ttk {
       this->setDebugMsgPrefix(
         "MergeTreeBarycenter"); // inherited from Debug: prefix will be printed
                                 // at the beginning of every msg
-#ifdef TTK_ENABLE_OPENMP4
-      omp_set_nested(1);
-#endif
     }
     ~MergeTreeBarycenter() override = default;
 
@@ -133,19 +130,21 @@ namespace ttk {
                            bool isFirstInput = true) {
       distanceMatrix.clear();
       distanceMatrix.resize(trees.size(), std::vector<double>(trees.size(), 0));
-#ifdef TTK_ENABLE_OPENMP4
-#pragma omp parallel for schedule(dynamic) \
-  num_threads(this->threadNumber_) if(parallelize_)
-#endif
+      // one task per pair, better balanced than one task per row
+      std::vector<std::pair<unsigned int, unsigned int>> pairs;
       for(unsigned int i = 0; i < trees.size(); ++i)
-        for(unsigned int j = i + 1; j < trees.size(); ++j) {
-          std::vector<std::tuple<ftm::idNode, ftm::idNode, double>> matching;
-          dataType distance;
-          computeOneDistance<dataType>(trees[i], trees2[j], matching, distance,
-                                       useDoubleInput, isFirstInput);
-          distanceMatrix[i][j] = distance;
-          distanceMatrix[j][i] = distance;
-        }
+        for(unsigned int j = i + 1; j < trees.size(); ++j)
+          pairs.emplace_back(i, j);
+      forEachTask(pairs.size(), [&](const size_t p) {
+        const auto i = pairs[p].first;
+        const auto j = pairs[p].second;
+        std::vector<std::tuple<ftm::idNode, ftm::idNode, double>> matching;
+        dataType distance;
+        computeOneDistance<dataType>(trees[i], trees2[j], matching, distance,
+                                     useDoubleInput, isFirstInput);
+        distanceMatrix[i][j] = distance;
+        distanceMatrix[j][i] = distance;
+      });
     }
 
     template <class dataType>
@@ -718,6 +717,10 @@ namespace ttk {
       mergeTreeDistance.setThreadNumber(this->threadNumber_);
       mergeTreeDistance.setDistanceSquaredRoot(true); // squared root
       mergeTreeDistance.setNodePerTask(nodePerTask_);
+      mergeTreeDistance.setParallelize(parallelize_);
+      mergeTreeDistance.setParallelEditDistanceMinSize(
+        parallelEditDistanceMinSize_);
+      mergeTreeDistance.setMemoryEfficient(memoryEfficient_);
       if(useDoubleInput) {
         double const weight = mixDistancesMinMaxPairWeight(isFirstInput);
         mergeTreeDistance.setMinMaxPairWeight(weight);
@@ -772,56 +775,11 @@ namespace ttk {
       std::vector<dataType> &distances,
       bool useDoubleInput = false,
       bool isFirstInput = true) {
-      if(not isCalled_)
-        assignmentPara(trees, baryMergeTree, matchings, distances,
-                       useDoubleInput, isFirstInput);
-      else
-        assignmentTask(trees, baryMergeTree, matchings, distances,
-                       useDoubleInput, isFirstInput);
-    }
-
-    template <class dataType>
-    void assignmentPara(
-      std::vector<ftm::FTMTree_MT *> &trees,
-      ftm::MergeTree<dataType> &baryMergeTree,
-      std::vector<std::vector<std::tuple<ftm::idNode, ftm::idNode, double>>>
-        &matchings,
-      std::vector<dataType> &distances,
-      bool useDoubleInput = false,
-      bool isFirstInput = true) {
-#ifdef TTK_ENABLE_OPENMP4
-#pragma omp parallel num_threads(this->threadNumber_) \
-  shared(baryMergeTree) if(parallelize_)
-      {
-#pragma omp single nowait
-#endif
-        assignmentTask(trees, baryMergeTree, matchings, distances,
-                       useDoubleInput, isFirstInput);
-#ifdef TTK_ENABLE_OPENMP4
-      } // pragma omp parallel
-#endif
-    }
-
-    template <class dataType>
-    void assignmentTask(
-      std::vector<ftm::FTMTree_MT *> &trees,
-      ftm::MergeTree<dataType> &baryMergeTree,
-      std::vector<std::vector<std::tuple<ftm::idNode, ftm::idNode, double>>>
-        &matchings,
-      std::vector<dataType> &distances,
-      bool useDoubleInput = false,
-      bool isFirstInput = true) {
-      for(unsigned int i = 0; i < trees.size(); ++i)
-#ifdef TTK_ENABLE_OPENMP4
-#pragma omp task firstprivate(i) UNTIED() \
-  shared(baryMergeTree, matchings, distances)
-#endif
+      forEachTask(trees.size(), [&](const size_t i) {
         computeOneDistance<dataType>(trees[i], baryMergeTree, matchings[i],
                                      distances[i], useDoubleInput,
                                      isFirstInput);
-#ifdef TTK_ENABLE_OPENMP4
-#pragma omp taskwait
-#endif
+      });
     }
 
     // ------------------------------------------------------------------------
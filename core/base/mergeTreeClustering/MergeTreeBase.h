@@ -56,6 +56,12 @@ namespace ttk {
     bool parallelize_ = true;
     int nodePerTask_ = 32;
     bool cleanTree_ = true;
+    // edit distance tables with fewer entries are filled sequentially, the
+    // enclosing loop over tree pairs provides the parallelism
+    size_t parallelEditDistanceMinSize_ = 4096;
+    // only keep the edit distance table rows still needed by the dynamic
+    // programming and store the backtracking information sparsely
+    bool memoryEfficient_ = false;
 
     // Clean correspondence
     std::vector<std::vector<int>> treesNodeCorr_;
@@ -111,6 +117,14 @@ namespace ttk {
       nodePerTask_ = npt;
     }
 
+    void setParallelEditDistanceMinSize(size_t size) {
+      parallelEditDistanceMinSize_ = size;
+    }
+
+    void setMemoryEfficient(bool memoryEfficient) {
+      memoryEfficient_ = memoryEfficient;
+    }
+
     void setBranchDecomposition(bool useBD) {
       branchDecomposition_ = useBD;
     }
@@ -155,6 +169,40 @@ namespace ttk {
       return treesNodeCorr_;
     }
 
+    // ------------------------------------------------------------------------
+    // Parallelism
+    // ------------------------------------------------------------------------
+    /**
+     * Calls f(i) for every i in [0, n[ in OpenMP tasks. A parallel region is
+     * only opened at the outermost level: nested calls (from a task or a
+     * parallel loop) add their tasks to the enclosing team instead of
+     * oversubscribing the machine with nested parallel regions.
+     */
+    template <typename Func>
+    void forEachTask(const size_t n, const Func &f) const {
+#ifdef TTK_ENABLE_OPENMP4
+      const auto spawnTasks = [&]() {
+        for(size_t i = 0; i < n; ++i) {
+#pragma omp task firstprivate(i) UNTIED() if(parallelize_)
+          f(i);
+        }
+#pragma omp taskwait
+      };
+      if(parallelize_ and omp_get_active_level() == 0) {
+#pragma omp parallel num_threads(this->threadNumber_)
+        {
+#pragma omp single nowait
+          spawnTasks();
+        } // pragma omp parallel
+      } else {
+        spawnTasks();
+      }
+#else
+      for(size_t i = 0; i < n; ++i)
+        f(i);
+#endif
+    }
+
     // ------------------------------------------------------------------------
     // Double Input
     // ------------------------------------------------------------------------
@@ -622,6 +622,11 @@ namespace ttk {
       mergeTreeBary.setAssignmentSolver(assignmentSolverID_);
       mergeTreeBary.setIsCalled(true);
       mergeTreeBary.setThreadNumber(this->threadNumber_);
+      mergeTreeBary.setParallelize(parallelize_);
+      mergeTreeBary.setNodePerTask(nodePerTask_);
+      mergeTreeBary.setParallelEditDistanceMinSize(
+        parallelEditDistanceMinSize_);
+      mergeTreeBary.setMemoryEfficient(memoryEfficient_);
       mergeTreeBary.setDistanceSquaredRoot(true); // squared root
       mergeTreeBary.setProgressiveBarycenter(progressiveBarycenter_);
       mergeTreeBary.setDeterministic(deterministic_);
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <stack>
 #include <thread>
 
@@ -64,9 +65,6 @@ namespace ttk {
       this->setDebugMsgPrefix(
         "MergeTreeDistance"); // inherited from Debug: prefix will be printed at
                               // the beginning of every msg
-#ifdef TTK_ENABLE_OPENMP4
-      omp_set_nested(1);
-#endif
     }
     ~MergeTreeDistance() override = default;
 
@@ -118,16 +116,10 @@ namespace ttk {
     // Assignment Problem
     // ------------------------------------------------------------------------
     template <class dataType>
-    void
-      runAssignmentProblemSolver(std::vector<std::vector<dataType>> &costMatrix,
-                                 std::vector<MatchingType> &matchings) {
-      AssignmentSolver<dataType> *assignmentSolver;
-      AssignmentExhaustive<dataType> solverExhaustive;
-      AssignmentMunkres<dataType> solverMunkres;
-      AssignmentAuction<dataType> solverAuction;
-
-      int const nRows = costMatrix.size() - 1;
-      int const nCols = costMatrix[0].size() - 1;
+    void runAssignmentProblemSolver(AssignmentMatrix<dataType> &costMatrix,
+                                    std::vector<MatchingType> &matchings) {
+      int const nRows = costMatrix.rows() - 1;
+      int const nCols = costMatrix.cols() - 1;
       int const max_dim = std::max(nRows, nCols);
       int const min_dim = std::min(nRows, nCols);
 
@@ -135,33 +127,39 @@ namespace ttk {
       if((min_dim <= 2 and max_dim <= 2) or (min_dim <= 1 and max_dim <= 6))
         assignmentSolverID = 1;
 
+      // only build the selected solver, which reads costMatrix in place
+      const auto solve = [&](AssignmentSolver<dataType> &assignmentSolver) {
+        assignmentSolver.setInput(AssignmentMatrixView<dataType>{costMatrix});
+        assignmentSolver.setBalanced(false);
+        assignmentSolver.run(matchings);
+      };
       switch(assignmentSolverID) {
-        case 1:
-          solverExhaustive = AssignmentExhaustive<dataType>();
-          assignmentSolver = &solverExhaustive;
+        case 1: {
+          AssignmentExhaustive<dataType> solverExhaustive;
+          solve(solverExhaustive);
           break;
-        case 2:
-          solverMunkres = AssignmentMunkres<dataType>();
-          assignmentSolver = &solverMunkres;
+        }
+        case 2: {
+          AssignmentMunkres<dataType> solverMunkres;
+          solve(solverMunkres);
           break;
+        }
         case 0:
-        default:
-          solverAuction = AssignmentAuction<dataType>();
+        default: {
+          AssignmentAuction<dataType> solverAuction;
           solverAuction.setEpsilon(auctionEpsilon_);
           solverAuction.setEpsilonDiviserMultiplier(auctionEpsilonDiviser_);
           solverAuction.setNumberOfRounds(auctionRound_);
-          assignmentSolver = &solverAuction;
+          solve(solverAuction);
+        }
       }
-      assignmentSolver->setInput(costMatrix);
-      assignmentSolver->setBalanced(false);
-      assignmentSolver->run(matchings);
     }
 
     template <class dataType>
     void createCostMatrix(std::vector<std::vector<dataType>> &treeTable,
                           std::vector<ftm::idNode> &children1,
                           std::vector<ftm::idNode> &children2,
-                          std::vector<std::vector<dataType>> &costMatrix) {
+                          AssignmentMatrix<dataType> &costMatrix) {
       unsigned int nRows = children1.size(), nCols = children2.size();
       for(unsigned int i = 0; i < nRows; ++i) {
         int const forestTableI = children1[i] + 1;
@@ -213,8 +211,7 @@ namespace ttk {
       std::vector<std::tuple<int, int>> &forestAssignment) {
       // --- Create cost matrix
       int nRows = children1.size(), nCols = children2.size();
-      std::vector<std::vector<dataType>> costMatrix(
-        nRows + 1, std::vector<dataType>(nCols + 1));
+      AssignmentMatrix<dataType> costMatrix(nRows + 1, nCols + 1);
       createCostMatrix(treeTable, children1, children2, costMatrix);
 
       // assignmentProblemSize[costMatrix.size()*costMatrix[0].size()]++;
@@ -435,6 +432,26 @@ namespace ttk {
       std::vector<std::tuple<ftm::idNode, ftm::idNode, double>> &outputMatching,
       int startR,
       int startC) {
+      backtrackMatching<dataType>(
+        tree1, tree2,
+        [&](int i, int j) { return treeBackTable[i][j]; },
+        [&](int i, int j) -> const std::vector<std::tuple<int, int>> & {
+          return forestBackTable[i][j];
+        },
+        outputMatching, startR, startC);
+    }
+
+    // getTreeBack(i, j) and getForestBack(i, j) return the backtracking
+    // information of the cell (i, j) of the tree and forest tables
+    template <class dataType, class TreeBack, class ForestBack>
+    void backtrackMatching(
+      ftm::FTMTree_MT *tree1,
+      ftm::FTMTree_MT *tree2,
+      const TreeBack &getTreeBack,
+      const ForestBack &getForestBack,
+      std::vector<std::tuple<ftm::idNode, ftm::idNode, double>> &outputMatching,
+      int startR,
+      int startC) {
       outputMatching.clear();
       std::queue<std::tuple<int, int, bool>> backQueue;
       backQueue.emplace(startR, startC, true);
@@ -446,8 +463,9 @@ namespace ttk {
         int const j = std::get<1>(elem);
 
         if(useTreeTable) {
-          int const tupleI = std::get<0>(treeBackTable[i][j]);
-          int const tupleJ = std::get<1>(treeBackTable[i][j]);
+          std::tuple<int, int> const treeBack = getTreeBack(i, j);
+          int const tupleI = std::get<0>(treeBack);
+          int const tupleJ = std::get<1>(treeBack);
           if(tupleI != 0 && tupleJ != 0) {
             useTreeTable = (tupleI != i || tupleJ != j);
             backQueue.emplace(tupleI, tupleJ, useTreeTable);
@@ -462,7 +480,7 @@ namespace ttk {
             }
           }
         } else {
-          for(std::tuple<int, int> forestBackElem : forestBackTable[i][j]) {
+          for(std::tuple<int, int> forestBackElem : getForestBack(i, j)) {
             int const tupleI = std::get<0>(forestBackElem);
             int const tupleJ = std::get<1>(forestBackElem);
             if(tupleI != 0 && tupleJ != 0) {
@@ -483,6 +501,44 @@ namespace ttk {
                       ftm::FTMTree_MT *tree2,
                       std::vector<std::tuple<ftm::idNode, ftm::idNode, double>>
                         &outputMatching) {
+      tree1->getAllNodeLevel(tree1Level_);
+      tree2->getAllNodeLevel(tree2Level_);
+      tree2->getLevelToNode(tree2LevelToNode_);
+
+      // ---------------------
+      // ----- Compute edit distance and matching
+      // --------------------
+      dataType distance
+        = (memoryEfficient_
+             ? compactEditDistance<dataType>(tree1, tree2, outputMatching)
+             : denseEditDistance<dataType>(tree1, tree2, outputMatching));
+      if(branchDecomposition_) {
+        if(not useMinMaxPair_) {
+          if(onlyEmptyTreeDistance_)
+            distance -= deleteCost<dataType>(tree1, tree1->getRoot());
+          else
+            distance -= relabelCost<dataType>(
+              tree1, tree1->getRoot(), tree2, tree2->getRoot());
+        } else {
+          if(minMaxPairWeight_ != 1.0) {
+            auto cost = relabelCost<dataType>(
+              tree1, tree1->getRoot(), tree2, tree2->getRoot());
+            distance = distance - cost + minMaxPairWeight_ * cost;
+          }
+        }
+      }
+      if(distanceSquaredRoot_)
+        distance = std::sqrt(distance);
+
+      return distance;
+    }
+
+    template <class dataType>
+    dataType denseEditDistance(
+      ftm::FTMTree_MT *tree1,
+      ftm::FTMTree_MT *tree2,
+      std::vector<std::tuple<ftm::idNode, ftm::idNode, double>>
+        &outputMatching) {
       // ---------------------
       // ----- Init dynamic programming tables
       // --------------------
@@ -503,10 +559,6 @@ namespace ttk {
       int const indR = tree1->getRoot() + 1;
       int const indC = tree2->getRoot() + 1;
 
-      tree1->getAllNodeLevel(tree1Level_);
-      tree2->getAllNodeLevel(tree2Level_);
-      tree2->getLevelToNode(tree2LevelToNode_);
-
       // ---------------------
       // ----- Compute edit distance
       // --------------------
@@ -515,23 +567,6 @@ namespace ttk {
       dataType distance = treeTable[indR][indC];
       if(onlyEmptyTreeDistance_)
         distance = treeTable[indR][0];
-      if(branchDecomposition_) {
-        if(not useMinMaxPair_) {
-          if(onlyEmptyTreeDistance_)
-            distance -= deleteCost<dataType>(tree1, tree1->getRoot());
-          else
-            distance -= relabelCost<dataType>(
-              tree1, tree1->getRoot(), tree2, tree2->getRoot());
-        } else {
-          if(minMaxPairWeight_ != 1.0) {
-            auto cost = relabelCost<dataType>(
-              tree1, tree1->getRoot(), tree2, tree2->getRoot());
-            distance = distance - cost + minMaxPairWeight_ * cost;
-          }
-        }
-      }
-      if(distanceSquaredRoot_)
-        distance = std::sqrt(distance);
 
       // ---------------------
       // ----- Compute matching
@@ -663,7 +698,12 @@ namespace ttk {
       Timer t_dyn;
       t_assignment_time_ = 0;
 
-      if(parallelize_) {
+      // small tables are not worth the tasking overhead
+      const bool parallelTable
+        = parallelize_
+          and static_cast<size_t>(nRows) * nCols
+                >= parallelEditDistanceMinSize_;
+      if(parallelTable) {
         parallelEditDistance(tree1, tree2, treeTable, forestTable,
                              treeBackTable, forestBackTable, nRows, nCols);
       } else {
@@ -684,7 +724,7 @@ namespace ttk {
       }
 
       printMsg("Dynamic programing", 1, t_dyn.getElapsedTime(),
-               this->threadNumber_, debug::LineMode::NEW,
+               parallelTable ? this->threadNumber_ : 1, debug::LineMode::NEW,
                debug::Priority::INFO);
       if(not parallelize_)
         printMsg("Assignment problems", 1, t_assignment_time_,
@@ -764,6 +804,203 @@ namespace ttk {
       }
     }
 
+    // ------------------------------------------------------------------------
+    // Memory efficient version
+    // ------------------------------------------------------------------------
+    // Nodes reachable from the root, every node being after its children
+    void getPostOrder(ftm::FTMTree_MT *tree, std::vector<ftm::idNode> &order) {
+      order.clear();
+      std::stack<ftm::idNode> nodeStack;
+      nodeStack.emplace(tree->getRoot());
+      std::vector<ftm::idNode> children;
+      while(!nodeStack.empty()) {
+        ftm::idNode const node = nodeStack.top();
+        nodeStack.pop();
+        order.emplace_back(node);
+        tree->getChildren(node, children);
+        for(ftm::idNode const child : children)
+          nodeStack.emplace(child);
+      }
+      std::reverse(order.begin(), order.end());
+    }
+
+    // With the branch decomposition, matching nodeI and nodeJ costs at least
+    // the distance between their persistence pairs, when it exceeds the cost
+    // of deleting both subtrees the assignment problems never strictly
+    // prefer this pair and its forest distance is not computed
+    template <class dataType>
+    bool isPrunedPair(ftm::FTMTree_MT *tree1,
+                      ftm::FTMTree_MT *tree2,
+                      ftm::idNode nodeI,
+                      ftm::idNode nodeJ,
+                      std::vector<std::vector<dataType>> &treeTable) {
+      int const i = nodeI + 1, j = nodeJ + 1;
+      return relabelCost<dataType>(tree1, nodeI, tree2, nodeJ)
+             >= treeTable[i][0] + treeTable[0][j];
+    }
+
+    // Sequential dynamic programming where the rows of the tables are only
+    // allocated from the processing of their tree1 node to the completion of
+    // the row of its parent, and where only the non trivial backtracking
+    // information is kept
+    template <class dataType>
+    dataType compactEditDistance(
+      ftm::FTMTree_MT *tree1,
+      ftm::FTMTree_MT *tree2,
+      std::vector<std::tuple<ftm::idNode, ftm::idNode, double>>
+        &outputMatching) {
+      Timer t_dyn;
+      t_assignment_time_ = 0;
+
+      size_t const nRows = tree1->getNumberOfNodes() + 1;
+      size_t const nCols = tree2->getNumberOfNodes() + 1;
+      std::vector<std::vector<dataType>> treeTable(nRows), forestTable(nRows);
+      std::vector<std::vector<bool>> prunedTable(nRows);
+      std::vector<std::vector<std::tuple<int, int>>> treeBackTable(nRows);
+      std::vector<std::vector<std::vector<std::tuple<int, int>>>>
+        forestBackTable(nRows);
+
+      // Sparse backtracking tables, cells of each row sorted by column, a
+      // missing tree cell (i, j) stands for (i, j) itself
+      std::vector<std::vector<std::pair<int, std::tuple<int, int>>>>
+        treeBackRows(nRows);
+      std::vector<
+        std::vector<std::pair<int, std::vector<std::tuple<int, int>>>>>
+        forestBackRows(nRows);
+
+      std::vector<ftm::idNode> tree1Order, tree2Order;
+      getPostOrder(tree1, tree1Order);
+      getPostOrder(tree2, tree2Order);
+
+      // Distance empty tree to T2
+      treeTable[0].resize(nCols);
+      forestTable[0].resize(nCols);
+      if(not onlyEmptyTreeDistance_)
+        for(ftm::idNode const nodeJ : tree2Order) {
+          computeEmptyToForestDistance(
+            tree2, nodeJ, nodeJ + 1, treeTable, forestTable);
+          computeEmptyToSubtreeDistance(
+            tree2, nodeJ, nodeJ + 1, treeTable, forestTable);
+        }
+
+      const auto releaseRow = [](auto &table, int i) {
+        std::remove_reference_t<decltype(table[i])>().swap(table[i]);
+      };
+
+      size_t liveRows = 1, maxLiveRows = 1, nPruned = 0;
+      std::vector<ftm::idNode> children1, children2;
+      for(ftm::idNode const nodeI : tree1Order) {
+        int const i = nodeI + 1;
+        treeTable[i].resize(nCols);
+        forestTable[i].resize(nCols);
+        prunedTable[i].resize(nCols);
+        maxLiveRows = std::max(maxLiveRows, ++liveRows);
+
+        // Distance T1 subtree to empty tree
+        computeForestToEmptyDistance(tree1, nodeI, i, treeTable, forestTable);
+        computeSubtreeToEmptyDistance(tree1, nodeI, i, treeTable, forestTable);
+
+        tree1->getChildren(nodeI, children1);
+        if(not onlyEmptyTreeDistance_) {
+          treeBackTable[i].resize(nCols);
+          forestBackTable[i].resize(nCols);
+
+          // Distance T1 subtree to T2 subtrees
+          bool const prune = branchDecomposition_ and not keepSubtree_
+                             and nodeI != tree1->getRoot();
+          for(ftm::idNode const nodeJ : tree2Order) {
+            if(not keepSubtree_ and tree1Level_[nodeI] != tree2Level_[nodeJ])
+              continue;
+            int const j = nodeJ + 1;
+            if(prune and isPrunedPair(tree1, tree2, nodeI, nodeJ, treeTable)) {
+              treeTable[i][j] = treeTable[i][0] + treeTable[0][j];
+              prunedTable[i][j] = true;
+              ++nPruned;
+              continue;
+            }
+            tree2->getChildren(nodeJ, children2);
+            computeForestsDistance(tree1, tree2, i, j, treeTable, forestTable,
+                                   forestBackTable, children1, children2);
+            computeSubtreesDistance(tree1, tree2, i, j, nodeI, nodeJ,
+                                    treeTable, forestTable, treeBackTable,
+                                    children1, children2);
+          }
+
+          // Keep the backtracking information that can not be deduced,
+          // assigning a pruned pair amounts to not assigning its nodes
+          for(size_t j = 0; j < nCols; ++j) {
+            int const tupleI = std::get<0>(treeBackTable[i][j]);
+            int const tupleJ = std::get<1>(treeBackTable[i][j]);
+            if((tupleI != 0 or tupleJ != 0)
+               and (tupleI != i or tupleJ != (int)j))
+              treeBackRows[i].emplace_back(j, treeBackTable[i][j]);
+            auto &forestBack = forestBackTable[i][j];
+            if(nPruned != 0)
+              forestBack.erase(
+                std::remove_if(forestBack.begin(), forestBack.end(),
+                               [&](const std::tuple<int, int> &elem) {
+                                 return prunedTable[std::get<0>(elem)]
+                                                   [std::get<1>(elem)];
+                               }),
+                forestBack.end());
+            if(not forestBack.empty())
+              forestBackRows[i].emplace_back(j, std::move(forestBack));
+          }
+          releaseRow(treeBackTable, i);
+          releaseRow(forestBackTable, i);
+        }
+
+        // The rows of the children are not needed anymore
+        for(ftm::idNode const child : children1) {
+          releaseRow(treeTable, child + 1);
+          releaseRow(forestTable, child + 1);
+          releaseRow(prunedTable, child + 1);
+          --liveRows;
+        }
+      }
+
+      int const indR = tree1->getRoot() + 1;
+      int const indC = tree2->getRoot() + 1;
+      dataType const distance
+        = treeTable[indR][onlyEmptyTreeDistance_ ? 0 : indC];
+
+      printMsg("Dynamic programing", 1, t_dyn.getElapsedTime(), 1,
+               debug::LineMode::NEW, debug::Priority::INFO);
+      printMsg("Assignment problems", 1, t_assignment_time_,
+               this->threadNumber_, debug::LineMode::NEW,
+               debug::Priority::INFO);
+      std::stringstream ss;
+      ss << "Rows: " << maxLiveRows << "/" << nRows
+         << " max. allocated, pruned pairs: " << nPruned;
+      printMsg(ss.str(), debug::Priority::DETAIL);
+
+      // ---------------------
+      // ----- Compute matching
+      // --------------------
+      outputMatching.clear();
+      if(onlyEmptyTreeDistance_)
+        return distance;
+      const auto findCell = [](const auto &row, int j) {
+        auto it = std::lower_bound(
+          row.begin(), row.end(), j,
+          [](const auto &cell, int col) { return cell.first < col; });
+        return (it != row.end() and it->first == j) ? &(it->second) : nullptr;
+      };
+      const std::vector<std::tuple<int, int>> noForestBack;
+      backtrackMatching<dataType>(
+        tree1, tree2,
+        [&](int i, int j) {
+          const auto cell = findCell(treeBackRows[i], j);
+          return cell ? *cell : std::make_tuple(i, j);
+        },
+        [&](int i, int j) -> const std::vector<std::tuple<int, int>> & {
+          const auto cell = findCell(forestBackRows[i], j);
+          return cell ? *cell : noForestBack;
+        },
+        outputMatching, indR, indC);
+
+      return distance;
+    }
     // ------------------------------------------------------------------------
     // Parallel version
     // ------------------------------------------------------------------------
@@ -881,18 +1118,27 @@ namespace ttk {
       std::vector<int> &treeChildDone,
       std::vector<bool> &treeNodeDone,
       std::queue<ftm::idNode> &treeQueue) {
-#ifdef TTK_ENABLE_OPENMP4
-#pragma omp parallel num_threads(this->threadNumber_) if(firstCall)
-      {
-#pragma omp single nowait
-#endif
+      const auto spawnTasks = [&]() {
         parallelTreeDistanceTask(tree1, tree2, isTree1, i, tree1Leaves,
                                  tree1NodeChildSize, tree2Leaves,
                                  tree2NodeChildSize, treeTable, forestTable,
                                  treeBackTable, forestBackTable, nodeT,
                                  treeChildDone, treeNodeDone, treeQueue);
+      };
 #ifdef TTK_ENABLE_OPENMP4
-      } // pragma omp parallel
+      // from a task of the barycenter or clustering (see forEachTask), the
+      // tasks are added to the enclosing team instead of a nested one
+      if(firstCall and omp_get_active_level() == 0) {
+#pragma omp parallel num_threads(this->threadNumber_)
+        {
+#pragma omp single nowait
+          spawnTasks();
+        } // pragma omp parallel
+      } else {
+        spawnTasks();
+      }
+#else
+      spawnTasks();
 #endif
 
       TTK_FORCE_USE(firstCall);
@@ -1048,17 +1294,25 @@ namespace ttk {
       std::vector<int> &treeChildDone,
       std::vector<bool> &treeNodeDone,
       std::queue<ftm::idNode> &treeQueue) {
-#ifdef TTK_ENABLE_OPENMP4
-#pragma omp parallel num_threads(this->threadNumber_)
-      {
-#pragma omp single nowait
-#endif
+      const auto spawnTasks = [&]() {
         parallelEmptyTreeDistanceTask(tree, isTree1, treeLeaves,
                                       treeNodeChildSize, treeTable, forestTable,
                                       treeBackTable, forestBackTable, nodeT,
                                       treeChildDone, treeNodeDone, treeQueue);
+      };
 #ifdef TTK_ENABLE_OPENMP4
-      } // pragma omp parallel
+      // same as parallelTreeDistancePara: no nested team inside a task
+      if(omp_get_active_level() == 0) {
+#pragma omp parallel num_threads(this->threadNumber_)
+        {
+#pragma omp single nowait
+          spawnTasks();
+        } // pragma omp parallel
+      } else {
+        spawnTasks();
+      }
+#else
+      spawnTasks();
 #endif
     }
 
@@ -213,8 +213,7 @@ namespace ttk {
           int size = std::max(tree1->getNumberOfChildren(curr1),
                               tree2->getNumberOfChildren(curr2))
                      + 1;
-          auto costMatrix = std::vector<std::vector<dataType>>(
-            size, std::vector<dataType>(size, 0));
+          AssignmentMatrix<dataType> costMatrix(size, size);
           std::vector<MatchingType> matching;
           for(int r = 0; r < size; r++) {
             for(int c = 0; c < size; c++) {
@@ -240,7 +239,8 @@ namespace ttk {
               solverAuction = AssignmentAuction<dataType>();
               assignmentSolver = &solverAuction;
           }
-          assignmentSolver->setInput(costMatrix);
+          assignmentSolver->setInput(
+            AssignmentMatrixView<dataType>{costMatrix});
           assignmentSolver->setBalanced(true);
           assignmentSolver->run(matching);
           dataType d_ = editCost_Persistence<dataType>(
@@ -540,8 +540,7 @@ namespace ttk {
                   int size = std::max(tree1->getNumberOfChildren(curr1),
                                       tree2->getNumberOfChildren(curr2))
                              + 1;
-                  auto costMatrix = std::vector<std::vector<dataType>>(
-                    size, std::vector<dataType>(size, 0));
+                  AssignmentMatrix<dataType> costMatrix(size, size);
                   std::vector<MatchingType> matching;
                   for(int r = 0; r < size; r++) {
                     for(int c = 0; c < size; c++) {
@@ -567,7 +566,8 @@ namespace ttk {
                       solverAuction = AssignmentAuction<dataType>();
                       assignmentSolver = &solverAuction;
                   }
-                  assignmentSolver->setInput(costMatrix);
+                  assignmentSolver->setInput(
+                    AssignmentMatrixView<dataType>{costMatrix});
                   assignmentSolver->setBalanced(true);
                   assignmentSolver->run(matching);
                   dataType d_ = editCost_Persistence<dataType>(
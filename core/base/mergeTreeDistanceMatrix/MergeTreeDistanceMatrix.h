@@ -20,6 +20,7 @@
 #include <Debug.h>
 
 #include <BranchMappingDistance.h>
+#include <DistanceMatrixEngine.h>
 #include <FTMTree.h>
 #include <FTMTreeUtils.h>
 #include <MergeTreeBase.h>
@@ -33,7 +34,8 @@ namespace ttk {
    * distance between multiple merge trees and output a distance matrix.
    */
   class MergeTreeDistanceMatrix : virtual public Debug,
-                                  virtual public MergeTreeBase {
+                                  virtual public MergeTreeBase,
+                                  public DistanceMatrixEngine {
   protected:
     int baseModule_ = 0;
     int branchMetric_ = 0;
@@ -80,120 +82,124 @@ namespace ttk {
     template <class dataType>
     void execute(std::vector<ftm::MergeTree<dataType>> &ftmtrees,
                  std::vector<std::vector<double>> &distanceMatrix) {
-      for(unsigned int i = 0; i < distanceMatrix.size(); ++i) {
-        if(i % std::max(int(distanceMatrix.size() / 10), 1) == 0) {
-          std::stringstream stream;
-          stream << i << " / " << distanceMatrix.size();
-          printMsg(stream.str());
+      const auto distance = [&](const size_t i, const size_t j) {
+        // Execute
+        if(baseModule_ == 1) {
+          BranchMappingDistance branchDist;
+          branchDist.setBaseMetric(branchMetric_);
+          branchDist.setAssignmentSolver(assignmentSolverID_);
+          branchDist.setSquared(not distanceSquaredRoot_);
+          dataType dist = branchDist.editDistance_branch<dataType>(
+            &(ftmtrees[i].tree), &(ftmtrees[j].tree));
+          return static_cast<double>(dist);
+        } else if(baseModule_ == 2) {
+          PathMappingDistance pathDist;
+          pathDist.setBaseMetric(pathMetric_);
+          pathDist.setAssignmentSolver(assignmentSolverID_);
+          pathDist.setSquared(not distanceSquaredRoot_);
+          pathDist.setComputeMapping(true);
+          dataType dist = pathDist.editDistance_path<dataType>(
+            &(ftmtrees[i].tree), &(ftmtrees[j].tree));
+          return static_cast<double>(dist);
         }
-
-        BranchMappingDistance branchDist;
-        branchDist.setBaseMetric(branchMetric_);
-        branchDist.setAssignmentSolver(assignmentSolverID_);
-        branchDist.setSquared(not distanceSquaredRoot_);
-        PathMappingDistance pathDist;
-        pathDist.setBaseMetric(pathMetric_);
-        pathDist.setAssignmentSolver(assignmentSolverID_);
-        pathDist.setSquared(not distanceSquaredRoot_);
-        pathDist.setComputeMapping(true);
-
-        distanceMatrix[i][i] = 0.0;
-        // compareTrees(trees[i],&(ftmtrees[i].tree));
-        for(unsigned int j = i + 1; j < distanceMatrix[0].size(); ++j) {
-          // Execute
-          if(baseModule_ == 0) {
-            distanceMatrix[i][j] = 0;
-          } else if(baseModule_ == 1) {
-            dataType dist = branchDist.editDistance_branch<dataType>(
-              &(ftmtrees[i].tree), &(ftmtrees[j].tree));
-            distanceMatrix[i][j] = static_cast<double>(dist);
-          } else if(baseModule_ == 2) {
-            dataType dist = pathDist.editDistance_path<dataType>(
-              &(ftmtrees[i].tree), &(ftmtrees[j].tree));
-            distanceMatrix[i][j] = static_cast<double>(dist);
-          }
-          // distance matrix is symmetric
-          distanceMatrix[j][i] = distanceMatrix[i][j];
-        } // end for j
-      } // end for i
+        return 0.0;
+      };
+      this->computeSymmetric(distanceMatrix, distanceMatrix.size(), distance,
+                             true, this->getFingerprint(ftmtrees));
     }
 
     template <class dataType>
     void executePara(std::vector<ftm::MergeTree<dataType>> &trees,
                      std::vector<std::vector<double>> &distanceMatrix,
                      bool isFirstInput = true) {
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel num_threads(this->threadNumber_)
-      {
-#pragma omp single nowait
-#endif
-        executeParaImpl<dataType>(trees, distanceMatrix, isFirstInput);
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp taskwait
-      } // pragma omp parallel
-#endif
+      const auto distance = [&](const size_t i, const size_t j) {
+        // Execute
+        if(baseModule_ != 0) {
+          return 0.0;
+        }
+        MergeTreeDistance mergeTreeDistance;
+        mergeTreeDistance.setAssignmentSolver(assignmentSolverID_);
+        mergeTreeDistance.setEpsilonTree1(epsilonTree1_);
+        mergeTreeDistance.setEpsilonTree2(epsilonTree2_);
+        mergeTreeDistance.setEpsilon2Tree1(epsilon2Tree1_);
+        mergeTreeDistance.setEpsilon2Tree2(epsilon2Tree2_);
+        mergeTreeDistance.setEpsilon3Tree1(epsilon3Tree1_);
+        mergeTreeDistance.setEpsilon3Tree2(epsilon3Tree2_);
+        mergeTreeDistance.setBranchDecomposition(branchDecomposition_);
+        mergeTreeDistance.setParallelize(parallelize_);
+        mergeTreeDistance.setPersistenceThreshold(persistenceThreshold_);
+        mergeTreeDistance.setDebugLevel(std::min(debugLevel_, 2));
+        // the pairs are already processed in parallel
+        mergeTreeDistance.setThreadNumber(this->getDistanceThreadNumber());
+        mergeTreeDistance.setNormalizedWasserstein(normalizedWasserstein_);
+        mergeTreeDistance.setKeepSubtree(keepSubtree_);
+        mergeTreeDistance.setMemoryEfficient(memoryEfficient_);
+        mergeTreeDistance.setDistanceSquaredRoot(distanceSquaredRoot_);
+        mergeTreeDistance.setUseMinMaxPair(useMinMaxPair_);
+        mergeTreeDistance.setSaveTree(true);
+        mergeTreeDistance.setCleanTree(true);
+        mergeTreeDistance.setIsCalled(true);
+        mergeTreeDistance.setPostprocess(false);
+        mergeTreeDistance.setIsPersistenceDiagram(isPersistenceDiagram_);
+        if(useDoubleInput_) {
+          double const weight = mixDistancesMinMaxPairWeight(isFirstInput);
+          mergeTreeDistance.setMinMaxPairWeight(weight);
+          mergeTreeDistance.setDistanceSquaredRoot(true);
+        }
+        std::vector<std::tuple<ftm::idNode, ftm::idNode>> outputMatching;
+        return static_cast<double>(mergeTreeDistance.execute<dataType>(
+          trees[i], trees[j], outputMatching));
+      };
+      // the known matrix and the checkpoint file only hold the distances
+      // of the first input
+      this->computeSymmetric(distanceMatrix, distanceMatrix.size(), distance,
+                             isFirstInput, this->getFingerprint(trees));
     }
 
+  protected:
+    // threads of each distance computation
+    inline int getDistanceThreadNumber() const {
+      return this->ParallelDistances ? this->threadNumber_ : 1;
+    }
+
+    // hash of the trees and of the distance parameters, identifying the
+    // matrix stored in the checkpoint file
     template <class dataType>
-    void executeParaImpl(std::vector<ftm::MergeTree<dataType>> &trees,
-                         std::vector<std::vector<double>> &distanceMatrix,
-                         bool isFirstInput = true) {
-      for(unsigned int i = 0; i < distanceMatrix.size(); ++i) {
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp task firstprivate(i) UNTIED() shared(distanceMatrix, trees)
-        {
-#endif
-          if(i % std::max(int(distanceMatrix.size() / 10), 1) == 0) {
-            std::stringstream stream;
-            stream << i << " / " << distanceMatrix.size();
-            printMsg(stream.str());
-          }
-          distanceMatrix[i][i] = 0.0;
-          for(unsigned int j = i + 1; j < distanceMatrix[0].size(); ++j) {
-            // Execute
-            if(baseModule_ == 0) {
-              MergeTreeDistance mergeTreeDistance;
-              mergeTreeDistance.setAssignmentSolver(assignmentSolverID_);
-              mergeTreeDistance.setEpsilonTree1(epsilonTree1_);
-              mergeTreeDistance.setEpsilonTree2(epsilonTree2_);
-              mergeTreeDistance.setEpsilon2Tree1(epsilon2Tree1_);
-              mergeTreeDistance.setEpsilon2Tree2(epsilon2Tree2_);
-              mergeTreeDistance.setEpsilon3Tree1(epsilon3Tree1_);
-              mergeTreeDistance.setEpsilon3Tree2(epsilon3Tree2_);
-              mergeTreeDistance.setBranchDecomposition(branchDecomposition_);
-              mergeTreeDistance.setParallelize(parallelize_);
-              mergeTreeDistance.setPersistenceThreshold(persistenceThreshold_);
-              mergeTreeDistance.setDebugLevel(std::min(debugLevel_, 2));
-              mergeTreeDistance.setThreadNumber(this->threadNumber_);
-              mergeTreeDistance.setNormalizedWasserstein(
-                normalizedWasserstein_);
-              mergeTreeDistance.setKeepSubtree(keepSubtree_);
-              mergeTreeDistance.setDistanceSquaredRoot(distanceSquaredRoot_);
-              mergeTreeDistance.setUseMinMaxPair(useMinMaxPair_);
-              mergeTreeDistance.setSaveTree(true);
-              mergeTreeDistance.setCleanTree(true);
-              mergeTreeDistance.setIsCalled(true);
-              mergeTreeDistance.setPostprocess(false);
-              mergeTreeDistance.setIsPersistenceDiagram(isPersistenceDiagram_);
-              if(useDoubleInput_) {
-                double const weight
-                  = mixDistancesMinMaxPairWeight(isFirstInput);
-                mergeTreeDistance.setMinMaxPairWeight(weight);
-                mergeTreeDistance.setDistanceSquaredRoot(true);
-              }
-              std::vector<std::tuple<ftm::idNode, ftm::idNode>> outputMatching;
-              distanceMatrix[i][j] = mergeTreeDistance.execute<dataType>(
-                trees[i], trees[j], outputMatching);
-            } else {
-              distanceMatrix[i][j] = 0;
-            }
-            // distance matrix is symmetric
-            distanceMatrix[j][i] = distanceMatrix[i][j];
-          } // end for j
-#ifdef TTK_ENABLE_OPENMP
-        } // end task
-#endif
-      } // end for i
+    std::uint64_t
+      getFingerprint(std::vector<ftm::MergeTree<dataType>> &trees) const {
+      if(!this->hasCheckpoint()) {
+        return 0;
+      }
+      Fingerprint fingerprint{};
+      fingerprint.add(baseModule_)
+        .add(branchMetric_)
+        .add(pathMetric_)
+        .add(assignmentSolverID_)
+        .add(epsilonTree1_)
+        .add(epsilonTree2_)
+        .add(epsilon2Tree1_)
+        .add(epsilon2Tree2_)
+        .add(epsilon3Tree1_)
+        .add(epsilon3Tree2_)
+        .add(persistenceThreshold_)
+        .add(branchDecomposition_)
+        .add(normalizedWasserstein_)
+        .add(keepSubtree_)
+        .add(distanceSquaredRoot_)
+        .add(useMinMaxPair_)
+        .add(isPersistenceDiagram_)
+        .add(useDoubleInput_)
+        .add(mixtureCoefficient_);
+      fingerprint.add(trees.size());
+      for(auto &tree : trees) {
+        const auto nNodes = tree.tree.getNumberOfNodes();
+        fingerprint.add(nNodes);
+        for(ftm::idNode i = 0; i < nNodes; ++i) {
+          fingerprint.add(tree.tree.template getValue<dataType>(i))
+            .add(tree.tree.getParentSafe(i));
+        }
+      }
+      return fingerprint.get();
     }
 
   }; // MergeTreeDistanceMatrix class
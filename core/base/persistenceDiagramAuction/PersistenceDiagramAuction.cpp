@@ -1,13 +1,14 @@
 #include "PersistenceDiagramAuction.h"
 
+#include <cmath>
+
 void ttk::PersistenceDiagramAuction::runAuctionRound(int &n_biddings,
                                                      const int kdt_index) {
-  double const max_price = getMaximalPrice();
-  double epsilon = epsilon_;
-  if(epsilon_ < 1e-6 * max_price) {
-    // Risks of floating point limits reached...
-    epsilon = 1e-6 * max_price;
+  if(useJacobiBidding_) {
+    this->runJacobiAuctionRound(n_biddings, kdt_index);
+    return;
   }
+  const double epsilon = this->updateRoundEpsilon();
   while(unassignedBidders_.size() > 0) {
     n_biddings++;
     int const pos = unassignedBidders_.front();
@@ -49,6 +50,178 @@ void ttk::PersistenceDiagramAuction::runAuctionRound(int &n_biddings,
   }
 }
 
+void ttk::PersistenceDiagramAuction::runJacobiAuctionRound(
+  int &n_biddings, const int kdt_index) {
+  const double epsilon = this->updateRoundEpsilon();
+
+  struct Bid {
+    // index of the good in goods_, shifted by goods_.size() for the twin
+    // (diagonal) goods
+    int good;
+    double price;
+    // KD-Tree node whose weight follows the price of the good (if any)
+    KDT *kdt;
+  };
+
+  const int nGoods = goods_.size();
+  std::vector<int> bidders{}, diagonalBidders{};
+  std::vector<Bid> bids{};
+  // highest bid on each good during the current iteration
+  std::vector<int> winners(goods_.size() + diagonal_goods_.size(), -1);
+
+  while(!unassignedBidders_.empty()) {
+    bidders.clear();
+    diagonalBidders.clear();
+    while(!unassignedBidders_.empty()) {
+      const int pos = unassignedBidders_.front();
+      unassignedBidders_.pop();
+      if(this->bidders_[pos].isDiagonal()) {
+        diagonalBidders.emplace_back(pos);
+      } else {
+        bidders.emplace_back(pos);
+      }
+    }
+    n_biddings += bidders.size() + diagonalBidders.size();
+
+    // 1. every off-diagonal bidder computes its bid against the current
+    // prices. Goods and KD-Tree weights are not modified here, so the KD-Tree
+    // can be queried concurrently
+    bids.resize(bidders.size());
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic, 16)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t i = 0; i < bidders.size(); ++i) {
+      const Bidder &b = this->bidders_[bidders[i]];
+      const Good &twin_good = diagonal_goods_[b.id_];
+      Bid &bid = bids[i];
+      int idx;
+      if(use_kdt_) {
+        idx = b.computeKDTBid(goods_, twin_good, wasserstein_, epsilon,
+                              geometricalFactor_, nonMatchingWeight_, &kdt_,
+                              bid.kdt, bid.price, kdt_index);
+      } else {
+        bid.kdt = nullptr;
+        idx = b.computeBid(goods_, twin_good, wasserstein_, epsilon,
+                           geometricalFactor_, nonMatchingWeight_, bid.price);
+      }
+      bid.good = idx >= 0 ? idx : nGoods + b.id_;
+    }
+
+    // 2. conflicts: only the highest bid on a good is kept
+    for(size_t i = 0; i < bids.size(); ++i) {
+      int &winner = winners[bids[i].good];
+      if(winner == -1 || bids[i].price > bids[winner].price) {
+        winner = i;
+      }
+    }
+
+    // 3. assign the goods to the winners, the previous owners and the
+    // outbidden bidders will bid again
+    for(size_t i = 0; i < bids.size(); ++i) {
+      const Bid &bid = bids[i];
+      if(winners[bid.good] != static_cast<int>(i)) {
+        unassignedBidders_.push(bidders[i]);
+        continue;
+      }
+      Good &g = bid.good < nGoods ? goods_[bid.good]
+                                  : diagonal_goods_[bid.good - nGoods];
+      Bidder &b = this->bidders_[bidders[i]];
+      b.setProperty(g);
+      b.setPricePaid(bid.price);
+      int const idx_reassigned = g.getOwner();
+      g.assign(b.getPositionInAuction(), bid.price);
+      if(bid.kdt != nullptr) {
+        bid.kdt->updateWeight(bid.price, kdt_index);
+      }
+      if(idx_reassigned >= 0) {
+        Bidder &reassigned = bidders_[idx_reassigned];
+        reassigned.resetProperty();
+        unassignedBidders_.push(idx_reassigned);
+      }
+    }
+    for(const auto &bid : bids) {
+      winners[bid.good] = -1;
+    }
+
+    // 4. diagonal bidders only look for the cheapest diagonal goods in the
+    // priority queue: they are cheap and would all compete for the same
+    // goods, so they keep bidding one after the other
+    for(const auto pos : diagonalBidders) {
+      Bidder &b = this->bidders_[pos];
+      Good &twin_good = goods_[-b.id_ - 1];
+      int idx_reassigned;
+      if(use_kdt_) {
+        idx_reassigned = b.runDiagonalKDTBidding(
+          &diagonal_goods_, twin_good, wasserstein_, epsilon,
+          geometricalFactor_, nonMatchingWeight_, correspondence_kdt_map_,
+          diagonal_queue_, kdt_index);
+      } else {
+        idx_reassigned = b.runDiagonalBidding(
+          &diagonal_goods_, twin_good, wasserstein_, epsilon,
+          geometricalFactor_, nonMatchingWeight_, diagonal_queue_);
+      }
+      if(idx_reassigned >= 0) {
+        Bidder &reassigned = bidders_[idx_reassigned];
+        reassigned.resetProperty();
+        unassignedBidders_.push(idx_reassigned);
+      }
+    }
+  }
+}
+
+int ttk::PersistenceDiagramAuction::restoreAssignment(
+  const std::vector<int> &previousGoods, const int kdt_index) {
+  this->reinitializeGoods();
+  int nRestored = 0;
+  std::vector<KDT *> neighbours;
+  std::vector<double> costs;
+  for(size_t i = 0; i < bidders_.size(); ++i) {
+    Bidder &b = bidders_[i];
+    b.resetProperty();
+    const int prev
+      = static_cast<int>(i) < n_bidders_ && i < previousGoods.size()
+          ? previousGoods[i]
+          : -2;
+    if(prev < -1 || prev >= n_goods_) {
+      unassignedBidders_.push(i);
+      continue;
+    }
+    Good &twin_good = diagonal_goods_[b.id_];
+    Good &good = prev >= 0 ? goods_[prev] : twin_good;
+
+    // best value over the goods with the current prices
+    double best_val
+      = -b.cost(twin_good, wasserstein_, geometricalFactor_, nonMatchingWeight_)
+        - twin_good.getPrice();
+    if(use_kdt_) {
+      std::array<double, 5> coordinates;
+      b.GetKDTCoordinates(geometricalFactor_, coordinates);
+      kdt_.getKClosest(1, coordinates, neighbours, costs, kdt_index);
+      best_val = std::max(best_val, -costs[0]);
+    } else {
+      for(const auto &g : goods_) {
+        best_val = std::max(
+          best_val,
+          -b.cost(g, wasserstein_, geometricalFactor_, nonMatchingWeight_)
+            - g.getPrice());
+      }
+    }
+    const double val
+      = -b.cost(good, wasserstein_, geometricalFactor_, nonMatchingWeight_)
+        - good.getPrice();
+
+    if(good.getOwner() >= 0 || val + epsilon_ < best_val) {
+      unassignedBidders_.push(i);
+      continue;
+    }
+    b.setProperty(good);
+    b.setPricePaid(good.getPrice());
+    good.assign(b.getPositionInAuction(), good.getPrice());
+    nRestored++;
+  }
+  return nRestored;
+}
+
 double ttk::PersistenceDiagramAuction::getMaximalPrice() {
   double max_price = 0;
   for(size_t i = 0; i < goods_.size(); ++i) {
@@ -113,21 +286,35 @@ double ttk::PersistenceDiagramAuction::getMatchingsAndDistance(
 
 double ttk::PersistenceDiagramAuction::initLowerBoundCost(const int kdt_index) {
   lowerBoundCost_ = 0;
+
+  // closest goods of the off-diagonal bidders, queried in one batch
+  std::vector<std::array<double, 5>> queries;
+  std::vector<std::vector<KDT *>> neighbours;
+  std::vector<std::vector<double>> costs;
+  if(use_kdt_) {
+    for(auto &b : bidders_) {
+      if(!b.isDiagonal()) {
+        queries.emplace_back();
+        b.GetKDTCoordinates(geometricalFactor_, queries.back());
+      }
+    }
+    kdt_.getKClosest(1, queries, neighbours, costs, kdt_index);
+  }
+
+  size_t query = 0;
   for(unsigned int i = 0; i < bidders_.size(); ++i) {
     if(bidders_[i].isDiagonal())
       continue;
 
     // Get closest good
     double bestCost = std::numeric_limits<double>::max();
-    std::vector<KDT *> neighbours;
-    std::vector<double> costs;
     if(use_kdt_) {
-      std::array<double, 5> coordinates;
-      bidders_[i].GetKDTCoordinates(geometricalFactor_, coordinates);
-      kdt_.getKClosest(1, coordinates, neighbours, costs, kdt_index);
-      int const bestIndex = neighbours[0]->id_;
-      bestCost = bidders_[i].cost(goods_[bestIndex], wasserstein_,
-                                  geometricalFactor_, nonMatchingWeight_);
+      if(!neighbours[query].empty()) {
+        int const bestIndex = neighbours[query][0]->id_;
+        bestCost = bidders_[i].cost(goods_[bestIndex], wasserstein_,
+                                    geometricalFactor_, nonMatchingWeight_);
+      }
+      query++;
     } else {
       for(unsigned int j = 0; j < goods_.size(); ++j) {
         double const cost = bidders_[i].cost(
@@ -155,6 +342,9 @@ double ttk::PersistenceDiagramAuction::run(std::vector<MatchingType> &matchings,
                                            const int kdt_index) {
   initLowerBoundCostWeight(delta_lim_);
   initLowerBoundCost(kdt_index);
+  if(lowerBoundCost_ > costThreshold_) {
+    return lowerBoundCost_;
+  }
   initializeEpsilon();
   int n_biddings = 0;
   double delta = 5;
@@ -164,6 +354,14 @@ double ttk::PersistenceDiagramAuction::run(std::vector<MatchingType> &matchings,
     this->reinitializeGoods();
     this->runAuctionRound(n_biddings, kdt_index);
     delta = this->getRelativePrecision();
+    // epsilon-complementary slackness: the optimal cost is above the cost
+    // of the current matching minus n * epsilon (with the epsilon actually
+    // used by the round)
+    if(delta > delta_lim_ && std::isfinite(costThreshold_)
+       && this->getMatchingDistance() - bidders_.size() * roundEpsilon_
+            > costThreshold_) {
+      return this->getMatchingDistance();
+    }
   }
   double const wassersteinDistance
     = this->getMatchingsAndDistance(matchings, true);
@@ -577,3 +775,103 @@ int ttk::Bidder::runKDTBidding(GoodDiagram *goods,
   }
   return idx_reassigned;
 }
+
+int ttk::Bidder::computeBid(const GoodDiagram &goods,
+                            const Good &twinGood,
+                            int wasserstein,
+                            double epsilon,
+                            double geometricalFactor,
+                            double nonMatchingWeight,
+                            double &new_price) const {
+  double best_val = std::numeric_limits<double>::lowest();
+  double second_val = std::numeric_limits<double>::lowest();
+  int best_idx = -1;
+  double best_price = twinGood.getPrice();
+  for(size_t i = 0; i < goods.size(); i++) {
+    const Good &g = goods[i];
+    double val
+      = -this->cost(g, wasserstein, geometricalFactor, nonMatchingWeight);
+    val -= g.getPrice();
+    if(val > best_val) {
+      second_val = best_val;
+      best_val = val;
+      best_idx = i;
+      best_price = g.getPrice();
+    } else if(val > second_val) {
+      second_val = val;
+    }
+  }
+  // And now check for the corresponding twin bidder
+  double val
+    = -this->cost(twinGood, wasserstein, geometricalFactor, nonMatchingWeight);
+  val -= twinGood.getPrice();
+  if(val > best_val) {
+    second_val = best_val;
+    best_val = val;
+    best_idx = -1;
+    best_price = twinGood.getPrice();
+  } else if(val > second_val) {
+    second_val = val;
+  }
+
+  if(second_val == std::numeric_limits<double>::lowest()) {
+    // There is only one acceptable good for the bidder
+    second_val = best_val;
+  }
+  new_price = getBidPrice(best_price, best_val, second_val, epsilon);
+  return best_idx;
+}
+
+int ttk::Bidder::computeKDTBid(const GoodDiagram &goods,
+                               const Good &twinGood,
+                               int wasserstein,
+                               double epsilon,
+                               double geometricalFactor,
+                               double nonMatchingWeight,
+                               KDT *kdt,
+                               KDT *&closest_kdt,
+                               double &new_price,
+                               const int kdt_index) const {
+  std::vector<KDT *> neighbours;
+  std::vector<double> costs;
+
+  std::array<double, 5> coordinates;
+  GetKDTCoordinates(geometricalFactor, coordinates);
+
+  kdt->getKClosest(2, coordinates, neighbours, costs, kdt_index);
+  double best_val, second_val;
+  if(costs.size() == 2) {
+    const int first = costs[0] <= costs[1] ? 0 : 1;
+    closest_kdt = neighbours[first];
+    best_val = -costs[first];
+    second_val = -costs[1 - first];
+  } else {
+    // If the kdtree contains only one point
+    closest_kdt = neighbours[0];
+    best_val = -costs[0];
+    second_val = best_val;
+  }
+  int best_idx = closest_kdt->id_;
+  double best_price = goods[best_idx].getPrice();
+
+  // And now check for the corresponding twin bidder
+  double val
+    = -this->cost(twinGood, wasserstein, geometricalFactor, nonMatchingWeight);
+  val -= twinGood.getPrice();
+  if(val > best_val) {
+    second_val = best_val;
+    best_val = val;
+    best_idx = -1;
+    best_price = twinGood.getPrice();
+    closest_kdt = nullptr;
+  } else if(val > second_val) {
+    second_val = val;
+  }
+
+  if(second_val == std::numeric_limits<double>::lowest()) {
+    // There is only one acceptable good for the bidder
+    second_val = best_val;
+  }
+  new_price = getBidPrice(best_price, best_val, second_val, epsilon);
+  return best_idx;
+}
@@ -2,6 +2,7 @@
 
 #include <PersistenceDiagramAuctionActor.h>
 
+#include <algorithm>
 #include <limits>
 
 namespace ttk {
@@ -89,6 +90,7 @@ namespace ttk {
     }
 
     void runAuctionRound(int &n_biddings, const int kdt_index = 0);
+    void runJacobiAuctionRound(int &n_biddings, const int kdt_index = 0);
     double getMatchingsAndDistance(std::vector<MatchingType> &matchings,
                                    bool get_diagonal_matches = false);
     double run(std::vector<MatchingType> &matchings, const int kdt_index = 0);
@@ -202,10 +204,33 @@ namespace ttk {
         = kdt_.build(coordinates.data(), goods_.size(), dimension);
     }
 
+    /// Jacobi bidding: at each iteration, every unassigned off-diagonal
+    /// bidder bids concurrently against the same prices, conflicts on a good
+    /// being resolved by keeping the highest bid. The default (Gauss-Seidel)
+    /// bidding processes the bidders one at a time.
+    void setUseJacobiBidding(const bool data) {
+      useJacobiBidding_ = data;
+    }
+
+    /// Stop as soon as the cost is proven above this threshold (used by
+    /// nearest neighbor queries): run() then returns a value above the
+    /// threshold that is not the optimal cost.
+    void setCostThreshold(const double threshold) {
+      costThreshold_ = threshold;
+    }
+
     void setEpsilon(const double epsilon) {
       epsilon_ = epsilon;
     }
 
+    /// Epsilon of the next auction round: epsilon_, clamped to avoid
+    /// reaching the floating point precision of the prices.
+    double updateRoundEpsilon() {
+      const double max_price = getMaximalPrice();
+      roundEpsilon_ = std::max(epsilon_, 1e-6 * max_price);
+      return roundEpsilon_;
+    }
+
     void initializeEpsilon() {
       double max_persistence = 0;
       for(const auto &b : this->bidders_) {
@@ -231,6 +256,15 @@ namespace ttk {
       }
     }
 
+    /// Warm start: every bidder gets back its good of a previous auction
+    /// (previousGoods[i] is the good id of the i-th bidder, -1 for its
+    /// diagonal projection and -2 for none) if this keeps the
+    /// epsilon-complementary slackness with the current prices. The other
+    /// bidders are queued as unassigned, replacing buildUnassignedBidders()
+    /// and reinitializeGoods().
+    int restoreAssignment(const std::vector<int> &previousGoods,
+                          const int kdt_index = 0);
+
     void reinitializeGoods() {
       for(auto &g : this->goods_) {
         g.setOwner(-1);
@@ -301,6 +335,8 @@ namespace ttk {
     int n_goods_{0};
 
     double epsilon_{1};
+    // epsilon used by the last round
+    double roundEpsilon_{1};
     double geometricalFactor_{};
     double lambda_{};
     // lambda : 0<=lambda<=1
@@ -309,9 +345,11 @@ namespace ttk {
     // pair sad-max) lambda = 0 : saddle (bad stability) lambda = 1/2 : middle
     // of the 2 critical points of the pair
     double delta_lim_{};
-    double lowerBoundCost_, lowerBoundCostWeight_;
+    double lowerBoundCost_{}, lowerBoundCostWeight_{1};
     bool use_kdt_{true};
     double nonMatchingWeight_ = 1.0;
+    bool useJacobiBidding_{false};
+    double costThreshold_{std::numeric_limits<double>::infinity()};
 
   }; // namespace ttk
 } // namespace ttk
@@ -6,6 +6,7 @@
 
 #include <array>
 #include <cmath>
+#include <limits>
 #include <queue>
 
 namespace ttk {
@@ -287,6 +288,28 @@ namespace ttk {
                           Compare> &diagonal_queue,
       const int kdt_index = 0);
 
+    // Jacobi Bidding: the bid (best good and price) is only computed against
+    // the current prices, nothing is assigned. These are read-only on the
+    // goods and on the KD-Tree so several bidders can run them concurrently.
+    // Return the index of the best good in goods, or -1 for the twin good.
+    int computeBid(const GoodDiagram &goods,
+                   const Good &twinGood,
+                   int wasserstein,
+                   double epsilon,
+                   double geometricalFactor,
+                   double nonMatchingWeight,
+                   double &new_price) const;
+    int computeKDTBid(const GoodDiagram &goods,
+                      const Good &twinGood,
+                      int wasserstein,
+                      double epsilon,
+                      double geometricalFactor,
+                      double nonMatchingWeight,
+                      KDT *kdt,
+                      KDT *&closest_kdt,
+                      double &new_price,
+                      const int kdt_index = 0) const;
+
     // Utility wrapper functions
     const Good &getProperty() const {
       return this->property_;
@@ -316,6 +339,17 @@ namespace ttk {
     Good property_{};
 
   private:
+    static inline double getBidPrice(const double old_price,
+                                     const double best_val,
+                                     const double second_val,
+                                     const double epsilon) {
+      double new_price = old_price + best_val - second_val + epsilon;
+      if(new_price > std::numeric_limits<double>::max() / 2) {
+        new_price = old_price + epsilon;
+      }
+      return new_price;
+    }
+
     // Attribute stating at which position in Auction.bidders_ this bidder can
     // be found In a single Auction, this attribute could be deducted from id_,
     // but with the use of Barycenter Goods will be added and deleted, which
@@ -20,6 +20,9 @@
 
 std::vector<std::vector<ttk::MatchingType>>
   ttk::PDBarycenter::execute(DiagramType &barycenter) {
+  if(!reinit_prices_) {
+    return executeWarmStartBarycenter(barycenter);
+  }
   return executeAuctionBarycenter(barycenter);
 }
 
@@ -38,7 +41,7 @@ void ttk::PDBarycenter::runMatching(
 
   double local_cost = *total_cost;
 #ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic, 1) reduction(+:local_cost)
+#pragma omp parallel for num_threads(getMatchingThreadNumber()) schedule(dynamic, 1) reduction(+:local_cost)
 #endif
   for(int i = 0; i < numberOfInputs_; i++) {
     double const delta_lim = 0.01;
@@ -46,6 +49,7 @@ void ttk::PDBarycenter::runMatching(
       current_bidder_diagrams_[i], barycenter_goods_[i], wasserstein_,
       geometrical_factor_, lambda_, delta_lim, kdt, correspondence_kdt_map,
       epsilon, min_diag_price->at(i), use_kdt, nonMatchingWeight_);
+    setupAuction(auction);
     int n_biddings = 0;
     auction.initLowerBoundCostWeight(delta_lim);
     auction.initLowerBoundCost(i);
@@ -88,13 +92,14 @@ void ttk::PDBarycenter::runMatchingAuction(
   bool actual_distance) {
   double local_cost = *total_cost;
 #ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic, 1) reduction(+:local_cost)
+#pragma omp parallel for num_threads(getMatchingThreadNumber()) schedule(dynamic, 1) reduction(+:local_cost)
 #endif
   for(int i = 0; i < numberOfInputs_; i++) {
     PersistenceDiagramAuction auction(
       current_bidder_diagrams_[i], barycenter_goods_[i], wasserstein_,
       geometrical_factor_, lambda_, 0.01, kdt, correspondence_kdt_map, 0,
       (*min_diag_price)[i], use_kdt, nonMatchingWeight_);
+    setupAuction(auction);
     std::vector<MatchingType> matchings;
     double const cost = auction.run(matchings, i);
     all_matchings->at(i) = matchings;
@@ -112,6 +117,70 @@ void ttk::PDBarycenter::runMatchingAuction(
   *total_cost = local_cost;
 }
 
+void ttk::PDBarycenter::runWarmStartMatching(
+  double *total_cost,
+  double epsilon,
+  bool reach_precision,
+  std::vector<int> &sizes,
+  KDT &kdt,
+  std::vector<KDT *> &correspondence_kdt_map,
+  std::vector<double> *min_diag_price,
+  std::vector<double> *min_price,
+  std::vector<std::vector<int>> &previous_goods,
+  std::vector<std::vector<MatchingType>> *all_matchings,
+  bool use_kdt,
+  bool actual_distance) {
+  double local_cost = *total_cost;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(getMatchingThreadNumber()) schedule(dynamic, 1) reduction(+:local_cost)
+#endif
+  for(int i = 0; i < numberOfInputs_; i++) {
+    double const delta_lim = 0.01;
+    PersistenceDiagramAuction auction(
+      current_bidder_diagrams_[i], barycenter_goods_[i], wasserstein_,
+      geometrical_factor_, lambda_, delta_lim, kdt, correspondence_kdt_map,
+      epsilon, min_diag_price->at(i), use_kdt, nonMatchingWeight_);
+    setupAuction(auction);
+    int n_biddings = 0;
+    // no cost lower bound here: the closest goods given by the KD-Tree
+    // account for the (warm) prices
+    auction.restoreAssignment(previous_goods[i], i);
+    auction.runAuctionRound(n_biddings, i);
+    double delta = auction.getRelativePrecision();
+    double eps = epsilon;
+    while(reach_precision && delta > delta_lim) {
+      eps /= 5;
+      auction.setEpsilon(eps);
+      auction.buildUnassignedBidders();
+      auction.reinitializeGoods();
+      auction.runAuctionRound(n_biddings, i);
+      delta = auction.getRelativePrecision();
+    }
+    precision_[i] = delta;
+    auction.updateDiagonalPrices();
+    min_diag_price->at(i) = auction.getMinimalDiagonalPrice();
+    min_price->at(i) = getMinimalPrice(i);
+    std::vector<MatchingType> matchings;
+    double const cost = auction.getMatchingsAndDistance(matchings, true);
+
+    // assignment of the off-diagonal bidders for the next warm start
+    previous_goods[i].assign(sizes[i], -2);
+    for(const auto &m : matchings) {
+      if(std::get<0>(m) >= 0) {
+        previous_goods[i][std::get<0>(m)] = std::max(std::get<1>(m), -1);
+      }
+    }
+    all_matchings->at(i) = std::move(matchings);
+    if(actual_distance) {
+      local_cost += sqrt(cost);
+    } else {
+      local_cost += cost;
+    }
+    current_bidder_diagrams_[i].resize(sizes[i]);
+  }
+  *total_cost = local_cost;
+}
+
 bool ttk::PDBarycenter::hasBarycenterConverged(
   std::vector<std::vector<MatchingType>> &matchings,
   std::vector<std::vector<MatchingType>> &previous_matchings) {
@@ -327,12 +396,14 @@ double ttk::PDBarycenter::updateBarycenter(
   }
 
   // 6. Finally, recreate barycenter_goods
+  new_good_ids_.assign(barycenter_goods_[0].size(), -1);
   for(size_t j = 0; j < n_diagrams; j++) {
     int count = 0;
     GoodDiagram new_barycenter;
     for(size_t i = 0; i < barycenter_goods_[j].size(); i++) {
       Good g = barycenter_goods_[j].at(i);
       if(g.id_ != -1) {
+        new_good_ids_[i] = count;
         g.id_ = count;
         new_barycenter.emplace_back(g);
         count++;
@@ -584,7 +655,7 @@ typename ttk::PDBarycenter::KDTreePair ttk::PDBarycenter::getKDTree() const {
 
   auto correspondence_kdt_map
     = kdt->build(coordinates.data(), barycenter_goods_[0].size(), dimension,
-                 weights, barycenter_goods_.size());
+                 weights, barycenter_goods_.size(), -1, false, threadNumber_);
   this->printMsg(" Building KDTree", 1, tm.getElapsedTime(),
                  debug::LineMode::NEW, debug::Priority::VERBOSE);
   return std::make_pair(std::move(kdt), correspondence_kdt_map);
@@ -619,9 +690,10 @@ std::vector<std::vector<ttk::MatchingType>>
   bool converged = false;
   bool finished = false;
   double total_cost;
+  int n_iterations = 0;
 
   while(!finished) {
-    Timer const tm;
+    Timer tm;
 
     std::pair<std::unique_ptr<KDT>, std::vector<KDT *>> pair;
     bool use_kdt = false;
@@ -674,7 +746,9 @@ std::vector<std::vector<ttk::MatchingType>>
     }
 
     previous_matchings = std::move(all_matchings);
-    // END OF TIMER
+    this->printMsg("Iteration " + std::to_string(++n_iterations), 1.0,
+                   tm.getElapsedTime(), threadNumber_, debug::LineMode::NEW,
+                   debug::Priority::DETAIL);
 
     for(size_t i = 0; i < barycenter_goods_.size(); ++i) {
       for(size_t j = 0; j < barycenter_goods_[i].size(); ++j) {
@@ -705,12 +779,152 @@ std::vector<std::vector<ttk::MatchingType>>
   return corrected_matchings;
 }
 
+std::vector<std::vector<ttk::MatchingType>>
+  ttk::PDBarycenter::executeWarmStartBarycenter(DiagramType &barycenter) {
+
+  Timer t_total;
+  std::vector<std::vector<MatchingType>> previous_matchings;
+  double min_cost = std::numeric_limits<double>::max();
+  int last_min_cost_obtained = 0;
+
+  this->setBidderDiagrams();
+  double const max_persistence = getMaxPersistence();
+  double const lowest_persistence = getLowestPersistence();
+  double const epsilon0 = getEpsilon(max_persistence);
+  double epsilon = epsilon0;
+  // below this, the auctions refine epsilon themselves when needed
+  double const epsilon_floor = 1e-3 * epsilon0;
+
+  std::vector<double> min_diag_price(numberOfInputs_, 0);
+  std::vector<double> min_price(numberOfInputs_, 0);
+
+  // Progressive: the auctions start with the most persistent pairs, the
+  // less persistent ones join them as epsilon decreases
+  int min_points_to_add
+    = use_progressive_ ? 10 : std::numeric_limits<int>::max();
+  double min_persistence = this->enrichCurrentBidderDiagrams(
+    2 * max_persistence, 0, min_diag_price, min_price, min_points_to_add,
+    false);
+  bool complete = min_persistence <= lowest_persistence;
+  this->setInitialBarycenter(complete ? 0 : min_persistence);
+
+  // good of each bidder in the previous auctions (-1: diagonal, -2: none)
+  std::vector<std::vector<int>> previous_goods(numberOfInputs_);
+
+  bool converged = false;
+  bool finished = false;
+  double total_cost = 0;
+  int n_iterations = 0;
+
+  while(!finished) {
+    Timer tm;
+    n_iterations++;
+
+    if(!complete && n_iterations > 1) {
+      double rho = getRho(epsilon);
+      if(epsilon <= epsilon_floor) {
+        // add all the remaining pairs for the final convergence
+        rho = 0;
+        min_points_to_add = std::numeric_limits<int>::max();
+      }
+      if(min_persistence > rho) {
+        min_persistence = this->enrichCurrentBidderDiagrams(
+          min_persistence, rho, min_diag_price, min_price, min_points_to_add);
+      }
+      complete = min_persistence <= lowest_persistence;
+    }
+
+    std::pair<std::unique_ptr<KDT>, std::vector<KDT *>> pair;
+    bool use_kdt = false;
+    if(!barycenter_goods_[0].empty()) {
+      pair = this->getKDTree();
+      use_kdt = true;
+    }
+
+    std::vector<std::vector<MatchingType>> all_matchings(numberOfInputs_);
+    std::vector<int> sizes(numberOfInputs_);
+    for(int i = 0; i < numberOfInputs_; i++) {
+      sizes[i] = current_bidder_diagrams_[i].size();
+    }
+
+    // once every pair is in, the auctions reach the same precision as in
+    // executeAuctionBarycenter so that the costs can be compared
+    total_cost = 0;
+    bool const actual_distance = (numberOfInputs_ == 2);
+    runWarmStartMatching(&total_cost, epsilon, complete, sizes, *pair.first,
+                         pair.second, &min_diag_price, &min_price,
+                         previous_goods, &all_matchings, use_kdt,
+                         actual_distance);
+
+    if(converged) {
+      finished = true;
+    }
+
+    if(!finished) {
+      double const max_shift = updateBarycenter(all_matchings);
+
+      // the previous assignments follow the new ids of the goods
+      for(auto &goods : previous_goods) {
+        for(auto &g : goods) {
+          if(g >= 0) {
+            g = new_good_ids_[g];
+          }
+        }
+      }
+
+      // same stopping rule as executeAuctionBarycenter, once the costs are
+      // comparable (every pair added)
+      if(complete) {
+        if(min_cost > total_cost) {
+          min_cost = total_cost;
+          last_min_cost_obtained = 0;
+        } else {
+          last_min_cost_obtained += 1;
+        }
+        converged = last_min_cost_obtained > 1;
+      }
+
+      // the prices only have to absorb the moves of the barycenter points
+      if(epsilon_decreases_) {
+        epsilon = std::min(std::max(max_shift / 8., epsilon / 5.),
+                           epsilon0 / (n_iterations * n_iterations));
+      } else {
+        epsilon /= 5.;
+      }
+      epsilon = std::max(epsilon, epsilon_floor);
+    }
+
+    previous_matchings = std::move(all_matchings);
+    this->printMsg("Iteration " + std::to_string(n_iterations) + " (cost "
+                     + std::to_string(total_cost) + ", epsilon "
+                     + std::to_string(epsilon) + ")",
+                   1.0, tm.getElapsedTime(), threadNumber_,
+                   debug::LineMode::NEW, debug::Priority::DETAIL);
+  }
+
+  barycenter.resize(0);
+  for(size_t j = 0; j < barycenter_goods_[0].size(); j++) {
+    Good const &g = barycenter_goods_[0].at(j);
+    barycenter.emplace_back(PersistencePair{CriticalVertex{0, nt1_, g.x_, {}},
+                                            CriticalVertex{0, nt2_, g.y_, {}},
+                                            diagramType_, true});
+  }
+
+  this->printMsg("Warm-started barycenter (" + std::to_string(n_iterations)
+                   + " iterations)",
+                 1.0, t_total.getElapsedTime(), threadNumber_);
+
+  cost_ = total_cost;
+  return correctMatchings(previous_matchings);
+}
+
 double ttk::PDBarycenter::computeRealCost() {
   double total_real_cost = 0;
   std::vector<MatchingType> fake_matchings;
   for(int i = 0; i < numberOfInputs_; i++) {
     PersistenceDiagramAuction auction(wasserstein_, geometrical_factor_,
                                       lambda_, 0.01, true, nonMatchingWeight_);
+    setupAuction(auction);
     GoodDiagram const current_barycenter = barycenter_goods_[0];
     BidderDiagram const current_bidder_diagram = bidder_diagrams_[i];
     auction.BuildAuctionDiagrams(current_bidder_diagram, current_barycenter);
@@ -39,6 +39,8 @@ namespace ttk {
       executeAuctionBarycenter(DiagramType &barycenter);
     std::vector<std::vector<MatchingType>>
       executePartialBiddingBarycenter(DiagramType &barycenter);
+    std::vector<std::vector<MatchingType>>
+      executeWarmStartBarycenter(DiagramType &barycenter);
 
     void setBidderDiagrams();
     double enrichCurrentBidderDiagrams(
@@ -79,6 +81,23 @@ namespace ttk {
                          bool use_kdt,
                          bool actual_distance);
 
+    // auctions starting from the prices and the assignment (previous_goods)
+    // of the previous iteration, the epsilon scaling is pursued until the
+    // relative precision is reached if reach_precision
+    void runWarmStartMatching(
+      double *total_cost,
+      double epsilon,
+      bool reach_precision,
+      std::vector<int> &sizes,
+      KDT &kdt,
+      std::vector<KDT *> &correspondence_kdt_map,
+      std::vector<double> *min_diag_price,
+      std::vector<double> *min_price,
+      std::vector<std::vector<int>> &previous_goods,
+      std::vector<std::vector<MatchingType>> *all_matchings,
+      bool use_kdt,
+      bool actual_distance);
+
     double updateBarycenter(std::vector<std::vector<MatchingType>> &matchings);
 
     double computeRealCost();
@@ -183,11 +202,28 @@ namespace ttk {
       nonMatchingWeight_ = nonMatchingWeight;
     }
 
+    /// Jacobi bidding in the auctions (see PersistenceDiagramAuction): the
+    /// threads then compute the bids of one diagram at a time instead of
+    /// matching the diagrams concurrently.
+    inline void setUseJacobiBidding(const bool useJacobiBidding) {
+      useJacobiBidding_ = useJacobiBidding;
+    }
+
     double getCost() {
       return cost_;
     }
 
   protected:
+    /// number of threads matching the diagrams concurrently
+    inline int getMatchingThreadNumber() const {
+      return useJacobiBidding_ ? 1 : threadNumber_;
+    }
+
+    inline void setupAuction(PersistenceDiagramAuction &auction) const {
+      auction.setUseJacobiBidding(useJacobiBidding_);
+      auction.setThreadNumber(useJacobiBidding_ ? threadNumber_ : 1);
+    }
+
     // std::vector<bool> precision_objective_;
     std::vector<double> precision_;
 
@@ -225,9 +261,12 @@ namespace ttk {
     std::vector<BidderDiagram> current_bidder_diagrams_;
     std::vector<std::vector<int>> current_bidder_ids_;
     std::vector<GoodDiagram> barycenter_goods_;
+    // new id of each good after the last updateBarycenter (-1 if deleted)
+    std::vector<int> new_good_ids_;
 
     bool reinit_prices_{true};
     bool epsilon_decreases_{true};
     bool early_stoppage_{true};
+    bool useJacobiBidding_{false};
   };
 } // namespace ttk
@@ -832,6 +832,8 @@ double ttk::PDClustering::computeDistance(const BidderDiagram &D1,
   const auto D2_bis = centroidWithZeroPrices(D2);
   PersistenceDiagramAuction auction(wasserstein_, geometrical_factor_, lambda_,
                                     delta_lim, use_kdtree_, nonMatchingWeight_);
+  auction.setUseJacobiBidding(useJacobiBidding_);
+  auction.setThreadNumber(threadNumber_);
   auction.BuildAuctionDiagrams(D1, D2_bis);
   double const cost = auction.run(matchings);
   return cost;
@@ -843,6 +845,8 @@ double ttk::PDClustering::computeDistance(BidderDiagram *const D1,
   std::vector<MatchingType> matchings;
   PersistenceDiagramAuction auction(wasserstein_, geometrical_factor_, lambda_,
                                     delta_lim, use_kdtree_, nonMatchingWeight_);
+  auction.setUseJacobiBidding(useJacobiBidding_);
+  auction.setThreadNumber(threadNumber_);
   int const size1 = D1->size();
   auction.BuildAuctionDiagrams(*D1, *D2);
   double const cost = auction.run(matchings);
@@ -2399,6 +2403,7 @@ void ttk::PDClustering::initializeBarycenterComputers(
       barycenter_computer_min_[c].setNumberOfInputs(diagrams_c.size());
       barycenter_computer_min_[c].setCurrentBidders(diagrams_c);
       barycenter_computer_min_[c].setNonMatchingWeight(nonMatchingWeight_);
+      barycenter_computer_min_[c].setUseJacobiBidding(useJacobiBidding_);
     }
   }
   if(do_sad_) {
@@ -2419,6 +2424,7 @@ void ttk::PDClustering::initializeBarycenterComputers(
       barycenter_computer_sad_[c].setNumberOfInputs(diagrams_c.size());
       barycenter_computer_sad_[c].setCurrentBidders(diagrams_c);
       barycenter_computer_sad_[c].setNonMatchingWeight(nonMatchingWeight_);
+      barycenter_computer_sad_[c].setUseJacobiBidding(useJacobiBidding_);
 
       std::vector<GoodDiagram> barycenter_goods(clustering_[c].size());
       for(size_t i_diagram = 0; i_diagram < clustering_[c].size();
@@ -2448,6 +2454,7 @@ void ttk::PDClustering::initializeBarycenterComputers(
       barycenter_computer_max_[c].setNumberOfInputs(diagrams_c.size());
       barycenter_computer_max_[c].setCurrentBidders(diagrams_c);
       barycenter_computer_max_[c].setNonMatchingWeight(nonMatchingWeight_);
+      barycenter_computer_max_[c].setUseJacobiBidding(useJacobiBidding_);
 
       std::vector<GoodDiagram> barycenter_goods(clustering_[c].size());
       for(size_t i_diagram = 0; i_diagram < clustering_[c].size();
@@ -208,6 +208,12 @@ namespace ttk {
       nonMatchingWeight_ = nonMatchingWeight;
     }
 
+    /// Jacobi (parallel) bidding in the auctions, see
+    /// PersistenceDiagramAuction
+    inline void setUseJacobiBidding(const bool useJacobiBidding) {
+      useJacobiBidding_ = useJacobiBidding;
+    }
+
     inline void printClustering() {
       std::string msg{};
       for(int c = 0; c < k_; ++c) {
@@ -266,6 +272,7 @@ namespace ttk {
     // of the 2 critical points of the pair
     double lambda_;
     double nonMatchingWeight_ = 1.0;
+    bool useJacobiBidding_{false};
 
     int k_;
     int numberOfInputs_;
@@ -0,0 +1,480 @@
+#include <PDMiniBatchClustering.h>
+
+#include <algorithm>
+#include <numeric>
+
+std::vector<int> ttk::PDMiniBatchClustering::execute(
+  const size_t nDiagrams,
+  const DiagramLoader &loader,
+  std::vector<DiagramType> &final_centroids,
+  std::vector<std::vector<MatchingType>> *const matchings) {
+
+  Timer tm{};
+
+  this->distances_.clear();
+  this->costs_ = {};
+  if(this->k_ < 1 || nDiagrams < static_cast<size_t>(this->k_)) {
+    this->printErr("Not enough diagrams for "
+                   + std::to_string(this->k_) + " cluster(s)");
+    return {};
+  }
+
+  const bool allPairs
+    = this->pairTypeClustering_ < 0 || this->pairTypeClustering_ > 2;
+  this->dos_ = {allPairs || this->pairTypeClustering_ == 0,
+                allPairs || this->pairTypeClustering_ == 1,
+                allPairs || this->pairTypeClustering_ == 2};
+
+  // the initial centroids are drawn from the first batch
+  const size_t batchSize = std::min(
+    std::max(this->batchSize_, static_cast<size_t>(this->k_)), nDiagrams);
+
+  this->printMsg("Clustering " + std::to_string(nDiagrams) + " diagrams in "
+                 + std::to_string(this->k_) + " cluster(s) by batches of "
+                 + std::to_string(batchSize));
+
+  // diagrams from disk are often sorted (e.g. by time step): batches are
+  // drawn from a random permutation
+  std::mt19937 rng(this->deterministic_ ? 0 : std::random_device{}());
+  std::vector<size_t> order(nDiagrams);
+  std::iota(order.begin(), order.end(), 0);
+  std::shuffle(order.begin(), order.end(), rng);
+
+  std::vector<SplitDiagram> batch{};
+  std::vector<Assignment> assignments{};
+
+  if(this->loadBatch(loader, order, 0, batchSize, batch) != 0) {
+    return {};
+  }
+  this->initializeCentroids(batch, rng);
+
+  const size_t nBatches = (nDiagrams + batchSize - 1) / batchSize;
+  const size_t nSteps = nBatches * (this->numberOfEpochs_ + 1);
+  size_t step{};
+
+  for(int e = 0; e < this->numberOfEpochs_; ++e) {
+    for(size_t first = 0; first < nDiagrams; first += batchSize) {
+      const auto size = std::min(batchSize, nDiagrams - first);
+      if(this->loadBatch(loader, order, first, size, batch) != 0) {
+        return {};
+      }
+      this->assign(batch, true, assignments);
+      this->updateCentroids(batch, assignments);
+      this->printMsg("Epoch " + std::to_string(e + 1) + "/"
+                       + std::to_string(this->numberOfEpochs_),
+                     static_cast<double>(++step) / nSteps,
+                     tm.getElapsedTime(), this->threadNumber_,
+                     debug::LineMode::REPLACE);
+    }
+    std::shuffle(order.begin(), order.end(), rng);
+  }
+
+  // final assignment of every diagram to the converged centroids
+  std::vector<int> inv_clustering(nDiagrams);
+  this->distances_.resize(nDiagrams);
+  // matchings to the centroid points, before their output numbering
+  std::vector<std::array<std::vector<MatchingType>, 3>> finalMatchings{};
+  if(matchings != nullptr) {
+    finalMatchings.resize(nDiagrams);
+  }
+  for(size_t first = 0; first < nDiagrams; first += batchSize) {
+    const auto size = std::min(batchSize, nDiagrams - first);
+    if(this->loadBatch(loader, order, first, size, batch) != 0) {
+      return {};
+    }
+    this->assign(batch, true, assignments);
+    for(size_t i = 0; i < size; ++i) {
+      const auto id = order[first + i];
+      auto &a = assignments[i];
+      inv_clustering[id] = a.cluster;
+      this->distances_[id] = Geometry::pow(a.cost, 1.0 / this->wasserstein_);
+      for(size_t c = 0; c < a.matchings.size(); ++c) {
+        for(auto &m : a.matchings[c]) {
+          this->costs_[c] += std::get<2>(m);
+          // bidders of the diagonal stand for centroid points matched to
+          // the diagonal
+          auto &bid = std::get<0>(m);
+          bid = bid >= 0 ? batch[i].pairIds[c][bid] : -1;
+        }
+      }
+      if(matchings != nullptr) {
+        finalMatchings[id] = std::move(a.matchings);
+      }
+    }
+    this->printMsg("Final assignment", static_cast<double>(++step) / nSteps,
+                   tm.getElapsedTime(), this->threadNumber_,
+                   debug::LineMode::REPLACE);
+  }
+
+  std::vector<std::array<std::vector<int>, 3>> outputIds{};
+  this->fillOutputCentroids(final_centroids, outputIds);
+
+  if(matchings != nullptr) {
+    matchings->resize(nDiagrams);
+    for(size_t i = 0; i < nDiagrams; ++i) {
+      const auto &ids = outputIds[inv_clustering[i]];
+      auto &output = (*matchings)[i];
+      output.clear();
+      for(size_t c = 0; c < ids.size(); ++c) {
+        for(const auto &m : finalMatchings[i][c]) {
+          const int bid = std::get<0>(m);
+          const int gid = std::get<1>(m);
+          // a diagonal bidder on the diagonal good of a pair
+          if(bid < 0 && gid < 0) {
+            continue;
+          }
+          output.emplace_back(bid, gid >= 0 ? ids[c][gid] : -1, std::get<2>(m));
+        }
+      }
+    }
+  }
+
+  this->printMsg("Complete", 1.0, tm.getElapsedTime(), this->threadNumber_);
+
+  return inv_clustering;
+}
+
+void ttk::PDMiniBatchClustering::splitDiagram(const DiagramType &diagram,
+                                              SplitDiagram &split) const {
+
+  const auto addBidder = [&](const size_t c, const PersistencePair &p,
+                             const size_t j) {
+    if(!this->dos_[c]) {
+      return;
+    }
+    auto &bidders = split.bidders[c];
+    Bidder b(p, bidders.size(), this->lambda_);
+    b.setPositionInAuction(bidders.size());
+    bidders.emplace_back(b);
+    split.pairIds[c].emplace_back(j);
+  };
+
+  for(size_t c = 0; c < split.bidders.size(); ++c) {
+    split.bidders[c].clear();
+    split.pairIds[c].clear();
+  }
+
+  for(size_t j = 0; j < diagram.size(); ++j) {
+    const auto &t = diagram[j];
+    const auto nt1 = t.birth.type;
+    const auto nt2 = t.death.type;
+
+    if(t.persistence() <= 0) {
+      continue;
+    }
+    if(nt1 == CriticalType::Local_minimum
+       && nt2 == CriticalType::Local_maximum) {
+      addBidder(this->pairTypeClustering_ == 2 ? 2 : 0, t, j);
+    } else {
+      if(nt1 == CriticalType::Local_maximum
+         || nt2 == CriticalType::Local_maximum) {
+        addBidder(2, t, j);
+      }
+      if(nt1 == CriticalType::Local_minimum
+         || nt2 == CriticalType::Local_minimum) {
+        addBidder(0, t, j);
+      }
+      if((nt1 == CriticalType::Saddle1 && nt2 == CriticalType::Saddle2)
+         || (nt1 == CriticalType::Saddle2 && nt2 == CriticalType::Saddle1)) {
+        addBidder(1, t, j);
+      }
+    }
+  }
+}
+
+int ttk::PDMiniBatchClustering::loadBatch(
+  const DiagramLoader &loader,
+  const std::vector<size_t> &order,
+  const size_t first,
+  const size_t size,
+  std::vector<SplitDiagram> &batch) const {
+
+  // the loader may not be thread-safe (file readers)
+  std::vector<DiagramType> diagrams(size);
+  for(size_t i = 0; i < size; ++i) {
+    if(loader(order[first + i], diagrams[i]) != 0) {
+      this->printErr("Could not load diagram "
+                     + std::to_string(order[first + i]));
+      return -1;
+    }
+  }
+
+  batch.resize(size);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(this->threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < size; ++i) {
+    this->splitDiagram(diagrams[i], batch[i]);
+  }
+
+  return 0;
+}
+
+double ttk::PDMiniBatchClustering::computePowerDistance(
+  const SplitDiagram &diagram,
+  const Centroid &centroid,
+  const double threshold,
+  std::array<std::vector<MatchingType>, 3> *const matchings) const {
+
+  double cost{};
+  for(size_t c = 0; c < diagram.bidders.size() && cost <= threshold; ++c) {
+    if(!this->dos_[c]) {
+      continue;
+    }
+    PersistenceDiagramAuction auction(
+      this->wasserstein_, this->geometrical_factor_, this->lambda_,
+      this->deltaLim_, true, this->nonMatchingWeight_);
+    auction.setUseJacobiBidding(this->useJacobiBidding_);
+    auction.setThreadNumber(this->useJacobiBidding_ ? this->threadNumber_ : 1);
+    auction.BuildAuctionDiagrams(diagram.bidders[c], centroid[c]);
+    auction.setCostThreshold(threshold - cost);
+    if(matchings != nullptr) {
+      (*matchings)[c].clear();
+      cost += auction.run((*matchings)[c]);
+    } else {
+      cost += auction.run();
+    }
+  }
+  return cost;
+}
+
+void ttk::PDMiniBatchClustering::assign(
+  const std::vector<SplitDiagram> &batch,
+  const bool withMatchings,
+  std::vector<Assignment> &assignments) const {
+
+  assignments.resize(batch.size());
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(this->getMatchingThreadNumber()) \
+  schedule(dynamic)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < batch.size(); ++i) {
+    auto &a = assignments[i];
+    a = Assignment{};
+    std::array<std::vector<MatchingType>, 3> matchings{};
+    for(size_t c = 0; c < this->centroids_.size(); ++c) {
+      // auctions stop as soon as the centroid is farther than the best one
+      const auto cost = this->computePowerDistance(
+        batch[i], this->centroids_[c], a.cost,
+        withMatchings ? &matchings : nullptr);
+      if(cost < a.cost || a.cluster == -1) {
+        a.cost = cost;
+        a.cluster = c;
+        std::swap(a.matchings, matchings);
+      }
+    }
+  }
+}
+
+void ttk::PDMiniBatchClustering::initializeCentroids(
+  const std::vector<SplitDiagram> &batch, std::mt19937 &rng) {
+
+  const auto toCentroid = [](const SplitDiagram &diagram) {
+    Centroid centroid{};
+    for(size_t c = 0; c < diagram.bidders.size(); ++c) {
+      for(const auto &b : diagram.bidders[c]) {
+        Good g(b.x_, b.y_, false, centroid[c].size());
+        g.SetCriticalCoordinates(b.coords_);
+        centroid[c].emplace_back(g);
+      }
+    }
+    return centroid;
+  };
+
+  // K-Means++ seeding on the first batch (already shuffled)
+  this->centroids_.clear();
+  std::vector<double> minDistances(
+    batch.size(), std::numeric_limits<double>::infinity());
+  size_t next{};
+
+  while(this->centroids_.size() < static_cast<size_t>(this->k_)) {
+    this->centroids_.emplace_back(toCentroid(batch[next]));
+    minDistances[next] = 0;
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(this->getMatchingThreadNumber()) \
+  schedule(dynamic)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t i = 0; i < batch.size(); ++i) {
+      minDistances[i] = std::min(
+        minDistances[i],
+        this->computePowerDistance(
+          batch[i], this->centroids_.back(), minDistances[i], nullptr));
+    }
+
+    const auto sum
+      = std::accumulate(minDistances.begin(), minDistances.end(), 0.0);
+    if(sum > 0) {
+      std::discrete_distribution<size_t> distribution(
+        minDistances.begin(), minDistances.end());
+      next = distribution(rng);
+    } else {
+      // identical diagrams
+      next = this->centroids_.size();
+    }
+  }
+
+  this->counts_.assign(this->k_, 1);
+}
+
+void ttk::PDMiniBatchClustering::updateCentroids(
+  const std::vector<SplitDiagram> &batch,
+  const std::vector<Assignment> &assignments) {
+
+  std::vector<std::vector<size_t>> members(this->centroids_.size());
+  for(size_t i = 0; i < assignments.size(); ++i) {
+    members[assignments[i].cluster].emplace_back(i);
+  }
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(this->threadNumber_) schedule(dynamic)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t k = 0; k < this->centroids_.size(); ++k) {
+    if(members[k].empty()) {
+      continue;
+    }
+    this->counts_[k] += members[k].size();
+    // running weight of the centroid, shared by the batch diagrams
+    const double eta
+      = static_cast<double>(members[k].size()) / this->counts_[k];
+    const double w = eta / members[k].size();
+
+    for(size_t c = 0; c < this->centroids_[k].size(); ++c) {
+      if(!this->dos_[c]) {
+        continue;
+      }
+      auto &goods = this->centroids_[k][c];
+      // displacement of every centroid point (birth, death, coordinates)
+      std::vector<std::array<double, 5>> shifts(goods.size());
+      std::vector<bool> matched(goods.size());
+      GoodDiagram added{};
+
+      for(const auto i : members[k]) {
+        const auto &bidders = batch[i].bidders[c];
+        std::fill(matched.begin(), matched.end(), false);
+        for(const auto &m : assignments[i].matchings[c]) {
+          const int bid = std::get<0>(m);
+          const int gid = std::get<1>(m);
+          if(bid >= 0 && gid >= 0) {
+            const auto &b = bidders[bid];
+            const auto &g = goods[gid];
+            auto &s = shifts[gid];
+            s[0] += w * (b.x_ - g.x_);
+            s[1] += w * (b.y_ - g.y_);
+            for(size_t d = 0; d < 3; ++d) {
+              s[2 + d] += w * (b.coords_[d] - g.coords_[d]);
+            }
+            matched[gid] = true;
+          } else if(bid >= 0) {
+            // bidder matched to the diagonal: a new point rises from the
+            // diagonal of the centroid
+            const auto &b = bidders[bid];
+            const double proj = (b.x_ + b.y_) / 2.0;
+            Good g(proj + w * (b.x_ - proj), proj + w * (b.y_ - proj), false,
+                   0);
+            g.SetCriticalCoordinates(b.coords_);
+            added.emplace_back(g);
+          }
+        }
+        // centroid points matched to the diagonal move towards it
+        for(size_t j = 0; j < goods.size(); ++j) {
+          if(!matched[j]) {
+            const double proj = (goods[j].x_ + goods[j].y_) / 2.0;
+            shifts[j][0] += w * (proj - goods[j].x_);
+            shifts[j][1] += w * (proj - goods[j].y_);
+          }
+        }
+      }
+
+      for(size_t j = 0; j < goods.size(); ++j) {
+        auto &g = goods[j];
+        g.SetCoordinates(g.x_ + shifts[j][0], g.y_ + shifts[j][1]);
+        g.SetCriticalCoordinates(g.coords_[0] + shifts[j][2],
+                                 g.coords_[1] + shifts[j][3],
+                                 g.coords_[2] + shifts[j][4]);
+      }
+      goods.insert(goods.end(), added.begin(), added.end());
+    }
+
+    this->pruneCentroid(this->centroids_[k]);
+  }
+}
+
+void ttk::PDMiniBatchClustering::pruneCentroid(Centroid &centroid) const {
+  for(auto &goods : centroid) {
+    double maxPersistence{};
+    for(const auto &g : goods) {
+      maxPersistence = std::max(maxPersistence, g.getPersistence());
+    }
+    const auto threshold = this->pruningThreshold_ * maxPersistence;
+    goods.erase(std::remove_if(goods.begin(), goods.end(),
+                               [threshold](const Good &g) {
+                                 return g.getPersistence() <= threshold;
+                               }),
+                goods.end());
+    for(size_t j = 0; j < goods.size(); ++j) {
+      goods[j].id_ = j;
+    }
+  }
+}
+
+void ttk::PDMiniBatchClustering::fillOutputCentroids(
+  std::vector<DiagramType> &final_centroids,
+  std::vector<std::array<std::vector<int>, 3>> &outputIds) const {
+
+  bool hasSaddles{false};
+  for(const auto &centroid : this->centroids_) {
+    hasSaddles = hasSaddles || !centroid[1].empty();
+  }
+  const auto saddleType
+    = hasSaddles ? CriticalType::Saddle2 : CriticalType::Saddle1;
+
+  final_centroids.resize(this->centroids_.size());
+  outputIds.resize(this->centroids_.size());
+  for(size_t k = 0; k < this->centroids_.size(); ++k) {
+    auto &output = final_centroids[k];
+    output.clear();
+
+    // the most persistent point of the class of the global pair is output
+    // as the min-max pair
+    const size_t globalClass = this->dos_[0] ? 0 : 2;
+    const auto &globalGoods = this->centroids_[k][globalClass];
+    const auto global = std::max_element(
+      globalGoods.begin(), globalGoods.end(), [](const Good &a, const Good &b) {
+        return a.getPersistence() < b.getPersistence();
+      });
+
+    const std::array<CriticalType, 3> birthTypes{
+      CriticalType::Local_minimum, CriticalType::Saddle1, saddleType};
+    const std::array<CriticalType, 3> deathTypes{
+      CriticalType::Saddle1, CriticalType::Saddle2,
+      CriticalType::Local_maximum};
+
+    if(global != globalGoods.end()) {
+      outputIds[k][globalClass].resize(globalGoods.size());
+      outputIds[k][globalClass][global - globalGoods.begin()] = 0;
+      const auto critCoords = global->GetCriticalCoordinates();
+      output.emplace_back(PersistencePair{
+        CriticalVertex{0, CriticalType::Local_minimum, global->x_, critCoords},
+        CriticalVertex{0, CriticalType::Local_maximum, global->y_, critCoords},
+        0, false});
+    }
+
+    for(size_t c = 0; c < this->centroids_[k].size(); ++c) {
+      const auto &goods = this->centroids_[k][c];
+      outputIds[k][c].resize(goods.size());
+      for(auto it = goods.begin(); it != goods.end(); ++it) {
+        if(c == globalClass && it == global) {
+          continue;
+        }
+        outputIds[k][c][it - goods.begin()] = output.size();
+        const auto critCoords = it->GetCriticalCoordinates();
+        output.emplace_back(PersistencePair{
+          CriticalVertex{0, birthTypes[c], it->x_, critCoords},
+          CriticalVertex{0, deathTypes[c], it->y_, critCoords},
+          static_cast<int>(c), true});
+      }
+    }
+  }
+}
@@ -0,0 +1,198 @@
+/// \ingroup base
+/// \class ttk::PDMiniBatchClustering
+///
+/// \brief Mini-batch K-Means clustering of a stream of persistence diagrams.
+///
+/// The diagrams are never held in memory together: they are requested by
+/// batches through a loader callback (which typically reads them from disk,
+/// for instance from a Cinema database or from a directory of .vtu files).
+///
+/// Each diagram of a batch is assigned to its closest centroid (auction
+/// based Wasserstein distance). Every centroid then moves along the
+/// geodesic towards the mean of its matched batch diagrams, with a step
+/// given by the running weight of the centroid (batch size over the number
+/// of diagrams it received so far), following:
+///
+/// \b Related \b publication \n
+/// "Web-Scale K-Means Clustering" \n
+/// D. Sculley \n
+/// Proc. of the International Conference on World Wide Web, 2010.
+///
+/// Centroid points that become too close to the diagonal are pruned to
+/// bound the size of the centroids.
+///
+/// \sa ttk::PDClustering
+/// \sa ttk::PersistenceDiagramClustering
+
+#pragma once
+
+#include <PersistenceDiagramAuction.h>
+
+#include <array>
+#include <functional>
+#include <random>
+
+namespace ttk {
+
+  class PDMiniBatchClustering : virtual public Debug {
+
+  public:
+    /**
+     * Loads the i-th diagram of the stream, returns 0 on success. Only
+     * called from the master thread.
+     */
+    using DiagramLoader = std::function<int(const size_t, DiagramType &)>;
+
+    PDMiniBatchClustering() {
+      this->setDebugMsgPrefix("PDMiniBatchClustering");
+    }
+
+    /**
+     * Clusters the nDiagrams diagrams of the loader. Returns the cluster of
+     * each diagram. If matchings is given, it receives the matching of each
+     * diagram to its centroid after the final assignment: (pair of the
+     * diagram or -1, pair of the centroid or -1, cost).
+     */
+    std::vector<int>
+      execute(const size_t nDiagrams,
+              const DiagramLoader &loader,
+              std::vector<DiagramType> &final_centroids,
+              std::vector<std::vector<MatchingType>> *const matchings
+              = nullptr);
+
+    inline void setK(const int k) {
+      k_ = k;
+    }
+    inline void setWasserstein(const int wasserstein) {
+      wasserstein_ = wasserstein;
+    }
+    inline void setGeometricalFactor(const double alpha) {
+      geometrical_factor_ = alpha;
+    }
+    inline void setLambda(const double lambda) {
+      lambda_ = lambda;
+    }
+    inline void setDeltaLim(const double deltaLim) {
+      deltaLim_ = deltaLim;
+    }
+    inline void setNonMatchingWeight(const double nonMatchingWeight) {
+      nonMatchingWeight_ = nonMatchingWeight;
+    }
+    inline void setDeterministic(const bool deterministic) {
+      deterministic_ = deterministic;
+    }
+    // Jacobi bidding in the auctions: the threads compute the bids of one
+    // diagram at a time instead of matching the diagrams concurrently
+    inline void setUseJacobiBidding(const bool useJacobiBidding) {
+      useJacobiBidding_ = useJacobiBidding;
+    }
+    // 0:min-saddles ; 1:saddles-saddles ; 2:sad-max ; else : all
+    inline void setPairTypeClustering(const int pairType) {
+      pairTypeClustering_ = pairType;
+    }
+    inline void setBatchSize(const size_t batchSize) {
+      batchSize_ = batchSize;
+    }
+    inline void setNumberOfEpochs(const int nEpochs) {
+      numberOfEpochs_ = nEpochs;
+    }
+    // centroid points whose persistence is below this fraction of the
+    // largest persistence of their class are removed
+    inline void setPruningThreshold(const double threshold) {
+      pruningThreshold_ = threshold;
+    }
+
+    /**
+     * Distance of each diagram to its centroid, after the final
+     * assignment.
+     */
+    inline const std::vector<double> &getDistances() const {
+      return distances_;
+    }
+
+    /**
+     * Sum over the diagrams of the matching costs to their centroid, per
+     * pair class (min-sad, sad-sad, sad-max), after the final assignment.
+     */
+    inline const std::array<double, 3> &getCosts() const {
+      return costs_;
+    }
+
+  protected:
+    // a diagram split by pair classes (min-sad, sad-sad, sad-max), the
+    // bidders being numbered in their class as the auction expects
+    struct SplitDiagram {
+      std::array<BidderDiagram, 3> bidders{};
+      // index in the input diagram of each bidder
+      std::array<std::vector<int>, 3> pairIds{};
+    };
+    using Centroid = std::array<GoodDiagram, 3>;
+
+    // matching of a split diagram to its centroid, per class
+    struct Assignment {
+      int cluster{-1};
+      double cost{std::numeric_limits<double>::infinity()};
+      std::array<std::vector<MatchingType>, 3> matchings{};
+    };
+
+    void splitDiagram(const DiagramType &diagram, SplitDiagram &split) const;
+
+    // loads and splits the diagrams order[first, first + size[
+    int loadBatch(const DiagramLoader &loader,
+                  const std::vector<size_t> &order,
+                  const size_t first,
+                  const size_t size,
+                  std::vector<SplitDiagram> &batch) const;
+
+    // power of the Wasserstein distance, above threshold if the auction
+    // was interrupted (the matchings are not filled then)
+    double computePowerDistance(
+      const SplitDiagram &diagram,
+      const Centroid &centroid,
+      const double threshold,
+      std::array<std::vector<MatchingType>, 3> *const matchings) const;
+
+    // number of threads matching the diagrams concurrently
+    inline int getMatchingThreadNumber() const {
+      return useJacobiBidding_ ? 1 : threadNumber_;
+    }
+
+    void assign(const std::vector<SplitDiagram> &batch,
+                const bool withMatchings,
+                std::vector<Assignment> &assignments) const;
+
+    void initializeCentroids(const std::vector<SplitDiagram> &batch,
+                             std::mt19937 &rng);
+
+    void updateCentroids(const std::vector<SplitDiagram> &batch,
+                         const std::vector<Assignment> &assignments);
+
+    void pruneCentroid(Centroid &centroid) const;
+
+    // outputIds: index in its output centroid of each centroid point
+    void fillOutputCentroids(
+      std::vector<DiagramType> &final_centroids,
+      std::vector<std::array<std::vector<int>, 3>> &outputIds) const;
+
+    int k_{1};
+    int wasserstein_{2};
+    double geometrical_factor_{1.0};
+    double lambda_{1.0};
+    double deltaLim_{0.01};
+    double nonMatchingWeight_{1.0};
+    bool deterministic_{true};
+    bool useJacobiBidding_{false};
+    int pairTypeClustering_{-1};
+    size_t batchSize_{256};
+    int numberOfEpochs_{3};
+    double pruningThreshold_{0.01};
+
+    std::array<bool, 3> dos_{};
+    std::vector<Centroid> centroids_{};
+    // number of diagrams that contributed to each centroid
+    std::vector<size_t> counts_{};
+    std::vector<double> distances_{};
+    std::array<double, 3> costs_{};
+  };
+
+} // namespace ttk
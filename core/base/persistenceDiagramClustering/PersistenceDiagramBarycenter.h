@@ -86,6 +86,10 @@ namespace ttk {
       nonMatchingWeight_ = nonMatchingWeight;
     }
 
+    inline void setUseJacobiBidding(const bool useJacobiBidding) {
+      useJacobiBidding_ = useJacobiBidding;
+    }
+
   protected:
     bool deterministic_{true};
     int method_;
@@ -95,6 +99,7 @@ namespace ttk {
     double alpha_{1.0};
     double lambda_{1.0};
     double nonMatchingWeight_ = 1.0;
+    bool useJacobiBidding_{false};
 
     int points_added_;
     int points_deleted_;
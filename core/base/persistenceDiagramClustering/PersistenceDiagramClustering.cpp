@@ -121,6 +121,7 @@ std::vector<int> ttk::PersistenceDiagramClustering::execute(
   KMeans.setDiagrams(&data_min, &data_sad, &data_max);
   KMeans.setDos(do_min, do_sad, do_max);
   KMeans.setNonMatchingWeight(NonMatchingWeight);
+  KMeans.setUseJacobiBidding(UseJacobiBidding);
   inv_clustering
     = KMeans.execute(final_centroids, all_matchings_per_type_and_cluster);
   std::vector<std::vector<int>> centroids_sizes = KMeans.get_centroids_sizes();
@@ -238,3 +239,45 @@ std::vector<int> ttk::PersistenceDiagramClustering::execute(
   printMsg("Complete", 1, tm.getElapsedTime(), threadNumber_);
   return inv_clustering;
 }
+
+std::vector<int> ttk::PersistenceDiagramClustering::executeMiniBatch(
+  const size_t nDiagrams,
+  const PDMiniBatchClustering::DiagramLoader &loader,
+  std::vector<DiagramType> &centroids,
+  std::vector<std::vector<std::vector<MatchingType>>> *const all_matchings) {
+
+  PDMiniBatchClustering KMeans{};
+  KMeans.setThreadNumber(threadNumber_);
+  KMeans.setDebugLevel(debugLevel_);
+  KMeans.setK(NumberOfClusters);
+  KMeans.setWasserstein(WassersteinMetric);
+  KMeans.setGeometricalFactor(Alpha);
+  KMeans.setLambda(Lambda);
+  KMeans.setDeltaLim(DeltaLim);
+  KMeans.setNonMatchingWeight(NonMatchingWeight);
+  KMeans.setUseJacobiBidding(UseJacobiBidding);
+  KMeans.setDeterministic(Deterministic);
+  KMeans.setPairTypeClustering(PairTypeClustering);
+  KMeans.setBatchSize(std::max(BatchSize, 1));
+  KMeans.setNumberOfEpochs(NumberOfEpochs);
+  KMeans.setPruningThreshold(PruningThreshold);
+
+  std::vector<std::vector<MatchingType>> matchings{};
+  const auto inv_clustering
+    = KMeans.execute(nDiagrams, loader, centroids,
+                     all_matchings != nullptr ? &matchings : nullptr);
+
+  this->distances = KMeans.getCosts();
+
+  if(all_matchings != nullptr && inv_clustering.size() == nDiagrams) {
+    all_matchings->resize(centroids.size());
+    for(auto &m : *all_matchings) {
+      m.resize(nDiagrams);
+    }
+    for(size_t i = 0; i < nDiagrams; ++i) {
+      (*all_matchings)[inv_clustering[i]][i] = std::move(matchings[i]);
+    }
+  }
+
+  return inv_clustering;
+}
@@ -31,6 +31,7 @@
 
 // base code includes
 #include <PDClustering.h>
+#include <PDMiniBatchClustering.h>
 #include <PersistenceDiagramBarycenter.h>
 
 namespace ttk {
@@ -49,6 +50,33 @@ namespace ttk {
       std::vector<DiagramType> &centroids,
       std::vector<std::vector<std::vector<MatchingType>>> &all_matchings);
 
+    /**
+     * Mini-batch variant of execute for collections that do not fit in
+     * memory: the nDiagrams diagrams are requested by batches of BatchSize
+     * through the loader. If all_matchings is given, it receives the
+     * matchings of the final assignment with the layout of execute (this
+     * holds as many matchings as there are pairs in the collection).
+     */
+    std::vector<int> executeMiniBatch(
+      const size_t nDiagrams,
+      const PDMiniBatchClustering::DiagramLoader &loader,
+      std::vector<DiagramType> &centroids,
+      std::vector<std::vector<std::vector<MatchingType>>> *const all_matchings
+      = nullptr);
+
+    inline void setNumberOfClusters(const int nClusters) {
+      this->NumberOfClusters = nClusters;
+    }
+    inline void setBatchSize(const int batchSize) {
+      this->BatchSize = batchSize;
+    }
+    inline void setNumberOfEpochs(const int nEpochs) {
+      this->NumberOfEpochs = nEpochs;
+    }
+    inline void setPruningThreshold(const double threshold) {
+      this->PruningThreshold = threshold;
+    }
+
     std::array<double, 3> getDistances() const {
       return this->distances;
     }
@@ -75,11 +103,21 @@ namespace ttk {
     double Lambda{1.0};
     double TimeLimit{999999};
     double NonMatchingWeight = 1.0;
+    bool UseJacobiBidding{false};
+    // auction barycenter: keep the prices and assignments between iterations
+    bool WarmStart{false};
 
     int NumberOfClusters{1};
     bool UseAccelerated{false};
     bool UseKmeansppInit{false};
 
+    // mini-batch mode
+    int BatchSize{256};
+    int NumberOfEpochs{3};
+    // fraction of the largest persistence below which centroid points are
+    // removed
+    double PruningThreshold{0.01};
+
     int points_added_;
     int points_deleted_;
   };
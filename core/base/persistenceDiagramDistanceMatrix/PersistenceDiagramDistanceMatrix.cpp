@@ -1,4 +1,6 @@
 #include <algorithm>
+#include <cmath>
+#include <functional>
 #include <limits>
 
 #include <PersistenceDiagramDistanceMatrix.h>
@@ -11,6 +13,66 @@ std::vector<std::vector<double>> PersistenceDiagramDistanceMatrix::execute(
 
   Timer tm{};
 
+  std::vector<BidderDiagram> diags_min{}, diags_sad{}, diags_max{};
+  this->prepareBidderDiagrams(
+    intermediateDiagrams, diags_min, diags_sad, diags_max);
+
+  std::vector<std::vector<double>> distMat{};
+  getDiagramsDistMat(nInputs, distMat, diags_min, diags_sad, diags_max);
+
+  this->printMsg("Complete", 1.0, tm.getElapsedTime(), this->threadNumber_);
+
+  return distMat;
+}
+
+std::vector<std::vector<std::pair<double, size_t>>>
+  PersistenceDiagramDistanceMatrix::executeNearestNeighbors(
+    const std::vector<DiagramType> &intermediateDiagrams,
+    const size_t k) const {
+
+  Timer tm{};
+
+  std::vector<BidderDiagram> diags_min{}, diags_sad{}, diags_max{};
+  this->prepareBidderDiagrams(
+    intermediateDiagrams, diags_min, diags_sad, diags_max);
+  const auto nDiags = intermediateDiagrams.size();
+
+  std::vector<DiagramTriplet> triplets(nDiags);
+  std::vector<DiagramSignature> signatures(nDiags);
+  for(size_t i = 0; i < nDiags; ++i) {
+    triplets[i] = this->getTriplet(i, diags_min, diags_sad, diags_max);
+    signatures[i] = this->computeSignature(triplets[i]);
+  }
+
+  const auto getDist
+    = [&](const size_t a, const size_t b, const double radius) {
+        return this->computeDistance(triplets[a], triplets[b], radius);
+      };
+  const auto lowerBound = [&](const size_t a, const size_t b) {
+    return this->normLowerBound(signatures[a], signatures[b]);
+  };
+  const auto upperBound = [&](const size_t a, const size_t b) {
+    return this->normUpperBound(signatures[a], signatures[b]);
+  };
+  const auto refinedBound = [&](const size_t a, const size_t b) {
+    return this->persistenceLowerBound(signatures[a], signatures[b]);
+  };
+
+  std::vector<std::vector<std::pair<double, size_t>>> neighbors{};
+  this->computeNearestNeighbors(
+    neighbors, nDiags, k, getDist, lowerBound, upperBound, refinedBound);
+
+  this->printMsg("Complete", 1.0, tm.getElapsedTime(), this->threadNumber_);
+
+  return neighbors;
+}
+
+void PersistenceDiagramDistanceMatrix::prepareBidderDiagrams(
+  const std::vector<DiagramType> &intermediateDiagrams,
+  std::vector<BidderDiagram> &diags_min,
+  std::vector<BidderDiagram> &diags_sad,
+  std::vector<BidderDiagram> &diags_max) const {
+
   const auto nDiags = intermediateDiagrams.size();
 
   if(do_min_ && do_sad_ && do_max_) {
@@ -30,9 +92,6 @@ std::vector<std::vector<double>> PersistenceDiagramDistanceMatrix::execute(
   std::vector<BidderDiagram> bidder_diagrams_min{};
   std::vector<BidderDiagram> bidder_diagrams_sad{};
   std::vector<BidderDiagram> bidder_diagrams_max{};
-  std::vector<BidderDiagram> current_bidder_diagrams_min{};
-  std::vector<BidderDiagram> current_bidder_diagrams_sad{};
-  std::vector<BidderDiagram> current_bidder_diagrams_max{};
 
   // Store the persistence of the global min-max pair
   std::vector<double> maxDiagPersistence(nDiags);
@@ -107,31 +166,24 @@ std::vector<std::vector<double>> PersistenceDiagramDistanceMatrix::execute(
       break;
   }
 
-  std::vector<std::vector<double>> distMat{};
   if(this->Constraint == ConstraintType::FULL_DIAGRAMS) {
-    getDiagramsDistMat(nInputs, distMat, bidder_diagrams_min,
-                       bidder_diagrams_sad, bidder_diagrams_max);
-  } else {
-    if(this->do_min_) {
-      enrichCurrentBidderDiagrams(
-        bidder_diagrams_min, current_bidder_diagrams_min, maxDiagPersistence);
-    }
-    if(this->do_sad_) {
-      enrichCurrentBidderDiagrams(
-        bidder_diagrams_sad, current_bidder_diagrams_sad, maxDiagPersistence);
-    }
-    if(this->do_max_) {
-      enrichCurrentBidderDiagrams(
-        bidder_diagrams_max, current_bidder_diagrams_max, maxDiagPersistence);
-    }
-    getDiagramsDistMat(nInputs, distMat, current_bidder_diagrams_min,
-                       current_bidder_diagrams_sad,
-                       current_bidder_diagrams_max);
+    diags_min = std::move(bidder_diagrams_min);
+    diags_sad = std::move(bidder_diagrams_sad);
+    diags_max = std::move(bidder_diagrams_max);
+    return;
+  }
+  if(this->do_min_) {
+    enrichCurrentBidderDiagrams(
+      bidder_diagrams_min, diags_min, maxDiagPersistence);
+  }
+  if(this->do_sad_) {
+    enrichCurrentBidderDiagrams(
+      bidder_diagrams_sad, diags_sad, maxDiagPersistence);
+  }
+  if(this->do_max_) {
+    enrichCurrentBidderDiagrams(
+      bidder_diagrams_max, diags_max, maxDiagPersistence);
   }
-
-  this->printMsg("Complete", 1.0, tm.getElapsedTime(), this->threadNumber_);
-
-  return distMat;
 }
 
 double PersistenceDiagramDistanceMatrix::getMostPersistent(
@@ -152,7 +204,9 @@ double PersistenceDiagramDistanceMatrix::getMostPersistent(
 }
 
 double PersistenceDiagramDistanceMatrix::computePowerDistance(
-  const BidderDiagram &D1, const BidderDiagram &D2) const {
+  const BidderDiagram &D1,
+  const BidderDiagram &D2,
+  const double threshold) const {
 
   GoodDiagram D2_bis{};
   for(size_t i = 0; i < D2.size(); i++) {
@@ -165,10 +219,103 @@ double PersistenceDiagramDistanceMatrix::computePowerDistance(
 
   PersistenceDiagramAuction auction(
     this->Wasserstein, this->Alpha, this->Lambda, this->DeltaLim, true);
+  auction.setUseJacobiBidding(this->UseJacobiBidding);
+  auction.setThreadNumber(this->UseJacobiBidding ? this->threadNumber_ : 1);
   auction.BuildAuctionDiagrams(D1, D2_bis);
+  auction.setCostThreshold(threshold);
   return auction.run();
 }
 
+PersistenceDiagramDistanceMatrix::DiagramTriplet
+  PersistenceDiagramDistanceMatrix::getTriplet(
+    const size_t i,
+    const std::vector<BidderDiagram> &diags_min,
+    const std::vector<BidderDiagram> &diags_sad,
+    const std::vector<BidderDiagram> &diags_max) const {
+  return {this->do_min_ ? &diags_min[i] : nullptr,
+          this->do_sad_ ? &diags_sad[i] : nullptr,
+          this->do_max_ ? &diags_max[i] : nullptr};
+}
+
+double PersistenceDiagramDistanceMatrix::computeDistance(
+  const DiagramTriplet &d1,
+  const DiagramTriplet &d2,
+  const double radius) const {
+
+  const double budget = Geometry::pow(radius, this->Wasserstein);
+  double distance{};
+  for(size_t c = 0; c < d1.size() && distance <= budget; ++c) {
+    if(d1[c] != nullptr) {
+      distance += computePowerDistance(*d1[c], *d2[c], budget - distance);
+    }
+  }
+  return Geometry::pow(distance, 1.0 / this->Wasserstein);
+}
+
+PersistenceDiagramDistanceMatrix::DiagramSignature
+  PersistenceDiagramDistanceMatrix::computeSignature(
+    const DiagramTriplet &diags) const {
+
+  DiagramSignature signature{};
+  for(size_t c = 0; c < diags.size(); ++c) {
+    if(diags[c] == nullptr) {
+      continue;
+    }
+    auto &persistences = signature.persistences[c];
+    for(size_t i = 0; i < diags[c]->size(); ++i) {
+      persistences.emplace_back(std::abs((*diags[c])[i].getPersistence()));
+    }
+    std::sort(persistences.begin(), persistences.end(), std::greater<>{});
+    // cost of matching a pair to the diagonal
+    for(const auto p : persistences) {
+      signature.power += 2 * Geometry::pow(p / 2, this->Wasserstein);
+    }
+  }
+  return signature;
+}
+
+double PersistenceDiagramDistanceMatrix::normLowerBound(
+  const DiagramSignature &s1, const DiagramSignature &s2) const {
+  if(!this->hasBounds()) {
+    return 0.0;
+  }
+  return std::abs(Geometry::pow(s1.power, 1.0 / this->Wasserstein)
+                  - Geometry::pow(s2.power, 1.0 / this->Wasserstein));
+}
+
+double PersistenceDiagramDistanceMatrix::normUpperBound(
+  const DiagramSignature &s1, const DiagramSignature &s2) const {
+  if(!this->hasBounds()) {
+    return std::numeric_limits<double>::infinity();
+  }
+  // loosened by the relative precision of the auction
+  return (1 + this->DeltaLim)
+         * (Geometry::pow(s1.power, 1.0 / this->Wasserstein)
+            + Geometry::pow(s2.power, 1.0 / this->Wasserstein));
+}
+
+double PersistenceDiagramDistanceMatrix::persistenceLowerBound(
+  const DiagramSignature &s1, const DiagramSignature &s2) const {
+  if(!this->hasBounds()) {
+    return 0.0;
+  }
+  // |dx|^p + |dy|^p >= 2 * |(dy - dx) / 2|^p: every matching costs more
+  // than the 1D matching of the persistences, where the diagonal is 0. The
+  // optimal 1D matching pairs sorted values (for p = 1, this is the L1
+  // distance between the persistence curves).
+  double power{};
+  for(size_t c = 0; c < s1.persistences.size(); ++c) {
+    const auto &p1 = s1.persistences[c];
+    const auto &p2 = s2.persistences[c];
+    for(size_t i = 0; i < std::max(p1.size(), p2.size()); ++i) {
+      const double v1 = i < p1.size() ? p1[i] : 0.0;
+      const double v2 = i < p2.size() ? p2[i] : 0.0;
+      power += 2 * Geometry::pow(std::abs(v1 - v2) / 2, this->Wasserstein);
+    }
+  }
+  return Geometry::pow(power, 1.0 / this->Wasserstein);
+}
+
 void PersistenceDiagramDistanceMatrix::getDiagramsDistMat(
   const std::array<size_t, 2> &nInputs,
   std::vector<std::vector<double>> &distanceMatrix,
@@ -177,60 +324,48 @@ void PersistenceDiagramDistanceMatrix::getDiagramsDistMat(
   const std::vector<BidderDiagram> &diags_max) const {
 
   distanceMatrix.resize(nInputs[0]);
+  for(auto &line : distanceMatrix) {
+    line.resize(nInputs[1] == 0 ? nInputs[0] : nInputs[1]);
+  }
 
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for schedule(dynamic) num_threads(this->threadNumber_)
-#endif // TTK_ENABLE_OPENMP
-  for(size_t i = 0; i < nInputs[0]; ++i) {
-
-    if(nInputs[1] == 0) {
-      distanceMatrix[i].resize(nInputs[0]);
-      // set the matrix diagonal
-      distanceMatrix[i][i] = 0.0;
-    } else {
-      distanceMatrix[i].resize(nInputs[1]);
-    }
-
-    const auto getDist = [&](const size_t a, const size_t b) -> double {
-      double distance{};
-      if(this->do_min_) {
-        auto &dimin = diags_min[a];
-        auto &djmin = diags_min[b];
-        distance += computePowerDistance(dimin, djmin);
-      }
-      if(this->do_sad_) {
-        auto &disad = diags_sad[a];
-        auto &djsad = diags_sad[b];
-        distance += computePowerDistance(disad, djsad);
-      }
-      if(this->do_max_) {
-        auto &dimax = diags_max[a];
-        auto &djmax = diags_max[b];
-        distance += computePowerDistance(dimax, djmax);
-      }
-      return Geometry::pow(distance, 1.0 / this->Wasserstein);
-    };
-
-    if(nInputs[1] == 0) {
-      // square matrix: only compute the upper triangle (i < j < nInputs[0])
-      for(size_t j = i + 1; j < nInputs[0]; ++j) {
-        distanceMatrix[i][j] = getDist(i, j);
-      }
-    } else {
-      // rectangular matrix: compute the whole line/column (0 <= j < nInputs[1])
-      for(size_t j = 0; j < nInputs[1]; ++j) {
-        distanceMatrix[i][j] = getDist(i, j + nInputs[0]);
+  const auto getDist = [&](const size_t a, const size_t b) {
+    return this->computeDistance(
+      this->getTriplet(a, diags_min, diags_sad, diags_max),
+      this->getTriplet(b, diags_min, diags_sad, diags_max));
+  };
+
+  // the bidder diagrams account for the constraint on the pairs
+  Fingerprint fingerprint{};
+  if(this->hasCheckpoint()) {
+    fingerprint.add(this->Wasserstein)
+      .add(this->Alpha)
+      .add(this->Lambda)
+      .add(this->DeltaLim)
+      .add(this->UseJacobiBidding)
+      .add(this->do_min_)
+      .add(this->do_sad_)
+      .add(this->do_max_);
+    for(const auto diags : {&diags_min, &diags_sad, &diags_max}) {
+      fingerprint.add(diags->size());
+      for(const auto &diag : *diags) {
+        fingerprint.add(diag.size());
+        for(const auto &b : diag) {
+          fingerprint.add(b.x_).add(b.y_).add(b.coords_.data(), 3);
+        }
       }
     }
   }
 
   if(nInputs[1] == 0) {
-    // square distance matrix is symmetric: complete the lower triangle
-    for(size_t i = 0; i < nInputs[0]; ++i) {
-      for(size_t j = i + 1; j < nInputs[0]; ++j) {
-        distanceMatrix[j][i] = distanceMatrix[i][j];
-      }
-    }
+    // square matrix: only compute the upper triangle (i < j < nInputs[0])
+    this->computeSymmetric(
+      distanceMatrix, nInputs[0], getDist, true, fingerprint.get());
+  } else {
+    // rectangular matrix: compute the whole line/column (0 <= j < nInputs[1])
+    this->computeRectangular(
+      distanceMatrix, nInputs[0], nInputs[1],
+      [&](const size_t i, const size_t j) { return getDist(i, j + nInputs[0]); },
+      true, fingerprint.get());
   }
 }
 
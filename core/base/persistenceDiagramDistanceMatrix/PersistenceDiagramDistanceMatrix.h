@@ -20,14 +20,16 @@
 #pragma once
 
 #include <array>
+#include <limits>
 
 #include <Debug.h>
+#include <DistanceMatrixEngine.h>
 #include <PersistenceDiagramAuction.h>
 #include <PersistenceDiagramUtils.h>
 
 namespace ttk {
 
-  class PersistenceDiagramDistanceMatrix : virtual public Debug {
+  class PersistenceDiagramDistanceMatrix : public DistanceMatrixEngine {
 
   public:
     PersistenceDiagramDistanceMatrix() {
@@ -38,6 +40,15 @@ namespace ttk {
       execute(const std::vector<DiagramType> &intermediateDiagrams,
               const std::array<size_t, 2> &nInputs) const;
 
+    /**
+     * The k nearest neighbors (distance, diagram index) of every diagram,
+     * without computing the whole distance matrix.
+     */
+    std::vector<std::vector<std::pair<double, size_t>>>
+      executeNearestNeighbors(
+        const std::vector<DiagramType> &intermediateDiagrams,
+        const size_t k) const;
+
     inline void setWasserstein(const int data) {
       Wasserstein = data;
     }
@@ -61,6 +72,12 @@ namespace ttk {
     inline void setMinPersistence(const double data) {
       MinPersistence = data;
     }
+    /// Jacobi bidding in the auctions (see PersistenceDiagramAuction): the
+    /// threads then compute the bids of one pair of diagrams at a time.
+    inline void setUseJacobiBidding(const bool data) {
+      UseJacobiBidding = data;
+      this->setParallelDistances(data);
+    }
     inline void setConstraint(const int data) {
       if(data == 0) {
         this->Constraint = ConstraintType::FULL_DIAGRAMS;
@@ -76,10 +93,54 @@ namespace ttk {
     }
 
   protected:
+    void prepareBidderDiagrams(
+      const std::vector<DiagramType> &intermediateDiagrams,
+      std::vector<BidderDiagram> &diags_min,
+      std::vector<BidderDiagram> &diags_sad,
+      std::vector<BidderDiagram> &diags_max) const;
+
+    // the min, sad and max diagrams of one input (nullptr if not processed)
+    using DiagramTriplet = std::array<const BidderDiagram *, 3>;
+    DiagramTriplet getTriplet(const size_t i,
+                              const std::vector<BidderDiagram> &diags_min,
+                              const std::vector<BidderDiagram> &diags_sad,
+                              const std::vector<BidderDiagram> &diags_max) const;
+
+    // distance between two inputs, the auctions stop early (returning any
+    // value above radius) when the distance is proven above radius
+    double computeDistance(
+      const DiagramTriplet &d1,
+      const DiagramTriplet &d2,
+      const double radius = std::numeric_limits<double>::infinity()) const;
+
+    // cheap summary of an input, used to bound its distances to the others
+    struct DiagramSignature {
+      // p-th power of the distance to the empty diagram
+      double power{};
+      // decreasing persistences of each class
+      std::array<std::vector<double>, 3> persistences{};
+    };
+    DiagramSignature computeSignature(const DiagramTriplet &diags) const;
+    // bounds are only valid when the ground distance is the Lp distance in
+    // the birth-death plane
+    inline bool hasBounds() const {
+      return this->Alpha == 1.0;
+    }
+    // triangle inequality through the empty diagram
+    double normLowerBound(const DiagramSignature &s1,
+                          const DiagramSignature &s2) const;
+    double normUpperBound(const DiagramSignature &s1,
+                          const DiagramSignature &s2) const;
+    // distance between the persistence values only (projection orthogonal
+    // to the diagonal)
+    double persistenceLowerBound(const DiagramSignature &s1,
+                                 const DiagramSignature &s2) const;
     double
       getMostPersistent(const std::vector<BidderDiagram> &bidder_diags) const;
-    double computePowerDistance(const BidderDiagram &D1,
-                                const BidderDiagram &D2) const;
+    double computePowerDistance(
+      const BidderDiagram &D1,
+      const BidderDiagram &D2,
+      const double threshold = std::numeric_limits<double>::infinity()) const;
     void getDiagramsDistMat(const std::array<size_t, 2> &nInputs,
                             std::vector<std::vector<double>> &distanceMatrix,
                             const std::vector<BidderDiagram> &diags_min,
@@ -105,6 +166,7 @@ namespace ttk {
     double Lambda;
     size_t MaxNumberOfPairs{20};
     double MinPersistence{0.1};
+    bool UseJacobiBidding{false};
     bool do_min_{true}, do_sad_{true}, do_max_{true};
 
     enum class ConstraintType {
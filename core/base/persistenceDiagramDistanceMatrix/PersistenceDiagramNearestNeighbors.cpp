@@ -0,0 +1,97 @@
+#include <PersistenceDiagramNearestNeighbors.h>
+
+#include <algorithm>
+
+using namespace ttk;
+
+int PersistenceDiagramNearestNeighbors::addDiagrams(
+  const std::vector<DiagramType> &diagrams) {
+
+  Timer tm{};
+
+  std::vector<BidderDiagram> diags_min{}, diags_sad{}, diags_max{};
+  this->prepareBidderDiagrams(diagrams, diags_min, diags_sad, diags_max);
+
+  const auto append = [](std::vector<BidderDiagram> &index,
+                         std::vector<BidderDiagram> &diags) {
+    index.insert(index.end(), std::make_move_iterator(diags.begin()),
+                 std::make_move_iterator(diags.end()));
+  };
+  append(this->DiagsMin, diags_min);
+  append(this->DiagsSad, diags_sad);
+  append(this->DiagsMax, diags_max);
+
+  const size_t first = this->Signatures.size();
+  this->Signatures.resize(first + diagrams.size());
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(this->threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = first; i < this->Signatures.size(); ++i) {
+    this->Signatures[i] = this->computeSignature(
+      this->getTriplet(i, this->DiagsMin, this->DiagsSad, this->DiagsMax));
+  }
+
+  this->printMsg("Indexed " + std::to_string(diagrams.size()) + " diagrams",
+                 1.0, tm.getElapsedTime(), this->threadNumber_);
+
+  return 0;
+}
+
+int PersistenceDiagramNearestNeighbors::query(
+  const DiagramType &diagram,
+  const size_t k,
+  std::vector<std::pair<double, size_t>> &neighbors) const {
+
+  Timer tm{};
+
+  std::vector<BidderDiagram> query_min{}, query_sad{}, query_max{};
+  this->prepareBidderDiagrams({diagram}, query_min, query_sad, query_max);
+  const auto queryTriplet
+    = this->getTriplet(0, query_min, query_sad, query_max);
+  const auto querySignature = this->computeSignature(queryTriplet);
+
+  const size_t n = this->Signatures.size();
+  const size_t kk = std::min(k, n);
+  neighbors.clear();
+  if(kk == 0) {
+    return 0;
+  }
+
+  // the k-th smallest upper bound is above the k-th neighbor distance
+  std::vector<double> upperBounds(n);
+  std::vector<std::pair<double, size_t>> candidates(n);
+  for(size_t j = 0; j < n; ++j) {
+    upperBounds[j] = this->normUpperBound(querySignature, this->Signatures[j]);
+    candidates[j]
+      = {this->normLowerBound(querySignature, this->Signatures[j]), j};
+  }
+  std::nth_element(
+    upperBounds.begin(), upperBounds.begin() + kk - 1, upperBounds.end());
+  const double radius = upperBounds[kk - 1];
+  candidates.erase(
+    std::remove_if(candidates.begin(), candidates.end(),
+                   [radius](const std::pair<double, size_t> &c) {
+                     return c.first > radius;
+                   }),
+    candidates.end());
+
+  const auto getDist = [&](const size_t j, const double r) {
+    return this->computeDistance(
+      queryTriplet,
+      this->getTriplet(j, this->DiagsMin, this->DiagsSad, this->DiagsMax), r);
+  };
+  const auto refinedBound = [&](const size_t j) {
+    return this->persistenceLowerBound(querySignature, this->Signatures[j]);
+  };
+
+  const auto nComputed
+    = this->selectNearest(candidates, kk, getDist, refinedBound, neighbors,
+                          this->getPairThreadNumber());
+
+  this->printMsg("Found " + std::to_string(neighbors.size())
+                   + " neighbors with " + std::to_string(nComputed) + " / "
+                   + std::to_string(n) + " auctions",
+                 1.0, tm.getElapsedTime(), this->threadNumber_);
+
+  return 0;
+}
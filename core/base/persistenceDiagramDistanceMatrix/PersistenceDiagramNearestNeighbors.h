@@ -0,0 +1,69 @@
+/// \ingroup base
+/// \class ttk::PersistenceDiagramNearestNeighbors
+///
+/// \brief Indexed collection of persistence diagrams answering k nearest
+/// neighbors queries.
+///
+/// Diagrams are prepared once (bidder diagrams and cheap signatures). A
+/// query only computes the exact Wasserstein distances that cannot be
+/// pruned by cascading lower bounds:
+///   - the triangle inequality through the empty diagram,
+///   - the distance between the persistence values only (the
+///   generalization of the L1 distance between persistence curves),
+///   - auctions stopping as soon as their cost is proven above the current
+///   k-th distance.
+///
+/// The pair selection constraint of ttk::PersistenceDiagramDistanceMatrix
+/// is applied to each batch of diagrams added to the index, and to each
+/// query diagram alone.
+///
+/// \sa ttk::PersistenceDiagramDistanceMatrix
+/// \sa ttk::DistanceMatrixEngine
+
+#pragma once
+
+#include <PersistenceDiagramDistanceMatrix.h>
+
+namespace ttk {
+
+  class PersistenceDiagramNearestNeighbors
+    : public PersistenceDiagramDistanceMatrix {
+
+  public:
+    PersistenceDiagramNearestNeighbors() {
+      this->setDebugMsgPrefix("PersistenceDiagramNearestNeighbors");
+    }
+
+    /**
+     * Append diagrams to the index.
+     */
+    int addDiagrams(const std::vector<DiagramType> &diagrams);
+
+    inline size_t getNumberOfDiagrams() const {
+      return this->Signatures.size();
+    }
+
+    inline void clear() {
+      this->DiagsMin.clear();
+      this->DiagsSad.clear();
+      this->DiagsMax.clear();
+      this->Signatures.clear();
+    }
+
+    /**
+     * The k indexed diagrams closest to the query, as (distance, index in
+     * the index) sorted by increasing distance.
+     */
+    int query(const DiagramType &diagram,
+              const size_t k,
+              std::vector<std::pair<double, size_t>> &neighbors) const;
+
+  protected:
+    // diagrams of the index, split by classes
+    std::vector<BidderDiagram> DiagsMin{};
+    std::vector<BidderDiagram> DiagsSad{};
+    std::vector<BidderDiagram> DiagsMax{};
+    std::vector<DiagramSignature> Signatures{};
+  };
+
+} // namespace ttk
@@ -1,3 +1,4 @@
+#include <RadiusSearchTree.h>
 #include <RipsComplex.h>
 
 #include <limits>
@@ -187,6 +188,199 @@ static void
   }
 }
 
+using Neighbor = std::pair<ttk::SimplexId, double>;
+
+// core decomposition of Batagelj and Zaversnik: the vertices are ranked by
+// removal order, each one having the minimal degree of the remaining graph
+static void
+  computeDegeneracyOrder(std::vector<ttk::SimplexId> &rank,
+                         const std::vector<std::vector<Neighbor>> &graph) {
+
+  const auto nVerts{graph.size()};
+  std::vector<size_t> degree(nVerts);
+  size_t maxDegree{};
+  for(size_t i = 0; i < nVerts; ++i) {
+    degree[i] = graph[i].size();
+    maxDegree = std::max(maxDegree, degree[i]);
+  }
+
+  // vertices sorted by degree, bins[d] being the first one of degree d
+  std::vector<size_t> bins(maxDegree + 1, 0);
+  for(size_t i = 0; i < nVerts; ++i) {
+    bins[degree[i]]++;
+  }
+  size_t start{};
+  for(auto &b : bins) {
+    const auto count{b};
+    b = start;
+    start += count;
+  }
+  std::vector<size_t> pos(nVerts), verts(nVerts);
+  for(size_t i = 0; i < nVerts; ++i) {
+    pos[i] = bins[degree[i]]++;
+    verts[pos[i]] = i;
+  }
+  for(size_t d = maxDegree; d > 0; --d) {
+    bins[d] = bins[d - 1];
+  }
+  bins[0] = 0;
+
+  rank.resize(nVerts);
+  for(size_t i = 0; i < nVerts; ++i) {
+    const auto v{verts[i]};
+    rank[v] = static_cast<ttk::SimplexId>(i);
+    for(const auto &n : graph[v]) {
+      const auto u{static_cast<size_t>(n.first)};
+      if(degree[u] > degree[v]) {
+        // move u to the beginning of its bin, then to the previous bin
+        const auto pu{pos[u]};
+        const auto pw{bins[degree[u]]};
+        const auto w{verts[pw]};
+        if(u != w) {
+          pos[u] = pw;
+          verts[pu] = w;
+          pos[w] = pu;
+          verts[pw] = u;
+        }
+        bins[degree[u]]++;
+        degree[u]--;
+      }
+    }
+  }
+}
+
+// cliques of n vertices extending clique[0, size[, whose common
+// successors are the candidates (with their maximal distance to the
+// clique)
+template <size_t n>
+static void expandCliques(std::array<ttk::SimplexId, n> &clique,
+                          const size_t size,
+                          const double diam,
+                          const std::vector<Neighbor> &candidates,
+                          const std::vector<std::vector<Neighbor>> &successors,
+                          std::vector<LocCell<n>> &cells) {
+
+  if(size + 1 == n) {
+    for(const auto &c : candidates) {
+      clique[size] = c.first;
+      cells.emplace_back(LocCell<n>{std::max(diam, c.second), clique});
+      std::sort(cells.back().verts.begin(), cells.back().verts.end());
+    }
+    return;
+  }
+
+  std::vector<Neighbor> next{};
+  for(const auto &c : candidates) {
+    // both lists are sorted by vertex
+    next.clear();
+    const auto &succ{successors[c.first]};
+    for(size_t i = 0, j = 0; i < candidates.size() && j < succ.size();) {
+      if(candidates[i].first < succ[j].first) {
+        ++i;
+      } else if(succ[j].first < candidates[i].first) {
+        ++j;
+      } else {
+        next.emplace_back(
+          succ[j].first, std::max(candidates[i].second, succ[j].second));
+        ++i;
+        ++j;
+      }
+    }
+    if(size + 1 + next.size() < n) {
+      continue;
+    }
+    clique[size] = c.first;
+    expandCliques(
+      clique, size + 1, std::max(diam, c.second), next, successors, cells);
+  }
+}
+
+template <size_t n>
+static void computeCliques(std::vector<ttk::SimplexId> &connectivity,
+                           std::vector<double> &diameters,
+                           const double epsilon,
+                           const std::vector<std::vector<double>> &points,
+                           const int nThreads) {
+
+  TTK_FORCE_USE(nThreads);
+
+  const auto nPoints{points.size()};
+
+  // epsilon graph from range queries (strict inequality for the edges, as
+  // in computeEdges)
+  std::vector<std::vector<Neighbor>> graph(nPoints);
+  {
+    const ttk::RadiusSearchTree tree{points};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(dynamic, 64)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t i = 0; i < nPoints; ++i) {
+      tree.forEachNeighbor(
+        points[i].data(), epsilon, [&](const size_t j, const double d) {
+          if(j != i && (n > 2 || d < epsilon)) {
+            graph[i].emplace_back(static_cast<ttk::SimplexId>(j), d);
+          }
+        });
+    }
+  }
+
+  // edges are oriented towards the highest rank in a degeneracy order,
+  // bounding the number of successors of every vertex by the degeneracy of
+  // the graph
+  std::vector<ttk::SimplexId> rank{};
+  computeDegeneracyOrder(rank, graph);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(dynamic, 64)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < nPoints; ++i) {
+    auto &succ{graph[i]};
+    succ.erase(std::remove_if(succ.begin(), succ.end(),
+                              [&](const Neighbor &v) {
+                                return rank[v.first] < rank[i];
+                              }),
+               succ.end());
+    succ.shrink_to_fit();
+    std::sort(succ.begin(), succ.end());
+  }
+
+  // every clique is found once, from its vertex of lowest rank
+  std::vector<std::vector<LocCell<n>>> cells(nPoints);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(dynamic)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < nPoints; ++i) {
+    std::array<ttk::SimplexId, n> clique{};
+    clique[0] = static_cast<ttk::SimplexId>(i);
+    expandCliques(clique, 1, 0.0, graph[i], graph, cells[i]);
+  }
+
+  graph = {};
+
+  std::vector<size_t> psum(cells.size() + 1);
+  for(size_t i = 0; i < cells.size(); ++i) {
+    psum[i + 1] = psum[i] + cells[i].size();
+  }
+
+  const auto nCells{psum.back()};
+  diameters.resize(nCells);
+  connectivity.resize(n * nCells);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(dynamic)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < cells.size(); ++i) {
+    for(size_t j = 0; j < cells[i].size(); ++j) {
+      for(size_t k = 0; k < n; ++k) {
+        connectivity[n * (psum[i] + j) + k] = cells[i][j].verts[k];
+      }
+      diameters[psum[i] + j] = cells[i][j].diam;
+    }
+    cells[i] = {};
+  }
+}
+
 int ttk::RipsComplex::computeGaussianDensity(
   double *const density,
   const std::vector<std::vector<double>> &distanceMatrix) const {
@@ -210,6 +404,28 @@ int ttk::RipsComplex::computeGaussianDensity(
   return 0;
 }
 
+int ttk::RipsComplex::computeGaussianDensityFromPoints(
+  double *const density, const std::vector<std::vector<double>> &points) const {
+
+  const auto sq = [](const double a) -> double { return a * a; };
+  const RadiusSearchTree tree{points};
+  const double radius{9.0 * this->StdDev};
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(this->threadNumber_) schedule(dynamic, 64)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < points.size(); ++i) {
+    // the point itself counts twice, as in computeGaussianDensity
+    density[i] = 1.0;
+    tree.forEachNeighbor(
+      points[i].data(), radius, [&](const size_t, const double d) {
+        density[i] += std::exp(-sq(d) / (2.0 * sq(this->StdDev)));
+      });
+  }
+
+  return 0;
+}
+
 int ttk::RipsComplex::computeDiameterStats(
   const SimplexId nPoints,
   std::array<double *const, 3> diamStats,
@@ -268,15 +484,31 @@ int ttk::RipsComplex::execute(
 
   Timer tm{};
 
-  if(distanceMatrix.empty()
-     || distanceMatrix.size() != distanceMatrix[0].size()) {
+  if(this->InputIsPointCloud) {
+    if(distanceMatrix.empty() || distanceMatrix[0].empty()) {
+      this->printErr("Invalid point cloud");
+      return 1;
+    }
+  } else if(distanceMatrix.empty()
+            || distanceMatrix.size() != distanceMatrix[0].size()) {
     this->printErr("Invalid distance matrix");
     return 1;
   }
 
   Timer tm_rips{};
 
-  if(this->OutputDimension == 1) {
+  if(this->InputIsPointCloud) {
+    if(this->OutputDimension == 1) {
+      computeCliques<2>(connectivity, diameters, this->Epsilon,
+                        distanceMatrix, this->threadNumber_);
+    } else if(this->OutputDimension == 2) {
+      computeCliques<3>(connectivity, diameters, this->Epsilon,
+                        distanceMatrix, this->threadNumber_);
+    } else if(this->OutputDimension == 3) {
+      computeCliques<4>(connectivity, diameters, this->Epsilon,
+                        distanceMatrix, this->threadNumber_);
+    }
+  } else if(this->OutputDimension == 1) {
     computeEdges(connectivity, diameters, this->Epsilon, distanceMatrix,
                  this->threadNumber_);
   } else if(this->OutputDimension == 2) {
@@ -287,7 +519,9 @@ int ttk::RipsComplex::execute(
                   this->threadNumber_);
   }
 
-  this->printMsg("Generated Rips complex from distance matrix", 1.0,
+  const std::string input{this->InputIsPointCloud ? "point cloud"
+                                                  : "distance matrix"};
+  this->printMsg("Generated Rips complex from " + input, 1.0,
                  tm_rips.getElapsedTime(), this->threadNumber_,
                  debug::LineMode::NEW, debug::Priority::DETAIL);
 
@@ -295,7 +529,11 @@ int ttk::RipsComplex::execute(
     distanceMatrix.size(), diamStats, connectivity, diameters);
 
   if(this->ComputeGaussianDensity) {
-    this->computeGaussianDensity(density, distanceMatrix);
+    if(this->InputIsPointCloud) {
+      this->computeGaussianDensityFromPoints(density, distanceMatrix);
+    } else {
+      this->computeGaussianDensity(density, distanceMatrix);
+    }
   }
 
   this->printMsg("Complete", 1.0, tm.getElapsedTime(), this->threadNumber_);
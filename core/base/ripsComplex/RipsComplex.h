@@ -12,6 +12,12 @@
 /// computes a Rips complex from it to generate an explicit
 /// triangulation.
 ///
+/// Alternatively, the input can be the point coordinates (of any
+/// dimension): the neighborhood graph is then built with concurrent range
+/// queries in a kd-tree and its cliques are enumerated from every vertex
+/// following a degeneracy order, so that the memory scales with the size of
+/// the complex instead of the square of the number of points.
+///
 /// \sa ttk::Triangulation
 /// \sa ttkRipsComplex.cpp %for a usage example.
 ///
@@ -41,7 +47,8 @@ namespace ttk {
      * @param[out] connectivity Cell connectivity array (VTK format)
      * @param[out] diameters Cell diameters
      * @param[out] diamStats Min, mean and max cell diameters around point
-     * @param[in] distanceMatrix Input distance matrix
+     * @param[in] distanceMatrix Input distance matrix (point coordinates if
+     * InputIsPointCloud)
      * @param[out] density Gaussian density array on points
      */
     int execute(std::vector<SimplexId> &connectivity,
@@ -50,6 +57,16 @@ namespace ttk {
                 const std::vector<std::vector<double>> &distanceMatrix,
                 double *const density = nullptr) const;
 
+    inline void setOutputDimension(const int dimension) {
+      this->OutputDimension = dimension;
+    }
+    inline void setEpsilon(const double epsilon) {
+      this->Epsilon = epsilon;
+    }
+    inline void setInputIsPointCloud(const bool isPointCloud) {
+      this->InputIsPointCloud = isPointCloud;
+    }
+
   protected:
     /**
      * @brief Compute diameter statistics on points
@@ -74,6 +91,20 @@ namespace ttk {
       double *const density,
       const std::vector<std::vector<double>> &distanceMatrix) const;
 
+    /**
+     * @brief Compute Gaussian density on points from their coordinates
+     *
+     * The contributions of the points farther than 9 standard deviations
+     * (below the double precision relative to the point itself) are
+     * neglected.
+     *
+     * @param[out] density Gaussian density array on points
+     * @param[in] points Point coordinates
+     */
+    int computeGaussianDensityFromPoints(
+      double *const density,
+      const std::vector<std::vector<double>> &points) const;
+
     /** Dimension of the generated complex */
     int OutputDimension{2};
     /** Distance threshold */
@@ -82,6 +113,8 @@ namespace ttk {
     double StdDev{1.0};
     /** Compute the Gaussian density from the distance matrix */
     bool ComputeGaussianDensity{false};
+    /** The input rows are point coordinates instead of a distance matrix */
+    bool InputIsPointCloud{false};
   };
 
 } // namespace ttk
@@ -1,5 +1,202 @@
 #include <RipsPersistenceDiagram.h>
 
+#include <OpenMP.h>
+#include <RadiusSearchTree.h>
+
+#include <limits>
+#include <queue>
+
+namespace {
+
+  using ripser::index_t;
+  using ripser::value_t;
+  using Neighbors = std::vector<std::vector<ripser::index_diameter_t>>;
+
+  /**
+   * Point cloud, radius queries in a kd-tree.
+   */
+  class PointCloud {
+  public:
+    PointCloud(const std::vector<std::vector<double>> &points)
+      : points_{points}, tree_{points} {
+    }
+
+    inline size_t size() const {
+      return points_.size();
+    }
+
+    /**
+     * Calls f(j, d(i, j)) for every point j (i included) with d(i, j) lower
+     * than or equal to radius.
+     */
+    template <typename Func>
+    void forEachNeighbor(const index_t i, const double radius, Func f) const {
+      tree_.forEachNeighbor(points_[i].data(), radius, f);
+    }
+
+  private:
+    const std::vector<std::vector<double>> &points_;
+    const ttk::RadiusSearchTree tree_;
+  };
+
+  /**
+   * Distance matrix given by its lower triangular part, radius queries
+   * scanning rows.
+   */
+  class DistanceMatrix {
+  public:
+    DistanceMatrix(const std::vector<double> &distances)
+      : distances_{distances},
+        size_{static_cast<size_t>(
+          (1 + std::sqrt(1 + 8 * static_cast<double>(distances.size()))) / 2)} {
+    }
+
+    inline size_t size() const {
+      return size_;
+    }
+
+    template <typename Func>
+    void forEachNeighbor(const index_t i, const double radius, Func f) const {
+      for(size_t j = 0; j < size_; ++j) {
+        const size_t k = static_cast<size_t>(i);
+        const double d = j == k  ? 0
+                         : j < k ? distances_[k * (k - 1) / 2 + j]
+                                 : distances_[j * (j - 1) / 2 + k];
+        if(d <= radius) {
+          f(j, d);
+        }
+      }
+    }
+
+  private:
+    const std::vector<double> &distances_;
+    const size_t size_;
+  };
+
+  /**
+   * Insertion radii of the greedy permutation (farthest point sampling),
+   * infinite for the first point.
+   */
+  template <typename Space>
+  void computeInsertionRadii(const Space &space, std::vector<double> &radii) {
+    const auto n = space.size();
+    const auto inf = std::numeric_limits<double>::infinity();
+    radii.assign(n, inf);
+    if(n == 0) {
+      return;
+    }
+
+    // distance to the inserted points, lazy max-heap of the candidates
+    std::vector<double> dist(n, inf);
+    std::vector<bool> inserted(n, false);
+    std::priority_queue<std::pair<double, index_t>> heap{};
+    inserted[0] = true;
+    space.forEachNeighbor(0, inf, [&](const index_t j, const double d) {
+      dist[j] = d;
+      heap.emplace(d, j);
+    });
+
+    while(!heap.empty()) {
+      const auto top = heap.top();
+      heap.pop();
+      const auto p = top.second;
+      if(inserted[p] || top.first != dist[p]) {
+        continue;
+      }
+      inserted[p] = true;
+      radii[p] = top.first;
+      space.forEachNeighbor(p, top.first, [&](const index_t j, const double d) {
+        if(!inserted[j] && d < dist[j]) {
+          dist[j] = d;
+          heap.emplace(d, j);
+        }
+      });
+    }
+  }
+
+  /**
+   * Edges of the Rips filtration, sorted by vertex. When epsilon is
+   * positive, the filtration is replaced by its (1 + epsilon)-approximation
+   * of
+   *
+   * "A Geometric Perspective on Sparse Filtrations" \n
+   * N. J. Cavanna, M. Jahanseir, D. R. Sheehy \n
+   * Proc. of the Canadian Conference on Computational Geometry, 2015.
+   *
+   * whose edges are pruned and warped according to the insertion radii of
+   * their vertices.
+   */
+  template <typename Space>
+  void computeNeighbors(const Space &space,
+                        const double threshold,
+                        const double epsilon,
+                        Neighbors &neighbors,
+                        const int threadNumber) {
+    const auto n = space.size();
+    neighbors.clear();
+    neighbors.resize(n);
+
+    if(epsilon <= 0) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber) schedule(dynamic, 64)
+#endif // TTK_ENABLE_OPENMP
+      for(size_t i = 0; i < n; ++i) {
+        space.forEachNeighbor(
+          i, threshold, [&](const index_t j, const double d) {
+            if(j != static_cast<index_t>(i)) {
+              neighbors[i].emplace_back(j, d);
+            }
+          });
+        std::sort(neighbors[i].begin(), neighbors[i].end());
+      }
+      return;
+    }
+
+    std::vector<double> radii{};
+    computeInsertionRadii(space, radii);
+
+    const double e0 = (1 + epsilon) / epsilon;
+    const double e1 = (1 + epsilon) * (1 + epsilon) / epsilon;
+
+    // each edge is found from its vertex of smallest insertion radius
+    Neighbors edges(n);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber) schedule(dynamic, 64)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t i = 0; i < n; ++i) {
+      const double ri = radii[i];
+      const double radius = std::min(threshold, (e0 + e1) * ri);
+      space.forEachNeighbor(i, radius, [&](const index_t j, const double d) {
+        const double rj = radii[j];
+        if(rj < ri || (rj == ri && j <= static_cast<index_t>(i))) {
+          return;
+        }
+        if(d > std::min((e0 + e1) * ri, e0 * (ri + rj))) {
+          return;
+        }
+        const double warped = d <= 2 * ri * e0 ? d : 2 * (d - ri * e0);
+        if(warped <= threshold) {
+          edges[i].emplace_back(j, warped);
+        }
+      });
+    }
+
+    for(size_t i = 0; i < n; ++i) {
+      for(const auto &e : edges[i]) {
+        neighbors[i].emplace_back(e);
+        neighbors[e.first].emplace_back(i, e.second);
+      }
+    }
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber) schedule(dynamic, 64)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t i = 0; i < n; ++i) {
+      std::sort(neighbors[i].begin(), neighbors[i].end());
+    }
+  }
+
+} // namespace
+
 ttk::RipsPersistenceDiagram::RipsPersistenceDiagram() {
   // inherited from Debug: prefix will be printed at the beginning of every msg
   this->setDebugMsgPrefix("RipsPersistenceDiagram");
@@ -9,8 +206,33 @@ int ttk::RipsPersistenceDiagram::execute(
   const std::vector<std::vector<double>> &points,
   std::vector<std::vector<ripser::pers_pair_t>> &ph) const {
 
-  ripser::ripser(points, SimplexMaximumDiameter, SimplexMaximumDimension,
-                 InputIsDistanceMatrix, ph);
+  Timer tm{};
+
+  Neighbors neighbors{};
+  if(InputIsDistanceMatrix) {
+    if(points.empty()) {
+      this->printErr("Empty distance matrix");
+      return -1;
+    }
+    computeNeighbors(DistanceMatrix{points[0]}, SimplexMaximumDiameter,
+                     SparseApproximation, neighbors, this->threadNumber_);
+  } else {
+    computeNeighbors(PointCloud{points}, SimplexMaximumDiameter,
+                     SparseApproximation, neighbors, this->threadNumber_);
+  }
+
+  size_t nEdges{};
+  for(const auto &n : neighbors) {
+    nEdges += n.size();
+  }
+  this->printMsg("Computed " + std::to_string(nEdges / 2) + " edges", 1.0,
+                 tm.getElapsedTime(), this->threadNumber_);
+
+  ripser::ripser(std::move(neighbors), SimplexMaximumDiameter,
+                 SimplexMaximumDimension, ph, this->threadNumber_);
+
+  this->printMsg("Computed persistence diagram", 1.0, tm.getElapsedTime(),
+                 this->threadNumber_);
 
   return 0;
-}
\ No newline at end of file
+}
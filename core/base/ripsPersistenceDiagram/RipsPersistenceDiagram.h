@@ -10,6 +10,12 @@
 /// cloud or a distance matrix and computes the persistence diagram of its Rips
 /// complex.
 ///
+/// The edges of the complex are found with radius queries in a kd-tree (or
+/// by scanning the rows of the distance matrix) and the persistence pairs
+/// are computed by Ripser, the apparent pairs and the clearing being
+/// processed in parallel. An optional sparse approximation of the
+/// filtration bounds the size of the complex on large point clouds.
+///
 /// \sa ttk::Triangulation
 /// \sa ttkRipsPersistenceDiagram.cpp %for a usage example.
 
@@ -42,6 +48,19 @@ namespace ttk {
     int execute(const std::vector<std::vector<double>> &points,
                 std::vector<std::vector<ripser::pers_pair_t>> &ph) const;
 
+    inline void setSimplexMaximumDimension(const int dimension) {
+      this->SimplexMaximumDimension = dimension;
+    }
+    inline void setSimplexMaximumDiameter(const double diameter) {
+      this->SimplexMaximumDiameter = diameter;
+    }
+    inline void setInputIsDistanceMatrix(const int isDistanceMatrix) {
+      this->InputIsDistanceMatrix = isDistanceMatrix;
+    }
+    inline void setSparseApproximation(const double epsilon) {
+      this->SparseApproximation = epsilon;
+    }
+
   protected:
     /** Max dimension of computed persistence diagram */
     int SimplexMaximumDimension{1};
@@ -49,6 +68,8 @@ namespace ttk {
     double SimplexMaximumDiameter{1.0};
     /** is input a distance matrix */
     int InputIsDistanceMatrix{0};
+    /** approximation factor of the sparse filtration (0: exact) */
+    double SparseApproximation{0};
 
   }; // RipsPersistenceDiagram class
 
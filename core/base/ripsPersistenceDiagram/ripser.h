@@ -31,4 +31,17 @@ namespace ripser {
               bool distanceMatrix,
               std::vector<std::vector<pers_pair_t>> &ph);
 
+  using index_diameter_t = std::pair<index_t, value_t>;
+
+  /**
+   * Sparse input: neighbors[i] lists the (vertex, edge length) pairs of the
+   * edges of vertex i, sorted by vertex. The pairs are computed with
+   * threadNumber threads.
+   */
+  void ripser(std::vector<std::vector<index_diameter_t>> &&neighbors,
+              value_t threshold,
+              index_t dim_max,
+              std::vector<std::vector<pers_pair_t>> &ph,
+              int threadNumber = 1);
+
 } // namespace ripser
\ No newline at end of file
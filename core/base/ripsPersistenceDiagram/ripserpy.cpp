@@ -58,6 +58,8 @@ derivative works thereof, in binary and source code form.
 
 #include "ripser.h"
 
+#include <OpenMP.h>
+
 using namespace ripser;
 
 void check_overflow(index_t i);
@@ -240,7 +242,6 @@ index_t get_index(const diameter_index_t &i) {
   return i.second;
 }
 
-using index_diameter_t = std::pair<index_t, value_t>;
 index_t get_index(const index_diameter_t &i);
 value_t get_diameter(const index_diameter_t &i);
 index_t get_index(const index_diameter_t &i) {
@@ -373,14 +374,19 @@ value_t compressed_upper_distance_matrix::operator()(const index_t i,
   return i == j ? 0 : i > j ? rows[j][i] : rows[i][j];
 }
 
+// buffers of the coboundary enumeration, one per thread
+struct coboundary_workspace {
+  std::vector<std::vector<index_diameter_t>::const_reverse_iterator>
+    neighbor_it;
+  std::vector<std::vector<index_diameter_t>::const_reverse_iterator>
+    neighbor_end;
+};
+
 struct sparse_distance_matrix {
   std::vector<std::vector<index_diameter_t>> neighbors;
   index_t num_edges;
 
-  mutable std::vector<std::vector<index_diameter_t>::const_reverse_iterator>
-    neighbor_it;
-  mutable std::vector<std::vector<index_diameter_t>::const_reverse_iterator>
-    neighbor_end;
+  mutable coboundary_workspace workspace;
 
   sparse_distance_matrix(
     std::vector<std::vector<index_diameter_t>> &&_neighbors, index_t _num_edges)
@@ -401,6 +407,18 @@ struct sparse_distance_matrix {
   size_t size() const {
     return neighbors.size();
   }
+
+  // length of an edge of the filtration
+  value_t operator()(const index_t i, const index_t j) const {
+    if(i == j)
+      return 0;
+    const auto it = std::lower_bound(
+      neighbors[i].begin(), neighbors[i].end(), j,
+      [](const index_diameter_t &a, const index_t b) { return a.first < b; });
+    return it != neighbors[i].end() && it->first == j
+             ? it->second
+             : std::numeric_limits<value_t>::infinity();
+  }
 };
 
 struct euclidean_distance_matrix {
@@ -509,6 +527,7 @@ class Ripser {
   const value_t threshold;
   const float ratio;
   const coefficient_t modulus;
+  const int threadNumber;
   const binomial_coeff_table binomial_coeff;
   const std::vector<coefficient_t> multiplicative_inverse;
   mutable std::vector<diameter_entry_t> cofacet_entries;
@@ -536,10 +555,11 @@ public:
          index_t _dim_max,
          value_t _threshold,
          float _ratio,
-         coefficient_t _modulus)
+         coefficient_t _modulus,
+         int _threadNumber = 1)
     : dist(std::move(_dist)), n(dist.size()), dim_max(_dim_max),
       threshold(_threshold), ratio(_ratio), modulus(_modulus),
-      binomial_coeff(n, dim_max + 2),
+      threadNumber(_threadNumber), binomial_coeff(n, dim_max + 2),
       multiplicative_inverse(multiplicative_inverse_vector(_modulus)) {
   }
 
@@ -591,41 +611,53 @@ public:
                                index_t dim) {
 #ifdef INDICATE_PROGRESS
     std::cerr << clear_line << "assembling columns" << std::flush;
-    std::chrono::steady_clock::time_point next
-      = std::chrono::steady_clock::now() + time_step;
 #endif
     --dim;
     columns_to_reduce.clear();
-    std::vector<diameter_index_t> next_simplices;
-
-    for(diameter_index_t &simplex : simplices) {
-      simplex_coboundary_enumerator cofacets(
-        diameter_entry_t(simplex, 1), dim, *this);
 
-      while(cofacets.has_next(false)) {
-#ifdef INDICATE_PROGRESS
-        if(std::chrono::steady_clock::now() > next) {
-          std::cerr << clear_line << "assembling " << next_simplices.size()
-                    << " columns (processing "
-                    << std::distance(&simplices[0], &simplex) << "/"
-                    << simplices.size() << " simplices)" << std::flush;
-          next = std::chrono::steady_clock::now() + time_step;
-        }
-#endif
-        auto cofacet = cofacets.next();
-        if(get_diameter(cofacet) <= threshold) {
-          if(dim != dim_max)
-            next_simplices.emplace_back(
-              get_diameter(cofacet), get_index(cofacet));
-
-          if(pivot_column_index.find(get_entry(cofacet))
-             == pivot_column_index.end())
-            columns_to_reduce.emplace_back(
-              get_diameter(cofacet), get_index(cofacet));
+    // the simplices are split in one contiguous chunk per thread, the
+    // results of the chunks being concatenated in order (the cleared
+    // columns, paired in the previous dimension, are skipped)
+    const size_t n_chunks = std::max(threadNumber, 1);
+    std::vector<std::vector<diameter_index_t>> chunk_simplices(n_chunks);
+    std::vector<std::vector<diameter_index_t>> chunk_columns(n_chunks);
+    const size_t chunk_size = simplices.size() / n_chunks + 1;
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber) schedule(static, 1)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t c = 0; c < n_chunks; ++c) {
+      coboundary_workspace workspace;
+      const size_t end = std::min(simplices.size(), (c + 1) * chunk_size);
+      for(size_t i = c * chunk_size; i < end; ++i) {
+        simplex_coboundary_enumerator cofacets(
+          diameter_entry_t(simplices[i], 1), dim, *this, workspace);
+
+        while(cofacets.has_next(false)) {
+          auto cofacet = cofacets.next();
+          if(get_diameter(cofacet) <= threshold) {
+            if(dim != dim_max)
+              chunk_simplices[c].emplace_back(
+                get_diameter(cofacet), get_index(cofacet));
+
+            if(pivot_column_index.find(get_entry(cofacet))
+               == pivot_column_index.end())
+              chunk_columns[c].emplace_back(
+                get_diameter(cofacet), get_index(cofacet));
+          }
         }
       }
     }
 
+    std::vector<diameter_index_t> next_simplices;
+    for(size_t c = 0; c < n_chunks; ++c) {
+      next_simplices.insert(next_simplices.end(), chunk_simplices[c].begin(),
+                            chunk_simplices[c].end());
+      columns_to_reduce.insert(columns_to_reduce.end(),
+                               chunk_columns[c].begin(),
+                               chunk_columns[c].end());
+    }
+
     simplices.swap(next_simplices);
 
 #ifdef INDICATE_PROGRESS
@@ -633,7 +665,7 @@ public:
               << " columns" << std::flush;
 #endif
 
-    std::sort(columns_to_reduce.begin(), columns_to_reduce.end(),
+    TTK_PSORT(threadNumber, columns_to_reduce.begin(), columns_to_reduce.end(),
               greater_diameter_or_smaller_index<diameter_index_t>());
 
 #ifdef INDICATE_PROGRESS
@@ -641,13 +673,91 @@ public:
 #endif
   }
 
+  // index of the facet of the simplex (vertices in decreasing order) that
+  // misses its r-th vertex
+  index_t get_facet_index(const std::vector<index_t> &vertices,
+                          const size_t r) const {
+    index_t index = 0;
+    index_t k = vertices.size() - 1;
+    for(size_t i = 0; i < vertices.size(); ++i) {
+      if(i != r) {
+        index += binomial_coeff(vertices[i], k--);
+      }
+    }
+    return index;
+  }
+
+  // Apparent pairs: the oldest cofacet of the column (the first one of the
+  // same diameter, as in the emergent pairs of compute_pairs) has the column
+  // as youngest facet. They are persistence pairs that need no reduction
+  // and whose pivot cannot show up in the reduction of the previous
+  // columns, hence they are found concurrently before the reduction. The
+  // pivot of each apparent column is returned (index -1 otherwise).
+  std::vector<diameter_entry_t>
+    get_apparent_pairs(const std::vector<diameter_index_t> &columns_to_reduce,
+                       const index_t dim) const {
+    std::vector<diameter_entry_t> apparent(
+      columns_to_reduce.size(), diameter_entry_t(-1));
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
+    {
+      coboundary_workspace workspace;
+      std::vector<index_t> vertices(dim + 2);
+      std::vector<value_t> lengths((dim + 2) * (dim + 2));
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp for schedule(dynamic, 256)
+#endif // TTK_ENABLE_OPENMP
+      for(size_t c = 0; c < columns_to_reduce.size(); ++c) {
+        const diameter_entry_t simplex(columns_to_reduce[c], 1);
+        const value_t diameter = get_diameter(simplex);
+
+        diameter_entry_t pivot(-1);
+        simplex_coboundary_enumerator cofacets(simplex, dim, *this, workspace);
+        while(cofacets.has_next()) {
+          const diameter_entry_t cofacet = cofacets.next();
+          if(get_diameter(cofacet) == diameter) {
+            pivot = cofacet;
+            break;
+          }
+        }
+        if(get_index(pivot) == -1)
+          continue;
+
+        // no younger facet of the pivot: same diameter, smaller index
+        get_simplex_vertices(get_index(pivot), dim + 1, n, vertices.begin());
+        const size_t m = vertices.size();
+        for(size_t i = 0; i < m; ++i)
+          for(size_t j = i + 1; j < m; ++j)
+            lengths[i * m + j] = dist(vertices[i], vertices[j]);
+        bool youngest = true;
+        for(size_t r = 0; r < m && youngest; ++r) {
+          value_t facet_diameter = 0;
+          for(size_t i = 0; i < m; ++i)
+            for(size_t j = i + 1; j < m; ++j)
+              if(i != r && j != r)
+                facet_diameter = std::max(facet_diameter, lengths[i * m + j]);
+          if(facet_diameter == diameter
+             && get_facet_index(vertices, r) < get_index(simplex))
+            youngest = false;
+        }
+        if(youngest)
+          apparent[c] = pivot;
+      }
+    }
+
+    return apparent;
+  }
+
   void compute_dim_0_pairs(std::vector<diameter_index_t> &edges,
                            std::vector<diameter_index_t> &columns_to_reduce,
                            std::vector<std::vector<pers_pair_t>> &ph) {
     union_find dset(n);
 
     edges = get_edges();
-    std::sort(edges.rbegin(), edges.rend(),
+    TTK_PSORT(threadNumber, edges.rbegin(), edges.rend(),
               greater_diameter_or_smaller_index<diameter_index_t>());
     std::vector<index_t> vertices_of_edge(2);
     for(auto e : edges) {
@@ -789,6 +899,11 @@ public:
     compressed_sparse_matrix<diameter_entry_t> reduction_matrix;
     size_t index_column_to_add;
 
+    const auto apparent = get_apparent_pairs(columns_to_reduce, dim);
+    for(size_t i = 0; i < apparent.size(); ++i)
+      if(get_index(apparent[i]) != -1)
+        pivot_column_index.insert({get_entry(apparent[i]), i});
+
 #ifdef INDICATE_PROGRESS
     std::chrono::steady_clock::time_point next
       = std::chrono::steady_clock::now() + time_step;
@@ -803,6 +918,10 @@ public:
 
       reduction_matrix.append_column();
 
+      // zero persistence pair, already in pivot_column_index
+      if(get_index(apparent[index_column_to_reduce]) != -1)
+        continue;
+
       working_t working_reduction_column;
       working_t working_coboundary;
 
@@ -915,6 +1034,14 @@ private:
   const binomial_coeff_table &binomial_coeff;
 
 public:
+  simplex_coboundary_enumerator(
+    const diameter_entry_t _simplex,
+    index_t _dim,
+    const Ripser<compressed_lower_distance_matrix> &parent,
+    coboundary_workspace & /*workspace*/)
+    : simplex_coboundary_enumerator(_simplex, _dim, parent) {
+  }
+
   simplex_coboundary_enumerator(
     const diameter_entry_t _simplex,
     index_t _dim,
@@ -968,10 +1095,20 @@ public:
   simplex_coboundary_enumerator(const diameter_entry_t _simplex,
                                 const index_t _dim,
                                 const Ripser<sparse_distance_matrix> &parent)
+    : simplex_coboundary_enumerator(
+      _simplex, _dim, parent, parent.dist.workspace) {
+  }
+
+  // the enumeration buffers are given by the caller (one per thread)
+  simplex_coboundary_enumerator(const diameter_entry_t _simplex,
+                                const index_t _dim,
+                                const Ripser<sparse_distance_matrix> &parent,
+                                coboundary_workspace &workspace)
     : idx_below(get_index(_simplex)), idx_above(0), k(_dim + 1),
       vertices(_dim + 1), simplex(_simplex), modulus(parent.modulus),
       dist(parent.dist), binomial_coeff(parent.binomial_coeff),
-      neighbor_it(dist.neighbor_it), neighbor_end(dist.neighbor_end) {
+      neighbor_it(workspace.neighbor_it),
+      neighbor_end(workspace.neighbor_end) {
     neighbor_it.clear();
     neighbor_end.clear();
 
@@ -1073,4 +1210,25 @@ void ripser::ripser(std::vector<std::vector<value_t>> points,
       std::move(dist), dim_max, threshold, ratio, modulus);
     ripser.compute_barcodes(ph);
   }
-}
\ No newline at end of file
+}
+
+void ripser::ripser(std::vector<std::vector<index_diameter_t>> &&neighbors,
+                    value_t threshold,
+                    index_t dim_max,
+                    std::vector<std::vector<pers_pair_t>> &ph,
+                    int threadNumber) {
+  double ratio = 1;
+  coefficient_t modulus = 2;
+
+  ph = std::vector<std::vector<pers_pair_t>>(
+    dim_max + 1, std::vector<pers_pair_t>(0));
+
+  index_t num_edges = 0;
+  for(const auto &n : neighbors)
+    num_edges += n.size();
+
+  sparse_distance_matrix dist(std::move(neighbors), num_edges);
+  Ripser<sparse_distance_matrix> ripser(
+    std::move(dist), dim_max, threshold, ratio, modulus, threadNumber);
+  ripser.compute_barcodes(ph);
+}
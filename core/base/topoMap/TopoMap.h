@@ -11,6 +11,11 @@
 /// Kruskal's algorithm. It also preserves the components Kruskal's algorithm
 /// builds iteratively.
 ///
+/// When the input is given by the coordinates of the points, no distance
+/// matrix is stored: the Euclidean minimum spanning tree is computed with a
+/// dual-tree Boruvka algorithm over a kd-tree (or Prim's algorithm in high
+/// dimension) and the distances are computed on demand.
+///
 ///
 /// \b Related \b publication: \n
 /// "Topomap: A 0-dimensional homology preserving projection of high-dimensional
@@ -25,13 +30,17 @@
 // ttk common includes
 #include <Debug.h>
 #include <Geometry.h>
+#include <RadiusSearchTree.h>
 #include <UnionFind.h>
 
 // STL includes
-#include <map>
+#include <array>
+#include <limits>
+#include <numeric>
 #include <queue>
 #include <set>
 #include <sstream>
+#include <tuple>
 #include <utility> // For std::pair
 #include <vector>
 
@@ -130,27 +139,69 @@ namespace ttk {
 
     // Tries to find the best angle of rotation for the two components. Updates
     // the coordiates of their vertices accordingly.
-    template <typename T>
+    template <typename T, typename Distance>
     T rotateMergingCompsBest(const std::vector<size_t> &hull1,
                              const std::vector<size_t> &hull2,
                              const std::vector<size_t> &comp1,
                              const std::vector<size_t> &comp2,
                              size_t iPt1,
                              size_t iPt2,
-                             const std::vector<T> &distMatrix,
+                             const Distance &getDist,
                              T *allCoords,
-                             size_t n,
                              size_t angularSampleNb);
 
     template <typename T>
     bool computeConvexHull(T *allCoords,
                            const std::vector<size_t> &compPtsIds,
                            std::vector<size_t> &idsInHull) const;
+
+    template <typename T>
+    using edgeType = std::pair<T, std::pair<size_t, size_t>>;
+
+    // Edges of the minimum spanning tree of a distance matrix, in the order
+    // of the strategy.
+    template <typename T>
+    int computeMSTFromMatrix(std::vector<edgeType<T>> &edgesMST,
+                             const std::vector<T> &distMatrix,
+                             size_t n) const;
+
+    // Edges (u, v), u < v, of the Euclidean minimum spanning tree of a point
+    // cloud, computed without distance matrix.
+    template <typename T>
+    void computeEuclideanMST(std::vector<edgeType<T>> &edgesMST,
+                             const T *coords,
+                             size_t n,
+                             size_t dim) const;
+
+    // Sorts the edges of a minimum spanning tree in the order of the
+    // strategy.
+    template <typename T>
+    void sortMSTEdges(std::vector<edgeType<T>> &edgesMST, size_t n) const;
+
+    // Places the components of u and v such that u and v are at distance
+    // edgeCost. Only reads and writes the coordinates of their points.
+    template <typename T, typename Distance>
+    int mergeComponents(size_t u,
+                        size_t v,
+                        T edgeCost,
+                        const std::vector<size_t> &compU,
+                        const std::vector<size_t> &compV,
+                        const Distance &getDist,
+                        T *outputCoords,
+                        T &distortion);
+
+    // Above this dimension, the kd-tree does not prune enough and the
+    // Euclidean MST is computed with Prim's algorithm.
+    static constexpr size_t MaxTreeDimension{6};
+    // Maximum number of distances cached when merging two components.
+    static constexpr size_t MaxCachedDistances{size_t{1} << 22};
   };
 
   // Sketch of the algorithm:
-  // 1. Sort the edges
-  // 2. For each edge uv with cost c_uv
+  // 1. Sort the edges of the minimum spanning tree (the Euclidean one is
+  // computed directly for point clouds)
+  // 2. For each edge uv with cost c_uv (edges merging disjoint components
+  // are processed concurrently)
   //      a. Get connected components comp(u), comp(v)
   //
   //      b. Compute convex hull of comp(u) and of (comp(v))
@@ -226,283 +277,161 @@ namespace ttk {
                      + " dimensions).");
     }
 
-    std::vector<T> computedDistMatrix(n * n);
-    if(!isDistMat) {
-      size_t dim = inputMatrix.size() / n;
-      if(n * dim != inputMatrix.size()) {
-        this->printErr("Error, the coordinates input matrix has invalid size.");
-        return 1;
-      }
+    if(this->Strategy != STRATEGY::KRUSKAL
+       && this->Strategy != STRATEGY::PRIM) {
+      this->printErr("Invalid stategy for the MST: only Kruskal (0) or Prim "
+                     "(1) algorithm can be used.");
+      return 1;
+    }
 
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(this->threadNumber_) \
-  shared(computedDistMatrix)
-#endif
-      for(size_t i1 = 0; i1 < n; i1++) {
-        for(size_t i2 = i1; i2 < n; i2++) {
-          T dist = ttk::Geometry::distance<T>(
-            &inputMatrix[dim * i1], &inputMatrix[dim * i2], dim);
-          computedDistMatrix[i1 * n + i2] = dist;
-          computedDistMatrix[i2 * n + i1] = dist;
-        }
-      }
-    } else {
+    // The high dimension distances are read from the distance matrix or
+    // computed on the fly from the coordinates, so that no distance matrix
+    // is stored for point clouds.
+    const size_t dim = isDistMat ? 0 : inputMatrix.size() / n;
+    if(isDistMat) {
       if(inputMatrix.size() != n * n) {
         this->printErr("Invalid size for the distance matrix.");
         return 1;
       }
+    } else if(n * dim != inputMatrix.size()) {
+      this->printErr("Error, the coordinates input matrix has invalid size.");
+      return 1;
     }
-
-    std::vector<double> edgesMSTBefore,
-      edgesMSTAfter; // Only used for minimum spanning tree checking;
-    edgesMSTBefore.reserve(n);
-    const std::vector<T> &distMatrix
-      = isDistMat ? inputMatrix : computedDistMatrix;
-
-    if(insertionTime != nullptr)
-      for(size_t i = 0; i < n; i++)
-        insertionTime[i] = -1;
-
-    // 1. Sorting the edges
-    using heapType = std::pair<T, std::pair<size_t, size_t>>;
-    std::priority_queue<heapType, std::vector<heapType>, std::greater<heapType>>
-      edgeHeap;
-    if(this->Strategy == STRATEGY::KRUSKAL) {
-      for(size_t u1 = 0; u1 < n; u1++) {
-        for(size_t u2 = u1 + 1; u2 < n; u2++) {
-          edgeHeap.push(
-            std::make_pair(distMatrix[u1 * n + u2], std::make_pair(u1, u2)));
-        }
+    const auto getDist = [&inputMatrix, isDistMat, dim, n](const size_t i,
+                                                          const size_t j) {
+      if(isDistMat) {
+        return inputMatrix[i * n + j];
       }
-    } else if(this->Strategy == STRATEGY::PRIM) {
-      for(size_t u1 = 0; u1 < n; u1++) {
-        edgeHeap.push(std::make_pair(distMatrix[u1], std::make_pair(0, u1)));
+      return ttk::Geometry::distance<T>(
+        &inputMatrix[dim * i], &inputMatrix[dim * j], dim);
+    };
+
+    // 1. Computing the edges of the MST, in their processing order.
+    std::vector<edgeType<T>> edgesMST{};
+    if(isDistMat) {
+      if(this->computeMSTFromMatrix(edgesMST, inputMatrix, n) != 0) {
+        return 1;
       }
     } else {
-      this->printErr("Invalid stategy for the MST: only Kruskal (0) or Prim "
-                     "(1) algorithm can be used.");
-      return 1;
-    }
-
-    // ufVectors is the union find vector
-    std::map<UnionFind *, std::vector<size_t>> ufToComp;
-    std::vector<UnionFind> ufVector(n);
-    for(size_t i = 0; i < n; i++) {
-      ufToComp[&ufVector[i]].emplace_back(i);
+      this->computeEuclideanMST(edgesMST, inputMatrix.data(), n, dim);
+      this->sortMSTEdges(edgesMST, n);
     }
-
-    for(size_t i = 0; i < 2 * n; i++) {
-      outputCoords[i] = 0;
-    }
-
-    T finalDistortion = 0;
-    // 2. Processing the edges
-    size_t nbEdgesMerged = 0;
+    this->printMsg("Computed the minimum spanning tree", 0.1,
+                   timer.getElapsedTime(), this->threadNumber_,
+                   debug::LineMode::NEW, debug::Priority::DETAIL);
+
+    // 2. Building the hierarchy of the merges of components: merges which do
+    // not depend on each other (same level) are processed concurrently.
+    // Each component is identified by the first point (leaves) or the merge
+    // (n + merge id) which created it.
+    const size_t nbMerges = edgesMST.size();
+    std::vector<std::array<size_t, 2>> mergedComps(nbMerges);
+    std::vector<bool> isFirstU(nbMerges);
+    std::vector<std::vector<size_t>> mergesOfLevel{};
+    std::vector<double> edgesMSTBefore{};
+    edgesMSTBefore.reserve(n);
     double MSTWeight = 0;
-
-    std::set<size_t>
-      stillToDo; // List of vertices not yet embedded, used for Prim strategy.
-    if(this->Strategy == STRATEGY::PRIM) {
-      for(size_t i = 1; i < n; i++) {
-        stillToDo.insert(i);
-      }
-    }
-    while(nbEdgesMerged != n - 1) {
-      if(edgeHeap.empty()) {
-        this->printErr("Error building the MST. Aborting.");
-        return 1;
-      }
-      const auto &elt = edgeHeap.top();
-      T edgeCost = elt.first;
-      size_t u = elt.second.first;
-      size_t v = elt.second.second;
-      edgeHeap.pop();
-
-      // 2.a Getting the components
-      UnionFind *reprU = ufVector[u].find();
-      UnionFind *reprV = ufVector[v].find();
-      if(reprU == reprV) { // Already in the same component
-        continue;
-      }
-      nbEdgesMerged++;
-      MSTWeight += edgeCost;
+    {
+      std::vector<UnionFind> ufVector(n);
+      std::vector<size_t> compOfRepr(n), levelOfComp(n + nbMerges, 0);
+      std::iota(compOfRepr.begin(), compOfRepr.end(), 0);
 
       if(insertionTime != nullptr) {
-        if(insertionTime[u] == -1) {
-          insertionTime[u] = nbEdgesMerged;
+        for(size_t i = 0; i < n; i++) {
+          insertionTime[i] = -1;
         }
-        if(insertionTime[v] == -1) {
-          insertionTime[v] = nbEdgesMerged;
-        }
-      }
-      edgesMSTBefore.push_back(edgeCost);
-      std::vector<size_t> &compU = ufToComp[reprU], &compV = ufToComp[reprV];
-      size_t idSmall = compU.size() < compV.size() ? u : v;
-      size_t idBig = idSmall == u ? v : u;
-      std::vector<size_t> &compSmall = idSmall == u ? compU : compV;
-      std::vector<size_t> &compBig = idSmall == u ? compV : compU;
-      size_t nBig = compBig.size();
-      size_t nSmall = compSmall.size();
-      std::vector<size_t> idsInHullSmall, idsInHullBig;
-
-      // 2.b Computing the convex hull.
-      // We retrieve the current coordinates of the big component..
-      bool statusHull = true;
-      statusHull
-        = statusHull | computeConvexHull(outputCoords, compBig, idsInHullBig);
-      statusHull = statusHull
-                   | computeConvexHull(outputCoords, compSmall, idsInHullSmall);
-      if(!statusHull) {
-        this->printErr("Aborting.");
-        return 1;
       }
 
-      size_t idChosenBig = idsInHullBig[0], idChosenSmall = idsInHullSmall[0];
-
-      // 2.c We want to select, among all vertices in the convex hull, the one
-      // which is closest to the vertex of the edge we work on.
-      for(size_t vert : idsInHullBig) {
-        T dist = distMatrix[vert * n + idBig];
-        if(dist < distMatrix[idChosenBig * n + idBig]) {
-          idChosenBig = vert;
+      for(size_t iMerge = 0; iMerge < nbMerges; iMerge++) {
+        const auto &edge = edgesMST[iMerge];
+        const size_t u = edge.second.first, v = edge.second.second;
+        UnionFind *reprU = ufVector[u].find();
+        UnionFind *reprV = ufVector[v].find();
+        const size_t compU = compOfRepr[reprU - ufVector.data()];
+        const size_t compV = compOfRepr[reprV - ufVector.data()];
+        UnionFind *unionRepr = UnionFind::makeUnion(reprU, reprV);
+        compOfRepr[unionRepr - ufVector.data()] = n + iMerge;
+
+        mergedComps[iMerge] = {compU, compV};
+        // The points of the component of the union representative come first
+        // in the merged component.
+        isFirstU[iMerge] = unionRepr == reprU;
+
+        const size_t level
+          = std::max(levelOfComp[compU], levelOfComp[compV]);
+        levelOfComp[n + iMerge] = level + 1;
+        if(mergesOfLevel.size() <= level) {
+          mergesOfLevel.resize(level + 1);
         }
-      }
+        mergesOfLevel[level].emplace_back(iMerge);
 
-      for(size_t vert : idsInHullSmall) {
-        T dist = distMatrix[vert * n + idSmall];
-        if(dist < distMatrix[idChosenSmall * n + idSmall]) {
-          idChosenSmall = vert;
+        MSTWeight += edge.first;
+        edgesMSTBefore.push_back(edge.first);
+        if(insertionTime != nullptr) {
+          if(insertionTime[u] == -1) {
+            insertionTime[u] = iMerge + 1;
+          }
+          if(insertionTime[v] == -1) {
+            insertionTime[v] = iMerge + 1;
+          }
         }
       }
+    }
 
-      size_t sizeBigHull = idsInHullBig.size(),
-             sizeSmallHull = idsInHullSmall.size();
-      std::vector<T> coordsBigHull(sizeBigHull * 2),
-        coordsSmallHull(sizeSmallHull * 2);
-      for(size_t iHull = 0; iHull < sizeBigHull; iHull++) {
-        size_t vert = idsInHullBig[iHull];
-        coordsBigHull[iHull * 2] = outputCoords[vert * 2];
-        coordsBigHull[iHull * 2 + 1] = outputCoords[vert * 2 + 1];
-      }
-      for(size_t iHull = 0; iHull < sizeSmallHull; iHull++) {
-        size_t vert = idsInHullSmall[iHull];
-        coordsSmallHull[iHull * 2] = outputCoords[vert * 2];
-        coordsSmallHull[iHull * 2 + 1] = outputCoords[vert * 2 + 1];
-      }
+    for(size_t i = 0; i < 2 * n; i++) {
+      outputCoords[i] = 0;
+    }
 
-      // Identifying the angles we are working on from the convex hulls.
-      T coordPrevBig[2], coordPostBig[2];
-      T coordPrevSmall[2], coordPostSmall[2];
-      if(!getPrevNextEdges(idsInHullSmall, idChosenSmall, outputCoords,
-                           coordPrevSmall, coordPostSmall)) {
-        return 1;
-      }
-      if(!getPrevNextEdges(idsInHullBig, idChosenBig, outputCoords,
-                           coordPrevBig, coordPostBig)) {
-        return 1;
-      }
-      T coordPtSmall[2] = {
-        outputCoords[2 * idChosenSmall], outputCoords[2 * idChosenSmall + 1]};
-      T coordPtBig[2]
-        = {outputCoords[2 * idChosenBig], outputCoords[2 * idChosenBig + 1]};
-
-      // Computing the angles.
-      double angleSmall = ttk::Geometry::angle2DUndirected(
-        coordPtSmall, coordPrevSmall, coordPostSmall);
-      double angleBig = ttk::Geometry::angle2DUndirected(
-        coordPtBig, coordPrevBig, coordPostBig);
-      if(angleSmall - M_PI > EpsilonDBL || angleBig - M_PI > EpsilonDBL) {
-        this->printErr("Error, angle out of bound (greater than pi).");
-      }
-      T coordscenterBig[2] = {coordPrevBig[0], coordPrevBig[1]};
-      T coordscenterSmall[2] = {coordPrevSmall[0], coordPrevSmall[1]};
-      // Computing the coordinates of the bisectors.
-      rotate(coordscenterSmall, coordPtSmall, angleSmall / 2);
-      rotate(coordscenterBig, coordPtBig, angleBig / 2);
-
-      T unitcenterBigVect[2], unitcenterSmallVect[2];
-      computeUnitVector(
-        &outputCoords[idChosenBig * 2], coordscenterBig, unitcenterBigVect);
-      computeUnitVector(&outputCoords[idChosenSmall * 2], coordscenterSmall,
-                        unitcenterSmallVect);
-
-      // Computing the new coordinates for the chosen point on the small
-      // components, and then translating the whole component.
-      T goalCoordChosenSmall[2]
-        = {outputCoords[idChosenBig * 2] - edgeCost * unitcenterBigVect[0],
-           outputCoords[idChosenBig * 2 + 1] - edgeCost * unitcenterBigVect[1]};
-      if(sizeBigHull == 1) {
-        goalCoordChosenSmall[0] = outputCoords[idChosenBig * 2] + edgeCost;
-        goalCoordChosenSmall[1] = outputCoords[idChosenBig * 2 + 1];
-      }
-      T smallCompMoveVect[2]
-        = {goalCoordChosenSmall[0] - outputCoords[idChosenSmall * 2],
-           goalCoordChosenSmall[1] - outputCoords[idChosenSmall * 2 + 1]};
-
-      T distBaryPointSmall = ttk::Geometry::distance2D(
-        &outputCoords[idChosenSmall * 2], coordscenterSmall);
-      T preFinalPosBarySmall[2] = {coordscenterSmall[0] + smallCompMoveVect[0],
-                                   coordscenterSmall[1] + smallCompMoveVect[1]};
-      T finalPosBarySmall[2]
-        = {goalCoordChosenSmall[0] - unitcenterBigVect[0] * distBaryPointSmall,
-           goalCoordChosenSmall[1] - unitcenterBigVect[1] * distBaryPointSmall};
-
-      // Performing the translation + rotation such that the bisectors in
-      // compSmall and compBig are aligned, and the two components are facing
-      // each other, not crossing.
-      for(size_t curIdSmall : compSmall) {
-        outputCoords[curIdSmall * 2] += smallCompMoveVect[0];
-        outputCoords[curIdSmall * 2 + 1] += smallCompMoveVect[1];
-
-        // 2.e Performing the rotation.
-        double rotationAngle = ttk::Geometry::angle2DUndirected(
-          goalCoordChosenSmall, preFinalPosBarySmall, finalPosBarySmall);
-        if(nSmall > 1 && std::isfinite(rotationAngle)) {
-          rotate(
-            &outputCoords[curIdSmall * 2], goalCoordChosenSmall, rotationAngle);
-        }
+    // 3. Processing the merges, level by level.
+    std::vector<std::vector<size_t>> comps(n + nbMerges);
+    for(size_t i = 0; i < n; i++) {
+      comps[i] = {i};
+    }
+    // Distortion of each merge, negative if not computed.
+    std::vector<T> distortions(nbMerges, -1);
+    std::vector<int> statuses(nbMerges, 0);
+    for(const auto &merges : mergesOfLevel) {
+      const size_t nbMergesLevel = merges.size();
+      // A single merge uses the threads to try the rotations instead.
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(this->threadNumber_) schedule(dynamic) \
+  if(nbMergesLevel > 1)
+#endif
+      for(size_t iLevel = 0; iLevel < nbMergesLevel; iLevel++) {
+        const size_t iMerge = merges[iLevel];
+        const auto &edge = edgesMST[iMerge];
+        auto &compU = comps[mergedComps[iMerge][0]];
+        auto &compV = comps[mergedComps[iMerge][1]];
+
+        statuses[iMerge] = this->mergeComponents(
+          edge.second.first, edge.second.second, edge.first, compU, compV,
+          getDist, outputCoords, distortions[iMerge]);
+
+        auto &first = isFirstU[iMerge] ? compU : compV;
+        auto &other = isFirstU[iMerge] ? compV : compU;
+        auto &unionSet = comps[n + iMerge];
+        unionSet = std::move(first);
+        unionSet.insert(unionSet.end(), other.begin(), other.end());
+        std::vector<size_t>{}.swap(first);
+        std::vector<size_t>{}.swap(other);
       }
-
-      // 2.f Trying several rotations of the two components and keeping the one
-      // which makes the new distance matrix closest to the one provided in the
-      // input.
-      if(nBig > 1) {
-        finalDistortion = rotateMergingCompsBest(
-          idsInHullSmall, idsInHullBig, compSmall, compBig, idChosenSmall,
-          idChosenBig, distMatrix, outputCoords, n, this->AngularSampleNb);
-        if(finalDistortion < -1) {
+      for(const size_t iMerge : merges) {
+        if(statuses[iMerge] != 0) {
+          this->printErr("Aborting.");
           return 1;
         }
       }
+    }
 
-      T finalDist = ttk::Geometry::distance2D(
-        &outputCoords[2 * idChosenSmall], &outputCoords[2 * idChosenBig]);
-      if(fabs(finalDist - edgeCost) > Epsilon) {
-        this->printErr(
-          "The distance we set is too far from the goal distance.");
-      }
-
-      UnionFind *unionRepr = UnionFind::makeUnion(reprU, reprV);
-      UnionFind *otherRepr = (unionRepr == reprU) ? reprV : reprU;
-      if(unionRepr != reprU && unionRepr != reprV) {
-        printErr("Error with the union find module results. Aborting.");
-        return 1;
-      }
-      std::vector<size_t> &unionSet = ufToComp[unionRepr];
-      std::vector<size_t> &otherSet = ufToComp[otherRepr];
-
-      unionSet.insert(unionSet.end(), otherSet.begin(), otherSet.end());
-
-      ufToComp.erase(otherRepr);
-
-      if(this->Strategy == STRATEGY::PRIM) {
-        stillToDo.erase(v);
-        for(size_t uToDo : stillToDo) {
-          edgeHeap.push(std::make_pair(
-            distMatrix[v * n + uToDo], std::make_pair(v, uToDo)));
-        }
+    // The distortion of the last merge which computed one.
+    T finalDistortion = 0;
+    for(size_t i = nbMerges; i-- > 0;) {
+      if(distortions[i] >= 0) {
+        finalDistortion = distortions[i];
+        break;
       }
     }
+
     std::stringstream ssDistortion;
     ssDistortion << std::scientific << 2 * finalDistortion;
     this->printMsg("Non normalized distance matrix distortion: "
@@ -522,93 +451,25 @@ namespace ttk {
     // We check that the lengths of the edges selected to build a minimum
     // spanning tree are preserved by our algorithm, as should be.
     if(CheckMST) {
-
-      edgesMSTAfter.reserve(n);
       this->printMsg("Checking the new minimum spanning tree.");
-      std::priority_queue<heapType, std::vector<heapType>,
-                          std::greater<heapType>>
-        edgeHeapAfter;
-      if(this->Strategy == STRATEGY::KRUSKAL) {
-        for(size_t u1 = 0; u1 < n; u1++) {
-          for(size_t u2 = u1 + 1; u2 < n; u2++) {
-            edgeHeapAfter.push(
-              std::make_pair(ttk::Geometry::distance2D(
-                               &outputCoords[2 * u1], &outputCoords[2 * u2]),
-                             std::make_pair(u1, u2)));
-          }
-        }
-      } else if(this->Strategy == STRATEGY::PRIM) {
-        for(size_t u1 = 0; u1 < n; u1++) {
-          edgeHeapAfter.push(std::make_pair(
-            ttk::Geometry::distance2D(&outputCoords[0], &outputCoords[2 * u1]),
-            std::make_pair(0, u1)));
-        }
-      }
 
-      std::map<UnionFind *, std::vector<size_t>> ufToCompAfter;
-      std::vector<UnionFind> ufVectorAfter(n);
-      std::vector<UnionFind *> ufPtrVectorAfter(n);
-      for(size_t i = 0; i < n; i++) {
-        ufPtrVectorAfter[i] = &ufVectorAfter[i];
-        ufToCompAfter[ufPtrVectorAfter[i]].push_back(i);
+      std::vector<edgeType<T>> edgesAfter{};
+      this->computeEuclideanMST(edgesAfter, outputCoords, n, 2);
+      std::vector<double> edgesMSTAfter{};
+      edgesMSTAfter.reserve(n);
+      for(const auto &edge : edgesAfter) {
+        edgesMSTAfter.push_back(edge.first);
       }
-
-      nbEdgesMerged = 0;
-      stillToDo.clear();
-      for(size_t i = 1; i < n; i++)
-        stillToDo.insert(i);
-      while(nbEdgesMerged != n - 1) {
-        if(edgeHeapAfter.empty()) {
-          this->printErr("Error building the MST for the check. Aborting.");
-          return 1;
-        }
-        const auto &elt = edgeHeapAfter.top();
-        T edgeCost = elt.first;
-        size_t u = elt.second.first;
-        size_t v = elt.second.second;
-        edgeHeapAfter.pop();
-
-        UnionFind *reprU = ufPtrVectorAfter[u]->find();
-        UnionFind *reprV = ufPtrVectorAfter[v]->find();
-        if(reprU == reprV) { // Already in the same component
-          continue;
-        }
-        UnionFind *unionRepr = UnionFind::makeUnion(reprU, reprV);
-        UnionFind *otherRepr = (unionRepr == reprU) ? reprV : reprU;
-        if(unionRepr != reprU && unionRepr != reprV) {
-          printErr("Error with the union find module results. Aborting.");
-          return 1;
-        }
-        nbEdgesMerged++;
-        std::vector<size_t> &unionSet = ufToCompAfter[unionRepr];
-        std::vector<size_t> &otherSet = ufToCompAfter[otherRepr];
-
-        unionSet.insert(unionSet.end(), otherSet.begin(), otherSet.end());
-
-        ufPtrVectorAfter[u] = unionRepr;
-        ufPtrVectorAfter[v] = unionRepr;
-
-        ufToCompAfter.erase(otherRepr);
-        if(this->Strategy == STRATEGY::PRIM) {
-          stillToDo.erase(v);
-          for(size_t uToDo : stillToDo) {
-            edgeHeapAfter.push(
-              std::make_pair(ttk::Geometry::distance2D(
-                               &outputCoords[2 * v], &outputCoords[2 * uToDo]),
-                             std::make_pair(v, uToDo)));
-          }
-        }
-
-        edgesMSTAfter.push_back(edgeCost);
+      if(edgesMSTAfter.size() != edgesMSTBefore.size()) {
+        this->printErr("Error building the MST for the check. Aborting.");
+        return 1;
       }
 
       const T epsilonCheck = Epsilon * 5;
       double sumDiff = 0, maxDiff = 0;
       size_t nbProblematic = 0;
-      if(this->Strategy == STRATEGY::PRIM) {
-        sort(edgesMSTBefore.begin(), edgesMSTBefore.end());
-        sort(edgesMSTAfter.begin(), edgesMSTAfter.end());
-      }
+      sort(edgesMSTBefore.begin(), edgesMSTBefore.end());
+      sort(edgesMSTAfter.begin(), edgesMSTAfter.end());
       for(size_t i = 0; i < edgesMSTBefore.size(); i++) {
         if(fabs(edgesMSTBefore[i] - edgesMSTAfter[i]) >= epsilonCheck) {
           nbProblematic++;
@@ -637,6 +498,346 @@ namespace ttk {
     return 0;
   }
 
+  template <typename T>
+  int TopoMap::computeMSTFromMatrix(std::vector<edgeType<T>> &edgesMST,
+                                    const std::vector<T> &distMatrix,
+                                    size_t n) const {
+    // Sorting the edges
+    std::priority_queue<edgeType<T>, std::vector<edgeType<T>>,
+                        std::greater<edgeType<T>>>
+      edgeHeap;
+    if(this->Strategy == STRATEGY::KRUSKAL) {
+      for(size_t u1 = 0; u1 < n; u1++) {
+        for(size_t u2 = u1 + 1; u2 < n; u2++) {
+          edgeHeap.push(
+            std::make_pair(distMatrix[u1 * n + u2], std::make_pair(u1, u2)));
+        }
+      }
+    } else {
+      for(size_t u1 = 0; u1 < n; u1++) {
+        edgeHeap.push(std::make_pair(distMatrix[u1], std::make_pair(0, u1)));
+      }
+    }
+
+    std::vector<UnionFind> ufVector(n);
+    std::set<size_t>
+      stillToDo; // List of vertices not yet embedded, used for Prim strategy.
+    if(this->Strategy == STRATEGY::PRIM) {
+      for(size_t i = 1; i < n; i++) {
+        stillToDo.insert(i);
+      }
+    }
+    edgesMST.clear();
+    edgesMST.reserve(n);
+    while(edgesMST.size() + 1 < n) {
+      if(edgeHeap.empty()) {
+        this->printErr("Error building the MST. Aborting.");
+        return 1;
+      }
+      const auto elt = edgeHeap.top();
+      edgeHeap.pop();
+      size_t v = elt.second.second;
+
+      UnionFind *reprU = ufVector[elt.second.first].find();
+      UnionFind *reprV = ufVector[v].find();
+      if(reprU == reprV) { // Already in the same component
+        continue;
+      }
+      UnionFind::makeUnion(reprU, reprV);
+      edgesMST.emplace_back(elt);
+
+      if(this->Strategy == STRATEGY::PRIM) {
+        stillToDo.erase(v);
+        for(size_t uToDo : stillToDo) {
+          edgeHeap.push(std::make_pair(
+            distMatrix[v * n + uToDo], std::make_pair(v, uToDo)));
+        }
+      }
+    }
+    return 0;
+  }
+
+  template <typename T>
+  void TopoMap::computeEuclideanMST(std::vector<edgeType<T>> &edgesMST,
+                                    const T *coords,
+                                    size_t n,
+                                    size_t dim) const {
+    edgesMST.clear();
+    if(n < 2) {
+      return;
+    }
+    edgesMST.reserve(n - 1);
+    const auto getLength = [coords, dim](const size_t u, const size_t v) {
+      return ttk::Geometry::distance<T>(
+        &coords[dim * u], &coords[dim * v], dim);
+    };
+
+    if(dim <= MaxTreeDimension) {
+      std::vector<std::pair<size_t, size_t>> edges{};
+      RadiusSearchTree tree{coords, n, dim};
+      tree.computeMinimumSpanningTree(edges, this->threadNumber_);
+      for(const auto &e : edges) {
+        edgesMST.emplace_back(getLength(e.first, e.second), e);
+      }
+      return;
+    }
+
+    // Prim's algorithm on the complete graph, edges ordered by (length,
+    // smallest id, largest id) as Kruskal's algorithm.
+    const auto isShorter = [](const T la, const size_t a0, const size_t a1,
+                              const T lb, const size_t b0, const size_t b1) {
+      return std::make_tuple(la, std::min(a0, a1), std::max(a0, a1))
+             < std::make_tuple(lb, std::min(b0, b1), std::max(b0, b1));
+    };
+    std::vector<T> keyLength(n, std::numeric_limits<T>::max());
+    std::vector<size_t> keyVertex(n, 0);
+    std::vector<bool> inTree(n, false);
+    size_t last = 0;
+    inTree[0] = true;
+    while(edgesMST.size() + 1 < n) {
+      size_t next = n;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel num_threads(this->threadNumber_)
+#endif
+      {
+        size_t localNext = n;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp for
+#endif
+        for(size_t i = 0; i < n; i++) {
+          if(inTree[i]) {
+            continue;
+          }
+          const T length = getLength(last, i);
+          if(isShorter(length, last, i, keyLength[i], keyVertex[i], i)) {
+            keyLength[i] = length;
+            keyVertex[i] = last;
+          }
+          if(localNext == n
+             || isShorter(keyLength[i], keyVertex[i], i, keyLength[localNext],
+                          keyVertex[localNext], localNext)) {
+            localNext = i;
+          }
+        }
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp critical
+#endif
+        {
+          if(localNext != n
+             && (next == n
+                 || isShorter(keyLength[localNext], keyVertex[localNext],
+                              localNext, keyLength[next], keyVertex[next],
+                              next))) {
+            next = localNext;
+          }
+        }
+      }
+      inTree[next] = true;
+      edgesMST.emplace_back(
+        keyLength[next], std::minmax(keyVertex[next], next));
+      last = next;
+    }
+  }
+
+  template <typename T>
+  void TopoMap::sortMSTEdges(std::vector<edgeType<T>> &edgesMST,
+                             size_t n) const {
+    if(this->Strategy == STRATEGY::KRUSKAL) {
+      TTK_PSORT(this->threadNumber_, edgesMST.begin(), edgesMST.end());
+      return;
+    }
+
+    // Order in which Prim's algorithm, starting from the first point,
+    // inserts the edges of the tree.
+    std::vector<std::vector<std::pair<T, size_t>>> neighbors(n);
+    for(const auto &e : edgesMST) {
+      neighbors[e.second.first].emplace_back(e.first, e.second.second);
+      neighbors[e.second.second].emplace_back(e.first, e.second.first);
+    }
+    std::priority_queue<edgeType<T>, std::vector<edgeType<T>>,
+                        std::greater<edgeType<T>>>
+      edgeHeap;
+    std::vector<bool> inTree(n, false);
+    edgesMST.clear();
+    size_t v = 0;
+    inTree[v] = true;
+    while(true) {
+      for(const auto &nb : neighbors[v]) {
+        if(!inTree[nb.second]) {
+          edgeHeap.push(std::make_pair(nb.first, std::make_pair(v, nb.second)));
+        }
+      }
+      if(edgeHeap.empty()) {
+        break;
+      }
+      const auto elt = edgeHeap.top();
+      edgeHeap.pop();
+      v = elt.second.second;
+      inTree[v] = true;
+      edgesMST.emplace_back(elt);
+    }
+  }
+
+  template <typename T, typename Distance>
+  int TopoMap::mergeComponents(size_t u,
+                               size_t v,
+                               T edgeCost,
+                               const std::vector<size_t> &compU,
+                               const std::vector<size_t> &compV,
+                               const Distance &getDist,
+                               T *outputCoords,
+                               T &distortion) {
+    size_t idSmall = compU.size() < compV.size() ? u : v;
+    size_t idBig = idSmall == u ? v : u;
+    const std::vector<size_t> &compSmall = idSmall == u ? compU : compV;
+    const std::vector<size_t> &compBig = idSmall == u ? compV : compU;
+    size_t nBig = compBig.size();
+    size_t nSmall = compSmall.size();
+    std::vector<size_t> idsInHullSmall, idsInHullBig;
+
+    // 2.b Computing the convex hull.
+    // We retrieve the current coordinates of the big component..
+    bool statusHull = true;
+    statusHull
+      = statusHull | computeConvexHull(outputCoords, compBig, idsInHullBig);
+    statusHull = statusHull
+                 | computeConvexHull(outputCoords, compSmall, idsInHullSmall);
+    if(!statusHull) {
+      return 1;
+    }
+
+    size_t idChosenBig = idsInHullBig[0], idChosenSmall = idsInHullSmall[0];
+
+    // 2.c We want to select, among all vertices in the convex hull, the one
+    // which is closest to the vertex of the edge we work on.
+    T distChosenBig = getDist(idChosenBig, idBig);
+    for(size_t vert : idsInHullBig) {
+      T dist = getDist(vert, idBig);
+      if(dist < distChosenBig) {
+        idChosenBig = vert;
+        distChosenBig = dist;
+      }
+    }
+
+    T distChosenSmall = getDist(idChosenSmall, idSmall);
+    for(size_t vert : idsInHullSmall) {
+      T dist = getDist(vert, idSmall);
+      if(dist < distChosenSmall) {
+        idChosenSmall = vert;
+        distChosenSmall = dist;
+      }
+    }
+
+    size_t sizeBigHull = idsInHullBig.size(),
+           sizeSmallHull = idsInHullSmall.size();
+    std::vector<T> coordsBigHull(sizeBigHull * 2),
+      coordsSmallHull(sizeSmallHull * 2);
+    for(size_t iHull = 0; iHull < sizeBigHull; iHull++) {
+      size_t vert = idsInHullBig[iHull];
+      coordsBigHull[iHull * 2] = outputCoords[vert * 2];
+      coordsBigHull[iHull * 2 + 1] = outputCoords[vert * 2 + 1];
+    }
+    for(size_t iHull = 0; iHull < sizeSmallHull; iHull++) {
+      size_t vert = idsInHullSmall[iHull];
+      coordsSmallHull[iHull * 2] = outputCoords[vert * 2];
+      coordsSmallHull[iHull * 2 + 1] = outputCoords[vert * 2 + 1];
+    }
+
+    // Identifying the angles we are working on from the convex hulls.
+    T coordPrevBig[2], coordPostBig[2];
+    T coordPrevSmall[2], coordPostSmall[2];
+    if(!getPrevNextEdges(idsInHullSmall, idChosenSmall, outputCoords,
+                         coordPrevSmall, coordPostSmall)) {
+      return 1;
+    }
+    if(!getPrevNextEdges(idsInHullBig, idChosenBig, outputCoords,
+                         coordPrevBig, coordPostBig)) {
+      return 1;
+    }
+    T coordPtSmall[2] = {
+      outputCoords[2 * idChosenSmall], outputCoords[2 * idChosenSmall + 1]};
+    T coordPtBig[2]
+      = {outputCoords[2 * idChosenBig], outputCoords[2 * idChosenBig + 1]};
+
+    // Computing the angles.
+    double angleSmall = ttk::Geometry::angle2DUndirected(
+      coordPtSmall, coordPrevSmall, coordPostSmall);
+    double angleBig = ttk::Geometry::angle2DUndirected(
+      coordPtBig, coordPrevBig, coordPostBig);
+    if(angleSmall - M_PI > EpsilonDBL || angleBig - M_PI > EpsilonDBL) {
+      this->printErr("Error, angle out of bound (greater than pi).");
+    }
+    T coordscenterBig[2] = {coordPrevBig[0], coordPrevBig[1]};
+    T coordscenterSmall[2] = {coordPrevSmall[0], coordPrevSmall[1]};
+    // Computing the coordinates of the bisectors.
+    rotate(coordscenterSmall, coordPtSmall, angleSmall / 2);
+    rotate(coordscenterBig, coordPtBig, angleBig / 2);
+
+    T unitcenterBigVect[2], unitcenterSmallVect[2];
+    computeUnitVector(
+      &outputCoords[idChosenBig * 2], coordscenterBig, unitcenterBigVect);
+    computeUnitVector(&outputCoords[idChosenSmall * 2], coordscenterSmall,
+                      unitcenterSmallVect);
+
+    // Computing the new coordinates for the chosen point on the small
+    // components, and then translating the whole component.
+    T goalCoordChosenSmall[2]
+      = {outputCoords[idChosenBig * 2] - edgeCost * unitcenterBigVect[0],
+         outputCoords[idChosenBig * 2 + 1] - edgeCost * unitcenterBigVect[1]};
+    if(sizeBigHull == 1) {
+      goalCoordChosenSmall[0] = outputCoords[idChosenBig * 2] + edgeCost;
+      goalCoordChosenSmall[1] = outputCoords[idChosenBig * 2 + 1];
+    }
+    T smallCompMoveVect[2]
+      = {goalCoordChosenSmall[0] - outputCoords[idChosenSmall * 2],
+         goalCoordChosenSmall[1] - outputCoords[idChosenSmall * 2 + 1]};
+
+    T distBaryPointSmall = ttk::Geometry::distance2D(
+      &outputCoords[idChosenSmall * 2], coordscenterSmall);
+    T preFinalPosBarySmall[2] = {coordscenterSmall[0] + smallCompMoveVect[0],
+                                 coordscenterSmall[1] + smallCompMoveVect[1]};
+    T finalPosBarySmall[2]
+      = {goalCoordChosenSmall[0] - unitcenterBigVect[0] * distBaryPointSmall,
+         goalCoordChosenSmall[1] - unitcenterBigVect[1] * distBaryPointSmall};
+
+    // Performing the translation + rotation such that the bisectors in
+    // compSmall and compBig are aligned, and the two components are facing
+    // each other, not crossing.
+    for(size_t curIdSmall : compSmall) {
+      outputCoords[curIdSmall * 2] += smallCompMoveVect[0];
+      outputCoords[curIdSmall * 2 + 1] += smallCompMoveVect[1];
+
+      // 2.e Performing the rotation.
+      double rotationAngle = ttk::Geometry::angle2DUndirected(
+        goalCoordChosenSmall, preFinalPosBarySmall, finalPosBarySmall);
+      if(nSmall > 1 && std::isfinite(rotationAngle)) {
+        rotate(
+          &outputCoords[curIdSmall * 2], goalCoordChosenSmall, rotationAngle);
+      }
+    }
+
+    // 2.f Trying several rotations of the two components and keeping the one
+    // which makes the new distance matrix closest to the one provided in the
+    // input.
+    if(nBig > 1) {
+      distortion = rotateMergingCompsBest(
+        idsInHullSmall, idsInHullBig, compSmall, compBig, idChosenSmall,
+        idChosenBig, getDist, outputCoords, this->AngularSampleNb);
+      if(distortion < -1) {
+        return 1;
+      }
+    }
+
+    T finalDist = ttk::Geometry::distance2D(
+      &outputCoords[2 * idChosenSmall], &outputCoords[2 * idChosenBig]);
+    if(fabs(finalDist - edgeCost) > Epsilon) {
+      this->printErr(
+        "The distance we set is too far from the goal distance.");
+    }
+
+    return 0;
+  }
+
   template <typename T>
   bool TopoMap::getPrevNextEdges(const std::vector<size_t> &idsPtsPolygon,
                                  size_t idCenter,
@@ -669,16 +870,15 @@ namespace ttk {
     return true;
   }
 
-  template <typename T>
+  template <typename T, typename Distance>
   T TopoMap::rotateMergingCompsBest(const std::vector<size_t> &hull1,
                                     const std::vector<size_t> &hull2,
                                     const std::vector<size_t> &comp1,
                                     const std::vector<size_t> &comp2,
                                     size_t iPt1,
                                     size_t iPt2,
-                                    const std::vector<T> &distMatrix,
+                                    const Distance &getDist,
                                     T *allCoords,
-                                    size_t n,
                                     size_t angularSampleNb) {
     // The distance between the two components.
     T shortestDistPossible
@@ -689,8 +889,10 @@ namespace ttk {
 
     T coordPrev1[2], coordPost1[2];
     T coordPrev2[2], coordPost2[2];
-    getPrevNextEdges(hull1, iPt1, allCoords, coordPrev1, coordPost1);
-    getPrevNextEdges(hull2, iPt2, allCoords, coordPrev2, coordPost2);
+    if(!getPrevNextEdges(hull1, iPt1, allCoords, coordPrev1, coordPost1)
+       || !getPrevNextEdges(hull2, iPt2, allCoords, coordPrev2, coordPost2)) {
+      return -2;
+    }
 
     double angle1
       = ttk::Geometry::angle2DUndirected(coordPt1, coordPrev1, coordPost1);
@@ -717,11 +919,16 @@ namespace ttk {
     double bestAnglePair[2] = {0, 0};
     T bestScore = 3.e38; // Near the maximum value for float
 
-    std::vector<std::vector<T>> origDistMatrix(comp1Size);
-    for(size_t i = 0; i < comp1Size; i++) {
-      origDistMatrix[i].resize(comp2Size);
-      for(size_t j = 0; j < comp2Size; j++) {
-        origDistMatrix[i][j] = distMatrix[comp1[i] * n + comp2[j]];
+    // The high dimension distances between the two components are cached
+    // unless they would take too much memory.
+    const bool cacheDistances = comp1Size * comp2Size <= MaxCachedDistances;
+    std::vector<T> origDistances{};
+    if(cacheDistances) {
+      origDistances.resize(comp1Size * comp2Size);
+      for(size_t i = 0; i < comp1Size; i++) {
+        for(size_t j = 0; j < comp2Size; j++) {
+          origDistances[i * comp2Size + j] = getDist(comp1[i], comp2[j]);
+        }
       }
     }
     std::vector<T> initialCoords1(2 * comp1Size), initialCoords2(2 * comp2Size);
@@ -774,8 +981,10 @@ namespace ttk {
           for(size_t j = 0; j < comp2Size; j++) {
             T coordBRotate[2] = {coords2Test[2 * j], coords2Test[2 * j + 1]};
             T newDist = ttk::Geometry::distance2D(coordARotate, coordBRotate);
-            curScore += (newDist - origDistMatrix[i][j])
-                        * (newDist - origDistMatrix[i][j]);
+            const T origDist = cacheDistances
+                                 ? origDistances[i * comp2Size + j]
+                                 : getDist(comp1[i], comp2[j]);
+            curScore += (newDist - origDist) * (newDist - origDist);
             if(newDist + Epsilon < shortestDistPossible) {
               curAngleError = true;
               errorDuringLoop = true;
@@ -829,6 +1038,9 @@ namespace ttk {
     }
 
     if(errorDuringLoop) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic write
+#endif
       this->errorConvexHull = true;
     }
 
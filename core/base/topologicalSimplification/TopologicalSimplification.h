@@ -128,6 +128,13 @@ namespace ttk {
       backend_ = arg;
     }
 
+    /// Consider the constraint identifiers as the extrema to remove
+    /// instead of the extrema to preserve. Supported by both backends.
+    inline void setConsiderIdentifierAsBlackList(const bool onOff) {
+      considerIdentifierAsBlackList_ = onOff;
+      legacyObject_.setConsiderIdentifierAsBlackList(onOff);
+    }
+
     inline int preconditionTriangulation(AbstractTriangulation *triangulation) {
       switch(backend_) {
         case BACKEND::LEGACY:
@@ -152,6 +159,7 @@ namespace ttk {
 
   protected:
     BACKEND backend_{BACKEND::LTS};
+    bool considerIdentifierAsBlackList_{false};
     LegacyTopologicalSimplification legacyObject_;
     lts::LocalizedTopologicalSimplification ltsObject_;
   };
@@ -169,11 +177,18 @@ int ttk::TopologicalSimplification::execute(
   const triangulationType &triangulation) {
   switch(backend_) {
     case BACKEND::LTS:
+      if(considerIdentifierAsBlackList_) {
+        return ltsObject_
+          .removeBlackListedExtrema<dataType, SimplexId, triangulationType>(
+            outputScalars, offsets, &triangulation, identifiers,
+            constraintNumber, addPerturbation);
+      }
       return ltsObject_
         .removeUnauthorizedExtrema<dataType, SimplexId, triangulationType>(
           outputScalars, offsets, &triangulation, identifiers, constraintNumber,
           addPerturbation);
     case BACKEND::LEGACY:
+      legacyObject_.setAddPerturbation(addPerturbation);
       return legacyObject_.execute(inputScalars, outputScalars, identifiers,
                                    inputOffsets, offsets, constraintNumber,
                                    triangulation);
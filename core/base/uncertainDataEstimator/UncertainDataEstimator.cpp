@@ -14,8 +14,9 @@ void ttk::PDFHistograms::getVertexHistogram(
   schedule(static, numberOfBins_ / threadNumber_)
 #endif
     for(int i = 0; i < (int)numberOfBins_; i++) {
-      if((SimplexId)probability_[i].size() == numberOfVertices_) {
-        histogram[i] = probability_[i][vertexId];
+      if(!probability_.empty()) {
+        histogram[i]
+          = probability_[static_cast<size_t>(i) * numberOfVertices_ + vertexId];
       } else {
         histogram[i] = 0.0;
       }
@@ -28,12 +29,9 @@ void ttk::PDFHistograms::getVertexHistogram(
 void ttk::PDFHistograms::normalize() {
   const double normalization = 1.0 / static_cast<double>(numberOfInputs_);
 #ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(threadNumber_) collapse(2) \
-  schedule(static, (numberOfBins_ * numberOfVertices_) / threadNumber_)
+#pragma omp parallel for num_threads(threadNumber_)
 #endif
-  for(int i = 0; i < numberOfBins_; i++) {
-    for(SimplexId j = 0; j < numberOfVertices_; j++) {
-      probability_[i][j] *= normalization;
-    }
+  for(size_t i = 0; i < probability_.size(); i++) {
+    probability_[i] *= normalization;
   }
 }
@@ -14,6 +14,10 @@
 // base code includes
 #include <Wrapper.h>
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 namespace ttk {
 
   template <class dataType>
@@ -124,12 +128,13 @@ namespace ttk {
       }
 #endif
       if(numberOfInputs_ == 0) {
-        /* Initialize */
-        probability_.resize(numberOfBins_);
+        /* Initialize: one contiguous field per bin */
+        probability_.assign(
+          static_cast<size_t>(numberOfBins_) * numberOfVertices_, 0.0);
+        binValue_.resize(numberOfBins_);
         double const dx
           = (rangeMax_ - rangeMin_) / static_cast<double>(numberOfBins_);
         for(size_t i = 0; i < static_cast<size_t>(numberOfBins_); i++) {
-          probability_[i].resize(numberOfVertices_);
           binValue_[i] = rangeMin_ + (dx / 2.0) + (static_cast<double>(i) * dx);
         }
       }
@@ -139,15 +144,15 @@ namespace ttk {
           = static_cast<int>(floor((inputData[i] - rangeMin_) * numberOfBins_
                                    / (rangeMax_ - rangeMin_)));
         bin = (bin == numberOfBins_) ? numberOfBins_ - 1 : bin;
-        probability_[bin][i] += 1.0;
+        probability_[static_cast<size_t>(bin) * numberOfVertices_ + i] += 1.0;
       }
       numberOfInputs_++;
       return 0;
     }
 
     inline double *getBinFieldPointer(const int binId) {
-      if(binId < numberOfBins_) {
-        return probability_[binId].data();
+      if(binId < numberOfBins_ && !probability_.empty()) {
+        return &probability_[static_cast<size_t>(binId) * numberOfVertices_];
       } else {
         return nullptr;
       }
@@ -173,7 +178,8 @@ namespace ttk {
 
   protected:
     std::vector<double> binValue_{};
-    std::vector<std::vector<double>> probability_{};
+    // bin-major, numberOfBins_ x numberOfVertices_
+    std::vector<double> probability_{};
     int numberOfBins_{0};
     int numberOfInputs_{0};
     SimplexId numberOfVertices_{0};
@@ -182,6 +188,99 @@ namespace ttk {
     // std::vector<int> selection_; // TODO : selection support
   };
 
+  /// \brief Streaming accumulation of vertexwise ensemble statistics.
+  ///
+  /// Realizations (ensemble members) are fed one at a time, or by batches,
+  /// and only the accumulators are kept in memory: bounds, mean, variance
+  /// (running sums of squared deviations) and histogram bin counts, each
+  /// stored as one contiguous array per quantity. Vertices are processed by
+  /// blocks: within a block, every member of a batch is streamed through
+  /// accumulators that stay in cache, in simple loops the compiler
+  /// vectorizes (except the histogram scatter).
+  ///
+  /// Only the statistics whose output pointers were set are computed. The
+  /// histograms need the data range beforehand (see setRange()). The mean
+  /// and variance fields hold running sums until finalize() is called.
+  template <class dataType>
+  class EnsembleStatistics : virtual public Debug {
+  public:
+    EnsembleStatistics() {
+      this->setDebugMsgPrefix("EnsembleStatistics");
+    }
+
+    /// Accumulate one realization.
+    /// \return Returns 0 upon success, negative values otherwise.
+    inline int evaluateRealization(const dataType *inputData) {
+      return evaluateRealizations(&inputData, 1);
+    }
+
+    /// Accumulate a batch of realizations, vertex block by vertex block.
+    /// \return Returns 0 upon success, negative values otherwise.
+    int evaluateRealizations(const dataType *const *inputData,
+                             const int numberOfRealizations);
+
+    /// Turn the running sums into the mean, the sample variance and the
+    /// probability of each bin.
+    /// \return Returns 0 upon success, negative values otherwise.
+    int finalize();
+
+    inline void setNumberOfVertices(const SimplexId number) {
+      numberOfVertices_ = number;
+    }
+
+    inline void setLowerBoundField(dataType *const data) {
+      lowerBoundField_ = data;
+    }
+
+    inline void setUpperBoundField(dataType *const data) {
+      upperBoundField_ = data;
+    }
+
+    inline void setMeanField(double *const data) {
+      meanField_ = data;
+    }
+
+    inline void setVarianceField(double *const data) {
+      varianceField_ = data;
+    }
+
+    inline void setNumberOfBins(const int number) {
+      binFields_.clear();
+      binFields_.resize(number, nullptr);
+    }
+
+    inline void setBinField(const int binId, double *const data) {
+      if(binId < static_cast<int>(binFields_.size())) {
+        binFields_[binId] = data;
+      }
+    }
+
+    inline void setRange(const double min, const double max) {
+      rangeMin_ = min;
+      rangeMax_ = max;
+    }
+
+    inline int getNumberOfRealizations() const {
+      return numberOfRealizations_;
+    }
+
+  protected:
+    // fits a few accumulators of a block in L1/L2 caches
+    static constexpr SimplexId BlockSize{4096};
+
+    SimplexId numberOfVertices_{0};
+    int numberOfRealizations_{0};
+    dataType *lowerBoundField_{};
+    dataType *upperBoundField_{};
+    double *meanField_{};
+    double *varianceField_{};
+    std::vector<double *> binFields_{};
+    double rangeMin_{0.0};
+    double rangeMax_{0.0};
+    // running sums when the mean is not requested but the variance is
+    std::vector<double> sums_{};
+  };
+
   class UncertainDataEstimator : virtual public Debug {
   public:
     UncertainDataEstimator();
@@ -284,6 +383,164 @@ namespace ttk {
   };
 } // namespace ttk
 
+template <class dataType>
+int ttk::EnsembleStatistics<dataType>::evaluateRealizations(
+  const dataType *const *inputData, const int numberOfRealizations) {
+
+#ifndef TTK_ENABLE_KAMIKAZE
+  if(!(numberOfVertices_ > 0)) {
+    return -1; // Number of vertices not defined
+  }
+  for(int m = 0; m < numberOfRealizations; m++) {
+    if(!inputData[m]) {
+      return -2;
+    }
+  }
+  for(const auto bin : binFields_) {
+    if(!bin) {
+      return -3; // Missing bin field
+    }
+  }
+#endif
+
+  const bool computeHistograms = !binFields_.empty();
+  const int numberOfBins = binFields_.size();
+  if(computeHistograms && !(rangeMin_ <= rangeMax_)) {
+    return -4; // Range error
+  }
+  const double binScale
+    = rangeMax_ > rangeMin_ ? numberOfBins / (rangeMax_ - rangeMin_) : 0.0;
+
+  double *sums = meanField_;
+  if(varianceField_ && !sums) {
+    sums_.resize(numberOfVertices_);
+    sums = sums_.data();
+  }
+  double *const *bins = binFields_.data();
+  const SimplexId numberOfBlocks
+    = (numberOfVertices_ + BlockSize - 1) / BlockSize;
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif
+  for(SimplexId block = 0; block < numberOfBlocks; block++) {
+    const SimplexId begin = block * BlockSize;
+    const SimplexId end = std::min(begin + BlockSize, numberOfVertices_);
+
+    for(int m = 0; m < numberOfRealizations; m++) {
+      const dataType *data = inputData[m];
+      // number of realizations already accumulated
+      const int k = numberOfRealizations_ + m;
+
+      if(lowerBoundField_) {
+        dataType *lower = lowerBoundField_;
+        if(k == 0) {
+          std::copy(data + begin, data + end, lower + begin);
+        } else {
+          for(SimplexId v = begin; v < end; v++) {
+            lower[v] = data[v] < lower[v] ? data[v] : lower[v];
+          }
+        }
+      }
+
+      if(upperBoundField_) {
+        dataType *upper = upperBoundField_;
+        if(k == 0) {
+          std::copy(data + begin, data + end, upper + begin);
+        } else {
+          for(SimplexId v = begin; v < end; v++) {
+            upper[v] = data[v] > upper[v] ? data[v] : upper[v];
+          }
+        }
+      }
+
+      if(varianceField_) {
+        // Welford's update, the means being derived from the running sums
+        double *m2 = varianceField_;
+        if(k == 0) {
+          for(SimplexId v = begin; v < end; v++) {
+            sums[v] = static_cast<double>(data[v]);
+            m2[v] = 0.0;
+          }
+        } else {
+          const double previousScale = 1.0 / k;
+          const double scale = 1.0 / (k + 1);
+          for(SimplexId v = begin; v < end; v++) {
+            const double x = static_cast<double>(data[v]);
+            const double delta = x - sums[v] * previousScale;
+            sums[v] += x;
+            m2[v] += delta * (x - sums[v] * scale);
+          }
+        }
+      } else if(sums) {
+        if(k == 0) {
+          for(SimplexId v = begin; v < end; v++) {
+            sums[v] = static_cast<double>(data[v]);
+          }
+        } else {
+          for(SimplexId v = begin; v < end; v++) {
+            sums[v] += static_cast<double>(data[v]);
+          }
+        }
+      }
+
+      if(computeHistograms) {
+        if(k == 0) {
+          for(int b = 0; b < numberOfBins; b++) {
+            std::fill(bins[b] + begin, bins[b] + end, 0.0);
+          }
+        }
+        for(SimplexId v = begin; v < end; v++) {
+          int bin = static_cast<int>(
+            std::floor((static_cast<double>(data[v]) - rangeMin_) * binScale));
+          bin = std::max(0, std::min(bin, numberOfBins - 1));
+          bins[bin][v] += 1.0;
+        }
+      }
+    }
+  }
+
+  numberOfRealizations_ += numberOfRealizations;
+
+  return 0;
+}
+
+template <class dataType>
+int ttk::EnsembleStatistics<dataType>::finalize() {
+
+#ifndef TTK_ENABLE_KAMIKAZE
+  if(!(numberOfRealizations_ > 0)) {
+    return -1; // No realization
+  }
+#endif
+
+  // probabilities are bin counts times 1/n: they may differ in the last
+  // bits from a sum of n increments of 1/n
+  const double normalization = 1.0 / numberOfRealizations_;
+  const double varianceNormalization
+    = numberOfRealizations_ > 1 ? 1.0 / (numberOfRealizations_ - 1) : 0.0;
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif
+  for(SimplexId v = 0; v < numberOfVertices_; v++) {
+    if(meanField_) {
+      meanField_[v] /= numberOfRealizations_;
+    }
+    if(varianceField_) {
+      varianceField_[v] *= varianceNormalization;
+    }
+    for(const auto bin : binFields_) {
+      bin[v] *= normalization;
+    }
+  }
+
+  numberOfRealizations_ = 0;
+  sums_.clear();
+
+  return 0;
+}
+
 template <class dataType>
 int ttk::UncertainDataEstimator::execute() {
 
@@ -306,77 +563,49 @@ int ttk::UncertainDataEstimator::execute() {
     return -6;
 #endif
 
-  SimplexId count = 0;
-
   // Pointers type casting
   dataType *outputLowerBoundField = (dataType *)outputLowerBoundField_;
   dataType *outputUpperBoundField = (dataType *)outputUpperBoundField_;
-  dataType **inputData = (dataType **)inputData_.data();
+  const dataType *const *inputData = (dataType **)inputData_.data();
   double *outputMeanField = static_cast<double *>(outputMeanField_);
 
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(threadNumber_)
-#endif
-  for(SimplexId v = 0; v < (SimplexId)vertexNumber_; v++) {
-
-    // Avoid any processing if the abort signal is sent
-    if((!wrapper_) || ((wrapper_) && (!wrapper_->needsToAbort()))) {
-
-      // For the lower bound scalar field
-      if(ComputeLowerBound) {
-        // Initialisation : values of the first input
-        outputLowerBoundField[v] = inputData[0][v];
-        // Loop over the inputs
-        for(int inp = 1; inp < numberOfInputs_; inp++) {
-          // Minimum value
-          if(ComputeLowerBound)
-            if(inputData[inp][v] < outputLowerBoundField[v])
-              outputLowerBoundField[v] = inputData[inp][v];
-        }
-      }
-
-      // For the upper bound scalar field
-      if(ComputeUpperBound) {
-        // Initialisation : values of the first input
-        outputUpperBoundField[v] = inputData[0][v];
-        // Loop over the inputs
-        for(int inp = 1; inp < numberOfInputs_; inp++) {
-          // Maximum value
-          if(ComputeUpperBound)
-            if(inputData[inp][v] > outputUpperBoundField[v])
-              outputUpperBoundField[v] = inputData[inp][v];
-        }
-      }
-
-      // Update the progress bar of the wrapping code -- to adapt
-      if(debugLevel_ > static_cast<int>(debug::Priority::DETAIL)) {
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp critical
-#endif
-        {
-          if((wrapper_) && (!(count % ((vertexNumber_) / 10)))) {
-            wrapper_->updateProgress((count + 1.0) / vertexNumber_);
-          }
+  // Bounds and mean field, in a single streaming pass over the inputs
+  EnsembleStatistics<dataType> moments{};
+  moments.setThreadNumber(threadNumber_);
+  moments.setNumberOfVertices(vertexNumber_);
+  if(ComputeLowerBound) {
+    moments.setLowerBoundField(outputLowerBoundField);
+  }
+  if(ComputeUpperBound) {
+    moments.setUpperBoundField(outputUpperBoundField);
+  }
+  moments.setMeanField(outputMeanField);
+  if(moments.evaluateRealizations(inputData, numberOfInputs_) != 0
+     || moments.finalize() != 0) {
+    this->printErr("Could not compute the bounds and the mean field");
+    return -7;
+  }
 
-          count++;
-        }
-      }
-    }
+  // Avoid any further processing if the abort signal is sent
+  if(wrapper_ && wrapper_->needsToAbort()) {
+    return 0;
   }
 
   // Histogram
   if(ComputeUpperBound && ComputeLowerBound) {
     // Range
-    double range[2];
-    range[0] = outputLowerBoundField[0];
-    range[1] = outputUpperBoundField[0];
-
+    dataType rangeMin = outputLowerBoundField[0];
+    dataType rangeMax = outputUpperBoundField[0];
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) \
+  reduction(min : rangeMin) reduction(max : rangeMax)
+#endif
     for(SimplexId v = 0; v < vertexNumber_; v++) {
-      if(outputLowerBoundField[v] < range[0])
-        range[0] = outputLowerBoundField[v];
-      if(outputUpperBoundField[v] > range[1])
-        range[1] = outputUpperBoundField[v];
+      rangeMin = std::min(rangeMin, outputLowerBoundField[v]);
+      rangeMax = std::max(rangeMax, outputUpperBoundField[v]);
     }
+    double range[2] = {static_cast<double>(rangeMin),
+                       static_cast<double>(rangeMax)};
 
     // Interval between bins
     double const dx = (range[1] - range[0]) / (double)BinCount;
@@ -386,28 +615,20 @@ int ttk::UncertainDataEstimator::execute() {
       binValues_[b] = range[0] + (dx / 2.0) + (double)b * dx;
     }
 
-    int idx;
-    double const increment = 1.0 / (double)numberOfInputs_;
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for private(idx) num_threads(threadNumber_)
-#endif
-    for(SimplexId v = 0; v < vertexNumber_; v++) {
-      for(int i = 0; i < numberOfInputs_; i++) {
-        idx = (int)floor((inputData[i][v] - range[0]) * BinCount
-                         / (range[1] - range[0]));
-        idx = (idx == BinCount) ? BinCount - 1 : idx;
-        outputProbability_[idx][v] += increment;
-      }
+    // Probabilities, in a second pass once the range is known
+    EnsembleStatistics<dataType> histograms{};
+    histograms.setThreadNumber(threadNumber_);
+    histograms.setNumberOfVertices(vertexNumber_);
+    histograms.setNumberOfBins(BinCount);
+    for(int b = 0; b < BinCount; b++) {
+      histograms.setBinField(b, outputProbability_[b]);
     }
-  }
-
-  // Mean field
-  for(SimplexId v = 0; v < vertexNumber_; v++) {
-    double sum = 0.0;
-    for(int i = 0; i < numberOfInputs_; i++) {
-      sum += static_cast<double>(inputData[i][v]);
+    histograms.setRange(range[0], range[1]);
+    if(histograms.evaluateRealizations(inputData, numberOfInputs_) != 0
+       || histograms.finalize() != 0) {
+      this->printErr("Could not compute the probabilities");
+      return -8;
     }
-    outputMeanField[v] = sum / static_cast<double>(numberOfInputs_);
   }
 
   this->printMsg(std::vector<std::vector<std::string>>{
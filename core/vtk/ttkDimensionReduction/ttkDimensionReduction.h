@@ -100,6 +100,9 @@ public:
   ttkSetEnumMacro(Method, METHOD);
   vtkGetEnumMacro(Method, METHOD);
 
+  vtkSetMacro(UseNativeBackend, bool);
+  vtkGetMacro(UseNativeBackend, bool);
+
   vtkSetMacro(KeepAllDataArrays, bool);
   vtkGetMacro(KeepAllDataArrays, bool);
 
@@ -162,6 +165,9 @@ public:
   vtkSetMacro(mds_Epsilon, float);
   vtkGetMacro(mds_Epsilon, float);
 
+  vtkSetMacro(mds_NumberOfLandmarks, int);
+  vtkGetMacro(mds_NumberOfLandmarks, int);
+
   // TSNE
   vtkSetMacro(tsne_Perplexity, float);
   vtkGetMacro(tsne_Perplexity, float);
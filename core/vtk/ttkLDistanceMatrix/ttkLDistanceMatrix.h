@@ -34,6 +34,18 @@ public:
   vtkSetMacro(DistanceType, const std::string &);
   vtkGetMacro(DistanceType, std::string);
 
+  void SetTileSize(const int size) {
+    this->setTileSize(size);
+    this->Modified();
+  }
+  vtkGetMacro(TileSize, int);
+
+  void SetCheckpointFile(const std::string &path) {
+    this->setCheckpointFile(path);
+    this->Modified();
+  }
+  vtkGetMacro(CheckpointFile, std::string);
+
 protected:
   ttkLDistanceMatrix();
   ~ttkLDistanceMatrix() override = default;
@@ -187,6 +187,18 @@ public:
   vtkSetMacro(mixtureCoefficient_, double);
   vtkGetMacro(mixtureCoefficient_, double);
 
+  void SetTileSize(const int size) {
+    this->setTileSize(size);
+    this->Modified();
+  }
+  vtkGetMacro(TileSize, int);
+
+  void SetCheckpointFile(const std::string &path) {
+    this->setCheckpointFile(path);
+    this->Modified();
+  }
+  vtkGetMacro(CheckpointFile, std::string);
+
   /**
    * This static method and the macro below are VTK conventions on how to
    * instantiate VTK objects. You don't have to modify this.
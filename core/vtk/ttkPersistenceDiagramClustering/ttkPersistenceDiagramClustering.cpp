@@ -155,6 +155,8 @@ int ttkPersistenceDiagramClustering::RequestData(
       pdBarycenter.setAlpha(Alpha);
       pdBarycenter.setLambda(Lambda);
       pdBarycenter.setNonMatchingWeight(NonMatchingWeight);
+      pdBarycenter.setUseJacobiBidding(UseJacobiBidding);
+      pdBarycenter.setReinitPrices(!WarmStart);
       pdBarycenter.execute(
         intermediateDiagrams_, final_centroids_[0], all_matchings_);
 
@@ -140,6 +140,12 @@ public:
   vtkSetMacro(NonMatchingWeight, double);
   vtkGetMacro(NonMatchingWeight, double);
 
+  vtkSetMacro(UseJacobiBidding, bool);
+  vtkGetMacro(UseJacobiBidding, bool);
+
+  vtkSetMacro(WarmStart, bool);
+  vtkGetMacro(WarmStart, bool);
+
 protected:
   ttkPersistenceDiagramClustering();
 
@@ -126,6 +126,24 @@ public:
   vtkSetMacro(MinPersistence, double);
   vtkGetMacro(MinPersistence, double);
 
+  void SetUseJacobiBidding(const bool data) {
+    this->setUseJacobiBidding(data);
+    this->Modified();
+  }
+  vtkGetMacro(UseJacobiBidding, bool);
+
+  void SetTileSize(const int size) {
+    this->setTileSize(size);
+    this->Modified();
+  }
+  vtkGetMacro(TileSize, int);
+
+  void SetCheckpointFile(const std::string &path) {
+    this->setCheckpointFile(path);
+    this->Modified();
+  }
+  vtkGetMacro(CheckpointFile, std::string);
+
 protected:
   ttkPersistenceDiagramDistanceMatrix();
   ~ttkPersistenceDiagramDistanceMatrix() override = default;
@@ -53,6 +53,9 @@ public:
   vtkSetMacro(InputIsDistanceMatrix, int);
   vtkGetMacro(InputIsDistanceMatrix, int);
 
+  vtkSetMacro(SparseApproximation, double);
+  vtkGetMacro(SparseApproximation, double);
+
 protected:
   ttkRipsPersistenceDiagram();
   ~ttkRipsPersistenceDiagram() override = default;